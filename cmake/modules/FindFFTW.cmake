@@ -0,0 +1,20 @@
+include(FindPackageHandleStandardArgs)
+
+find_path(FFTW_INCLUDE_DIR fftw3.h PATH_SUFFIXES include)
+find_library(FFTW_LIBRARY fftw3 PATH_SUFFIXES lib)
+find_library(FFTW_FLOAT_LIBRARY fftw3f PATH_SUFFIXES lib)
+find_library(FFTW_THREADS_LIBRARY fftw3_threads PATH_SUFFIXES lib)
+find_library(FFTW_FLOAT_THREADS_LIBRARY fftw3f_threads PATH_SUFFIXES lib)
+mark_as_advanced(FFTW_INCLUDE_DIR FFTW_LIBRARY FFTW_FLOAT_LIBRARY
+    FFTW_THREADS_LIBRARY FFTW_FLOAT_THREADS_LIBRARY)
+
+find_package_handle_standard_args(FFTW
+    DEFAULT_MSG FFTW_LIBRARY FFTW_FLOAT_LIBRARY FFTW_INCLUDE_DIR)
+
+set(FFTW_INCLUDE_DIRS ${FFTW_INCLUDE_DIR})
+set(FFTW_LIBRARIES ${FFTW_LIBRARY} ${FFTW_FLOAT_LIBRARY})
+if (FFTW_THREADS_LIBRARY AND FFTW_FLOAT_THREADS_LIBRARY)
+    set(FFTW_THREADS_FOUND TRUE)
+    list(INSERT FFTW_LIBRARIES 0
+        ${FFTW_THREADS_LIBRARY} ${FFTW_FLOAT_THREADS_LIBRARY})
+endif()
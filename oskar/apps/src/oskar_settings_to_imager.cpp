@@ -64,7 +64,15 @@ oskar_Imager* oskar_settings_to_imager(oskar::SettingsTree* s,
             s->to_int("scale_norm_with_num_input_files", status));
     oskar_imager_set_ms_column(h,
             s->to_string("ms_column", status), status);
+    oskar_imager_set_coord_cache_mb(h, s->to_double("coord_cache_mb", status));
+    oskar_imager_set_grid_memory_mb(h, s->to_double("grid_memory_mb", status));
+    oskar_imager_set_grid_scratch_dir(h,
+            s->to_string("grid_scratch_dir", status));
     oskar_imager_set_output_root(h, s->to_string("root_path", status));
+    oskar_imager_set_fits_compression(h,
+            s->to_string("fits_compression", status), status);
+    oskar_imager_set_fits_quantize_level(h,
+            s->to_double("fits_quantize_level", status));
 
     // Set remaining imager options.
     oskar_imager_set_image_type(h,
@@ -106,10 +114,19 @@ oskar_Imager* oskar_settings_to_imager(oskar::SettingsTree* s,
         oskar_imager_set_num_w_planes(h,
                 s->to_int("wproj/num_w_planes", status));
     }
+    if (s->starts_with("algorithm", "W-s", status) &&
+            !s->starts_with("wstack/num_w_layers", "auto", status))
+    {
+        oskar_imager_set_num_w_planes(h,
+                s->to_int("wstack/num_w_layers", status));
+    }
     oskar_imager_set_fft_on_gpu(h, s->to_int("fft/use_gpu", status));
     oskar_imager_set_grid_on_gpu(h, s->to_int("fft/grid_on_gpu", status));
+    oskar_imager_set_half_plane(h, s->to_int("fft/half_plane", status));
     oskar_imager_set_generate_w_kernels_on_gpu(h,
             s->to_int("wproj/generate_w_kernels_on_gpu", status));
+    oskar_imager_set_w_kernel_cache_dir(h,
+            s->to_string("wproj/kernel_cache_dir", status));
     if (s->first_letter("direction", status) == 'R')
     {
         oskar_imager_set_direction(h,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, The OSKAR Developers.
+ * Copyright (c) 2017-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -88,6 +88,19 @@ oskar_Interferometer* oskar_settings_to_interferometer(oskar::SettingsTree* s,
             s->to_int("max_time_samples_per_block", status));
     oskar_interferometer_set_max_channels_per_block(h,
             s->to_int("max_channels_per_block", status));
+    oskar_interferometer_set_num_output_buffers(h,
+            s->to_int("num_output_buffers", status));
+    oskar_interferometer_set_num_writer_threads(h,
+            s->to_int("num_writer_threads", status));
+    if (s->starts_with("num_threads_per_device", "auto", status))
+    {
+        oskar_interferometer_set_num_threads_per_device(h, 0);
+    }
+    else
+    {
+        oskar_interferometer_set_num_threads_per_device(h,
+                s->to_int("num_threads_per_device", status));
+    }
     oskar_interferometer_set_output_vis_file(h,
             s->to_string("oskar_vis_filename", status));
     oskar_interferometer_set_output_measurement_set(h,
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 
 using oskar::SettingsTree;
@@ -431,3 +432,157 @@ TEST(apps, test_imager_sizes)
     // Free settings.
     SettingsTree::free(sim_settings);
 }
+
+TEST(apps, test_imager_coord_cache)
+{
+    int status = 0;
+    printf("OSKAR %s: Testing imager coordinate cache...\n",
+            oskar_version_string());
+
+    // Create a sky model file.
+    const char* sky_model_file = "apps_test_sky.txt";
+    create_sky_model(sky_model_file, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create a telescope model directory.
+    const char* tel_model_dir = "apps_test_telescope.tm";
+    create_telescope_model(tel_model_dir, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Test using binary file and Measurement Set, if available.
+    const char* suffixes[] = {"vis"
+#ifndef OSKAR_NO_MS
+            , "ms"
+#endif
+    };
+    const int num_suffixes = sizeof(suffixes) / sizeof(char*);
+
+    // Test without the cache, in memory, and using a temporary file.
+    const double cache_mb[] = {0.0, 1024.0, 0.001};
+    const int num_cache_sizes = sizeof(cache_mb) / sizeof(double);
+
+    // Set base parameters.
+    string test_name = "apps_test_imager_coord_cache";
+    const char* sim_par[] = {
+            "sky/oskar_sky_model/file", sky_model_file,
+            "observation/phase_centre_ra_deg", "20.0",
+            "observation/phase_centre_dec_deg", "-30.0",
+            "observation/start_frequency_hz", "100e6",
+            "observation/num_channels", "2",
+            "observation/frequency_inc_hz", "20e6",
+            "observation/start_time_utc", "2000-01-01 12:00:00.0",
+            "observation/length", "06:00:00.0",
+            "observation/num_time_steps", "24",
+            "telescope/input_directory", tel_model_dir,
+            "telescope/allow_station_beam_duplication", "true",
+            "telescope/station_type", "Gaussian beam",
+            "telescope/gaussian_beam/fwhm_deg", "5.0",
+            "telescope/gaussian_beam/ref_freq_hz", "100e6",
+            "interferometer/max_time_samples_per_block", "4",
+            NULL, NULL
+    };
+    const char* img_par[] = {
+            "image/fov_deg", "2.0",
+            "image/size", "128",
+            "image/use_gpus", "false",
+            "image/weighting", "Uniform",
+            NULL, NULL
+    };
+    const char* algorithms[] = {"FFT", "W-projection"};
+    const int num_algorithms = sizeof(algorithms) / sizeof(char*);
+
+    // Create settings and set base values.
+    SettingsTree* sim_settings = oskar_app_settings_tree(app_interferometer, 0);
+    ASSERT_TRUE(sim_settings->set_values(0, sim_par));
+
+    // Set output names for visibilities.
+    string root_name = test_name;
+    ASSERT_TRUE(sim_settings->set_value("interferometer/oskar_vis_filename",
+            string(root_name + ".vis").c_str()));
+#ifndef OSKAR_NO_MS
+    ASSERT_TRUE(sim_settings->set_value("interferometer/ms_filename",
+            string(root_name + ".ms").c_str()));
+#endif
+
+    // Create an interferometer simulator.
+    oskar_Interferometer* sim = oskar_settings_to_interferometer(
+            sim_settings, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create a sky model and telescope model.
+    oskar_Sky* sky = oskar_settings_to_sky(
+            sim_settings, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    oskar_Telescope* tel = oskar_settings_to_telescope(
+            sim_settings, 0, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Run visibility simulation.
+    printf("Generating visibilities: %s\n", root_name.c_str());
+    oskar_interferometer_set_telescope_model(sim, tel, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    oskar_interferometer_set_sky_model(sim, sky, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    oskar_interferometer_run(sim, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Delete objects.
+    oskar_interferometer_free(sim, &status);
+    oskar_sky_free(sky, &status);
+    oskar_telescope_free(tel, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Loop over file types and algorithms.
+    for (int i_suffix = 0; i_suffix < num_suffixes; ++i_suffix)
+    {
+        for (int i_alg = 0; i_alg < num_algorithms; ++i_alg)
+        {
+            // Make an image with each cache size.
+            oskar_Mem* image[3];
+            for (int i = 0; i < num_cache_sizes; ++i)
+            {
+                // Create imager.
+                SettingsTree* img_settings =
+                        oskar_app_settings_tree(app_imager, 0);
+                ASSERT_TRUE(img_settings->set_values(0, img_par));
+                ASSERT_TRUE(img_settings->set_value(
+                        "image/algorithm", algorithms[i_alg]));
+                string input_vis_data = string(
+                        root_name + ".") + suffixes[i_suffix];
+                ASSERT_TRUE(img_settings->set_value(
+                        "image/input_vis_data", input_vis_data.c_str()));
+                oskar_Imager* img = oskar_settings_to_imager(
+                        img_settings, 0, &status);
+                oskar_imager_set_coord_cache_mb(img, cache_mb[i]);
+                ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+                // Run imager.
+                image[i] = 0;
+                oskar_imager_run(img, 1, &image[i], 0, 0, &status);
+                ASSERT_EQ(0, status) << oskar_get_error_string(status);
+                oskar_imager_free(img, &status);
+                SettingsTree::free(img_settings);
+            }
+
+            // Check the images are the same.
+            for (int i = 1; i < num_cache_sizes; ++i)
+            {
+                ASSERT_EQ(oskar_mem_length(image[0]),
+                        oskar_mem_length(image[i]));
+                EXPECT_EQ(0, memcmp(oskar_mem_void(image[0]),
+                        oskar_mem_void(image[i]),
+                        oskar_mem_length(image[0]) * oskar_mem_element_size(
+                                oskar_mem_type(image[0])))) <<
+                        algorithms[i_alg] << ", " << suffixes[i_suffix] <<
+                        ", cache size " << cache_mb[i] << " MB";
+            }
+            for (int i = 0; i < num_cache_sizes; ++i)
+            {
+                oskar_mem_free(image[i], &status);
+            }
+        }
+    }
+
+    // Free settings.
+    SettingsTree::free(sim_settings);
+}
@@ -1,14 +1,19 @@
 /*
- * Copyright (c) 2021, The OSKAR Developers.
+ * Copyright (c) 2021-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <gtest/gtest.h>
 
 #include "apps/oskar_apps.h"
+#include "binary/oskar_binary.h"
+#include "imager/oskar_imager.h"
+#include "interferometer/oskar_interferometer.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_version_string.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
@@ -209,3 +214,138 @@ TEST(apps, test_interferometer_modes)
     // Free settings.
     SettingsTree::free(sim_settings);
 }
+
+TEST(apps, test_interferometer_model_image)
+{
+    int status = 0;
+    const int size = 64;
+
+    // Create a sky model file and a telescope model directory.
+    const char* sky_model_file = "apps_test_sky.txt";
+    create_sky_model(sky_model_file, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    const char* tel_model_dir = "apps_test_telescope.tm";
+    create_telescope_model(tel_model_dir, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create an imager with a model image containing a single pixel.
+    oskar_Imager* model_imager = oskar_imager_create(OSKAR_DOUBLE, &status);
+    oskar_imager_set_fov(model_imager, 2.0);
+    oskar_imager_set_size(model_imager, size, &status);
+    oskar_Mem* model = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+            (size_t) size * size, &status);
+    oskar_mem_clear_contents(model, &status);
+    oskar_mem_double(model, &status)[20 * size + 40] = 2.0;
+    oskar_imager_set_model_image(model_imager, model, &status);
+    oskar_mem_free(model, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Simulate the sky model without and with the model image.
+    const char* sim_par[] = {
+            "simulator/double_precision", "true",
+            "simulator/use_gpus", "false",
+            "sky/oskar_sky_model/file", sky_model_file,
+            "observation/phase_centre_ra_deg", "20.0",
+            "observation/phase_centre_dec_deg", "-30.0",
+            "observation/start_frequency_hz", "100e6",
+            "observation/num_channels", "3",
+            "observation/frequency_inc_hz", "20e6",
+            "observation/start_time_utc", "2000-01-01 12:00:00.0",
+            "observation/length", "06:00:00.0",
+            "observation/num_time_steps", "8",
+            "telescope/input_directory", tel_model_dir,
+            "telescope/pol_mode", "Full",
+            "interferometer/correlation_type", "Both",
+            "interferometer/max_time_samples_per_block", "3",
+            NULL, NULL
+    };
+    const char* vis_files[] = {
+            "apps_test_interferometer_model_image_0.vis",
+            "apps_test_interferometer_model_image_1.vis"
+    };
+    SettingsTree* sim_settings = oskar_app_settings_tree(app_interferometer, 0);
+    ASSERT_TRUE(sim_settings->set_values(0, sim_par));
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(sim_settings->set_value(
+                "interferometer/oskar_vis_filename", vis_files[i]));
+        oskar_Interferometer* sim = oskar_settings_to_interferometer(
+                sim_settings, 0, &status);
+        oskar_Sky* sky = oskar_settings_to_sky(sim_settings, 0, &status);
+        oskar_Telescope* tel = oskar_settings_to_telescope(
+                sim_settings, 0, &status);
+        oskar_interferometer_set_telescope_model(sim, tel, &status);
+        oskar_interferometer_set_sky_model(sim, sky, &status);
+        if (i == 1) oskar_interferometer_set_model_imager(sim, model_imager);
+        oskar_interferometer_run(sim, &status);
+        oskar_interferometer_free(sim, &status);
+        oskar_sky_free(sky, &status);
+        oskar_telescope_free(tel, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    }
+    SettingsTree::free(sim_settings);
+
+    // Check the difference between the two simulations in each block
+    // is the model image prediction for the block.
+    oskar_Binary* file[2];
+    oskar_VisHeader* hdr[2];
+    oskar_VisBlock* block[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        file[i] = oskar_binary_create(vis_files[i], 'r', &status);
+        hdr[i] = oskar_vis_header_read(file[i], &status);
+        block[i] = oskar_vis_block_create_from_header(
+                OSKAR_CPU, hdr[i], &status);
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    const int num_blocks = oskar_vis_header_num_blocks(hdr[0]);
+    ASSERT_GT(num_blocks, 1);
+    ASSERT_EQ(num_blocks, oskar_vis_header_num_blocks(hdr[1]));
+    oskar_VisBlock* expected = oskar_vis_block_create_from_header(
+            OSKAR_CPU, hdr[0], &status);
+    double max_diff = 0.0, max_pred = 0.0;
+    for (int i_block = 0; i_block < num_blocks; ++i_block)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            oskar_vis_block_read(block[i], hdr[i], file[i], i_block, &status);
+        }
+        oskar_vis_block_copy(expected, block[0], &status);
+        oskar_imager_predict_block(model_imager, hdr[0], expected, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Check the cross-correlations.
+        const oskar_Mem* xc_0 = oskar_vis_block_cross_correlations_const(
+                block[0]);
+        const size_t num = 2 * 4 * oskar_mem_length(xc_0);
+        const double* v0 = oskar_mem_double_const(xc_0, &status);
+        const double* v1 = oskar_mem_double_const(
+                oskar_vis_block_cross_correlations_const(block[1]), &status);
+        const double* ve = oskar_mem_double_const(
+                oskar_vis_block_cross_correlations_const(expected), &status);
+        for (size_t j = 0; j < num; ++j)
+        {
+            max_pred = std::max(max_pred, std::fabs(ve[j] - v0[j]));
+            max_diff = std::max(max_diff, std::fabs(v1[j] - ve[j]));
+        }
+
+        // Check the auto-correlations are unchanged.
+        EXPECT_EQ(0, oskar_mem_different(
+                oskar_vis_block_auto_correlations_const(block[0]),
+                oskar_vis_block_auto_correlations_const(block[1]),
+                0, &status));
+    }
+    EXPECT_GT(max_pred, 0.1);
+    EXPECT_LT(max_diff, 1e-10);
+
+    // Clean up.
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_binary_free(file[i]);
+        oskar_vis_block_free(block[i], &status);
+        oskar_vis_header_free(hdr[i], &status);
+    }
+    oskar_vis_block_free(expected, &status);
+    oskar_imager_free(model_imager, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+}
@@ -1093,6 +1093,16 @@ static void record_timing(oskar_BeamPattern* h)
     }
     oskar_log_value(h->log, 'M', 0, "Write", "%.3f s",
             oskar_timer_elapsed(h->tmr_write));
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        const oskar_StationWork* work = h->d[i].work;
+        if (!work || !oskar_station_work_element_cache_lookups(work)) continue;
+        oskar_log_value(h->log, 'M', 0, "Element pattern cache",
+                "%lu hits of %lu [Device %i]",
+                (unsigned long) oskar_station_work_element_cache_hits(work),
+                (unsigned long) oskar_station_work_element_cache_lookups(work),
+                i);
+    }
 }
 
 
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+/* Definitions shared by the SIMD CPU correlators (C++ only). */
+
+#ifndef OSKAR_DEFINE_CORRELATE_SIMD_H_
+#define OSKAR_DEFINE_CORRELATE_SIMD_H_
+
+#include "math/oskar_kahan_sum.h"
+#include <stdint.h>
+#include <string.h>
+
+/* The SIMD kernels use GCC vector extensions, compiled for each instruction
+ * set using target attributes, so only one build of the library is needed. */
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__x86_64__) || defined(__i386__))
+#define OSKAR_XCORR_SIMD 1
+#endif
+
+/* Alignment of all SIMD buffers, in bytes (and so, the widest vector). */
+#define SIMD_ALIGN 64
+
+#ifdef OSKAR_XCORR_SIMD
+
+typedef float  oskar_SimdF32x8  __attribute__((vector_size(32)));
+typedef float  oskar_SimdF32x16 __attribute__((vector_size(64)));
+typedef double oskar_SimdF64x4  __attribute__((vector_size(32)));
+typedef double oskar_SimdF64x8  __attribute__((vector_size(64)));
+
+template<typename REAL, int BYTES> struct oskar_SimdVec;
+template<> struct oskar_SimdVec<float, 32>  { typedef oskar_SimdF32x8 type; };
+template<> struct oskar_SimdVec<float, 64>  { typedef oskar_SimdF32x16 type; };
+template<> struct oskar_SimdVec<double, 32> { typedef oskar_SimdF64x4 type; };
+template<> struct oskar_SimdVec<double, 64> { typedef oskar_SimdF64x8 type; };
+
+/* Vector loads and stores are done using memcpy to avoid pointer casts.
+ * All vector data are aligned, so these compile to single instructions. */
+#define SIMD_LOAD(VEC, PTR)  memcpy(&(VEC), (PTR), sizeof(VEC))
+#define SIMD_STORE(PTR, VEC) memcpy((PTR), &(VEC), sizeof(VEC))
+
+/* Adds a vector of terms to a vector of sums. As in the other CPU
+ * correlators, Kahan summation is used in single precision. */
+#define SIMD_ACCUMULATE(REAL, VEC, SUM, VAL, GUARD)                        \
+        if (sizeof(REAL) == sizeof(float))                                 \
+            OSKAR_KAHAN_SUM(VEC, SUM, VAL, GUARD)                          \
+        else SUM += VAL;
+
+/* Returns the widest vector size supported by this CPU, in bytes. */
+static int oskar_xcorr_simd_bytes(void)
+{
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return 64;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return 32;
+    return 0;
+}
+
+/* Returns the first aligned address at or after ptr.
+ * The allocation must have SIMD_ALIGN spare bytes. */
+static void* oskar_xcorr_simd_align(void* ptr)
+{
+    return (void*) (((uintptr_t) ptr + SIMD_ALIGN - 1) &
+            ~((uintptr_t) SIMD_ALIGN - 1));
+}
+
+#endif /* OSKAR_XCORR_SIMD */
+
+#endif /* include guard */
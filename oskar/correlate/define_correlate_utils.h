@@ -41,3 +41,20 @@
 /* Evaluates 1D linear baseline index for stations P and Q. */
 #define OSKAR_BASELINE_INDEX(NUM_STATIONS, P, Q) \
     (Q * (NUM_STATIONS - 1) - (Q - 1) * Q / 2 + P - Q - 1)
+
+/* Evaluates the range [START, END) of baselines for one of NUM_THREADS
+ * threads, so that all threads get the same number of baselines (+/- 1). */
+#define OSKAR_BASELINE_RANGE(NUM_BASELINES, THREAD, NUM_THREADS, START, END) {\
+        START = (int) (((long long) (NUM_BASELINES) * (THREAD)) /\
+                (NUM_THREADS));\
+        END = (int) (((long long) (NUM_BASELINES) * ((THREAD) + 1)) /\
+                (NUM_THREADS));}\
+
+/* Evaluates stations P > Q for linear baseline index B, where baselines
+ * are ordered first by station P and then by station Q, so that
+ * consecutive baselines share the same station P. */
+#define OSKAR_BASELINE_STATIONS(B, P, Q) {\
+        P = (int) ((1.0 + sqrt(1.0 + 8.0 * (double) (B))) / 2.0);\
+        while (P * (P - 1) / 2 > (B)) P--;\
+        while ((P + 1) * P / 2 <= (B)) P++;\
+        Q = (B) - P * (P - 1) / 2;}
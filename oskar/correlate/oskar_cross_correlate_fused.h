@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_CROSS_CORRELATE_FUSED_H_
+#define OSKAR_CROSS_CORRELATE_FUSED_H_
+
+/**
+ * @file oskar_cross_correlate_fused.h
+ */
+
+#include <oskar_global.h>
+#include <telescope/oskar_telescope.h>
+#include <interferometer/oskar_jones.h>
+#include <mem/oskar_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Forms scalar visibilities, evaluating the interferometer phase on the fly.
+ *
+ * @details
+ * This gives the same result as evaluating Jones K using
+ * oskar_evaluate_jones_K(), joining it with Jones E, and then calling
+ * oskar_cross_correlate(), but the combined Jones scalars are only ever
+ * formed for a small tile of sources at a time. This avoids reading and
+ * writing arrays of size (num_stations * num_sources) several times.
+ *
+ * If the station beams are all unity, then \p E may be NULL,
+ * and it will not be used.
+ *
+ * Only scalar (complex) visibilities in CPU memory are currently supported.
+ *
+ * @param[in]  source_type    Source type (0 = point, 1 = Gaussian).
+ * @param[in]  num_sources    Number of sources to use.
+ * @param[in]  E              Station beam Jones scalars, or NULL.
+ * @param[in]  src_flux[4]    Vectors of source Stokes (I, Q, U, V) values.
+ * @param[in]  src_dir[3]     Vectors of source direction cosines.
+ * @param[in]  src_ext[3]     Vectors of extended source parameters.
+ * @param[in]  tel            Telescope model.
+ * @param[in]  station_uvw[3] Station (u, v, w) coordinates, in metres.
+ * @param[in]  gast           Greenwich apparent sidereal time, in radians.
+ * @param[in]  frequency_hz   Current observation frequency, in Hz.
+ * @param[in]  source_filter_min Sources with Stokes I <= this are excluded.
+ * @param[in]  source_filter_max Sources with Stokes I > this are excluded.
+ * @param[in]  ignore_w_components If true, ignore station w-coordinates.
+ * @param[in]  offset_out     Output visibility start offset.
+ * @param[out] vis            Output visibility amplitudes.
+ * @param[in,out] status      Status return code.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused(
+        int source_type,
+        int num_sources,
+        const oskar_Jones* E,
+        const oskar_Mem* const src_flux[4],
+        const oskar_Mem* const src_dir[3],
+        const oskar_Mem* const src_ext[3],
+        const oskar_Telescope* tel,
+        const oskar_Mem* const station_uvw[3],
+        double gast,
+        double frequency_hz,
+        double source_filter_min,
+        double source_filter_max,
+        int ignore_w_components,
+        int offset_out,
+        oskar_Mem* vis,
+        int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
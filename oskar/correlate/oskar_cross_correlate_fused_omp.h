@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_CROSS_CORRELATE_FUSED_OMP_H_
+#define OSKAR_CROSS_CORRELATE_FUSED_OMP_H_
+
+/**
+ * @file oskar_cross_correlate_fused_omp.h
+ */
+
+#include <oskar_global.h>
+#include <utility/oskar_vector_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Correlate function for point sources, scalar version with the
+ * interferometer phase evaluated on the fly (single precision).
+ *
+ * @details
+ * Forms visibilities on all baselines by correlating the product of the
+ * interferometer phase (Jones K) and station beam (Jones E) scalars for
+ * pairs of stations, and summing along the source dimension.
+ *
+ * The combined Jones scalars are never formed for all sources at once:
+ * they are evaluated for one small tile of sources at a time, which is
+ * then correlated while it is still in cache.
+ *
+ * If the station beams are all unity, then \p jones_E may be NULL.
+ *
+ * Sources with Stokes I outside the range (\p source_filter_min,
+ * \p source_filter_max] are excluded, as in oskar_evaluate_jones_K().
+ *
+ * Note that the station x, y, z coordinates must be in the ECEF frame.
+ *
+ * @param[in] num_sources    Number of sources.
+ * @param[in] num_stations   Number of stations.
+ * @param[in] offset_out     Output visibility start offset.
+ * @param[in] jones_E        Matrix of station beam scalars, or NULL.
+ * @param[in] I              Source Stokes I values, in Jy.
+ * @param[in] l              Source l-direction cosines from phase centre.
+ * @param[in] m              Source m-direction cosines from phase centre.
+ * @param[in] n              Source n-direction cosines from phase centre.
+ * @param[in] station_u      Station u-coordinates, in metres.
+ * @param[in] station_v      Station v-coordinates, in metres.
+ * @param[in] station_w      Station w-coordinates, in metres.
+ * @param[in] station_x      Station x-coordinates, in metres.
+ * @param[in] station_y      Station y-coordinates, in metres.
+ * @param[in] uv_min_lambda  Minimum allowed UV length, in wavelengths.
+ * @param[in] uv_max_lambda  Maximum allowed UV length, in wavelengths.
+ * @param[in] inv_wavelength Inverse of the wavelength, in metres.
+ * @param[in] wavenumber     Wavenumber (2 pi / wavelength), in radians/metre.
+ * @param[in] frac_bandwidth Bandwidth divided by frequency.
+ * @param[in] time_int_sec   Time averaging interval, in seconds.
+ * @param[in] gha0_rad       Greenwich Hour Angle of phase centre, in radians.
+ * @param[in] dec0_rad       Declination of phase centre, in radians.
+ * @param[in] source_filter_min Minimum Stokes I value to include.
+ * @param[in] source_filter_max Maximum Stokes I value to include.
+ * @param[in] ignore_w_components If true, ignore station w-coordinates.
+ * @param[in,out] vis        Modified output complex visibilities.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_point_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float2* jones_E, const float* I, const float* l,
+        const float* m, const float* n,
+        const float* station_u, const float* station_v,
+        const float* station_w, const float* station_x,
+        const float* station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float wavenumber, float frac_bandwidth,
+        float time_int_sec, float gha0_rad, float dec0_rad,
+        float source_filter_min, float source_filter_max,
+        int ignore_w_components, float2* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function for point sources, scalar version with the
+ * interferometer phase evaluated on the fly (double precision).
+ *
+ * @details
+ * See oskar_cross_correlate_fused_point_omp_f().
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_point_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double2* jones_E, const double* I, const double* l,
+        const double* m, const double* n,
+        const double* station_u, const double* station_v,
+        const double* station_w, const double* station_x,
+        const double* station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double wavenumber, double frac_bandwidth,
+        double time_int_sec, double gha0_rad, double dec0_rad,
+        double source_filter_min, double source_filter_max,
+        int ignore_w_components, double2* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function for Gaussian sources, scalar version with the
+ * interferometer phase evaluated on the fly (single precision).
+ *
+ * @details
+ * See oskar_cross_correlate_fused_point_omp_f().
+ *
+ * Gaussian parameters a, b, and c are assumed to be evaluated when the
+ * sky model is loaded.
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_gaussian_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float2* jones_E, const float* I, const float* l,
+        const float* m, const float* n,
+        const float* a, const float* b, const float* c,
+        const float* station_u, const float* station_v,
+        const float* station_w, const float* station_x,
+        const float* station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float wavenumber, float frac_bandwidth,
+        float time_int_sec, float gha0_rad, float dec0_rad,
+        float source_filter_min, float source_filter_max,
+        int ignore_w_components, float2* vis, int* status);
+
+/**
+ * @brief
+ * Correlate function for Gaussian sources, scalar version with the
+ * interferometer phase evaluated on the fly (double precision).
+ *
+ * @details
+ * See oskar_cross_correlate_fused_gaussian_omp_f().
+ */
+OSKAR_EXPORT
+void oskar_cross_correlate_fused_gaussian_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double2* jones_E, const double* I, const double* l,
+        const double* m, const double* n,
+        const double* a, const double* b, const double* c,
+        const double* station_u, const double* station_v,
+        const double* station_w, const double* station_x,
+        const double* station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double wavenumber, double frac_bandwidth,
+        double time_int_sec, double gha0_rad, double dec0_rad,
+        double source_filter_min, double source_filter_max,
+        int ignore_w_components, double2* vis, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
@@ -8,6 +8,8 @@
 #include "correlate/oskar_cross_correlate_omp.h"
 #include "correlate/oskar_cross_correlate_scalar_cuda.h"
 #include "correlate/oskar_cross_correlate_scalar_omp.h"
+#include "correlate/oskar_cross_correlate_gemm_omp.h"
+#include "correlate/oskar_cross_correlate_simd_omp.h"
 #include "utility/oskar_device.h"
 
 #include <float.h>
@@ -121,7 +123,7 @@ void oskar_cross_correlate(
             switch (oskar_mem_type(vis))
             {
             case OSKAR_SINGLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_gaussian_omp_f(
+                oskar_cross_correlate_gaussian_simd_omp_f(
                         num_sources, num_stations, offset_out,
                         oskar_mem_float4c_const(J, status),
                         oskar_mem_float_const(src_flux[0], status),
@@ -141,10 +143,10 @@ void oskar_cross_correlate(
                         oskar_mem_float_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_float4c(vis, status));
+                        oskar_mem_float4c(vis, status), status);
                 break;
             case OSKAR_DOUBLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_gaussian_omp_d(
+                oskar_cross_correlate_gaussian_simd_omp_d(
                         num_sources, num_stations, offset_out,
                         oskar_mem_double4c_const(J, status),
                         oskar_mem_double_const(src_flux[0], status),
@@ -164,7 +166,7 @@ void oskar_cross_correlate(
                         oskar_mem_double_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_double4c(vis, status));
+                        oskar_mem_double4c(vis, status), status);
                 break;
             case OSKAR_SINGLE_COMPLEX:
                 oskar_cross_correlate_scalar_gaussian_omp_f(
@@ -216,7 +218,7 @@ void oskar_cross_correlate(
             switch (oskar_mem_type(vis))
             {
             case OSKAR_SINGLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_point_omp_f(
+                oskar_cross_correlate_point_gemm_omp_f(
                         num_sources, num_stations, offset_out,
                         oskar_mem_float4c_const(J, status),
                         oskar_mem_float_const(src_flux[0], status),
@@ -233,10 +235,10 @@ void oskar_cross_correlate(
                         oskar_mem_float_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_float4c(vis, status));
+                        oskar_mem_float4c(vis, status), status);
                 break;
             case OSKAR_DOUBLE_COMPLEX_MATRIX:
-                oskar_cross_correlate_point_omp_d(
+                oskar_cross_correlate_point_gemm_omp_d(
                         num_sources, num_stations, offset_out,
                         oskar_mem_double4c_const(J, status),
                         oskar_mem_double_const(src_flux[0], status),
@@ -253,7 +255,7 @@ void oskar_cross_correlate(
                         oskar_mem_double_const(y, status),
                         uv_filter_min, uv_filter_max, inv_wavelength,
                         frac_bandwidth, time_avg, gha0, dec0,
-                        oskar_mem_double4c(vis, status));
+                        oskar_mem_double4c(vis, status), status);
                 break;
             case OSKAR_SINGLE_COMPLEX:
                 oskar_cross_correlate_scalar_point_omp_f(
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "correlate/oskar_cross_correlate_fused.h"
+#include "correlate/oskar_cross_correlate_fused_omp.h"
+#include "math/oskar_cmath.h"
+
+#include <float.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void oskar_cross_correlate_fused(
+        int source_type,
+        int num_sources,
+        const oskar_Jones* E,
+        const oskar_Mem* const src_flux[4],
+        const oskar_Mem* const src_dir[3],
+        const oskar_Mem* const src_ext[3],
+        const oskar_Telescope* tel,
+        const oskar_Mem* const station_uvw[3],
+        double gast,
+        double frequency_hz,
+        double source_filter_min,
+        double source_filter_max,
+        int ignore_w_components,
+        int offset_out,
+        oskar_Mem* vis,
+        int* status)
+{
+    const oskar_Mem *x = 0, *y = 0;
+    double uv_filter_min = 0.0, uv_filter_max = 0.0;
+    double time_avg = 0.0, gha0 = 0.0, dec0 = 0.0;
+    if (*status) return;
+
+    /* Get the data dimensions. */
+    const int num_stations = oskar_telescope_num_stations(tel);
+    const int use_extended = (source_type == 1);
+
+    /* Get the wavenumber, as used for Jones K. */
+    const double wavenumber = 2.0 * M_PI * frequency_hz / 299792458.0;
+
+    /* Get bandwidth-smearing terms. */
+    frequency_hz = fabs(frequency_hz);
+    const double inv_wavelength = frequency_hz / 299792458.0;
+    const double channel_bandwidth = oskar_telescope_channel_bandwidth_hz(tel);
+    const double frac_bandwidth = channel_bandwidth / frequency_hz;
+
+    /* Get time-average smearing terms.
+     * Ignore if drift scanning - this will need to be done differently. */
+    if (oskar_telescope_phase_centre_coord_type(tel) != OSKAR_COORDS_AZEL)
+    {
+        time_avg = oskar_telescope_time_average_sec(tel);
+        gha0 = gast - oskar_telescope_phase_centre_longitude_rad(tel);
+        dec0 = oskar_telescope_phase_centre_latitude_rad(tel);
+    }
+
+    /* Get UV filter parameters in wavelengths. */
+    uv_filter_min = oskar_telescope_uv_filter_min(tel);
+    uv_filter_max = oskar_telescope_uv_filter_max(tel);
+    if (oskar_telescope_uv_filter_units(tel) == OSKAR_METRES)
+    {
+        uv_filter_min *= inv_wavelength;
+        uv_filter_max *= inv_wavelength;
+    }
+    if (uv_filter_max < 0.0 || uv_filter_max > FLT_MAX)
+    {
+        uv_filter_max = FLT_MAX;
+    }
+
+    /* Check data locations. */
+    const int location = oskar_mem_location(vis);
+    if (location != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (oskar_telescope_mem_location(tel) != location ||
+            (E && oskar_jones_mem_location(E) != location) ||
+            oskar_mem_location(station_uvw[0]) != location ||
+            oskar_mem_location(station_uvw[1]) != location ||
+            oskar_mem_location(station_uvw[2]) != location)
+    {
+        *status = OSKAR_ERR_LOCATION_MISMATCH;
+        return;
+    }
+
+    /* Check for consistent data types. */
+    const int vis_type = oskar_mem_type(vis);
+    const int base_type = oskar_type_precision(vis_type);
+    if (oskar_mem_type(station_uvw[0]) != base_type ||
+            oskar_mem_type(station_uvw[1]) != base_type ||
+            oskar_mem_type(station_uvw[2]) != base_type ||
+            (E && oskar_jones_type(E) != vis_type))
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return;
+    }
+
+    /* Check the input dimensions. */
+    if ((E && (oskar_jones_num_sources(E) < num_sources ||
+            oskar_jones_num_stations(E) != num_stations)) ||
+            (int)oskar_mem_length(station_uvw[0]) != num_stations ||
+            (int)oskar_mem_length(station_uvw[1]) != num_stations ||
+            (int)oskar_mem_length(station_uvw[2]) != num_stations)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+
+    /* Get handles to arrays. */
+    x = oskar_telescope_station_true_offset_ecef_metres_const(tel, 0);
+    y = oskar_telescope_station_true_offset_ecef_metres_const(tel, 1);
+
+    /* Select kernel. */
+    if (vis_type == OSKAR_SINGLE_COMPLEX)
+    {
+        const float2* jones_E = E ?
+                oskar_mem_float2_const(oskar_jones_mem_const(E), status) : 0;
+        if (use_extended)
+        {
+            oskar_cross_correlate_fused_gaussian_omp_f(
+                    num_sources, num_stations, offset_out, jones_E,
+                    oskar_mem_float_const(src_flux[0], status),
+                    oskar_mem_float_const(src_dir[0], status),
+                    oskar_mem_float_const(src_dir[1], status),
+                    oskar_mem_float_const(src_dir[2], status),
+                    oskar_mem_float_const(src_ext[0], status),
+                    oskar_mem_float_const(src_ext[1], status),
+                    oskar_mem_float_const(src_ext[2], status),
+                    oskar_mem_float_const(station_uvw[0], status),
+                    oskar_mem_float_const(station_uvw[1], status),
+                    oskar_mem_float_const(station_uvw[2], status),
+                    oskar_mem_float_const(x, status),
+                    oskar_mem_float_const(y, status),
+                    uv_filter_min, uv_filter_max, inv_wavelength,
+                    wavenumber, frac_bandwidth, time_avg, gha0, dec0,
+                    source_filter_min, source_filter_max,
+                    ignore_w_components, oskar_mem_float2(vis, status),
+                    status);
+        }
+        else
+        {
+            oskar_cross_correlate_fused_point_omp_f(
+                    num_sources, num_stations, offset_out, jones_E,
+                    oskar_mem_float_const(src_flux[0], status),
+                    oskar_mem_float_const(src_dir[0], status),
+                    oskar_mem_float_const(src_dir[1], status),
+                    oskar_mem_float_const(src_dir[2], status),
+                    oskar_mem_float_const(station_uvw[0], status),
+                    oskar_mem_float_const(station_uvw[1], status),
+                    oskar_mem_float_const(station_uvw[2], status),
+                    oskar_mem_float_const(x, status),
+                    oskar_mem_float_const(y, status),
+                    uv_filter_min, uv_filter_max, inv_wavelength,
+                    wavenumber, frac_bandwidth, time_avg, gha0, dec0,
+                    source_filter_min, source_filter_max,
+                    ignore_w_components, oskar_mem_float2(vis, status),
+                    status);
+        }
+    }
+    else if (vis_type == OSKAR_DOUBLE_COMPLEX)
+    {
+        const double2* jones_E = E ?
+                oskar_mem_double2_const(oskar_jones_mem_const(E), status) : 0;
+        if (use_extended)
+        {
+            oskar_cross_correlate_fused_gaussian_omp_d(
+                    num_sources, num_stations, offset_out, jones_E,
+                    oskar_mem_double_const(src_flux[0], status),
+                    oskar_mem_double_const(src_dir[0], status),
+                    oskar_mem_double_const(src_dir[1], status),
+                    oskar_mem_double_const(src_dir[2], status),
+                    oskar_mem_double_const(src_ext[0], status),
+                    oskar_mem_double_const(src_ext[1], status),
+                    oskar_mem_double_const(src_ext[2], status),
+                    oskar_mem_double_const(station_uvw[0], status),
+                    oskar_mem_double_const(station_uvw[1], status),
+                    oskar_mem_double_const(station_uvw[2], status),
+                    oskar_mem_double_const(x, status),
+                    oskar_mem_double_const(y, status),
+                    uv_filter_min, uv_filter_max, inv_wavelength,
+                    wavenumber, frac_bandwidth, time_avg, gha0, dec0,
+                    source_filter_min, source_filter_max,
+                    ignore_w_components, oskar_mem_double2(vis, status),
+                    status);
+        }
+        else
+        {
+            oskar_cross_correlate_fused_point_omp_d(
+                    num_sources, num_stations, offset_out, jones_E,
+                    oskar_mem_double_const(src_flux[0], status),
+                    oskar_mem_double_const(src_dir[0], status),
+                    oskar_mem_double_const(src_dir[1], status),
+                    oskar_mem_double_const(src_dir[2], status),
+                    oskar_mem_double_const(station_uvw[0], status),
+                    oskar_mem_double_const(station_uvw[1], status),
+                    oskar_mem_double_const(station_uvw[2], status),
+                    oskar_mem_double_const(x, status),
+                    oskar_mem_double_const(y, status),
+                    uv_filter_min, uv_filter_max, inv_wavelength,
+                    wavenumber, frac_bandwidth, time_avg, gha0, dec0,
+                    source_filter_min, source_filter_max,
+                    ignore_w_components, oskar_mem_double2(vis, status),
+                    status);
+        }
+    }
+    else
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
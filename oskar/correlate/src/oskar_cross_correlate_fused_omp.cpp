@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "correlate/define_correlate_utils.h"
+#include "correlate/oskar_cross_correlate_fused_omp.h"
+#include "math/define_multiply.h"
+#include "math/oskar_kahan_sum.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Target size of the tile of station phasors, in bytes. */
+#define FUSED_TILE_BYTES (256 * 1024)
+
+template<typename T1, typename T2>
+struct oskar_IsSame
+{
+    enum { value = false }; // oskar_IsSame represents a bool.
+    typedef oskar_IsSame<T1,T2> type; // to qualify as a metafunction.
+};
+
+template<typename T>
+struct oskar_IsSame<T,T>
+{
+    enum { value = true };
+    typedef oskar_IsSame<T,T> type;
+};
+
+template
+<
+// Compile-time parameters.
+bool BANDWIDTH_SMEARING, bool TIME_SMEARING, bool GAUSSIAN, bool HAVE_E,
+typename REAL, typename REAL2
+>
+void oskar_xcorr_fused_omp(
+        const int                   num_sources,
+        const int                   num_stations,
+        const int                   offset_out,
+        const REAL2* const RESTRICT jones_E,
+        const REAL*  const RESTRICT source_I,
+        const REAL*  const RESTRICT source_l,
+        const REAL*  const RESTRICT source_m,
+        const REAL*  const RESTRICT source_n,
+        const REAL*  const RESTRICT source_a,
+        const REAL*  const RESTRICT source_b,
+        const REAL*  const RESTRICT source_c,
+        const REAL*  const RESTRICT station_u,
+        const REAL*  const RESTRICT station_v,
+        const REAL*  const RESTRICT station_w,
+        const REAL*  const RESTRICT station_x,
+        const REAL*  const RESTRICT station_y,
+        const REAL                  uv_min_lambda,
+        const REAL                  uv_max_lambda,
+        const REAL                  inv_wavelength,
+        const REAL                  wavenumber,
+        const REAL                  frac_bandwidth,
+        const REAL                  time_int_sec,
+        const REAL                  gha0_rad,
+        const REAL                  dec0_rad,
+        const REAL                  source_filter_min,
+        const REAL                  source_filter_max,
+        const int                   ignore_w_components,
+        REAL2*             RESTRICT vis,
+        int*                        status)
+{
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+    int tile_size = (int) (FUSED_TILE_BYTES / sizeof(REAL2)) / num_stations;
+    if (tile_size < 16) tile_size = 16;
+    if (tile_size > num_sources) tile_size = num_sources;
+    if (num_baselines == 0 || tile_size == 0) return;
+
+    // Station phasors for one tile of sources, and the running sum
+    // (and Kahan guard) for each baseline, carried over between tiles.
+    REAL2* tile = (REAL2*) malloc(
+            (size_t) num_stations * tile_size * sizeof(REAL2));
+    REAL2* sums = (REAL2*) calloc(2 * (size_t) num_baselines, sizeof(REAL2));
+    if (!tile || !sums)
+    {
+        free(tile);
+        free(sums);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+
+#pragma omp parallel
+    {
+        // Baselines are correlated in contiguous ranges of equal length
+        // for each thread. Consecutive baselines share the same station p.
+        int thread_id = 0, num_threads = 1, b_start = 0, b_end = 0;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+        num_threads = omp_get_num_threads();
+#endif
+        OSKAR_BASELINE_RANGE(num_baselines, thread_id, num_threads,
+                b_start, b_end)
+        for (int s0 = 0; s0 < num_sources; s0 += tile_size)
+        {
+            int sp = 0, sq = 0;
+            const int tile_sources = (num_sources - s0 < tile_size) ?
+                    num_sources - s0 : tile_size;
+
+            // Evaluate the combined Jones scalars for the tile, in the
+            // same way as oskar_evaluate_jones_K() and oskar_jones_join().
+#pragma omp for schedule(static)
+            for (int a = 0; a < num_stations; ++a)
+            {
+                REAL2* const tile_a = &tile[a * tile_size];
+                for (int i = 0; i < tile_sources; ++i)
+                {
+                    const int s = s0 + i;
+                    REAL2 k;
+                    k.x = k.y = (REAL) 0;
+                    if (source_I[s] > source_filter_min &&
+                            source_I[s] <= source_filter_max)
+                    {
+                        REAL phase = station_u[a] * source_l[s] +
+                                station_v[a] * source_m[s];
+                        if (!ignore_w_components)
+                        {
+                            phase += station_w[a] * (source_n[s] - (REAL) 1);
+                        }
+                        phase *= wavenumber;
+                        k.x = (REAL) cos((double) phase);
+                        k.y = (REAL) sin((double) phase);
+                    }
+                    if (HAVE_E)
+                    {
+                        const REAL2 e = jones_E[a * num_sources + s];
+                        OSKAR_MUL_COMPLEX(tile_a[i], k, e)
+                    }
+                    else
+                    {
+                        tile_a[i] = k;
+                    }
+                }
+            }
+
+            // Correlate the tile for the baselines of this thread.
+            // The barrier after the loop stops the tile being overwritten
+            // while other threads are still using it.
+            OSKAR_BASELINE_STATIONS(b_start, sp, sq)
+            for (int j = b_start; j < b_end; ++j)
+            {
+                REAL uv_len, uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
+                REAL2 t1, t2, sum, guard;
+                const int SP = sp, SQ = sq;
+                if (++sq == sp)
+                {
+                    sq = 0;
+                    ++sp;
+                }
+
+                // Pointers to source vectors for stations p and q.
+                const REAL2* const station_p = &tile[SP * tile_size];
+                const REAL2* const station_q = &tile[SQ * tile_size];
+
+                // Get common baseline values.
+                OSKAR_BASELINE_TERMS(REAL,
+                        station_u[SP], station_u[SQ],
+                        station_v[SP], station_v[SQ],
+                        station_w[SP], station_w[SQ],
+                        uu, vv, ww, uu2, vv2, uuvv, uv_len);
+
+                // Apply the baseline length filter.
+                if (uv_len < uv_min_lambda || uv_len > uv_max_lambda)
+                    continue;
+
+                // Compute the deltas for time-average smearing.
+                if (TIME_SMEARING)
+                    OSKAR_BASELINE_DELTAS(REAL,
+                            station_x[SP], station_x[SQ],
+                            station_y[SP], station_y[SQ], du, dv, dw);
+
+                // Resume the sum for this baseline.
+                const int b = OSKAR_BASELINE_INDEX(num_stations, SP, SQ);
+                sum = sums[2 * b];
+                guard = sums[2 * b + 1];
+
+                // Loop over sources in the tile.
+                for (int i = 0; i < tile_sources; ++i)
+                {
+                    const int s = s0 + i;
+                    REAL smearing;
+                    if (GAUSSIAN)
+                    {
+                        const REAL t = source_a[s] * uu2 +
+                                source_b[s] * uuvv + source_c[s] * vv2;
+                        smearing = exp((REAL) -t);
+                    }
+                    else
+                    {
+                        smearing = (REAL) 1;
+                    }
+                    smearing *= source_I[s];
+                    if (BANDWIDTH_SMEARING || TIME_SMEARING)
+                    {
+                        const REAL l = source_l[s];
+                        const REAL m = source_m[s];
+                        const REAL n = source_n[s] - (REAL) 1;
+                        if (BANDWIDTH_SMEARING)
+                        {
+                            const REAL t = uu * l + vv * m + ww * n;
+                            smearing *= OSKAR_SINC(REAL, t);
+                        }
+                        if (TIME_SMEARING)
+                        {
+                            const REAL t = du * l + dv * m + dw * n;
+                            smearing *= OSKAR_SINC(REAL, t);
+                        }
+                    }
+
+                    // Multiply Jones scalars.
+                    t1 = station_p[i];
+                    t2 = station_q[i];
+                    OSKAR_MUL_COMPLEX_CONJUGATE_IN_PLACE(REAL2, t1, t2)
+
+                    // Multiply result by smearing term and accumulate.
+                    if (oskar_IsSame<REAL, float>::value)
+                    {
+                        OSKAR_KAHAN_SUM_MULTIPLY_COMPLEX(
+                                REAL, sum, t1, smearing, guard)
+                    }
+                    else
+                    {
+                        sum.x += t1.x * smearing;
+                        sum.y += t1.y * smearing;
+                    }
+                }
+                sums[2 * b] = sum;
+                sums[2 * b + 1] = guard;
+            }
+#pragma omp barrier
+        }
+
+        // Add results to the baseline visibilities.
+#pragma omp for schedule(static)
+        for (int b = 0; b < num_baselines; ++b)
+        {
+            vis[b + offset_out].x += sums[2 * b].x;
+            vis[b + offset_out].y += sums[2 * b].y;
+        }
+    }
+    free(tile);
+    free(sums);
+}
+
+#define XCORR_KERNEL(BS, TS, GAUSSIAN, REAL, REAL2)                         \
+        if (d_jones_E)                                                      \
+            oskar_xcorr_fused_omp<BS, TS, GAUSSIAN, true, REAL, REAL2>      \
+            (num_sources, num_stations, offset_out, d_jones_E,              \
+                    d_I, d_l, d_m, d_n, d_a, d_b, d_c,                      \
+                    d_station_u, d_station_v, d_station_w,                  \
+                    d_station_x, d_station_y, uv_min_lambda, uv_max_lambda, \
+                    inv_wavelength, wavenumber, frac_bandwidth,             \
+                    time_int_sec, gha0_rad, dec0_rad,                       \
+                    source_filter_min, source_filter_max,                   \
+                    ignore_w_components, d_vis, status);                    \
+        else                                                                \
+            oskar_xcorr_fused_omp<BS, TS, GAUSSIAN, false, REAL, REAL2>     \
+            (num_sources, num_stations, offset_out, d_jones_E,              \
+                    d_I, d_l, d_m, d_n, d_a, d_b, d_c,                      \
+                    d_station_u, d_station_v, d_station_w,                  \
+                    d_station_x, d_station_y, uv_min_lambda, uv_max_lambda, \
+                    inv_wavelength, wavenumber, frac_bandwidth,             \
+                    time_int_sec, gha0_rad, dec0_rad,                       \
+                    source_filter_min, source_filter_max,                   \
+                    ignore_w_components, d_vis, status);
+
+#define XCORR_SELECT(GAUSSIAN, REAL, REAL2)                                 \
+        if (frac_bandwidth == (REAL)0 && time_int_sec == (REAL)0)           \
+        { XCORR_KERNEL(false, false, GAUSSIAN, REAL, REAL2) }               \
+        else if (frac_bandwidth != (REAL)0 && time_int_sec == (REAL)0)      \
+        { XCORR_KERNEL(true, false, GAUSSIAN, REAL, REAL2) }                \
+        else if (frac_bandwidth == (REAL)0 && time_int_sec != (REAL)0)      \
+        { XCORR_KERNEL(false, true, GAUSSIAN, REAL, REAL2) }                \
+        else if (frac_bandwidth != (REAL)0 && time_int_sec != (REAL)0)      \
+        { XCORR_KERNEL(true, true, GAUSSIAN, REAL, REAL2) }
+
+void oskar_cross_correlate_fused_point_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float2* d_jones_E, const float* d_I, const float* d_l,
+        const float* d_m, const float* d_n,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w, const float* d_station_x,
+        const float* d_station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float wavenumber, float frac_bandwidth,
+        float time_int_sec, float gha0_rad, float dec0_rad,
+        float source_filter_min, float source_filter_max,
+        int ignore_w_components, float2* d_vis, int* status)
+{
+    const float *d_a = 0, *d_b = 0, *d_c = 0;
+    XCORR_SELECT(false, float, float2)
+}
+
+void oskar_cross_correlate_fused_point_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double2* d_jones_E, const double* d_I, const double* d_l,
+        const double* d_m, const double* d_n,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w, const double* d_station_x,
+        const double* d_station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double wavenumber, double frac_bandwidth,
+        double time_int_sec, double gha0_rad, double dec0_rad,
+        double source_filter_min, double source_filter_max,
+        int ignore_w_components, double2* d_vis, int* status)
+{
+    const double *d_a = 0, *d_b = 0, *d_c = 0;
+    XCORR_SELECT(false, double, double2)
+}
+
+void oskar_cross_correlate_fused_gaussian_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float2* d_jones_E, const float* d_I, const float* d_l,
+        const float* d_m, const float* d_n,
+        const float* d_a, const float* d_b, const float* d_c,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w, const float* d_station_x,
+        const float* d_station_y, float uv_min_lambda, float uv_max_lambda,
+        float inv_wavelength, float wavenumber, float frac_bandwidth,
+        float time_int_sec, float gha0_rad, float dec0_rad,
+        float source_filter_min, float source_filter_max,
+        int ignore_w_components, float2* d_vis, int* status)
+{
+    XCORR_SELECT(true, float, float2)
+}
+
+void oskar_cross_correlate_fused_gaussian_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double2* d_jones_E, const double* d_I, const double* d_l,
+        const double* d_m, const double* d_n,
+        const double* d_a, const double* d_b, const double* d_c,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w, const double* d_station_x,
+        const double* d_station_y, double uv_min_lambda, double uv_max_lambda,
+        double inv_wavelength, double wavenumber, double frac_bandwidth,
+        double time_int_sec, double gha0_rad, double dec0_rad,
+        double source_filter_min, double source_filter_max,
+        int ignore_w_components, double2* d_vis, int* status)
+{
+    XCORR_SELECT(true, double, double2)
+}
@@ -0,0 +1,401 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "correlate/define_correlate_simd.h"
+#include "correlate/define_correlate_utils.h"
+#include "correlate/oskar_cross_correlate_gemm_omp.h"
+#include "correlate/oskar_cross_correlate_simd_omp.h"
+#include "math/define_multiply.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Target size of the packed products for one block of stations in a tile of
+// sources, in bytes. This should fit comfortably in the L2 cache.
+#define GEMM_BLOCK_BYTES (256 * 1024)
+
+// Number of stations p in each work item.
+#define GEMM_ROWS 32
+
+#ifdef OSKAR_XCORR_SIMD
+
+// Data shared by all threads while correlating one tile of sources.
+template<typename REAL>
+struct oskar_XcorrGemmTile
+{
+    int num_sources, num_stations, tile_size;
+
+    // Jones matrices for all stations and sources, as [station][source][8].
+    const REAL* jones;
+
+    // Products of source brightness and Hermitian transpose of Jones matrix,
+    // packed as [station_block][tile_size][8][lanes].
+    const REAL* packed;
+
+    const REAL *station_u, *station_v;
+    REAL uv_min_lambda, uv_max_lambda, inv_wavelength;
+
+    // Visibility sums for each baseline, as [baseline][8].
+    double* sums;
+};
+
+// Micro-kernel: correlates NP consecutive stations p with one block of
+// stations q (one per vector lane) for sources [s0, s0 + num_s),
+// and adds the results to the baseline sums.
+// This is inlined into the functions compiled for each instruction set.
+template<int NP, typename REAL, typename VEC>
+static inline __attribute__((always_inline)) void oskar_xcorr_gemm_micro(
+        const oskar_XcorrGemmTile<REAL>* const RESTRICT t,
+        const int                                       s0,
+        const int                                       num_s,
+        const int                                       block_q,
+        const int                                       SP,
+        REAL*                                  RESTRICT out)
+{
+    const int W = (int) (sizeof(VEC) / sizeof(REAL));
+    const REAL* const RESTRICT tq =
+            &t->packed[(size_t) block_q * t->tile_size * 8 * W];
+    const REAL* RESTRICT jp[NP];
+    for (int i = 0; i < NP; ++i)
+    {
+        jp[i] = &t->jones[8 * ((size_t) (SP + i) * t->num_sources + s0)];
+    }
+
+    // Accumulate (J_p * B * J_q^H) for all lanes q, keeping all sums in
+    // registers. The real and imaginary parts of each Jones matrix element
+    // for station p are broadcast across the vector.
+    VEC acc[NP][8], guard[NP][8];
+    memset(acc, 0, sizeof(acc));
+    memset(guard, 0, sizeof(guard));
+    for (int s = 0; s < num_s; ++s)
+    {
+        const REAL* const r_ptr = &tq[8 * W * s];
+        VEC r0, r1, r2, r3, r4, r5, r6, r7;
+        SIMD_LOAD(r0, &r_ptr[0 * W]);
+        SIMD_LOAD(r1, &r_ptr[1 * W]);
+        SIMD_LOAD(r4, &r_ptr[4 * W]);
+        SIMD_LOAD(r5, &r_ptr[5 * W]);
+        for (int i = 0; i < NP; ++i)
+        {
+            const REAL* const p = &jp[i][8 * s];
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][0],
+                    p[0] * r0 - p[1] * r1 + p[2] * r4 - p[3] * r5, guard[i][0])
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][1],
+                    p[0] * r1 + p[1] * r0 + p[2] * r5 + p[3] * r4, guard[i][1])
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][4],
+                    p[4] * r0 - p[5] * r1 + p[6] * r4 - p[7] * r5, guard[i][4])
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][5],
+                    p[4] * r1 + p[5] * r0 + p[6] * r5 + p[7] * r4, guard[i][5])
+        }
+        SIMD_LOAD(r2, &r_ptr[2 * W]);
+        SIMD_LOAD(r3, &r_ptr[3 * W]);
+        SIMD_LOAD(r6, &r_ptr[6 * W]);
+        SIMD_LOAD(r7, &r_ptr[7 * W]);
+        for (int i = 0; i < NP; ++i)
+        {
+            const REAL* const p = &jp[i][8 * s];
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][2],
+                    p[0] * r2 - p[1] * r3 + p[2] * r6 - p[3] * r7, guard[i][2])
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][3],
+                    p[0] * r3 + p[1] * r2 + p[2] * r7 + p[3] * r6, guard[i][3])
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][6],
+                    p[4] * r2 - p[5] * r3 + p[6] * r6 - p[7] * r7, guard[i][6])
+            SIMD_ACCUMULATE(REAL, VEC, acc[i][7],
+                    p[4] * r3 + p[5] * r2 + p[6] * r7 + p[7] * r6, guard[i][7])
+        }
+    }
+    for (int i = 0; i < NP; ++i)
+    {
+        for (int c = 0; c < 8; ++c)
+        {
+            SIMD_STORE(&out[(8 * i + c) * W], acc[i][c]);
+        }
+    }
+
+    // Add the lanes for valid baselines to the sums.
+    for (int i = 0; i < NP; ++i)
+    {
+        const int p = SP + i;
+        for (int j = 0; j < W; ++j)
+        {
+            const int q = block_q * W + j;
+            if (q >= p || q >= t->num_stations) break;
+            const REAL uu = (t->station_u[p] - t->station_u[q]) *
+                    t->inv_wavelength;
+            const REAL vv = (t->station_v[p] - t->station_v[q]) *
+                    t->inv_wavelength;
+            const REAL uv_len = sqrt(uu * uu + vv * vv);
+            if (uv_len < t->uv_min_lambda || uv_len > t->uv_max_lambda)
+            {
+                continue;
+            }
+            double* const sums = &t->sums[
+                    8 * OSKAR_BASELINE_INDEX(t->num_stations, p, q)];
+            for (int c = 0; c < 8; ++c) sums[c] += out[(8 * i + c) * W + j];
+        }
+    }
+}
+
+// Correlates stations p in the range [p_start, p_end) with one block of
+// stations q, using two rows of stations p at a time where the vector
+// registers allow it.
+template<int NP, typename REAL, typename VEC>
+static inline __attribute__((always_inline)) void oskar_xcorr_gemm_rows(
+        const oskar_XcorrGemmTile<REAL>* t, int s0, int num_s, int block_q,
+        int p_start, int p_end, REAL* out)
+{
+    int SP = p_start;
+    for (; SP + NP <= p_end; SP += NP)
+    {
+        oskar_xcorr_gemm_micro<NP, REAL, VEC>(t, s0, num_s, block_q, SP, out);
+    }
+    for (; SP < p_end; ++SP)
+    {
+        oskar_xcorr_gemm_micro<1, REAL, VEC>(t, s0, num_s, block_q, SP, out);
+    }
+}
+
+template<typename REAL>
+__attribute__((target("avx2,fma")))
+static void oskar_xcorr_gemm_rows_avx2(
+        const oskar_XcorrGemmTile<REAL>* t, int s0, int num_s, int block_q,
+        int p_start, int p_end, REAL* out)
+{
+    // Only 16 vector registers are available, so use one row at a time.
+    // (The Kahan guards used in single precision are spilled.)
+    oskar_xcorr_gemm_rows<1, REAL, typename oskar_SimdVec<REAL, 32>::type>(
+            t, s0, num_s, block_q, p_start, p_end, out);
+}
+
+template<typename REAL>
+__attribute__((target("avx512f")))
+static void oskar_xcorr_gemm_rows_avx512(
+        const oskar_XcorrGemmTile<REAL>* t, int s0, int num_s, int block_q,
+        int p_start, int p_end, REAL* out)
+{
+    // Use two rows at a time, except in single precision, where the
+    // registers are needed for the Kahan guards.
+    oskar_xcorr_gemm_rows<sizeof(REAL) == sizeof(float) ? 1 : 2, REAL,
+            typename oskar_SimdVec<REAL, 64>::type>(
+                    t, s0, num_s, block_q, p_start, p_end, out);
+}
+
+template<typename REAL, typename REAL2, typename REAL4c>
+void oskar_xcorr_gemm_omp(
+        const int                    simd_bytes,
+        const int                    num_sources,
+        const int                    num_stations,
+        const int                    offset_out,
+        const REAL4c* const RESTRICT jones,
+        const REAL*   const RESTRICT source_I,
+        const REAL*   const RESTRICT source_Q,
+        const REAL*   const RESTRICT source_U,
+        const REAL*   const RESTRICT source_V,
+        const REAL*   const RESTRICT station_u,
+        const REAL*   const RESTRICT station_v,
+        const REAL                   uv_min_lambda,
+        const REAL                   uv_max_lambda,
+        const REAL                   inv_wavelength,
+        REAL4c*             RESTRICT vis,
+        int*                         status)
+{
+    typedef void (*RowsFn)(
+            const oskar_XcorrGemmTile<REAL>*, int, int, int, int, int, REAL*);
+    const RowsFn correlate_rows = (simd_bytes == 64) ?
+            oskar_xcorr_gemm_rows_avx512<REAL> :
+            oskar_xcorr_gemm_rows_avx2<REAL>;
+    const int W = simd_bytes / (int) sizeof(REAL);
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+    if (num_baselines == 0 || num_sources == 0) return;
+
+    // Choose the tile size so that the packed products for one block of
+    // stations q stay in cache while all stations p are correlated with it.
+    int tile_size = (int) (GEMM_BLOCK_BYTES / (8 * sizeof(REAL) * W));
+    if (tile_size > num_sources) tile_size = num_sources;
+    const int num_blocks_q = (num_stations + W - 1) / W;
+    const int num_blocks_p = (num_stations + GEMM_ROWS - 1) / GEMM_ROWS;
+    const int num_items = num_blocks_q * num_blocks_p;
+
+    // Allocate the packed products, the baseline sums, and a buffer for
+    // the micro-kernel results for each thread.
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    const size_t block_len = 8 * (size_t) tile_size * W;
+    const size_t out_stride = 16 * W * sizeof(REAL);
+    void* packed_mem = malloc(
+            num_blocks_q * block_len * sizeof(REAL) + SIMD_ALIGN);
+    void* out_mem = malloc(num_threads * out_stride + SIMD_ALIGN);
+    double* sums = (double*) calloc(8 * (size_t) num_baselines, sizeof(double));
+    if (!packed_mem || !out_mem || !sums)
+    {
+        free(packed_mem);
+        free(out_mem);
+        free(sums);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    REAL* packed = (REAL*) oskar_xcorr_simd_align(packed_mem);
+    oskar_XcorrGemmTile<REAL> t;
+    t.num_sources = num_sources;
+    t.num_stations = num_stations;
+    t.tile_size = tile_size;
+    t.jones = (const REAL*) jones;
+    t.packed = packed;
+    t.station_u = station_u;
+    t.station_v = station_v;
+    t.uv_min_lambda = uv_min_lambda;
+    t.uv_max_lambda = uv_max_lambda;
+    t.inv_wavelength = inv_wavelength;
+    t.sums = sums;
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        int thread_id = 0;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+#endif
+        REAL* out = (REAL*) ((char*) oskar_xcorr_simd_align(out_mem) +
+                thread_id * out_stride);
+
+        for (int s0 = 0; s0 < num_sources; s0 += tile_size)
+        {
+            const int tile_sources = (num_sources - s0 < tile_size) ?
+                    num_sources - s0 : tile_size;
+
+            // Pack the products of the source brightness matrix and the
+            // Hermitian transpose of the Jones matrix for each station q,
+            // with consecutive stations in consecutive lanes.
+            // Lanes for stations beyond the end are set to zero.
+#pragma omp for schedule(static)
+            for (int SQ = 0; SQ < num_blocks_q * W; ++SQ)
+            {
+                REAL* dst = &packed[(SQ / W) * block_len + (SQ % W)];
+                for (int i = 0; i < tile_sources; ++i)
+                {
+                    REAL4c m1, m2;
+                    const int s = s0 + i;
+                    if (SQ < num_stations)
+                    {
+                        OSKAR_CONSTRUCT_B(REAL, m1,
+                                source_I[s], source_Q[s],
+                                source_U[s], source_V[s])
+                        m1.a.y = m1.d.y = (REAL) 0;
+                        m1.c.x = m1.b.x;
+                        m1.c.y = -m1.b.y;
+                        OSKAR_LOAD_MATRIX(m2,
+                                jones[(size_t) SQ * num_sources + s])
+                        OSKAR_MUL_COMPLEX_MATRIX_CONJUGATE_TRANSPOSE_IN_PLACE(
+                                REAL2, m1, m2)
+                    }
+                    else
+                    {
+                        OSKAR_CLEAR_COMPLEX_MATRIX(REAL, m1)
+                    }
+                    REAL* r = &dst[8 * W * i];
+                    r[0 * W] = m1.a.x; r[1 * W] = m1.a.y;
+                    r[2 * W] = m1.b.x; r[3 * W] = m1.b.y;
+                    r[4 * W] = m1.c.x; r[5 * W] = m1.c.y;
+                    r[6 * W] = m1.d.x; r[7 * W] = m1.d.y;
+                }
+            }
+
+            // Multiply and accumulate for all baselines, one block of
+            // stations q and a group of stations p > q at a time.
+#pragma omp for schedule(dynamic, 1)
+            for (int item = 0; item < num_items; ++item)
+            {
+                const int block_q = item / num_blocks_p;
+                int p_start = (item % num_blocks_p) * GEMM_ROWS;
+                int p_end = p_start + GEMM_ROWS;
+                if (p_start < block_q * W + 1) p_start = block_q * W + 1;
+                if (p_end > num_stations) p_end = num_stations;
+                if (p_start >= p_end) continue;
+                correlate_rows(&t, s0, tile_sources, block_q,
+                        p_start, p_end, out);
+            }
+        }
+
+        // Add results to the baseline visibilities.
+#pragma omp for schedule(static)
+        for (int b = 0; b < num_baselines; ++b)
+        {
+            REAL* o = (REAL*) &vis[b + offset_out];
+            for (int c = 0; c < 8; ++c) o[c] += (REAL) sums[8 * b + c];
+        }
+    }
+    free(packed_mem);
+    free(out_mem);
+    free(sums);
+}
+
+#endif /* OSKAR_XCORR_SIMD */
+
+void oskar_cross_correlate_point_gemm_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float4c* d_jones, const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w,
+        const float* d_station_x, const float* d_station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float4c* d_vis, int* status)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (simd_bytes && frac_bandwidth == 0.0f && time_int_sec == 0.0f)
+    {
+        oskar_xcorr_gemm_omp<float, float2, float4c>(simd_bytes,
+                num_sources, num_stations, offset_out, d_jones,
+                d_I, d_Q, d_U, d_V, d_station_u, d_station_v,
+                uv_min_lambda, uv_max_lambda, inv_wavelength, d_vis,
+                status);
+        return;
+    }
+#endif
+    oskar_cross_correlate_point_simd_omp_f(num_sources, num_stations,
+            offset_out, d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength,
+            frac_bandwidth, time_int_sec, gha0_rad, dec0_rad, d_vis, status);
+}
+
+void oskar_cross_correlate_point_gemm_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double4c* d_jones, const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w,
+        const double* d_station_x, const double* d_station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double4c* d_vis, int* status)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (simd_bytes && frac_bandwidth == 0.0 && time_int_sec == 0.0)
+    {
+        oskar_xcorr_gemm_omp<double, double2, double4c>(simd_bytes,
+                num_sources, num_stations, offset_out, d_jones,
+                d_I, d_Q, d_U, d_V, d_station_u, d_station_v,
+                uv_min_lambda, uv_max_lambda, inv_wavelength, d_vis,
+                status);
+        return;
+    }
+#endif
+    oskar_cross_correlate_point_simd_omp_d(num_sources, num_stations,
+            offset_out, d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength,
+            frac_bandwidth, time_int_sec, gha0_rad, dec0_rad, d_vis, status);
+}
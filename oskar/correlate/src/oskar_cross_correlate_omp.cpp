@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2022, The OSKAR Developers.
+ * Copyright (c) 2013-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -10,6 +10,10 @@
 #include "utility/oskar_kernel_macros.h"
 #include "utility/oskar_vector_types.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 template<typename T1, typename T2>
 struct oskar_IsSame
 {
@@ -59,16 +63,29 @@ void oskar_xcorr_omp(
         const REAL                   dec0_rad,
         REAL4c*             RESTRICT vis)
 {
-    // Loop over stations.
-#pragma omp parallel for schedule(dynamic, 1)
-    for (int SQ = 0; SQ < num_stations; ++SQ)
+    // Loop over baselines, in contiguous ranges of equal length for each
+    // thread. Consecutive baselines share the same station p.
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+#pragma omp parallel
     {
-        // Pointer to source vector for station q.
-        const REAL4c* const station_q = &jones[SQ * num_sources];
-
-        // Loop over baselines for this station.
-        for (int SP = SQ + 1; SP < num_stations; ++SP)
+        int thread_id = 0, num_threads = 1, b_start = 0, b_end = 0;
+        int sp = 0, sq = 0;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+        num_threads = omp_get_num_threads();
+#endif
+        OSKAR_BASELINE_RANGE(num_baselines, thread_id, num_threads,
+                b_start, b_end)
+        OSKAR_BASELINE_STATIONS(b_start, sp, sq)
+        for (int b = b_start; b < b_end; ++b)
         {
+            const int SP = sp, SQ = sq;
+            if (++sq == sp)
+            {
+                sq = 0;
+                ++sp;
+            }
+
             REAL uv_len, uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
             REAL4c m1, m2, sum, guard;
             OSKAR_CLEAR_COMPLEX_MATRIX(REAL, sum)
@@ -77,8 +94,9 @@ void oskar_xcorr_omp(
                 OSKAR_CLEAR_COMPLEX_MATRIX(REAL, guard)
             }
 
-            // Pointer to source vector for station p.
+            // Pointers to source vectors for stations p and q.
             const REAL4c* const station_p = &jones[SP * num_sources];
+            const REAL4c* const station_q = &jones[SQ * num_sources];
 
             // Get common baseline values.
             OSKAR_BASELINE_TERMS(REAL, station_u[SP], station_u[SQ],
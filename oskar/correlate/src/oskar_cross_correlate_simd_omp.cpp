@@ -0,0 +1,645 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "correlate/define_correlate_simd.h"
+#include "correlate/define_correlate_utils.h"
+#include "correlate/oskar_cross_correlate_omp.h"
+#include "correlate/oskar_cross_correlate_simd_omp.h"
+#include "binary/oskar_binary_data_types.h"
+#include "utility/oskar_kernel_macros.h"
+#include "utility/oskar_vector_types.h"
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Target size of the Jones matrices for one station in a tile of sources,
+// in bytes.
+#define SIMD_ROW_BYTES (16 * 1024)
+
+// Target size of the Jones matrices for one block of stations in a tile of
+// sources, in bytes. This should fit comfortably in the L2 cache.
+#define SIMD_BLOCK_BYTES (256 * 1024)
+
+// Granularity of the tile size, in sources (the maximum number of lanes).
+#define SIMD_TILE_GRANULE 16
+
+#ifdef OSKAR_XCORR_SIMD
+
+// Data shared by all threads while correlating one tile of sources.
+template<typename REAL>
+struct oskar_XcorrSimdTile
+{
+    int num_stations, tile_size, tile_sources;
+
+    // Jones matrix components for all stations, as [station][8][tile_size],
+    // in the order (a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y).
+    const REAL* jones;
+
+    // Source brightness matrix components, as [4][tile_size],
+    // in the order (I + Q, I - Q, U, V).
+    const REAL* brightness;
+
+    // Products of the source brightness matrices with the Hermitian
+    // transpose of the Jones matrices, as [station][8][tile_size].
+    REAL* products;
+
+    // Source parameters, offset to the start of the tile.
+    const REAL *l, *m, *n, *a, *b, *c;
+
+    const REAL *station_u, *station_v, *station_w, *station_x, *station_y;
+    REAL uv_min_lambda, uv_max_lambda, inv_wavelength, frac_bandwidth;
+    REAL time_int_sec, gha0_rad, dec0_rad;
+
+    // Visibility sums for each baseline, as [baseline][8].
+    double* sums;
+};
+
+// Multiplies the source brightness matrix with the Hermitian transpose of
+// the Jones matrix for station q, for one tile of sources.
+// This is common to all baselines of the station.
+template<typename REAL, typename VEC>
+static inline __attribute__((always_inline)) void oskar_xcorr_simd_product(
+        const oskar_XcorrSimdTile<REAL>* const RESTRICT t,
+        const int                                       SQ)
+{
+    const int W = (int) (sizeof(VEC) / sizeof(REAL));
+    const int T = t->tile_size;
+    const int num_vectors = (t->tile_sources + W - 1) / W;
+    const REAL* const RESTRICT jq = &t->jones[8 * T * SQ];
+    const REAL* const RESTRICT br = t->brightness;
+    REAL* const RESTRICT out = &t->products[8 * T * SQ];
+    for (int k = 0; k < num_vectors; ++k)
+    {
+        VEC B_a, B_d, B_u, B_v, q[8], r[8];
+        const int i = k * W;
+        SIMD_LOAD(B_a, &br[0 * T + i]);
+        SIMD_LOAD(B_d, &br[1 * T + i]);
+        SIMD_LOAD(B_u, &br[2 * T + i]);
+        SIMD_LOAD(B_v, &br[3 * T + i]);
+        for (int c = 0; c < 8; ++c) SIMD_LOAD(q[c], &jq[c * T + i]);
+        r[0] =  B_a * q[0] + B_u * q[2] + B_v * q[3];
+        r[1] = -B_a * q[1] + B_v * q[2] - B_u * q[3];
+        r[2] =  B_a * q[4] + B_u * q[6] + B_v * q[7];
+        r[3] = -B_a * q[5] + B_v * q[6] - B_u * q[7];
+        r[4] =  B_u * q[0] - B_v * q[1] + B_d * q[2];
+        r[5] = -B_u * q[1] - B_v * q[0] - B_d * q[3];
+        r[6] =  B_u * q[4] - B_v * q[5] + B_d * q[6];
+        r[7] = -B_u * q[5] - B_v * q[4] - B_d * q[7];
+        for (int c = 0; c < 8; ++c) SIMD_STORE(&out[c * T + i], r[c]);
+    }
+}
+
+// Correlates station q with stations p > q in the range [p_start, p_end),
+// for one tile of sources.
+// This is inlined into the functions compiled for each instruction set.
+template
+<
+// Compile-time parameters.
+bool BANDWIDTH_SMEARING, bool TIME_SMEARING, bool GAUSSIAN,
+typename REAL, typename VEC
+>
+static inline __attribute__((always_inline)) void oskar_xcorr_simd_station(
+        const oskar_XcorrSimdTile<REAL>* const RESTRICT t,
+        const int                                       SQ,
+        const int                                       p_start,
+        const int                                       p_end,
+        REAL*                                  RESTRICT scratch)
+{
+    const int W = (int) (sizeof(VEC) / sizeof(REAL));
+    const int T = t->tile_size;
+    const int num_vectors = (t->tile_sources + W - 1) / W;
+    const int num_stations = t->num_stations;
+    const REAL inv_wavelength = t->inv_wavelength;
+    const REAL frac_bandwidth = t->frac_bandwidth;
+    const REAL time_int_sec = t->time_int_sec;
+    const REAL gha0_rad = t->gha0_rad;
+    const REAL dec0_rad = t->dec0_rad;
+    const REAL* const RESTRICT prod = &t->products[8 * T * SQ];
+    REAL* const RESTRICT smearing = scratch;
+    (void) time_int_sec;
+    (void) gha0_rad;
+    (void) dec0_rad;
+
+    // Loop over baselines for this station.
+    for (int SP = (p_start > SQ ? p_start : SQ + 1); SP < p_end; ++SP)
+    {
+        REAL uv_len, uu, vv, ww, uu2, vv2, uuvv, du, dv, dw;
+        const REAL* const RESTRICT jp = &t->jones[8 * T * SP];
+
+        // Get common baseline values.
+        OSKAR_BASELINE_TERMS(REAL,
+                t->station_u[SP], t->station_u[SQ],
+                t->station_v[SP], t->station_v[SQ],
+                t->station_w[SP], t->station_w[SQ],
+                uu, vv, ww, uu2, vv2, uuvv, uv_len);
+
+        // Apply the baseline length filter.
+        if (uv_len < t->uv_min_lambda || uv_len > t->uv_max_lambda) continue;
+
+        // Compute the deltas for time-average smearing.
+        if (TIME_SMEARING)
+            OSKAR_BASELINE_DELTAS(REAL,
+                    t->station_x[SP], t->station_x[SQ],
+                    t->station_y[SP], t->station_y[SQ], du, dv, dw);
+
+        // Evaluate the smearing terms for all sources in the tile.
+        if (GAUSSIAN || BANDWIDTH_SMEARING || TIME_SMEARING)
+        {
+            for (int i = 0; i < t->tile_sources; ++i)
+            {
+                REAL s;
+                if (GAUSSIAN)
+                {
+                    const REAL r = t->a[i] * uu2 + t->b[i] * uuvv +
+                            t->c[i] * vv2;
+                    s = exp((REAL) -r);
+                }
+                else s = (REAL) 1;
+                if (BANDWIDTH_SMEARING || TIME_SMEARING)
+                {
+                    const REAL l = t->l[i];
+                    const REAL m = t->m[i];
+                    const REAL n = t->n[i] - (REAL) 1;
+                    if (BANDWIDTH_SMEARING)
+                    {
+                        const REAL r = uu * l + vv * m + ww * n;
+                        s *= OSKAR_SINC(REAL, r);
+                    }
+                    if (TIME_SMEARING)
+                    {
+                        const REAL r = du * l + dv * m + dw * n;
+                        s *= OSKAR_SINC(REAL, r);
+                    }
+                }
+                smearing[i] = s;
+            }
+            for (int i = t->tile_sources; i < num_vectors * W; ++i)
+            {
+                smearing[i] = (REAL) 0;
+            }
+        }
+
+        // Loop over sources, multiplying the Jones matrix for station p
+        // with the product for station q, and accumulate.
+        VEC sum[8], guard[8];
+        memset(sum, 0, sizeof(sum));
+        memset(guard, 0, sizeof(guard));
+        for (int k = 0; k < num_vectors; ++k)
+        {
+            VEC p[8], r[8], m[8];
+            const int i = k * W;
+            for (int c = 0; c < 8; ++c)
+            {
+                SIMD_LOAD(p[c], &jp[c * T + i]);
+                SIMD_LOAD(r[c], &prod[c * T + i]);
+            }
+            m[0] = p[0] * r[0] - p[1] * r[1] + p[2] * r[4] - p[3] * r[5];
+            m[1] = p[0] * r[1] + p[1] * r[0] + p[2] * r[5] + p[3] * r[4];
+            m[2] = p[0] * r[2] - p[1] * r[3] + p[2] * r[6] - p[3] * r[7];
+            m[3] = p[0] * r[3] + p[1] * r[2] + p[2] * r[7] + p[3] * r[6];
+            m[4] = p[4] * r[0] - p[5] * r[1] + p[6] * r[4] - p[7] * r[5];
+            m[5] = p[4] * r[1] + p[5] * r[0] + p[6] * r[5] + p[7] * r[4];
+            m[6] = p[4] * r[2] - p[5] * r[3] + p[6] * r[6] - p[7] * r[7];
+            m[7] = p[4] * r[3] + p[5] * r[2] + p[6] * r[7] + p[7] * r[6];
+            if (GAUSSIAN || BANDWIDTH_SMEARING || TIME_SMEARING)
+            {
+                VEC s;
+                SIMD_LOAD(s, &smearing[i]);
+                for (int c = 0; c < 8; ++c)
+                {
+                    SIMD_ACCUMULATE(REAL, VEC, sum[c], m[c] * s, guard[c])
+                }
+            }
+            else
+            {
+                for (int c = 0; c < 8; ++c)
+                {
+                    SIMD_ACCUMULATE(REAL, VEC, sum[c], m[c], guard[c])
+                }
+            }
+        }
+
+        // Add the lanes to the sums for this baseline.
+        double* const sums =
+                &t->sums[8 * OSKAR_BASELINE_INDEX(num_stations, SP, SQ)];
+        for (int c = 0; c < 8; ++c)
+        {
+            double total = 0.0;
+            for (int j = 0; j < W; ++j) total += sum[c][j];
+            sums[c] += total;
+        }
+    }
+}
+
+template<typename REAL>
+__attribute__((target("avx2,fma")))
+static void oskar_xcorr_simd_product_avx2(
+        const oskar_XcorrSimdTile<REAL>* t, int SQ)
+{
+    oskar_xcorr_simd_product<REAL,
+            typename oskar_SimdVec<REAL, 32>::type>(t, SQ);
+}
+
+template<typename REAL>
+__attribute__((target("avx512f")))
+static void oskar_xcorr_simd_product_avx512(
+        const oskar_XcorrSimdTile<REAL>* t, int SQ)
+{
+    oskar_xcorr_simd_product<REAL,
+            typename oskar_SimdVec<REAL, 64>::type>(t, SQ);
+}
+
+template<bool BS, bool TS, bool GAUSSIAN, typename REAL>
+__attribute__((target("avx2,fma")))
+static void oskar_xcorr_simd_station_avx2(
+        const oskar_XcorrSimdTile<REAL>* t, int SQ, int p_start, int p_end,
+        REAL* scratch)
+{
+    oskar_xcorr_simd_station<BS, TS, GAUSSIAN, REAL,
+            typename oskar_SimdVec<REAL, 32>::type>(
+                    t, SQ, p_start, p_end, scratch);
+}
+
+template<bool BS, bool TS, bool GAUSSIAN, typename REAL>
+__attribute__((target("avx512f")))
+static void oskar_xcorr_simd_station_avx512(
+        const oskar_XcorrSimdTile<REAL>* t, int SQ, int p_start, int p_end,
+        REAL* scratch)
+{
+    oskar_xcorr_simd_station<BS, TS, GAUSSIAN, REAL,
+            typename oskar_SimdVec<REAL, 64>::type>(
+                    t, SQ, p_start, p_end, scratch);
+}
+
+template
+<
+// Compile-time parameters.
+bool BANDWIDTH_SMEARING, bool TIME_SMEARING, bool GAUSSIAN,
+typename REAL, typename REAL4c
+>
+void oskar_xcorr_simd_omp(
+        const int                    simd_bytes,
+        const int                    num_sources,
+        const int                    num_stations,
+        const int                    offset_out,
+        const REAL4c* const RESTRICT jones,
+        const REAL*   const RESTRICT source_I,
+        const REAL*   const RESTRICT source_Q,
+        const REAL*   const RESTRICT source_U,
+        const REAL*   const RESTRICT source_V,
+        const REAL*   const RESTRICT source_l,
+        const REAL*   const RESTRICT source_m,
+        const REAL*   const RESTRICT source_n,
+        const REAL*   const RESTRICT source_a,
+        const REAL*   const RESTRICT source_b,
+        const REAL*   const RESTRICT source_c,
+        const REAL*   const RESTRICT station_u,
+        const REAL*   const RESTRICT station_v,
+        const REAL*   const RESTRICT station_w,
+        const REAL*   const RESTRICT station_x,
+        const REAL*   const RESTRICT station_y,
+        const REAL                   uv_min_lambda,
+        const REAL                   uv_max_lambda,
+        const REAL                   inv_wavelength,
+        const REAL                   frac_bandwidth,
+        const REAL                   time_int_sec,
+        const REAL                   gha0_rad,
+        const REAL                   dec0_rad,
+        REAL4c*             RESTRICT vis,
+        int*                         status)
+{
+    typedef void (*ProductFn)(const oskar_XcorrSimdTile<REAL>*, int);
+    typedef void (*StationFn)(
+            const oskar_XcorrSimdTile<REAL>*, int, int, int, REAL*);
+    const ProductFn form_product = (simd_bytes == 64) ?
+            oskar_xcorr_simd_product_avx512<REAL> :
+            oskar_xcorr_simd_product_avx2<REAL>;
+    const StationFn correlate_station = (simd_bytes == 64) ?
+            oskar_xcorr_simd_station_avx512<BANDWIDTH_SMEARING,
+                    TIME_SMEARING, GAUSSIAN, REAL> :
+            oskar_xcorr_simd_station_avx2<BANDWIDTH_SMEARING,
+                    TIME_SMEARING, GAUSSIAN, REAL>;
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+    if (num_baselines == 0 || num_sources == 0) return;
+
+    // Choose the tile size, as a whole number of vectors.
+    int tile_size = (int) (SIMD_ROW_BYTES / (8 * sizeof(REAL)));
+    const int max_tile_size = SIMD_TILE_GRANULE *
+            ((num_sources + SIMD_TILE_GRANULE - 1) / SIMD_TILE_GRANULE);
+    if (tile_size > max_tile_size) tile_size = max_tile_size;
+
+    // Choose the station block size. Baselines are correlated for pairs of
+    // station blocks, so that the Jones matrices for the second block are
+    // reused from cache for all stations in the first block.
+    int block_size = (int) (SIMD_BLOCK_BYTES /
+            (8 * sizeof(REAL) * (size_t) tile_size));
+    if (block_size < 1) block_size = 1;
+    if (block_size > num_stations) block_size = num_stations;
+    const int num_blocks = (num_stations + block_size - 1) / block_size;
+    const int num_block_pairs = num_blocks * (num_blocks + 1) / 2;
+
+    // Allocate the shared tile buffers, the baseline sums, and a buffer
+    // for the smearing terms for each thread.
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    const size_t tile_bytes =
+            (16 * (size_t) num_stations + 4) * tile_size * sizeof(REAL);
+    const size_t scratch_stride = SIMD_ALIGN *
+            (((size_t) tile_size * sizeof(REAL) + SIMD_ALIGN - 1) / SIMD_ALIGN);
+    void* tile_mem = malloc(tile_bytes + SIMD_ALIGN);
+    void* scratch_mem = malloc(num_threads * scratch_stride + SIMD_ALIGN);
+    double* sums = (double*) calloc(8 * (size_t) num_baselines, sizeof(double));
+    if (!tile_mem || !scratch_mem || !sums)
+    {
+        free(tile_mem);
+        free(scratch_mem);
+        free(sums);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    REAL* tile_jones = (REAL*) oskar_xcorr_simd_align(tile_mem);
+    REAL* tile_products = &tile_jones[8 * (size_t) num_stations * tile_size];
+    REAL* tile_brightness =
+            &tile_products[8 * (size_t) num_stations * tile_size];
+    oskar_XcorrSimdTile<REAL> t;
+    t.num_stations = num_stations;
+    t.tile_size = tile_size;
+    t.tile_sources = 0;
+    t.jones = tile_jones;
+    t.brightness = tile_brightness;
+    t.products = tile_products;
+    t.l = t.m = t.n = t.a = t.b = t.c = 0;
+    t.station_u = station_u;
+    t.station_v = station_v;
+    t.station_w = station_w;
+    t.station_x = station_x;
+    t.station_y = station_y;
+    t.uv_min_lambda = uv_min_lambda;
+    t.uv_max_lambda = uv_max_lambda;
+    t.inv_wavelength = inv_wavelength;
+    t.frac_bandwidth = frac_bandwidth;
+    t.time_int_sec = time_int_sec;
+    t.gha0_rad = gha0_rad;
+    t.dec0_rad = dec0_rad;
+    t.sums = sums;
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        int thread_id = 0;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+#endif
+        REAL* scratch = (REAL*) ((char*) oskar_xcorr_simd_align(scratch_mem) +
+                thread_id * scratch_stride);
+
+        for (int s0 = 0; s0 < num_sources; s0 += tile_size)
+        {
+            const int tile_sources = (num_sources - s0 < tile_size) ?
+                    num_sources - s0 : tile_size;
+
+            // Set up the tile, and copy the source brightness matrices.
+            // The implied barrier makes them visible to all threads
+            // before the products are formed.
+#pragma omp single
+            {
+                t.tile_sources = tile_sources;
+                t.l = &source_l[s0];
+                t.m = &source_m[s0];
+                t.n = &source_n[s0];
+                if (GAUSSIAN)
+                {
+                    t.a = &source_a[s0];
+                    t.b = &source_b[s0];
+                    t.c = &source_c[s0];
+                }
+                for (int i = 0; i < tile_size; ++i)
+                {
+                    const int s = s0 + i;
+                    const int valid = (i < tile_sources);
+                    tile_brightness[0 * tile_size + i] = valid ?
+                            source_I[s] + source_Q[s] : (REAL) 0;
+                    tile_brightness[1 * tile_size + i] = valid ?
+                            source_I[s] - source_Q[s] : (REAL) 0;
+                    tile_brightness[2 * tile_size + i] = valid ?
+                            source_U[s] : (REAL) 0;
+                    tile_brightness[3 * tile_size + i] = valid ?
+                            source_V[s] : (REAL) 0;
+                }
+            }
+
+            // Copy the Jones matrices into the structure-of-arrays layout,
+            // and form the products for each station once for the tile.
+            // Unused sources at the end of the tile are set to zero.
+#pragma omp for schedule(static)
+            for (int a = 0; a < num_stations; ++a)
+            {
+                const REAL* src = (const REAL*) &jones[
+                        (size_t) a * num_sources + s0];
+                REAL* dst = &tile_jones[8 * (size_t) a * tile_size];
+                for (int i = 0; i < tile_sources; ++i)
+                {
+                    for (int c = 0; c < 8; ++c)
+                    {
+                        dst[c * tile_size + i] = src[8 * i + c];
+                    }
+                }
+                for (int i = tile_sources; i < tile_size; ++i)
+                {
+                    for (int c = 0; c < 8; ++c)
+                    {
+                        dst[c * tile_size + i] = (REAL) 0;
+                    }
+                }
+                form_product(&t, a);
+            }
+
+            // Correlate the tile for all baselines, one pair of station
+            // blocks at a time.
+#pragma omp for schedule(dynamic, 1)
+            for (int pair = 0; pair < num_block_pairs; ++pair)
+            {
+                int block_q = 0, block_p = pair;
+                while (block_p >= num_blocks - block_q)
+                {
+                    block_p -= num_blocks - block_q;
+                    block_q++;
+                }
+                block_p += block_q;
+                const int q_start = block_q * block_size;
+                const int p_start = block_p * block_size;
+                int q_end = q_start + block_size;
+                int p_end = p_start + block_size;
+                if (q_end > num_stations) q_end = num_stations;
+                if (p_end > num_stations) p_end = num_stations;
+                for (int SQ = q_start; SQ < q_end; ++SQ)
+                {
+                    correlate_station(&t, SQ, p_start, p_end, scratch);
+                }
+            }
+        }
+
+        // Add results to the baseline visibilities.
+#pragma omp for schedule(static)
+        for (int b = 0; b < num_baselines; ++b)
+        {
+            REAL* out = (REAL*) &vis[b + offset_out];
+            for (int c = 0; c < 8; ++c) out[c] += (REAL) sums[8 * b + c];
+        }
+    }
+    free(tile_mem);
+    free(scratch_mem);
+    free(sums);
+}
+
+#define XCORR_KERNEL(BS, TS, GAUSSIAN, REAL, REAL4c)                        \
+        oskar_xcorr_simd_omp<BS, TS, GAUSSIAN, REAL, REAL4c>                \
+        (simd_bytes, num_sources, num_stations, offset_out, d_jones,        \
+                d_I, d_Q, d_U, d_V, d_l, d_m, d_n, d_a, d_b, d_c,           \
+                d_station_u, d_station_v, d_station_w,                      \
+                d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,     \
+                inv_wavelength, frac_bandwidth, time_int_sec,               \
+                gha0_rad, dec0_rad, d_vis, status);
+
+#define XCORR_SELECT(GAUSSIAN, REAL, REAL4c)                                \
+        if (frac_bandwidth == (REAL)0 && time_int_sec == (REAL)0)           \
+            XCORR_KERNEL(false, false, GAUSSIAN, REAL, REAL4c)              \
+        else if (frac_bandwidth != (REAL)0 && time_int_sec == (REAL)0)      \
+            XCORR_KERNEL(true, false, GAUSSIAN, REAL, REAL4c)               \
+        else if (frac_bandwidth == (REAL)0 && time_int_sec != (REAL)0)      \
+            XCORR_KERNEL(false, true, GAUSSIAN, REAL, REAL4c)               \
+        else if (frac_bandwidth != (REAL)0 && time_int_sec != (REAL)0)      \
+            XCORR_KERNEL(true, true, GAUSSIAN, REAL, REAL4c)
+
+#endif /* OSKAR_XCORR_SIMD */
+
+int oskar_cross_correlate_simd_width(int precision)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (precision == OSKAR_SINGLE) return simd_bytes / (int) sizeof(float);
+    if (precision == OSKAR_DOUBLE) return simd_bytes / (int) sizeof(double);
+#else
+    (void) precision;
+#endif
+    return 0;
+}
+
+void oskar_cross_correlate_point_simd_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float4c* d_jones, const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w,
+        const float* d_station_x, const float* d_station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float4c* d_vis, int* status)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (simd_bytes)
+    {
+        const float *d_a = 0, *d_b = 0, *d_c = 0;
+        XCORR_SELECT(false, float, float4c)
+        return;
+    }
+#endif
+    oskar_cross_correlate_point_omp_f(num_sources, num_stations, offset_out,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength,
+            frac_bandwidth, time_int_sec, gha0_rad, dec0_rad, d_vis);
+}
+
+void oskar_cross_correlate_point_simd_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double4c* d_jones, const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w,
+        const double* d_station_x, const double* d_station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double4c* d_vis, int* status)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (simd_bytes)
+    {
+        const double *d_a = 0, *d_b = 0, *d_c = 0;
+        XCORR_SELECT(false, double, double4c)
+        return;
+    }
+#endif
+    oskar_cross_correlate_point_omp_d(num_sources, num_stations, offset_out,
+            d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n,
+            d_station_u, d_station_v, d_station_w, d_station_x, d_station_y,
+            uv_min_lambda, uv_max_lambda, inv_wavelength,
+            frac_bandwidth, time_int_sec, gha0_rad, dec0_rad, d_vis);
+}
+
+void oskar_cross_correlate_gaussian_simd_omp_f(
+        int num_sources, int num_stations, int offset_out,
+        const float4c* d_jones, const float* d_I, const float* d_Q,
+        const float* d_U, const float* d_V,
+        const float* d_l, const float* d_m, const float* d_n,
+        const float* d_a, const float* d_b, const float* d_c,
+        const float* d_station_u, const float* d_station_v,
+        const float* d_station_w,
+        const float* d_station_x, const float* d_station_y,
+        float uv_min_lambda, float uv_max_lambda, float inv_wavelength,
+        float frac_bandwidth, float time_int_sec, float gha0_rad,
+        float dec0_rad, float4c* d_vis, int* status)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (simd_bytes)
+    {
+        XCORR_SELECT(true, float, float4c)
+        return;
+    }
+#endif
+    oskar_cross_correlate_gaussian_omp_f(num_sources, num_stations,
+            offset_out, d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n,
+            d_a, d_b, d_c, d_station_u, d_station_v, d_station_w,
+            d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,
+            inv_wavelength, frac_bandwidth, time_int_sec,
+            gha0_rad, dec0_rad, d_vis);
+}
+
+void oskar_cross_correlate_gaussian_simd_omp_d(
+        int num_sources, int num_stations, int offset_out,
+        const double4c* d_jones, const double* d_I, const double* d_Q,
+        const double* d_U, const double* d_V,
+        const double* d_l, const double* d_m, const double* d_n,
+        const double* d_a, const double* d_b, const double* d_c,
+        const double* d_station_u, const double* d_station_v,
+        const double* d_station_w,
+        const double* d_station_x, const double* d_station_y,
+        double uv_min_lambda, double uv_max_lambda, double inv_wavelength,
+        double frac_bandwidth, double time_int_sec, double gha0_rad,
+        double dec0_rad, double4c* d_vis, int* status)
+{
+#ifdef OSKAR_XCORR_SIMD
+    const int simd_bytes = oskar_xcorr_simd_bytes();
+    if (simd_bytes)
+    {
+        XCORR_SELECT(true, double, double4c)
+        return;
+    }
+#endif
+    oskar_cross_correlate_gaussian_omp_d(num_sources, num_stations,
+            offset_out, d_jones, d_I, d_Q, d_U, d_V, d_l, d_m, d_n,
+            d_a, d_b, d_c, d_station_u, d_station_v, d_station_w,
+            d_station_x, d_station_y, uv_min_lambda, uv_max_lambda,
+            inv_wavelength, frac_bandwidth, time_int_sec,
+            gha0_rad, dec0_rad, d_vis);
+}
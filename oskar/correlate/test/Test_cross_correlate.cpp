@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2021, The OSKAR Developers.
+ * Copyright (c) 2013-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -8,8 +8,15 @@
 #include "utility/oskar_timer.h"
 
 #include "correlate/oskar_cross_correlate.h"
+#include "correlate/oskar_cross_correlate_fused.h"
+#include "correlate/oskar_cross_correlate_gemm_omp.h"
+#include "correlate/oskar_cross_correlate_omp.h"
+#include "correlate/oskar_cross_correlate_simd_omp.h"
+#include "interferometer/oskar_evaluate_jones_K.h"
+#include "interferometer/oskar_jones_join.h"
 #include "utility/oskar_get_error_string.h"
 #include "math/oskar_kahan_sum.h"
+#include <cfloat>
 #include <cstdlib>
 
 // Comment out this line to disable benchmark timer printing.
@@ -50,13 +57,14 @@ static const char* loc_to_str(int loc)
 class cross_correlate : public ::testing::Test
 {
 protected:
-    static const int num_sources = 277;
-    static const int num_stations = 19;
+    int num_sources, num_stations;
     oskar_Mem *src_dir[3], *src_ext[3], *src_flux[4], *uvw[3];
     oskar_Telescope* tel;
     oskar_Jones* jones;
 
 protected:
+    cross_correlate() : num_sources(277), num_stations(19) {}
+
     void create_test_data(int precision, int location, int matrix)
     {
         int status = 0, type = 0;
@@ -221,6 +229,192 @@ protected:
                 time2 * 1000.0);
 #endif
     }
+
+    void run_test_fused(int prec, int extended, int unity_E,
+            double time_average, double freq_average)
+    {
+        int num_baselines = 0, status = 0;
+        const double frequency = 100e6, filter_min = 1.2, filter_max = 1.9;
+        oskar_Mem *vis1 = 0, *vis2 = 0;
+        oskar_Jones *K = 0, *J = 0;
+
+        // Form Jones K and join it with Jones E, as the interferometer does.
+        create_test_data(prec, OSKAR_CPU, 0);
+        if (unity_E)
+        {
+            oskar_Mem* E = oskar_jones_mem(jones);
+            oskar_mem_set_value_real(E, 1.0, 0, oskar_mem_length(E), &status);
+        }
+        num_baselines = oskar_telescope_num_baselines(tel);
+        K = oskar_jones_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_stations, num_sources, &status);
+        J = oskar_jones_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_stations, num_sources, &status);
+        oskar_telescope_set_channel_bandwidth(tel, freq_average);
+        oskar_telescope_set_time_average(tel, time_average);
+        oskar_evaluate_jones_K(K, num_sources, src_dir[0], src_dir[1],
+                src_dir[2], uvw[0], uvw[1], uvw[2], frequency, src_flux[0],
+                filter_min, filter_max, 0, &status);
+        oskar_jones_join(J, K, jones, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Correlate the joined Jones scalars.
+        vis1 = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_baselines, &status);
+        vis2 = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_baselines, &status);
+        oskar_mem_clear_contents(vis1, &status);
+        oskar_mem_clear_contents(vis2, &status);
+        oskar_cross_correlate(extended, num_sources, J,
+                src_flux, src_dir, src_ext,
+                tel, uvw, 1.0, frequency, 0, vis1, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Correlate with the interferometer phase evaluated on the fly.
+        oskar_cross_correlate_fused(extended, num_sources,
+                unity_E ? 0 : jones, src_flux, src_dir, src_ext,
+                tel, uvw, 1.0, frequency, filter_min, filter_max, 0,
+                0, vis2, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Compare results.
+        check_values(vis2, vis1);
+
+        // Free memory.
+        oskar_jones_free(K, &status);
+        oskar_jones_free(J, &status);
+        oskar_mem_free(vis1, &status);
+        oskar_mem_free(vis2, &status);
+        destroy_test_data();
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    }
+
+    void run_test_simd(int prec, int extended, int gemm,
+            double time_average, double freq_average)
+    {
+        int num_baselines = 0, status = 0;
+        const int type = prec | OSKAR_COMPLEX | OSKAR_MATRIX;
+        const double inv_wavelength = 100e6 / 299792458.0;
+        const double gha0 = 0.1, dec0 = 0.5;
+        oskar_Mem *vis1 = 0, *vis2 = 0;
+        const oskar_Mem *x = 0, *y = 0;
+
+        // Correlate using the reference and SIMD (or GEMM) versions.
+        create_test_data(prec, OSKAR_CPU, 1);
+        num_baselines = oskar_telescope_num_baselines(tel);
+        vis1 = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+        vis2 = oskar_mem_create(type, OSKAR_CPU, num_baselines, &status);
+        oskar_mem_clear_contents(vis1, &status);
+        oskar_mem_clear_contents(vis2, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        x = oskar_telescope_station_true_offset_ecef_metres_const(tel, 0);
+        y = oskar_telescope_station_true_offset_ecef_metres_const(tel, 1);
+        const double frac_bandwidth = freq_average / 100e6;
+        if (prec == OSKAR_SINGLE)
+        {
+            const float4c* J = oskar_mem_float4c_const(
+                    oskar_jones_mem_const(jones), &status);
+            const float *I = oskar_mem_float_const(src_flux[0], &status);
+            const float *Q = oskar_mem_float_const(src_flux[1], &status);
+            const float *U = oskar_mem_float_const(src_flux[2], &status);
+            const float *V = oskar_mem_float_const(src_flux[3], &status);
+            const float *l = oskar_mem_float_const(src_dir[0], &status);
+            const float *m = oskar_mem_float_const(src_dir[1], &status);
+            const float *n = oskar_mem_float_const(src_dir[2], &status);
+            const float *a = oskar_mem_float_const(src_ext[0], &status);
+            const float *b = oskar_mem_float_const(src_ext[1], &status);
+            const float *c = oskar_mem_float_const(src_ext[2], &status);
+            const float *u = oskar_mem_float_const(uvw[0], &status);
+            const float *v = oskar_mem_float_const(uvw[1], &status);
+            const float *w = oskar_mem_float_const(uvw[2], &status);
+            const float *sx = oskar_mem_float_const(x, &status);
+            const float *sy = oskar_mem_float_const(y, &status);
+            float4c* out1 = oskar_mem_float4c(vis1, &status);
+            float4c* out2 = oskar_mem_float4c(vis2, &status);
+            if (extended)
+            {
+                oskar_cross_correlate_gaussian_omp_f(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n, a, b, c,
+                        u, v, w, sx, sy, 0.0f, FLT_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out1);
+                oskar_cross_correlate_gaussian_simd_omp_f(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n, a, b, c,
+                        u, v, w, sx, sy, 0.0f, FLT_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out2,
+                        &status);
+            }
+            else
+            {
+                oskar_cross_correlate_point_omp_f(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n,
+                        u, v, w, sx, sy, 0.0f, FLT_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out1);
+                (gemm ? oskar_cross_correlate_point_gemm_omp_f :
+                        oskar_cross_correlate_point_simd_omp_f)(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n,
+                        u, v, w, sx, sy, 0.0f, FLT_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out2,
+                        &status);
+            }
+        }
+        else
+        {
+            const double4c* J = oskar_mem_double4c_const(
+                    oskar_jones_mem_const(jones), &status);
+            const double *I = oskar_mem_double_const(src_flux[0], &status);
+            const double *Q = oskar_mem_double_const(src_flux[1], &status);
+            const double *U = oskar_mem_double_const(src_flux[2], &status);
+            const double *V = oskar_mem_double_const(src_flux[3], &status);
+            const double *l = oskar_mem_double_const(src_dir[0], &status);
+            const double *m = oskar_mem_double_const(src_dir[1], &status);
+            const double *n = oskar_mem_double_const(src_dir[2], &status);
+            const double *a = oskar_mem_double_const(src_ext[0], &status);
+            const double *b = oskar_mem_double_const(src_ext[1], &status);
+            const double *c = oskar_mem_double_const(src_ext[2], &status);
+            const double *u = oskar_mem_double_const(uvw[0], &status);
+            const double *v = oskar_mem_double_const(uvw[1], &status);
+            const double *w = oskar_mem_double_const(uvw[2], &status);
+            const double *sx = oskar_mem_double_const(x, &status);
+            const double *sy = oskar_mem_double_const(y, &status);
+            double4c* out1 = oskar_mem_double4c(vis1, &status);
+            double4c* out2 = oskar_mem_double4c(vis2, &status);
+            if (extended)
+            {
+                oskar_cross_correlate_gaussian_omp_d(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n, a, b, c,
+                        u, v, w, sx, sy, 0.0, DBL_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out1);
+                oskar_cross_correlate_gaussian_simd_omp_d(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n, a, b, c,
+                        u, v, w, sx, sy, 0.0, DBL_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out2,
+                        &status);
+            }
+            else
+            {
+                oskar_cross_correlate_point_omp_d(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n,
+                        u, v, w, sx, sy, 0.0, DBL_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out1);
+                (gemm ? oskar_cross_correlate_point_gemm_omp_d :
+                        oskar_cross_correlate_point_simd_omp_d)(num_sources,
+                        num_stations, 0, J, I, Q, U, V, l, m, n,
+                        u, v, w, sx, sy, 0.0, DBL_MAX, inv_wavelength,
+                        frac_bandwidth, time_average, gha0, dec0, out2,
+                        &status);
+            }
+        }
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+        // Compare results.
+        check_values(vis2, vis1);
+
+        // Free memory.
+        oskar_mem_free(vis1, &status);
+        oskar_mem_free(vis2, &status);
+        destroy_test_data();
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    }
 };
 
 
@@ -252,6 +446,124 @@ TEST_F(cross_correlate, CPU)
     }
 }
 
+// Check the fused kernel against Jones K, join and cross-correlate.
+TEST_F(cross_correlate, fused_CPU)
+{
+    const int precision[] = {OSKAR_SINGLE, OSKAR_DOUBLE};
+    const double time_avg[] = {0.0, 10.0};
+    const double freq_avg[] = {0.0, 1.e4};
+    for (int i_prec = 0; i_prec < 2; ++i_prec)
+    {
+        for (int extended = 0; extended < 2; ++extended)
+        {
+            for (int unity_E = 0; unity_E < 2; ++unity_E)
+            {
+                for (int i_avg = 0; i_avg < 2; ++i_avg)
+                {
+                    run_test_fused(precision[i_prec], extended, unity_E,
+                            time_avg[i_avg], freq_avg[i_avg]);
+                }
+            }
+        }
+    }
+}
+
+// Check the SIMD version against the reference CPU version.
+TEST_F(cross_correlate, SIMD)
+{
+    const int precision[] = {OSKAR_SINGLE, OSKAR_DOUBLE};
+    const double time_avg[] = {0.0, 10.0};
+    const double freq_avg[] = {0.0, 1.e4};
+    for (int i_prec = 0; i_prec < 2; ++i_prec)
+    {
+#ifdef ALLOW_PRINTING
+        printf("  > SIMD width (%s precision): %d\n",
+                precision[i_prec] == OSKAR_SINGLE ? "Single" : "Double",
+                oskar_cross_correlate_simd_width(precision[i_prec]));
+#endif
+        for (int extended = 0; extended < 2; ++extended)
+        {
+            for (int i_time_avg = 0; i_time_avg < 2; ++i_time_avg)
+            {
+                for (int i_freq_avg = 0; i_freq_avg < 2; ++i_freq_avg)
+                {
+                    run_test_simd(precision[i_prec], extended, 0,
+                            time_avg[i_time_avg], freq_avg[i_freq_avg]);
+                }
+            }
+        }
+    }
+}
+
+// Check the GEMM version against the reference CPU version, including the
+// fallback used with smearing, and sizes that span several tiles of sources
+// and several blocks of stations.
+TEST_F(cross_correlate, GEMM)
+{
+    const int precision[] = {OSKAR_SINGLE, OSKAR_DOUBLE};
+    const double time_avg[] = {0.0, 10.0};
+    const double freq_avg[] = {0.0, 1.e4};
+    for (int i_prec = 0; i_prec < 2; ++i_prec)
+    {
+        for (int i_time_avg = 0; i_time_avg < 2; ++i_time_avg)
+        {
+            for (int i_freq_avg = 0; i_freq_avg < 2; ++i_freq_avg)
+            {
+                run_test_simd(precision[i_prec], 0, 1,
+                        time_avg[i_time_avg], freq_avg[i_freq_avg]);
+            }
+        }
+        num_sources = 2500;
+        num_stations = 45;
+        run_test_simd(precision[i_prec], 0, 1, 0.0, 0.0);
+        num_sources = 277;
+        num_stations = 19;
+    }
+}
+
+// Check that the SIMD and GEMM versions keep full single precision
+// when summing many sources.
+TEST_F(cross_correlate, SIMD_single_precision_sum)
+{
+    const int n_src = 100000, n_st = 11;
+    const int n_baselines = n_st * (n_st - 1) / 2;
+    const float flux = 0.1f;
+    int status = 0;
+    float4c* jones = (float4c*) calloc(n_st * n_src, sizeof(float4c));
+    float* I = (float*) calloc(n_src, sizeof(float));
+    float* zero = (float*) calloc(n_src, sizeof(float));
+    float* st = (float*) calloc(n_st, sizeof(float));
+    float4c* vis = (float4c*) calloc(n_baselines, sizeof(float4c));
+    for (int i = 0; i < n_st * n_src; ++i)
+    {
+        jones[i].a.x = jones[i].d.x = 1.0f;
+    }
+    for (int i = 0; i < n_src; ++i) I[i] = flux;
+    for (int i = 0; i < n_st; ++i) st[i] = (float) i;
+    const double expected = (double) n_src * flux;
+    for (int gemm = 0; gemm < 2; ++gemm)
+    {
+        memset(vis, 0, n_baselines * sizeof(float4c));
+        (gemm ? oskar_cross_correlate_point_gemm_omp_f :
+                oskar_cross_correlate_point_simd_omp_f)(n_src, n_st, 0,
+                jones, I, zero, zero, zero, zero, zero, zero,
+                st, st, zero, st, st, 0.0f, FLT_MAX, 1.0f,
+                0.0f, 0.0f, 0.0f, 0.0f, vis, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        for (int b = 0; b < n_baselines; ++b)
+        {
+            EXPECT_NEAR(expected, vis[b].a.x, 1e-6 * expected) << gemm;
+            EXPECT_NEAR(expected, vis[b].d.x, 1e-6 * expected) << gemm;
+            EXPECT_EQ(0.0f, vis[b].b.x);
+        }
+    }
+    free(jones);
+    free(I);
+    free(zero);
+    free(st);
+    free(vis);
+}
+
 #ifdef OSKAR_HAVE_CUDA
 // Check for consistency between CPU and CUDA versions.
 TEST_F(cross_correlate, CUDA)
@@ -1,9 +1,10 @@
 /*
- * Copyright (c) 2013-2021, The OSKAR Developers.
+ * Copyright (c) 2013-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "settings/oskar_option_parser.h"
+#include "correlate/define_correlate_utils.h"
 #include "correlate/oskar_cross_correlate.h"
 #include "interferometer/oskar_jones.h"
 #include "telescope/oskar_telescope.h"
@@ -18,12 +19,18 @@
 #include <string>
 #include <vector>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 static void benchmark(int num_stations, int num_sources, int type,
         int jones_type, int location, int use_extended,
         int use_bandwidth_smearing, int use_time_smearing,
         int niter, std::vector<double>& times, const std::string& ascii_file,
         int* status);
 
+static void print_thread_balance(int num_stations);
+
 int main(int argc, char** argv)
 {
     oskar::OptionParser opt("oskar_correlator_benchmark", OSKAR_VERSION_STR);
@@ -114,6 +121,10 @@ int main(int argc, char** argv)
         {
             printf("- Writing iteration data to: %s\n", raw_file.c_str());
         }
+        if (location == OSKAR_CPU)
+        {
+            print_thread_balance(num_stations);
+        }
         printf("\n");
     }
 
@@ -297,3 +308,36 @@ void benchmark(int num_stations, int num_sources, int type,
     }
     oskar_timer_free(timer);
 }
+
+
+/*
+ * Prints the range of baselines given to each thread by the reference,
+ * scalar and fused CPU correlators, and the largest number of baselines
+ * for any thread relative to the mean.
+ */
+void print_thread_balance(int num_stations)
+{
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    const int num_baselines = num_stations * (num_stations - 1) / 2;
+    int min_baselines = num_baselines, max_baselines = 0;
+    printf("- Number of CPU threads: %i\n", num_threads);
+    for (int i = 0; i < num_threads; ++i)
+    {
+        int b_start = 0, b_end = 0, sp = 0, sq = 0;
+        OSKAR_BASELINE_RANGE(num_baselines, i, num_threads, b_start, b_end)
+        OSKAR_BASELINE_STATIONS(b_start, sp, sq)
+        const int num = b_end - b_start;
+        if (num < min_baselines) min_baselines = num;
+        if (num > max_baselines) max_baselines = num;
+        printf("  - Thread %i: %i baselines, starting at p=%i, q=%i\n",
+                i, num, sp, sq);
+    }
+    const double mean = (double) num_baselines / num_threads;
+    printf("- Per-thread baseline imbalance (max / mean): %.4f "
+            "(min %i, max %i)\n",
+            mean > 0.0 ? max_baselines / mean : 1.0,
+            min_baselines, max_baselines);
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_DEGRID_H_
+#define OSKAR_DEGRID_H_
+
+/**
+ * @file oskar_degrid.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Degridding function for 1D real convolution kernel (double precision).
+ *
+ * @details
+ * Interpolates visibilities from a complex grid, using the same convolution
+ * kernel and grid coordinates as oskar_grid_simple_d(), so that apart from
+ * the normalisation below, this is the adjoint of the gridding operation.
+ *
+ * Each visibility is normalised by the sum of the kernel values used for it,
+ * in the same way that the imager normalises its grids.
+ * Visibilities that fall outside the grid are set to zero.
+ *
+ * Visibilities are processed in parallel using OpenMP.
+ *
+ * @param[in] support       GCF support size (typ. 3; width = 2 * support + 1).
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ * @param[in] conv_func     GCF array, length oversample * (support + 1).
+ * @param[in] num_points    Number of visibility points.
+ * @param[in] uu            Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv            Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] cell_size_rad Cell size, in radians.
+ * @param[in] grid_size     Side length of image and grid.
+ * @param[in] grid          Complex visibility grid.
+ * @param[out] num_skipped  Number of visibilities that fell outside the grid.
+ * @param[out] vis          Complex visibilities for each baseline.
+ */
+OSKAR_EXPORT
+void oskar_degrid_simple_d(
+        const int support,
+        const int oversample,
+        const double* RESTRICT conv_func,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double cell_size_rad,
+        const int grid_size,
+        const double* RESTRICT grid,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT vis);
+
+/**
+ * @brief
+ * Degridding function for 1D real convolution kernel (single precision).
+ *
+ * @details
+ * Interpolates visibilities from a complex grid, using the same convolution
+ * kernel and grid coordinates as oskar_grid_simple_f(), so that apart from
+ * the normalisation below, this is the adjoint of the gridding operation.
+ *
+ * Each visibility is normalised by the sum of the kernel values used for it,
+ * in the same way that the imager normalises its grids.
+ * Visibilities that fall outside the grid are set to zero.
+ *
+ * Visibilities are processed in parallel using OpenMP.
+ *
+ * @param[in] support       GCF support size (typ. 3; width = 2 * support + 1).
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ * @param[in] conv_func     GCF array, length oversample * (support + 1).
+ * @param[in] num_points    Number of visibility points.
+ * @param[in] uu            Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv            Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] cell_size_rad Cell size, in radians.
+ * @param[in] grid_size     Side length of image and grid.
+ * @param[in] grid          Complex visibility grid.
+ * @param[out] num_skipped  Number of visibilities that fell outside the grid.
+ * @param[out] vis          Complex visibilities for each baseline.
+ */
+OSKAR_EXPORT
+void oskar_degrid_simple_f(
+        const int support,
+        const int oversample,
+        const float* RESTRICT conv_func,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float cell_size_rad,
+        const int grid_size,
+        const float* RESTRICT grid,
+        size_t* RESTRICT num_skipped,
+        float* RESTRICT vis);
+
+/**
+ * @brief
+ * Degridding function for W-projection (double precision).
+ *
+ * @details
+ * Interpolates visibilities from a complex grid, using the same
+ * W-projection kernels and grid coordinates as oskar_grid_wproj2_d().
+ * The conjugate of each kernel is used, so that apart from the
+ * normalisation below, this is the adjoint of the gridding operation.
+ *
+ * Each visibility is normalised by the sum of the real parts of the
+ * kernel values used for it, in the same way that the imager normalises
+ * its grids. Visibilities that fall outside the grid are set to zero.
+ *
+ * Visibilities are processed in parallel using OpenMP.
+ *
+ * @param[in] num_w_planes   Number of W-projection planes.
+ * @param[in] support        GCF support size per W-plane.
+ * @param[in] oversample     GCF oversample factor.
+ * @param[in] wkernel_start  Start index of each convolution kernel.
+ * @param[in] wkernel        The rearranged convolution kernels.
+ * @param[in] num_points     Number of visibility points.
+ * @param[in] uu             Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv             Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] ww             Visibility baseline ww coordinates, in wavelengths.
+ * @param[in] cell_size_rad  Cell size, in radians.
+ * @param[in] w_scale        Scaling factor used to find W-plane index.
+ * @param[in] grid_size      Side length of grid.
+ * @param[in] grid           Complex visibility grid.
+ * @param[out] num_skipped   Number of visibilities that fell outside the grid.
+ * @param[out] vis           Complex visibilities for each baseline.
+ */
+OSKAR_EXPORT
+void oskar_degrid_wproj2_d(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const double* RESTRICT wkernel,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT ww,
+        const double cell_size_rad,
+        const double w_scale,
+        const int grid_size,
+        const double* RESTRICT grid,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT vis);
+
+/**
+ * @brief
+ * Degridding function for W-projection (single precision).
+ *
+ * @details
+ * Interpolates visibilities from a complex grid, using the same
+ * W-projection kernels and grid coordinates as oskar_grid_wproj2_f().
+ * The conjugate of each kernel is used, so that apart from the
+ * normalisation below, this is the adjoint of the gridding operation.
+ *
+ * Each visibility is normalised by the sum of the real parts of the
+ * kernel values used for it, in the same way that the imager normalises
+ * its grids. Visibilities that fall outside the grid are set to zero.
+ *
+ * Visibilities are processed in parallel using OpenMP.
+ *
+ * @param[in] num_w_planes   Number of W-projection planes.
+ * @param[in] support        GCF support size per W-plane.
+ * @param[in] oversample     GCF oversample factor.
+ * @param[in] wkernel_start  Start index of each convolution kernel.
+ * @param[in] wkernel        The rearranged convolution kernels.
+ * @param[in] num_points     Number of visibility points.
+ * @param[in] uu             Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv             Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] ww             Visibility baseline ww coordinates, in wavelengths.
+ * @param[in] cell_size_rad  Cell size, in radians.
+ * @param[in] w_scale        Scaling factor used to find W-plane index.
+ * @param[in] grid_size      Side length of grid.
+ * @param[in] grid           Complex visibility grid.
+ * @param[out] num_skipped   Number of visibilities that fell outside the grid.
+ * @param[out] vis           Complex visibilities for each baseline.
+ */
+OSKAR_EXPORT
+void oskar_degrid_wproj2_f(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const float* RESTRICT wkernel,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT ww,
+        const float cell_size_rad,
+        const float w_scale,
+        const int grid_size,
+        const float* RESTRICT grid,
+        size_t* RESTRICT num_skipped,
+        float* RESTRICT vis);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_DEGRID_H_ */
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_GRID_KERNEL_TABLE_H_
+#define OSKAR_GRID_KERNEL_TABLE_H_
+
+/**
+ * @file oskar_grid_kernel_table.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Returns the largest scaled offset from a grid cell.
+ *
+ * @details
+ * Returns the largest magnitude of the scaled distance of a visibility
+ * from its nearest grid cell, (oversample + 1) / 2. The kernel table has
+ * one row for each offset from minus this value to plus this value.
+ *
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ */
+OSKAR_EXPORT
+int oskar_grid_kernel_table_max_offset(int oversample);
+
+/**
+ * @brief
+ * Tabulates a 1D real convolution kernel for each offset (double precision).
+ *
+ * @details
+ * Tabulates the convolution kernel taps used by the simple gridding
+ * functions for each scaled offset from the nearest grid cell.
+ * Row (off + max_offset) of the table holds the (2 * support + 1) values
+ *
+ *   conv_func[abs(off + k * oversample)]  for k = -support ... support,
+ *
+ * so the kernel of each visibility in one dimension is a contiguous row,
+ * and the 2D kernel is the outer product of the rows for u and v.
+ * The sum of each row is also returned, in double precision.
+ *
+ * @param[in] support       GCF support size (typ. 3; width = 2 * support + 1).
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ * @param[in] conv_func     GCF array, length oversample * (support + 1).
+ * @param[out] table        Kernel table, (2 * max_offset + 1) rows of
+ *                          (2 * support + 1) values.
+ * @param[out] table_sum    Sum of each row of the table.
+ */
+OSKAR_EXPORT
+void oskar_grid_kernel_table_d(
+        const int support,
+        const int oversample,
+        const double* RESTRICT conv_func,
+        double* RESTRICT table,
+        double* RESTRICT table_sum);
+
+/**
+ * @brief
+ * Tabulates a 1D real convolution kernel for each offset (single precision).
+ *
+ * @details
+ * Tabulates the convolution kernel taps used by the simple gridding
+ * functions for each scaled offset from the nearest grid cell.
+ * Row (off + max_offset) of the table holds the (2 * support + 1) values
+ *
+ *   conv_func[abs(off + k * oversample)]  for k = -support ... support,
+ *
+ * so the kernel of each visibility in one dimension is a contiguous row,
+ * and the 2D kernel is the outer product of the rows for u and v.
+ * The sum of each row is also returned, in double precision.
+ *
+ * @param[in] support       GCF support size (typ. 3; width = 2 * support + 1).
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ * @param[in] conv_func     GCF array, length oversample * (support + 1).
+ * @param[out] table        Kernel table, (2 * max_offset + 1) rows of
+ *                          (2 * support + 1) values.
+ * @param[out] table_sum    Sum of each row of the table.
+ */
+OSKAR_EXPORT
+void oskar_grid_kernel_table_f(
+        const int support,
+        const int oversample,
+        const float* RESTRICT conv_func,
+        float* RESTRICT table,
+        double* RESTRICT table_sum);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_GRID_KERNEL_TABLE_H_ */
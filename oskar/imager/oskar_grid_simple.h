@@ -60,6 +60,7 @@ extern "C" {
  * @param[out] num_skipped  Number of visibilities that fell outside the grid.
  * @param[in,out] norm      Updated grid normalisation factor.
  * @param[in,out] grid      Updated complex visibility grid.
+ * @param[in,out] status    Status return code.
  */
 OSKAR_EXPORT
 void oskar_grid_simple_d(
@@ -75,7 +76,8 @@ void oskar_grid_simple_d(
         const int grid_size,
         size_t* RESTRICT num_skipped,
         double* RESTRICT norm,
-        double* RESTRICT grid);
+        double* RESTRICT grid,
+        int* status);
 
 /**
  * @brief
@@ -97,6 +99,7 @@ void oskar_grid_simple_d(
  * @param[out] num_skipped  Number of visibilities that fell outside the grid.
  * @param[in,out] norm      Updated grid normalisation factor.
  * @param[in,out] grid      Updated complex visibility grid.
+ * @param[in,out] status    Status return code.
  */
 OSKAR_EXPORT
 void oskar_grid_simple_f(
@@ -112,7 +115,8 @@ void oskar_grid_simple_f(
         const int grid_size,
         size_t* RESTRICT num_skipped,
         double* RESTRICT norm,
-        float* RESTRICT grid);
+        float* RESTRICT grid,
+        int* status);
 
 #ifdef __cplusplus
 }
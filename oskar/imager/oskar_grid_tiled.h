@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_GRID_TILED_H_
+#define OSKAR_GRID_TILED_H_
+
+/**
+ * @file oskar_grid_tiled.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Returns the number of threads available to the tiled gridding functions.
+ *
+ * @details
+ * Returns the number of threads available to the tiled gridding functions.
+ * If this is 1, the serial gridding functions should be used instead,
+ * as they avoid the cost of sorting the visibilities into tiles.
+ */
+OSKAR_EXPORT
+int oskar_grid_tiled_num_threads(void);
+
+/**
+ * @brief
+ * Tiled simple gridding function for 1D real convolution kernel
+ * (double precision).
+ *
+ * @details
+ * Does the same as oskar_grid_simple_d(), but the grid is divided
+ * into square tiles which are updated concurrently by all available threads.
+ * Visibilities are first sorted into a list for each tile that their
+ * convolution kernel overlaps, keeping their original order, and each tile
+ * is then updated only by the thread that owns it, so no atomic operations
+ * are needed. Each grid cell receives its updates in the same order as
+ * in the serial version, but consecutive visibilities with the same kernel
+ * at the same grid position are summed before the kernel is applied, so
+ * the results agree with the serial version to rounding error.
+ *
+ * If \p half_plane is set, only the half of the grid at and to the right
+ * of the centre column is stored, with a margin on the left as wide as the
+ * (largest) kernel support size S, so the grid has (grid_size / 2 + 1 + S)
+ * columns. Visibilities that would lie in the other half are gridded as
+ * their Hermitian conjugates at the opposite position instead.
+ *
+ * @param[in] support       GCF support size (typ. 3; width = 2 * support + 1).
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ * @param[in] conv_func     GCF array, length oversample * (support + 1).
+ * @param[in] num_points    Number of visibility points.
+ * @param[in] uu            Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv            Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] vis           Complex visibilities for each baseline.
+ * @param[in] weight        Visibility weight for each baseline.
+ * @param[in] cell_size_rad Cell size, in radians.
+ * @param[in] grid_size     Side length of image and grid.
+ * @param[in] half_plane    If set, grid only half of the uv-plane.
+ * @param[out] num_skipped  Number of visibilities that fell outside the grid.
+ * @param[in,out] norm      Updated grid normalisation factor.
+ * @param[in,out] grid      Updated complex visibility grid.
+ * @param[in,out] status    Status return code.
+ */
+OSKAR_EXPORT
+void oskar_grid_simple_tiled_d(
+        const int support,
+        const int oversample,
+        const double* RESTRICT conv_func,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT vis,
+        const double* RESTRICT weight,
+        const double cell_size_rad,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        double* RESTRICT grid,
+        int* status);
+
+/**
+ * @brief
+ * Tiled simple gridding function for 1D real convolution kernel
+ * (single precision).
+ *
+ * @details
+ * Does the same as oskar_grid_simple_f(), but the grid is divided
+ * into square tiles which are updated concurrently by all available threads.
+ * Visibilities are first sorted into a list for each tile that their
+ * convolution kernel overlaps, keeping their original order, and each tile
+ * is then updated only by the thread that owns it, so no atomic operations
+ * are needed. Each grid cell receives its updates in the same order as
+ * in the serial version, but consecutive visibilities with the same kernel
+ * at the same grid position are summed before the kernel is applied, so
+ * the results agree with the serial version to rounding error.
+ *
+ * If \p half_plane is set, only the half of the grid at and to the right
+ * of the centre column is stored, with a margin on the left as wide as the
+ * (largest) kernel support size S, so the grid has (grid_size / 2 + 1 + S)
+ * columns. Visibilities that would lie in the other half are gridded as
+ * their Hermitian conjugates at the opposite position instead.
+ *
+ * @param[in] support       GCF support size (typ. 3; width = 2 * support + 1).
+ * @param[in] oversample    GCF oversample factor, or values per grid cell.
+ * @param[in] conv_func     GCF array, length oversample * (support + 1).
+ * @param[in] num_points    Number of visibility points.
+ * @param[in] uu            Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv            Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] vis           Complex visibilities for each baseline.
+ * @param[in] weight        Visibility weight for each baseline.
+ * @param[in] cell_size_rad Cell size, in radians.
+ * @param[in] grid_size     Side length of image and grid.
+ * @param[in] half_plane    If set, grid only half of the uv-plane.
+ * @param[out] num_skipped  Number of visibilities that fell outside the grid.
+ * @param[in,out] norm      Updated grid normalisation factor.
+ * @param[in,out] grid      Updated complex visibility grid.
+ * @param[in,out] status    Status return code.
+ */
+OSKAR_EXPORT
+void oskar_grid_simple_tiled_f(
+        const int support,
+        const int oversample,
+        const float* RESTRICT conv_func,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT vis,
+        const float* RESTRICT weight,
+        const float cell_size_rad,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        float* RESTRICT grid,
+        int* status);
+
+/**
+ * @brief
+ * Tiled gridding function for W-projection (double precision).
+ *
+ * @details
+ * Does the same as oskar_grid_wproj2_d(), but the grid is divided
+ * into square tiles which are updated concurrently by all available threads.
+ * Visibilities are first sorted into a list for each tile that their
+ * convolution kernel overlaps, keeping their original order, and each tile
+ * is then updated only by the thread that owns it, so no atomic operations
+ * are needed. Each grid cell receives its updates in the same order as
+ * in the serial version, but consecutive visibilities with the same kernel
+ * at the same grid position are summed before the kernel is applied, so
+ * the results agree with the serial version to rounding error.
+ *
+ * If \p half_plane is set, only the half of the grid at and to the right
+ * of the centre column is stored, with a margin on the left as wide as the
+ * (largest) kernel support size S, so the grid has (grid_size / 2 + 1 + S)
+ * columns. Visibilities that would lie in the other half are gridded as
+ * their Hermitian conjugates at the opposite position instead.
+ *
+ * @param[in] num_w_planes   Number of W-projection planes.
+ * @param[in] support        GCF support size per W-plane.
+ * @param[in] oversample     GCF oversample factor.
+ * @param[in] wkernel_start  Start index of each convolution kernel.
+ * @param[in] wkernel        The rearranged convolution kernels.
+ * @param[in] num_points     Number of visibility points.
+ * @param[in] uu             Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv             Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] ww             Visibility baseline ww coordinates, in wavelengths.
+ * @param[in] vis            Complex visibilities for each baseline.
+ * @param[in] weight         Visibility weight for each baseline.
+ * @param[in] cell_size_rad  Cell size, in radians.
+ * @param[in] w_scale        Scaling factor used to find W-plane index.
+ * @param[in] grid_size      Side length of grid.
+ * @param[in] half_plane     If set, grid only half of the uv-plane.
+ * @param[out] num_skipped   Number of visibilities that fell outside the grid.
+ * @param[in,out] norm       Updated grid normalisation factor.
+ * @param[in,out] grid       Updated complex visibility grid.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_grid_wproj2_tiled_d(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const double* RESTRICT wkernel,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT ww,
+        const double* RESTRICT vis,
+        const double* RESTRICT weight,
+        const double cell_size_rad,
+        const double w_scale,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        double* RESTRICT grid,
+        int* status);
+
+/**
+ * @brief
+ * Tiled gridding function for W-projection (single precision).
+ *
+ * @details
+ * Does the same as oskar_grid_wproj2_f(), but the grid is divided
+ * into square tiles which are updated concurrently by all available threads.
+ * Visibilities are first sorted into a list for each tile that their
+ * convolution kernel overlaps, keeping their original order, and each tile
+ * is then updated only by the thread that owns it, so no atomic operations
+ * are needed. Each grid cell receives its updates in the same order as
+ * in the serial version, but consecutive visibilities with the same kernel
+ * at the same grid position are summed before the kernel is applied, so
+ * the results agree with the serial version to rounding error.
+ *
+ * If \p half_plane is set, only the half of the grid at and to the right
+ * of the centre column is stored, with a margin on the left as wide as the
+ * (largest) kernel support size S, so the grid has (grid_size / 2 + 1 + S)
+ * columns. Visibilities that would lie in the other half are gridded as
+ * their Hermitian conjugates at the opposite position instead.
+ *
+ * @param[in] num_w_planes   Number of W-projection planes.
+ * @param[in] support        GCF support size per W-plane.
+ * @param[in] oversample     GCF oversample factor.
+ * @param[in] wkernel_start  Start index of each convolution kernel.
+ * @param[in] wkernel        The rearranged convolution kernels.
+ * @param[in] num_points     Number of visibility points.
+ * @param[in] uu             Visibility baseline uu coordinates, in wavelengths.
+ * @param[in] vv             Visibility baseline vv coordinates, in wavelengths.
+ * @param[in] ww             Visibility baseline ww coordinates, in wavelengths.
+ * @param[in] vis            Complex visibilities for each baseline.
+ * @param[in] weight         Visibility weight for each baseline.
+ * @param[in] cell_size_rad  Cell size, in radians.
+ * @param[in] w_scale        Scaling factor used to find W-plane index.
+ * @param[in] grid_size      Side length of grid.
+ * @param[in] half_plane     If set, grid only half of the uv-plane.
+ * @param[out] num_skipped   Number of visibilities that fell outside the grid.
+ * @param[in,out] norm       Updated grid normalisation factor.
+ * @param[in,out] grid       Updated complex visibility grid.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_grid_wproj2_tiled_f(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const float* RESTRICT wkernel,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT ww,
+        const float* RESTRICT vis,
+        const float* RESTRICT weight,
+        const float cell_size_rad,
+        const float w_scale,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        float* RESTRICT grid,
+        int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -46,7 +46,8 @@ void oskar_grid_weights_write_d(const size_t num_points,
  *
  * @details
  * Re-weights supplied visibilities using gridded weights, for
- * uniform weighting.
+ * uniform weighting. Points that lie outside the grid are given zero
+ * weight. Points are processed in parallel using OpenMP.
  *
  * @param[in] num_points        Number of data points.
  * @param[in] uu                Baseline uu coordinates, in wavelengths.
@@ -94,7 +95,8 @@ void oskar_grid_weights_write_f(const size_t num_points,
  *
  * @details
  * Re-weights supplied visibilities using gridded weights, for
- * uniform weighting.
+ * uniform weighting. Points that lie outside the grid are given zero
+ * weight. Points are processed in parallel using OpenMP.
  *
  * @param[in] num_points        Number of data points.
  * @param[in] uu                Baseline uu coordinates, in wavelengths.
@@ -112,6 +114,63 @@ void oskar_grid_weights_read_f(const size_t num_points,
         const float cell_size_rad, const int grid_size,
         size_t* RESTRICT num_skipped, const float* RESTRICT grid);
 
+/**
+ * @brief
+ * Updates gridded weights using all available threads (double precision).
+ *
+ * @details
+ * Gives the same result as oskar_grid_weights_write_d(), but the grid rows
+ * are divided into bands which are updated concurrently.
+ * Points are first sorted into a list for each band, keeping their original
+ * order, so each grid cell receives its updates in the same order as in
+ * the serial version, and the results are identical.
+ *
+ * @param[in] num_points        Number of data points.
+ * @param[in] uu                Baseline uu coordinates, in wavelengths.
+ * @param[in] vv                Baseline vv coordinates, in wavelengths.
+ * @param[in] weight            Input visibility weights.
+ * @param[in] cell_size_rad     Cell size, in radians.
+ * @param[in] grid_size         Side length of grid.
+ * @param[out] num_skipped      Number of points that fell outside the grid.
+ * @param[in,out] grid          Gridded weights.
+ * @param[in,out] status        Status return code.
+ */
+OSKAR_EXPORT
+void oskar_grid_weights_write_tiled_d(const size_t num_points,
+        const double* RESTRICT uu, const double* RESTRICT vv,
+        const double* RESTRICT weight, const double cell_size_rad,
+        const int grid_size, size_t* RESTRICT num_skipped,
+        double* RESTRICT grid, int* status);
+
+/**
+ * @brief
+ * Updates gridded weights using all available threads (single precision).
+ *
+ * @details
+ * Gives the same result as oskar_grid_weights_write_f(), but the grid rows
+ * are divided into bands which are updated concurrently.
+ * Points are first sorted into a list for each band, keeping their original
+ * order, so each grid cell receives its updates in the same order as in
+ * the serial version, and the results are identical.
+ *
+ * @param[in] num_points        Number of data points.
+ * @param[in] uu                Baseline uu coordinates, in wavelengths.
+ * @param[in] vv                Baseline vv coordinates, in wavelengths.
+ * @param[in] weight            Input visibility weights.
+ * @param[in] cell_size_rad     Cell size, in radians.
+ * @param[in] grid_size         Side length of grid.
+ * @param[out] num_skipped      Number of points that fell outside the grid.
+ * @param[in,out] grid          Gridded weights.
+ * @param[in,out] grid_guard    Guard digits for gridded weights.
+ * @param[in,out] status        Status return code.
+ */
+OSKAR_EXPORT
+void oskar_grid_weights_write_tiled_f(const size_t num_points,
+        const float* RESTRICT uu, const float* RESTRICT vv,
+        const float* RESTRICT weight, const float cell_size_rad,
+        const int grid_size, size_t* RESTRICT num_skipped,
+        float* RESTRICT grid, float* RESTRICT grid_guard, int* status);
+
 #ifdef __cplusplus
 }
 #endif
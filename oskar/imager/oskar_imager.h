@@ -66,7 +66,8 @@ enum OSKAR_IMAGE_ALGORITHM
     OSKAR_ALGORITHM_DFT_2D,
     OSKAR_ALGORITHM_DFT_3D,
     OSKAR_ALGORITHM_WPROJ,
-    OSKAR_ALGORITHM_AWPROJ
+    OSKAR_ALGORITHM_AWPROJ,
+    OSKAR_ALGORITHM_WSTACK
 };
 
 enum OSKAR_IMAGE_WEIGHTING
@@ -87,6 +88,7 @@ enum OSKAR_IMAGE_WEIGHTING
 #include <imager/oskar_imager_finalise.h>
 #include <imager/oskar_imager_free.h>
 #include <imager/oskar_imager_linear_to_stokes.h>
+#include <imager/oskar_imager_predict.h>
 #include <imager/oskar_imager_reset_cache.h>
 #include <imager/oskar_imager_rotate_coords.h>
 #include <imager/oskar_imager_rotate_vis.h>
@@ -53,6 +53,18 @@ double oskar_imager_cellsize(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_channel_snapshots(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the memory size of the coordinate cache, in MB.
+ *
+ * @details
+ * Returns the memory size of the coordinate cache, in MB.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+double oskar_imager_coord_cache_mb(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the flag specifying whether the imager is in coordinate-only mode.
@@ -77,6 +89,31 @@ int oskar_imager_coords_only(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_fft_on_gpu(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the compression type used for output FITS files.
+ *
+ * @details
+ * Returns a string describing the compression type used for output
+ * FITS files ("None", "Rice" or "GZIP").
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+const char* oskar_imager_fits_compression(const oskar_Imager* h);
+
+/**
+ * @brief
+ * Returns the quantisation level used for compressed FITS files.
+ *
+ * @details
+ * Returns the quantisation level used for compressed FITS files.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+double oskar_imager_fits_quantize_level(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the image field of view.
@@ -127,6 +164,18 @@ double oskar_imager_freq_min_hz(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_generate_w_kernels_on_gpu(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the memory limit for the image planes, in MB.
+ *
+ * @details
+ * Returns the memory limit for the image planes, in MB.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+double oskar_imager_grid_memory_mb(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the flag specifying whether to use the GPU for gridding.
@@ -139,6 +188,31 @@ int oskar_imager_generate_w_kernels_on_gpu(const oskar_Imager* h);
 OSKAR_EXPORT
 int oskar_imager_grid_on_gpu(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the directory used for memory-mapped image planes.
+ *
+ * @details
+ * Returns the directory used for memory-mapped image planes,
+ * or NULL if the system temporary directory is used.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+const char* oskar_imager_grid_scratch_dir(const oskar_Imager* h);
+
+/**
+ * @brief
+ * Returns the flag specifying whether to grid only half the uv-plane.
+ *
+ * @details
+ * Returns the flag specifying whether to grid only half the uv-plane.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+int oskar_imager_half_plane(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the image side length.
@@ -296,6 +370,7 @@ int oskar_imager_scale_norm_with_num_input_files(const oskar_Imager* h);
  * The \p type string can be:
  * - "FFT" to use standard gridding followed by a FFT.
  * - "W-projection" to use W-projection gridding followed by a FFT.
+ * - "W-stacking" to grid onto W-layers, with a FFT of each layer.
  * - "DFT 2D" to use a 2D Direct Fourier Transform, without gridding.
  * - "DFT 3D" to use a 3D Direct Fourier Transform, without gridding.
  *
@@ -338,6 +413,25 @@ void oskar_imager_set_cellsize(oskar_Imager* h, double cellsize_arcsec);
 OSKAR_EXPORT
 void oskar_imager_set_channel_snapshots(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the memory size of the coordinate cache, in MB.
+ *
+ * @details
+ * When oskar_imager_run() needs to read coordinates before the visibility
+ * data (for uniform weighting, W-projection or W-stacking), the
+ * coordinates and weights are cached during the first pass, so that only
+ * the visibility amplitudes need to be read in the second pass.
+ *
+ * This sets the amount of memory the cache may use. Any remainder is
+ * written to a temporary file. A value of zero or less disables the cache.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Memory size of the coordinate cache, in MB.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_coord_cache_mb(oskar_Imager* h, double value);
+
 /**
  * @brief
  * Sets the imager to ignore visibility data and only update weights grids.
@@ -408,6 +502,49 @@ void oskar_imager_set_direction(oskar_Imager* h, double ra_deg, double dec_deg);
 OSKAR_EXPORT
 void oskar_imager_set_fft_on_gpu(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the compression type used for output FITS files.
+ *
+ * @details
+ * Sets the compression type used for output FITS files.
+ * Compressed images are written using tiles of one image row.
+ *
+ * The \p type string can be:
+ * - "None" to write uncompressed images (the default).
+ * - "Rice" to use Rice compression of quantised pixel values.
+ * - "GZIP" to use GZIP compression with byte shuffling.
+ *
+ * Rice compression requires a quantisation level greater than zero;
+ * GZIP is used instead if the quantisation level is zero.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     type       Compression type, as described above.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_fits_compression(oskar_Imager* h, const char* type,
+        int* status);
+
+/**
+ * @brief
+ * Sets the quantisation level used for compressed FITS files.
+ *
+ * @details
+ * Floating-point pixel values are quantised before they are compressed,
+ * so that the quantisation step is the noise level in each tile divided
+ * by this value. Larger values preserve the pixel values more precisely,
+ * but compress less. A value of zero disables quantisation, so that
+ * images are compressed without loss using GZIP.
+ *
+ * The default is 16.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Quantisation level.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_fits_quantize_level(oskar_Imager* h, double value);
+
 /**
  * @brief
  * Sets the image field of view.
@@ -498,6 +635,30 @@ OSKAR_EXPORT
 void oskar_imager_set_grid_kernel(oskar_Imager* h, const char* type,
         int support, int oversample, int* status);
 
+/**
+ * @brief
+ * Sets the memory limit for the image planes, in MB.
+ *
+ * @details
+ * If the image or visibility planes on the host need more memory than
+ * this, they are stored in a memory-mapped scratch file instead of being
+ * allocated on the heap. The file is created in the directory set using
+ * oskar_imager_set_grid_scratch_dir().
+ *
+ * Only the parts of each plane that are updated are read into memory.
+ * Planes stay in memory between calls to oskar_imager_update() while as
+ * many as fit within this limit are in use; beyond that, the most recently
+ * used plane is released from memory before another is updated, and each
+ * plane is released once it has been finalised.
+ *
+ * A value of zero or less means there is no limit (the default).
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      Memory limit for the image planes, in MB.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_grid_memory_mb(oskar_Imager* h, double value);
+
 /**
  * @brief
  * Sets whether to use the GPU for gridding.
@@ -511,6 +672,50 @@ void oskar_imager_set_grid_kernel(oskar_Imager* h, const char* type,
 OSKAR_EXPORT
 void oskar_imager_set_grid_on_gpu(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the directory used for memory-mapped image planes.
+ *
+ * @details
+ * Sets the directory in which to create the scratch file used when the
+ * image planes need more memory than the limit set using
+ * oskar_imager_set_grid_memory_mb(). The file is deleted when the imager
+ * is reset or freed. The directory is created if it does not exist.
+ *
+ * Set to NULL or an empty string to use the system temporary directory
+ * (the default).
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     dir_path   Path of the scratch directory.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_grid_scratch_dir(oskar_Imager* h, const char* dir_path);
+
+/**
+ * @brief
+ * Sets whether to grid only half the uv-plane.
+ *
+ * @details
+ * Sets whether to grid only half the uv-plane when using the FFT or
+ * W-projection algorithms on the CPU.
+ *
+ * As the image is real, the grid has Hermitian symmetry, so visibilities
+ * in one half of the uv-plane can be gridded as their complex conjugates
+ * in the other half instead. The grids are then finalised using a
+ * complex-to-real FFT, which halves the memory needed for the grids and
+ * the time taken by the FFT.
+ *
+ * This is ignored if gridding on the GPU, or if the grid size is odd.
+ * If used, grids returned by oskar_imager_finalise() contain only the
+ * half-plane, which has (grid_size / 2 + 1 + S) columns, where S is the
+ * largest convolution kernel support size.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     value      If true, grid only half the uv-plane.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_half_plane(oskar_Imager* h, int value);
+
 /**
  * @brief
  * Sets image side length.
@@ -785,7 +990,8 @@ void oskar_imager_set_vis_phase_centre(oskar_Imager* h,
  * Sets the number of W planes to use.
  *
  * @details
- * Sets the number of W planes, used only for W-projection.
+ * Sets the number of W planes used for W-projection,
+ * or the number of W-layers used for W-stacking.
  * A value of 0 or less means 'automatic'.
  *
  * @param[in,out] h            Handle to imager.
@@ -794,6 +1000,28 @@ void oskar_imager_set_vis_phase_centre(oskar_Imager* h,
 OSKAR_EXPORT
 void oskar_imager_set_num_w_planes(oskar_Imager* h, int value);
 
+/**
+ * @brief
+ * Sets the directory used to cache W-projection kernels.
+ *
+ * @details
+ * Sets the directory used to cache W-projection kernels between runs.
+ *
+ * Kernels are written to a file in this directory after they have been
+ * generated, with a name derived from the imaging parameters used to
+ * generate them. If the same parameters are used again, the kernels are
+ * mapped from the file instead of being generated again.
+ *
+ * The directory is created if it does not exist.
+ * Set to NULL or an empty string to disable the cache (the default).
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     dir_path   Path of the cache directory.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_w_kernel_cache_dir(oskar_Imager* h,
+        const char* dir_path);
+
 /**
  * @brief
  * Sets the visibility weighting scheme to use.
@@ -871,6 +1099,19 @@ double oskar_imager_uv_filter_max(const oskar_Imager* h);
 OSKAR_EXPORT
 double oskar_imager_uv_filter_min(const oskar_Imager* h);
 
+/**
+ * @brief
+ * Returns the directory used to cache W-projection kernels.
+ *
+ * @details
+ * Returns the directory used to cache W-projection kernels,
+ * or NULL if kernels are not cached.
+ *
+ * @param[in] h  Handle to imager.
+ */
+OSKAR_EXPORT
+const char* oskar_imager_w_kernel_cache_dir(const oskar_Imager* h);
+
 /**
  * @brief
  * Returns the visibility weighting scheme.
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_PREDICT_H_
+#define OSKAR_IMAGER_PREDICT_H_
+
+/**
+ * @file oskar_imager_predict.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <vis/oskar_vis_block.h>
+#include <vis/oskar_vis_header.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Sets the model image used to predict visibilities.
+ *
+ * @details
+ * Transforms the supplied model image to a grid of visibilities, from
+ * which visibilities can then be predicted using oskar_imager_predict()
+ * or oskar_imager_predict_block().
+ *
+ * The model image must be real, with the imager's image size and field of
+ * view, in Jy/pixel, and centred on the phase centre of the visibilities.
+ * It is multiplied by the grid correction function and transformed
+ * using an FFT, and visibilities are then interpolated from the grid using
+ * the imager's convolution kernels. This mirrors the imager's gridding and
+ * transform steps, but is not their exact adjoint, as each predicted
+ * visibility is divided by the sum of the kernel values used for it
+ * (see oskar_degrid.h).
+ *
+ * Only the FFT and W-projection algorithms can be used, and visibilities
+ * are always predicted on the CPU. For W-projection, the range of baseline
+ * W coordinates must be known in advance, for example by calling
+ * oskar_imager_update() in "coordinates only" mode first.
+ *
+ * The model grid is cleared if the imager cache is reset.
+ *
+ * @param[in,out] h             Handle to imager.
+ * @param[in]     image         Model image, with image_size * image_size
+ *                              pixels.
+ * @param[in,out] status        Status return code.
+ */
+OSKAR_EXPORT
+void oskar_imager_set_model_image(oskar_Imager* h, const oskar_Mem* image,
+        int* status);
+
+/**
+ * @brief
+ * Predicts visibilities from the model image.
+ *
+ * @details
+ * Interpolates visibilities from the model grid set using
+ * oskar_imager_set_model_image(), using the imager's convolution kernels.
+ *
+ * The supplied baseline coordinates must be in wavelengths.
+ * The output array is resized if necessary and overwritten with
+ * complex scalar visibilities. Visibilities that fall outside the grid
+ * are set to zero.
+ *
+ * @param[in,out] h             Handle to imager.
+ * @param[in]     num_vis       Number of visibilities.
+ * @param[in]     uu            Visibility uu coordinates, in wavelengths.
+ * @param[in]     vv            Visibility vv coordinates, in wavelengths.
+ * @param[in]     ww            Visibility ww coordinates, in wavelengths.
+ * @param[out]    amps          Predicted visibility complex amplitudes.
+ * @param[in,out] status        Status return code.
+ */
+OSKAR_EXPORT
+void oskar_imager_predict(oskar_Imager* h, size_t num_vis,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        oskar_Mem* amps, int* status);
+
+/**
+ * @brief
+ * Adds visibilities predicted from the model image to a visibility block.
+ *
+ * @details
+ * Predicts visibilities from the model grid set using
+ * oskar_imager_set_model_image() for the baseline coordinates and
+ * channels in the block, and adds them to the cross-correlations.
+ *
+ * The model is treated as unpolarised, so for blocks with four
+ * polarisations the predicted visibilities are added to the XX and YY
+ * amplitudes only.
+ *
+ * The same model image is used for all channels in the block, and
+ * no station beams or other direction-dependent effects are applied,
+ * so the model image must be the apparent sky.
+ * The imager is locked while the block is processed, so this function
+ * may be called from several threads.
+ *
+ * @param[in,out] h             Handle to imager.
+ * @param[in]     header        Handle to visibility header.
+ * @param[in,out] block         Handle to visibility block.
+ * @param[in,out] status        Status return code.
+ */
+OSKAR_EXPORT
+void oskar_imager_predict_block(oskar_Imager* h,
+        const oskar_VisHeader* header, oskar_VisBlock* block, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_PREDICT_H_ */
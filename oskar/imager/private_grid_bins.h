@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_GRID_BINS_H_
+#define OSKAR_PRIVATE_GRID_BINS_H_
+
+/**
+ * @file private_grid_bins.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Returns the range of bins overlapped by a point.
+ *
+ * @details
+ * Sets the inclusive range of bin columns (\p u0 to \p u1) and bin rows
+ * (\p v0 to \p v1) overlapped by point \p i, and returns 1,
+ * or returns 0 if the point is not in any bin.
+ */
+typedef int (*oskar_GridBinRange)(const void* points, size_t i,
+        int* u0, int* u1, int* v0, int* v1);
+
+/* Point indices sorted into bins. */
+struct oskar_GridBins
+{
+    int num_bins_u, num_bins;
+    size_t* bin_start; /* Start of the list for each bin (num_bins + 1). */
+    size_t* bin_points; /* Point indices in each bin, in original order. */
+};
+typedef struct oskar_GridBins oskar_GridBins;
+
+/**
+ * @brief
+ * Sorts points into a list for each bin they overlap.
+ *
+ * @details
+ * Sorts points into a list for each bin of a 2D array of bins, using all
+ * available threads. Each thread counts and then writes the points in one
+ * contiguous range, and the output offsets are ordered by bin and then by
+ * thread, so no atomic operations are needed, and the points in each bin
+ * keep their original order whatever the number of threads.
+ *
+ * The lists must be released using oskar_grid_bins_free().
+ *
+ * @param[in] num_points   Number of points.
+ * @param[in] points       Point data, passed to \p range.
+ * @param[in] range        Function returning the bins overlapped by a point.
+ * @param[in] num_bins_u   Number of bin columns.
+ * @param[in] num_bins_v   Number of bin rows.
+ * @param[out] bins        Lists of points in each bin.
+ * @param[in,out] status   Status return code.
+ */
+void oskar_grid_bins_create(size_t num_points, const void* points,
+        oskar_GridBinRange range, int num_bins_u, int num_bins_v,
+        oskar_GridBins* bins, int* status);
+
+/**
+ * @brief
+ * Releases the lists created by oskar_grid_bins_create().
+ *
+ * @param[in,out] bins     Lists of points in each bin.
+ */
+void oskar_grid_bins_free(oskar_GridBins* bins);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_PRIVATE_GRID_BINS_H_ */
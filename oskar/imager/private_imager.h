@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -10,6 +10,8 @@
 #include <utility/oskar_thread.h>
 #include <utility/oskar_timer.h>
 
+#include <stdio.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -33,24 +35,37 @@ struct DeviceData
 };
 typedef struct DeviceData DeviceData;
 
+/* W-stacking layer grid, held until it is transformed and added to a plane. */
+struct WStackLayer
+{
+    oskar_Mem *grid, *plane; /* Plane is null if the grid is unused. */
+    int layer;
+    size_t last_used;
+};
+typedef struct WStackLayer WStackLayer;
+
 struct oskar_Imager
 {
     char* output_name[4];
     fitsfile* fits_file[4];
     oskar_Timer *tmr_overall, *tmr_grid_update, *tmr_grid_finalise, *tmr_init;
-    oskar_Timer *tmr_select_scale, *tmr_filter, *tmr_read, *tmr_write;
+    oskar_Timer *tmr_select_scale, *tmr_filter, *tmr_read, *tmr_read_io;
+    oskar_Timer *tmr_write;
     oskar_Timer *tmr_copy_convert, *tmr_coord_scan, *tmr_rotate;
-    oskar_Timer *tmr_weights_grid, *tmr_weights_lookup;
+    oskar_Timer *tmr_weights_grid, *tmr_weights_lookup, *tmr_sort;
 
     /* Settings parameters. */
     int imager_prec, num_devices, num_gpus_avail, dev_loc, num_gpus, *gpu_ids;
     int chan_snaps, im_type, num_im_channels, num_im_pols, pol_offset;
-    int algorithm, fft_on_gpu, grid_on_gpu;
+    int algorithm, fft_on_gpu, grid_on_gpu, half_plane;
     int image_size, use_stokes, support, oversample;
     int generate_w_kernels_on_gpu, set_cellsize, set_fov, weighting;
     int num_files, scale_norm_with_num_input_files;
     char direction_type, kernel_type;
     char **input_files, *input_root, *output_root, *ms_column;
+    char *w_kernel_cache_dir, *grid_scratch_dir;
+    int fits_compression; /* CFITSIO compression type, or 0 for none. */
+    double grid_memory_mb, fits_quantize_level;
     double cellsize_rad, fov_deg, image_padding, im_centre_deg[2];
     double uv_filter_min, uv_filter_max, uv_taper[2];
     double time_min_utc, time_max_utc, freq_min_hz, freq_max_hz;
@@ -67,12 +82,25 @@ struct oskar_Imager
     oskar_Log* log;
     size_t num_vis_processed;
 
+    /* Coordinate cache, filled during the first pass. */
+    int coord_cache_write, coord_cache_read;
+    size_t coord_cache_size, coord_cache_pos;
+    double coord_cache_mb;
+    oskar_Mem* coord_cache;
+    FILE* coord_cache_file;
+
     /* Scratch data. */
     oskar_Mem *uu_im, *vv_im, *ww_im, *vis_im, *weight_im, *time_im;
-    oskar_Mem *uu_tmp, *vv_tmp, *ww_tmp, *stokes, *weight_tmp;
+    oskar_Mem *uu_tmp, *vv_tmp, *ww_tmp, *stokes, *weight_tmp, *vis_tmp;
+    oskar_Mem *w_key, *w_index, *w_key_tmp, *w_index_tmp; /* Index: size_t. */
     int num_planes; /* For each output channel and polarisation. */
     double *plane_norm, delta_l, delta_m, delta_n, M[9];
     oskar_Mem **planes, **weights_grids, **weights_guard;
+    void* grid_map; /* Memory-mapped scratch file for planes, if used. */
+    size_t grid_map_size, grid_map_stride;
+    size_t *grid_map_last_used, grid_map_use_count; /* 0 if not in memory. */
+    int grid_map_num_used, grid_map_max_used;
+    FILE* grid_map_file;
 
     /* DFT imager data. */
     oskar_Mem *l, *m, *n;
@@ -81,12 +109,22 @@ struct oskar_Imager
     oskar_FFT* fft;
     int grid_size;
     oskar_Mem *conv_func, *corr_func;
+    oskar_Mem *model_grid; /* Model visibility grid, for prediction. */
 
     /* W-projection imager data. */
     size_t ww_points;
     int num_w_planes;
     double w_scale, ww_min, ww_max, ww_rms;
     oskar_Mem *w_support, *w_kernels_compact, *w_kernel_start;
+    void* w_kernel_map; /* Memory-mapped kernel cache file, if used. */
+    size_t w_kernel_map_size;
+
+    /* W-stacking imager data.
+     * The number of layers and the W scale use num_w_planes and w_scale. */
+    oskar_Mem *layer_uu, *layer_vv, *layer_vis;
+    WStackLayer* layers;
+    int num_layers, max_layers;
+    size_t layer_use_count;
 
     /* Memory allocated per GPU (array of DeviceData structures). */
     DeviceData* d;
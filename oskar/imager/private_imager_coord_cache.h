@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_COORD_CACHE_H_
+#define OSKAR_IMAGER_COORD_CACHE_H_
+
+/**
+ * @file private_imager_coord_cache.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Appends an array to the imager's coordinate cache.
+ *
+ * @details
+ * Appends the first \p num_elements of the array to the coordinate cache,
+ * which is filled while reading coordinates in the first pass over the
+ * input data, so that they do not have to be read again.
+ *
+ * The cache is held in memory until it reaches the size set using
+ * oskar_imager_set_coord_cache_mb(), after which it is written to a
+ * temporary file. If the temporary file cannot be written, the cache is
+ * disabled and a warning is logged, so that the coordinates are read
+ * again from the input files instead.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in]     data         Array to append.
+ * @param[in]     num_elements Number of elements to append.
+ */
+void oskar_imager_coord_cache_put(oskar_Imager* h, const oskar_Mem* data,
+        size_t num_elements);
+
+/**
+ * @brief
+ * Reads the next array from the imager's coordinate cache.
+ *
+ * @details
+ * Reads the next array from the coordinate cache, in the order in which
+ * they were appended. The array is resized if it is too small.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in,out] data         Array to fill.
+ * @param[in,out] status       Status return code.
+ */
+void oskar_imager_coord_cache_get(oskar_Imager* h, oskar_Mem* data,
+        int* status);
+
+/**
+ * @brief
+ * Returns to the start of the imager's coordinate cache.
+ *
+ * @param[in,out] h            Handle to imager.
+ */
+void oskar_imager_coord_cache_rewind(oskar_Imager* h);
+
+/**
+ * @brief
+ * Frees the imager's coordinate cache, and removes any temporary file.
+ *
+ * @param[in,out] h            Handle to imager.
+ * @param[in,out] status       Status return code.
+ */
+void oskar_imager_coord_cache_free(oskar_Imager* h, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_COORD_CACHE_H_ */
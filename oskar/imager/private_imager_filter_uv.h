@@ -47,7 +47,16 @@ extern "C" {
  *
  * @details
  * Filters supplied visibility data using the baseline UV range,
- * if it has been set. If not set, this function returns immediately.
+ * if it has been set.
+ *
+ * If a grid of weights is supplied, the uniform weight of each remaining
+ * visibility is also looked up from it in the same pass, and the weights
+ * are updated in place. If neither is required, this function returns
+ * immediately.
+ *
+ * The visibilities are divided between threads in contiguous ranges,
+ * which are joined in order afterwards, so the output order matches
+ * the input order.
  *
  * @param[in,out] h          Handle to imager.
  * @param[in,out] num_vis    On input, number of supplied visibilities;
@@ -57,12 +66,13 @@ extern "C" {
  * @param[in,out] ww         Baseline ww coordinates, in wavelengths.
  * @param[in,out] amp        Baseline complex visibility amplitudes.
  * @param[in,out] weight     Baseline visibility weights.
+ * @param[in] weights_grid   Grid of weights for uniform weighting, or NULL.
  * @param[in,out] status     Status return code.
  */
 OSKAR_EXPORT
 void oskar_imager_filter_uv(oskar_Imager* h, size_t* num_vis,
         oskar_Mem* uu, oskar_Mem* vv, oskar_Mem* ww, oskar_Mem* amp,
-        oskar_Mem* weight, int* status);
+        oskar_Mem* weight, const oskar_Mem* weights_grid, int* status);
 
 #ifdef __cplusplus
 }
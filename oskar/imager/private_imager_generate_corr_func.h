@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_GENERATE_CORR_FUNC_H_
+#define OSKAR_IMAGER_GENERATE_CORR_FUNC_H_
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Generates the grid correction function, if it does not already exist.
+ *
+ * @details
+ * The function is stored in h->corr_func, and depends on the
+ * algorithm and convolution kernel type.
+ *
+ * @param[in,out] h       Handle to imager.
+ * @param[in,out] status  Status return code.
+ */
+void oskar_imager_generate_corr_func(oskar_Imager* h, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_GENERATE_CORR_FUNC_H_ */
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_GRID_SCRATCH_H_
+#define OSKAR_IMAGER_GRID_SCRATCH_H_
+
+/**
+ * @file private_imager_grid_scratch.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Creates the image planes in a memory-mapped scratch file, if required.
+ *
+ * @details
+ * If the planes need more memory than the limit set using
+ * oskar_imager_set_grid_memory_mb(), a sparse scratch file is created in
+ * the directory set using oskar_imager_set_grid_scratch_dir(), and each
+ * plane in the imager's array of planes is set to an alias of one part of
+ * the mapped file. The array of planes must already have been allocated.
+ *
+ * Each plane starts on a page boundary, so that it can be released from
+ * memory independently of the others. Parts of the planes that are never
+ * written to use neither memory nor disk space.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     plane_type Enumerated data type of the planes.
+ * @param[in]     num_cells  Number of elements in each plane.
+ * @param[in,out] status     Status return code.
+ *
+ * @return Returns true if the planes were created, or false if they
+ *         should be allocated on the heap instead.
+ */
+int oskar_imager_grid_scratch_create(oskar_Imager* h, int plane_type,
+        size_t num_cells, int* status);
+
+/**
+ * @brief
+ * Marks a memory-mapped image plane as being used.
+ *
+ * @details
+ * This must be called before a memory-mapped plane is updated, to keep
+ * the memory used by the planes within the limit set using
+ * oskar_imager_set_grid_memory_mb(). If the plane is not already in
+ * memory, and there are as many planes in memory as fit within the limit,
+ * the most recently used plane is released first. When the planes are
+ * updated in turn for each block of data, this keeps in memory the planes
+ * that will be used first for the next block.
+ *
+ * This function does nothing if \p plane is not a memory-mapped plane.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     plane      Plane that will be updated.
+ */
+void oskar_imager_grid_scratch_use(oskar_Imager* h, const oskar_Mem* plane);
+
+/**
+ * @brief
+ * Releases memory-mapped image planes from physical memory.
+ *
+ * @details
+ * The contents of the planes are kept in the scratch file, and are read
+ * back in when they are next used. This function does nothing if the
+ * planes are not memory-mapped.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     i_plane    Index of the plane to release, or -1 for all.
+ */
+void oskar_imager_grid_scratch_release(oskar_Imager* h, int i_plane);
+
+/**
+ * @brief
+ * Unmaps and deletes the scratch file used for the image planes.
+ *
+ * @details
+ * The plane aliases must have been freed before calling this function.
+ *
+ * @param[in,out] h          Handle to imager.
+ */
+void oskar_imager_grid_scratch_free(oskar_Imager* h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_GRID_SCRATCH_H_ */
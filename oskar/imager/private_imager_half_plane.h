@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_HALF_PLANE_H_
+#define OSKAR_IMAGER_HALF_PLANE_H_
+
+/**
+ * @file private_imager_half_plane.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Returns the number of columns in each half-plane grid.
+ *
+ * @details
+ * Returns the number of columns in each grid if only half the uv-plane
+ * is gridded, or 0 if full grids are used.
+ *
+ * Half-plane grids hold the columns at and to the right of the centre
+ * of the full grid, with a margin on the left as wide as the largest
+ * convolution kernel support size, as used by the tiled gridding functions.
+ * They are only used if requested, when gridding and transforming on the
+ * CPU using the FFT or W-projection algorithms, and only if the grid size
+ * is even.
+ * The convolution kernels must have been initialised.
+ *
+ * @param[in] h  Handle to imager.
+ */
+int oskar_imager_half_plane_width(oskar_Imager* h);
+
+/**
+ * @brief
+ * Transforms a half-plane grid to an image.
+ *
+ * @details
+ * Adds the margin of the half-plane grid to the Hermitian-symmetric part of
+ * the grid, and uses a complex-to-real FFT to give the same image as would
+ * be made from the real part of the FFT of the full grid.
+ *
+ * The grid correction function in \p corr_func is also applied, and the
+ * real image is written to the start of \p plane.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     corr_func  Grid correction function.
+ * @param[in,out] plane      Half-plane grid on input; image on output.
+ * @param[in,out] status     Status return code.
+ */
+void oskar_imager_finalise_half_plane(oskar_Imager* h,
+        const oskar_Mem* corr_func, oskar_Mem* plane, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_HALF_PLANE_H_ */
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_SORT_BY_W_H_
+#define OSKAR_IMAGER_SORT_BY_W_H_
+
+/**
+ * @file private_imager_sort_by_w.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Sorts visibility data in the imager scratch arrays by W-projection plane,
+ * or by W-layer when using W-stacking.
+ *
+ * @details
+ * Sorts the first \p num_vis elements of the imager's visibility scratch
+ * arrays (uu_im, vv_im, ww_im, vis_im and weight_im) so that visibilities
+ * in the same W-projection plane or W-layer are gridded consecutively.
+ *
+ * The key is the W-projection plane or W-layer index used by the gridder.
+ * A stable parallel least-significant-digit radix sort is used,
+ * and the data are then gathered into the matching temporary arrays,
+ * which are swapped with the scratch arrays.
+ *
+ * The visibility amplitudes are not sorted if only coordinates are
+ * being processed.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     num_vis    Number of visibilities to sort.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_imager_sort_by_w(oskar_Imager* h, size_t num_vis, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_SORT_BY_W_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_UPDATE_CHANNELS_H_
+#define OSKAR_IMAGER_UPDATE_CHANNELS_H_
+
+/**
+ * @file private_imager_update_channels.h
+ */
+
+#include <oskar_global.h>
+#include <mem/oskar_mem.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Updates the imager with all channels of a block of visibility data.
+ *
+ * @details
+ * Updates the imager with the channels of a visibility block that lie
+ * within the selected frequency range.
+ *
+ * The visibility amplitude data dimension order must be
+ * (slowest) time, channel, baseline, polarisation (fastest),
+ * which is the order used by oskar_VisBlock.
+ *
+ * If channel snapshots are being made, the imager is updated separately
+ * for each channel. Otherwise, the amplitudes of all the selected channels
+ * are reordered into the scratch array so that the imager can be updated
+ * with the whole block at once, and each baseline is gridded for all
+ * channels in turn.
+ *
+ * @param[in,out] h             Handle to imager.
+ * @param[in]     num_baselines Number of baselines in the block.
+ * @param[in]     num_times     Number of times in the block.
+ * @param[in]     start_chan    Start channel index of the block.
+ * @param[in]     num_channels  Number of channels in the block.
+ * @param[in]     num_pols      Number of polarisations in the block.
+ * @param[in]     uu            Baseline uu coordinates, in metres.
+ * @param[in]     vv            Baseline vv coordinates, in metres.
+ * @param[in]     ww            Baseline ww coordinates, in metres.
+ * @param[in]     amps          Visibility amplitudes, or NULL if only
+ *                              updating coordinates.
+ * @param[in]     weight        Visibility weights.
+ * @param[in]     time_centroid Visibility time centroids.
+ * @param[in,out] scratch       Scratch array of the same type as \p amps.
+ * @param[in,out] status        Status return code.
+ */
+void oskar_imager_update_channels(oskar_Imager* h, int num_baselines,
+        int num_times, int start_chan, int num_channels, int num_pols,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight,
+        const oskar_Mem* time_centroid, oskar_Mem* scratch, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_UPDATE_CHANNELS_H_ */
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_UPDATE_PLANE_WSTACK_H_
+#define OSKAR_IMAGER_UPDATE_PLANE_WSTACK_H_
+
+#include <mem/oskar_mem.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Visibilities are gridded onto one W-layer at a time.
+ * Each run of consecutive visibilities in the same layer is gridded onto
+ * a layer grid, which stays resident across calls (up to a memory limit)
+ * until it is flushed: it is then transformed, multiplied by the layer's
+ * W-screen and added to the (image-domain) plane.
+ * If all layer grids fit, each layer of each plane is transformed once.
+ */
+void oskar_imager_update_plane_wstack(oskar_Imager* h, size_t num_vis,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight, int i_plane,
+        oskar_Mem* plane, double* plane_norm, size_t* num_skipped, int* status);
+
+/*
+ * Flushes the resident layer grids for the given plane into it,
+ * or for all planes if plane is NULL.
+ * This must be done before the plane is used.
+ */
+void oskar_imager_flush_wstack_layers(oskar_Imager* h,
+        const oskar_Mem* plane, int* status);
+
+/* Frees the layer grids, discarding any that have not been flushed. */
+void oskar_imager_free_wstack_layers(oskar_Imager* h, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_UPDATE_PLANE_WSTACK_H_ */
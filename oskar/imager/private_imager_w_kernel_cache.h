@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_IMAGER_W_KERNEL_CACHE_H_
+#define OSKAR_IMAGER_W_KERNEL_CACHE_H_
+
+/**
+ * @file private_imager_w_kernel_cache.h
+ */
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Loads W-projection kernels from the imager's kernel cache directory.
+ *
+ * @details
+ * Looks for a kernel cache file generated with the current imaging
+ * parameters in the directory set using
+ * oskar_imager_set_w_kernel_cache_dir(), and if one is found, uses it to
+ * set the compact kernels, their start indices and their support sizes.
+ *
+ * Where possible, the compact kernels are mapped directly from the file
+ * rather than copied into memory. The mapping is released by
+ * oskar_imager_w_kernel_cache_release().
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     conv_size  Size of the kernel generation grid.
+ * @param[in,out] status     Status return code.
+ *
+ * @return Returns true if the kernels were loaded, false if not.
+ */
+int oskar_imager_w_kernel_cache_load(oskar_Imager* h, int conv_size,
+        int* status);
+
+/**
+ * @brief
+ * Saves W-projection kernels to the imager's kernel cache directory.
+ *
+ * @details
+ * Writes the compact kernels, their start indices and their support sizes
+ * to a file in the kernel cache directory, named using the current
+ * imaging parameters. Failure to write the file is not an error: a warning
+ * is logged, and the kernels will be generated again next time.
+ *
+ * @param[in,out] h          Handle to imager.
+ * @param[in]     conv_size  Size of the kernel generation grid.
+ * @param[in,out] status     Status return code.
+ */
+void oskar_imager_w_kernel_cache_save(oskar_Imager* h, int conv_size,
+        int* status);
+
+/**
+ * @brief
+ * Releases any memory-mapped kernel cache file.
+ *
+ * @details
+ * The compact kernels must have been freed before calling this function.
+ *
+ * @param[in,out] h          Handle to imager.
+ */
+void oskar_imager_w_kernel_cache_release(oskar_Imager* h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_IMAGER_W_KERNEL_CACHE_H_ */
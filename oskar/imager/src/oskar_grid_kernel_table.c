@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/oskar_grid_kernel_table.h"
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Taps beyond the end of the convolution function, which can only be
+ * reached if the oversample factor is 1, are set to zero.
+ */
+
+int oskar_grid_kernel_table_max_offset(int oversample)
+{
+    return (oversample + 1) / 2;
+}
+
+#define OSKAR_GRID_KERNEL_TABLE(NAME, FP)\
+void NAME(\
+        const int support,\
+        const int oversample,\
+        const FP* RESTRICT conv_func,\
+        FP* RESTRICT table,\
+        double* RESTRICT table_sum)\
+{\
+    int off = 0, k = 0;\
+    const int width = 2 * support + 1;\
+    const int num_values = oversample * (support + 1);\
+    const int max_offset = oskar_grid_kernel_table_max_offset(oversample);\
+    for (off = -max_offset; off <= max_offset; ++off)\
+    {\
+        double sum = 0.0;\
+        FP* RESTRICT row = &table[(size_t) (off + max_offset) * width];\
+        for (k = -support; k <= support; ++k)\
+        {\
+            const int i = abs(off + k * oversample);\
+            row[k + support] = (i < num_values) ? conv_func[i] : (FP) 0;\
+            sum += row[k + support];\
+        }\
+        table_sum[off + max_offset] = sum;\
+    }\
+}\
+
+OSKAR_GRID_KERNEL_TABLE(oskar_grid_kernel_table_d, double)
+OSKAR_GRID_KERNEL_TABLE(oskar_grid_kernel_table_f, float)
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,886 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/oskar_grid_tiled.h"
+#include "imager/oskar_grid_kernel_table.h"
+#include "imager/private_grid_bins.h"
+#include <math.h>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Side length of each tile, in grid cells. */
+#define TILE_SIZE 32
+
+/* Number of tiles needed to cover N grid cells. */
+#define NUM_TILES(N) (((N) + TILE_SIZE - 1) / TILE_SIZE)
+
+/* Location of a visibility on the grid. */
+struct oskar_GridTilePoint
+{
+    double norm; /* Contribution to the normalisation factor. */
+    int grid_u, grid_v; /* Nearest grid cell (grid_u is -1 if skipped). */
+    int off_u, off_v; /* Scaled distance from nearest grid cell. */
+    int support, kernel_start, conj; /* Convolution kernel parameters. */
+    int vis_conj; /* -1 if the visibility is conjugated, otherwise 1. */
+};
+typedef struct oskar_GridTilePoint oskar_GridTilePoint;
+
+/* Range of tiles overlapped by the convolution kernel of point PT. */
+#define TILE_RANGE(PT, TU0, TU1, TV0, TV1) {\
+        TU0 = (PT->grid_u - PT->support) / TILE_SIZE;\
+        TU1 = (PT->grid_u + PT->support) / TILE_SIZE;\
+        TV0 = (PT->grid_v - PT->support) / TILE_SIZE;\
+        TV1 = (PT->grid_v + PT->support) / TILE_SIZE;}\
+
+/* True if points A and B use the same kernel at the same grid cell. */
+#define SAME_KERNEL(A, B) (\
+        A->grid_u == B->grid_u && A->grid_v == B->grid_v &&\
+        A->off_u == B->off_u && A->off_v == B->off_v &&\
+        A->support == B->support && A->kernel_start == B->kernel_start &&\
+        A->conj == B->conj)\
+
+/* Range of kernel offsets of point PT that lie in the tile at U0, V0. */
+#define TILE_CLIP(PT, U0, V0, J_MIN, J_MAX, K_MIN, K_MAX) {\
+        J_MIN = V0 - PT->grid_v;\
+        J_MAX = V0 + TILE_SIZE - 1 - PT->grid_v;\
+        K_MIN = U0 - PT->grid_u;\
+        K_MAX = U0 + TILE_SIZE - 1 - PT->grid_u;\
+        if (J_MIN < -PT->support) J_MIN = -PT->support;\
+        if (J_MAX > PT->support) J_MAX = PT->support;\
+        if (K_MIN < -PT->support) K_MIN = -PT->support;\
+        if (K_MAX > PT->support) K_MAX = PT->support;}\
+
+
+int oskar_grid_tiled_num_threads(void)
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+
+/* Returns the range of tiles overlapped by the kernel of point i. */
+static int oskar_grid_tile_range(const void* points, size_t i,
+        int* u0, int* u1, int* v0, int* v1)
+{
+    const oskar_GridTilePoint* pt = &((const oskar_GridTilePoint*) points)[i];
+    if (pt->grid_u < 0) return 0;
+    TILE_RANGE(pt, *u0, *u1, *v0, *v1)
+    return 1;
+}
+
+
+/* Sums the normalisation factor in the same order as the serial version. */
+static void oskar_grid_tiles_sum_norm(
+        const size_t num_points,
+        const oskar_GridTilePoint* RESTRICT points,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm)
+{
+    size_t i = 0;
+    *num_skipped = 0;
+    for (i = 0; i < num_points; ++i)
+    {
+        if (points[i].grid_u < 0)
+        {
+            *num_skipped += 1;
+            continue;
+        }
+        *norm += points[i].norm;
+    }
+}
+
+
+static void oskar_grid_locate_simple_d(
+        const int support,
+        const int oversample,
+        const double* RESTRICT table_sum,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT weight,
+        const double cell_size_rad,
+        const int grid_size,
+        const int half_plane,
+        const int u_start,
+        oskar_GridTilePoint* RESTRICT points)
+{
+    size_t i = 0;
+    const int max_offset = oskar_grid_kernel_table_max_offset(oversample);
+    const int grid_centre = grid_size / 2;
+    const double grid_scale = grid_size * cell_size_rad;
+#pragma omp parallel for schedule(static)
+    for (i = 0; i < num_points; ++i)
+    {
+        oskar_GridTilePoint* pt = &points[i];
+
+        /* Convert UV coordinates to grid coordinates, using the conjugate
+         * of visibilities that would lie outside the half-plane. */
+        const int vis_conj = (half_plane && uu[i] > 0.0) ? -1 : 1;
+        const double pos_u = -vis_conj * uu[i] * grid_scale;
+        const double pos_v = vis_conj * vv[i] * grid_scale;
+        const int grid_u = (int)round(pos_u) + grid_centre;
+        const int grid_v = (int)round(pos_v) + grid_centre;
+
+        /* Scaled distance from nearest grid point. */
+        const int off_u = (int)round((round(pos_u) - pos_u) * oversample);
+        const int off_v = (int)round((round(pos_v) - pos_v) * oversample);
+
+        /* Catch points that would lie outside the grid. */
+        if (grid_u + support >= grid_size || grid_u - support < 0 ||
+                grid_v + support >= grid_size || grid_v - support < 0)
+        {
+            pt->grid_u = -1;
+            continue;
+        }
+        pt->grid_u = grid_u - u_start;
+        pt->grid_v = grid_v;
+        pt->off_u = off_u;
+        pt->off_v = off_v;
+        pt->support = support;
+        pt->kernel_start = 0;
+        pt->conj = 1;
+        pt->vis_conj = vis_conj;
+
+        /* Sum the convolution kernel. */
+        pt->norm = table_sum[off_u + max_offset] *
+                table_sum[off_v + max_offset] * weight[i];
+    }
+}
+
+
+static void oskar_grid_tiles_simple_d(
+        const oskar_GridBins* tiles,
+        const oskar_GridTilePoint* RESTRICT points,
+        const int oversample,
+        const double* RESTRICT table,
+        const double* RESTRICT vis,
+        const double* RESTRICT weight,
+        const int grid_width,
+        double* RESTRICT grid)
+{
+    int i_tile = 0;
+    const int max_offset = oskar_grid_kernel_table_max_offset(oversample);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i_tile = 0; i_tile < tiles->num_bins; ++i_tile)
+    {
+        const int u0 = (i_tile % tiles->num_bins_u) * TILE_SIZE;
+        const int v0 = (i_tile / tiles->num_bins_u) * TILE_SIZE;
+        const size_t end = tiles->bin_start[i_tile + 1];
+        size_t i = tiles->bin_start[i_tile];
+        while (i < end)
+        {
+            int j = 0, k = 0, j_min = 0, j_max = 0, k_min = 0, k_max = 0;
+            size_t i_vis = tiles->bin_points[i];
+            const oskar_GridTilePoint* pt = &points[i_vis];
+            const int width = 2 * pt->support + 1;
+            double v_re = 0.0, v_im = 0.0;
+
+            /* Get visibility data, summing any that follow with the same
+             * kernel at the same grid cell, so the kernel is used once. */
+            do
+            {
+                const double weight_i = weight[i_vis];
+                v_re += weight_i * vis[2 * i_vis];
+                v_im += weight_i * vis[2 * i_vis + 1] *
+                        points[i_vis].vis_conj;
+                if (++i == end) break;
+                i_vis = tiles->bin_points[i];
+            }
+            while (SAME_KERNEL(pt, (&points[i_vis])));
+
+            /* Convolve the part of this point in the tile onto the grid,
+             * using the rows of the kernel table for its offsets. */
+            const double* RESTRICT conv_u =
+                    &table[(pt->off_u + max_offset) * width + pt->support];
+            const double* RESTRICT conv_v =
+                    &table[(pt->off_v + max_offset) * width + pt->support];
+            TILE_CLIP(pt, u0, v0, j_min, j_max, k_min, k_max)
+            for (j = j_min; j <= j_max; ++j)
+            {
+                size_t p1 = 0;
+                const double c1 = conv_v[j];
+                p1 = pt->grid_v + j;
+                p1 *= grid_width; /* Tested to avoid int overflow. */
+                p1 += pt->grid_u;
+                double* RESTRICT grid_row = &grid[p1 << 1];
+#pragma omp simd
+                for (k = k_min; k <= k_max; ++k)
+                {
+                    const double c = conv_u[k] * c1;
+                    grid_row[2 * k]     += v_re * c;
+                    grid_row[2 * k + 1] += v_im * c;
+                }
+            }
+        }
+    }
+}
+
+
+static void oskar_grid_locate_simple_f(
+        const int support,
+        const int oversample,
+        const double* RESTRICT table_sum,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT weight,
+        const float cell_size_rad,
+        const int grid_size,
+        const int half_plane,
+        const int u_start,
+        oskar_GridTilePoint* RESTRICT points)
+{
+    size_t i = 0;
+    const int max_offset = oskar_grid_kernel_table_max_offset(oversample);
+    const int grid_centre = grid_size / 2;
+    const float grid_scale = grid_size * cell_size_rad;
+#pragma omp parallel for schedule(static)
+    for (i = 0; i < num_points; ++i)
+    {
+        oskar_GridTilePoint* pt = &points[i];
+
+        /* Convert UV coordinates to grid coordinates, using the conjugate
+         * of visibilities that would lie outside the half-plane. */
+        const int vis_conj = (half_plane && uu[i] > 0.0f) ? -1 : 1;
+        const float pos_u = -vis_conj * uu[i] * grid_scale;
+        const float pos_v = vis_conj * vv[i] * grid_scale;
+        const int grid_u = (int)roundf(pos_u) + grid_centre;
+        const int grid_v = (int)roundf(pos_v) + grid_centre;
+
+        /* Scaled distance from nearest grid point. */
+        const int off_u = (int)roundf((roundf(pos_u) - pos_u) * oversample);
+        const int off_v = (int)roundf((roundf(pos_v) - pos_v) * oversample);
+
+        /* Catch points that would lie outside the grid. */
+        if (grid_u + support >= grid_size || grid_u - support < 0 ||
+                grid_v + support >= grid_size || grid_v - support < 0)
+        {
+            pt->grid_u = -1;
+            continue;
+        }
+        pt->grid_u = grid_u - u_start;
+        pt->grid_v = grid_v;
+        pt->off_u = off_u;
+        pt->off_v = off_v;
+        pt->support = support;
+        pt->kernel_start = 0;
+        pt->conj = 1;
+        pt->vis_conj = vis_conj;
+
+        /* Sum the convolution kernel. */
+        pt->norm = table_sum[off_u + max_offset] *
+                table_sum[off_v + max_offset] * weight[i];
+    }
+}
+
+
+static void oskar_grid_tiles_simple_f(
+        const oskar_GridBins* tiles,
+        const oskar_GridTilePoint* RESTRICT points,
+        const int oversample,
+        const float* RESTRICT table,
+        const float* RESTRICT vis,
+        const float* RESTRICT weight,
+        const int grid_width,
+        float* RESTRICT grid)
+{
+    int i_tile = 0;
+    const int max_offset = oskar_grid_kernel_table_max_offset(oversample);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i_tile = 0; i_tile < tiles->num_bins; ++i_tile)
+    {
+        const int u0 = (i_tile % tiles->num_bins_u) * TILE_SIZE;
+        const int v0 = (i_tile / tiles->num_bins_u) * TILE_SIZE;
+        const size_t end = tiles->bin_start[i_tile + 1];
+        size_t i = tiles->bin_start[i_tile];
+        while (i < end)
+        {
+            int j = 0, k = 0, j_min = 0, j_max = 0, k_min = 0, k_max = 0;
+            size_t i_vis = tiles->bin_points[i];
+            const oskar_GridTilePoint* pt = &points[i_vis];
+            const int width = 2 * pt->support + 1;
+            float v_re = 0.0f, v_im = 0.0f;
+
+            /* Get visibility data, summing any that follow with the same
+             * kernel at the same grid cell, so the kernel is used once. */
+            do
+            {
+                const float weight_i = weight[i_vis];
+                v_re += weight_i * vis[2 * i_vis];
+                v_im += weight_i * vis[2 * i_vis + 1] *
+                        points[i_vis].vis_conj;
+                if (++i == end) break;
+                i_vis = tiles->bin_points[i];
+            }
+            while (SAME_KERNEL(pt, (&points[i_vis])));
+
+            /* Convolve the part of this point in the tile onto the grid,
+             * using the rows of the kernel table for its offsets. */
+            const float* RESTRICT conv_u =
+                    &table[(pt->off_u + max_offset) * width + pt->support];
+            const float* RESTRICT conv_v =
+                    &table[(pt->off_v + max_offset) * width + pt->support];
+            TILE_CLIP(pt, u0, v0, j_min, j_max, k_min, k_max)
+            for (j = j_min; j <= j_max; ++j)
+            {
+                size_t p1 = 0;
+                const float c1 = conv_v[j];
+                p1 = pt->grid_v + j;
+                p1 *= grid_width; /* Tested to avoid int overflow. */
+                p1 += pt->grid_u;
+                float* RESTRICT grid_row = &grid[p1 << 1];
+#pragma omp simd
+                for (k = k_min; k <= k_max; ++k)
+                {
+                    const float c = conv_u[k] * c1;
+                    grid_row[2 * k]     += v_re * c;
+                    grid_row[2 * k + 1] += v_im * c;
+                }
+            }
+        }
+    }
+}
+
+
+static void oskar_grid_locate_wproj2_d(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const double* RESTRICT wkernel,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT ww,
+        const double* RESTRICT weight,
+        const double cell_size_rad,
+        const double w_scale,
+        const int grid_size,
+        const int half_plane,
+        const int u_start,
+        oskar_GridTilePoint* RESTRICT points)
+{
+    size_t i = 0;
+    const int grid_centre = grid_size / 2;
+    const int oversample_h = oversample / 2;
+    const double grid_scale = grid_size * cell_size_rad;
+#pragma omp parallel for schedule(static)
+    for (i = 0; i < num_points; ++i)
+    {
+        double sum = 0.0;
+        int j = 0, k = 0;
+        oskar_GridTilePoint* pt = &points[i];
+
+        /* Convert UV coordinates to grid coordinates, using the conjugate
+         * of visibilities that would lie outside the half-plane. */
+        const int vis_conj = (half_plane && uu[i] > 0.0) ? -1 : 1;
+        const double pos_u = -vis_conj * uu[i] * grid_scale;
+        const double pos_v = vis_conj * vv[i] * grid_scale;
+        const double ww_i = vis_conj * ww[i];
+        const size_t grid_w = (size_t)round(sqrt(fabs(ww_i * w_scale)));
+        const int grid_u = (int)round(pos_u) + grid_centre;
+        const int grid_v = (int)round(pos_v) + grid_centre;
+
+        /* Scaled distance from nearest grid point. */
+        const int off_u = (int)round((round(pos_u) - pos_u) * oversample);
+        const int off_v = (int)round((round(pos_v) - pos_v) * oversample);
+
+        /* Get kernel support size and start offset. */
+        const int w_support = grid_w < num_w_planes ?
+                support[grid_w] : support[num_w_planes - 1];
+        const int kernel_start = grid_w < num_w_planes ?
+                wkernel_start[grid_w] : wkernel_start[num_w_planes - 1];
+
+        /* Catch points that would lie outside the grid. */
+        if (grid_u + w_support >= grid_size || grid_u - w_support < 0 ||
+                grid_v + w_support >= grid_size || grid_v - w_support < 0)
+        {
+            pt->grid_u = -1;
+            continue;
+        }
+        pt->grid_u = grid_u - u_start;
+        pt->grid_v = grid_v;
+        pt->off_u = off_u;
+        pt->off_v = off_v;
+        pt->support = w_support;
+        pt->kernel_start = kernel_start;
+        pt->conj = (ww_i > 0.0) ? -1 : 1;
+        pt->vis_conj = vis_conj;
+
+        /* Sum the convolution kernel (real part only). */
+        const int conv_len = 2 * w_support + 1;
+        const int width = (oversample_h * conv_len + 1) * conv_len;
+        const int mid = kernel_start + (abs(off_u) + 1) * width - 1 - w_support;
+        const int stride = (off_u >= 0) ? 1 : -1;
+        for (j = -w_support; j <= w_support; ++j)
+        {
+            const int t = mid - abs(off_v + j * oversample) * conv_len;
+            for (k = -w_support; k <= w_support; ++k)
+            {
+                const int p = (t + stride * k) << 1;
+                sum += wkernel[p];
+            }
+        }
+        pt->norm = sum * weight[i];
+    }
+}
+
+
+static void oskar_grid_tiles_wproj2_d(
+        const oskar_GridBins* tiles,
+        const oskar_GridTilePoint* RESTRICT points,
+        const int oversample,
+        const double* RESTRICT wkernel,
+        const double* RESTRICT vis,
+        const double* RESTRICT weight,
+        const int grid_width,
+        double* RESTRICT grid)
+{
+    int i_tile = 0;
+    const int oversample_h = oversample / 2;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i_tile = 0; i_tile < tiles->num_bins; ++i_tile)
+    {
+        const int u0 = (i_tile % tiles->num_bins_u) * TILE_SIZE;
+        const int v0 = (i_tile / tiles->num_bins_u) * TILE_SIZE;
+        const size_t end = tiles->bin_start[i_tile + 1];
+        size_t i = tiles->bin_start[i_tile];
+        while (i < end)
+        {
+            int j = 0, k = 0, j_min = 0, j_max = 0, k_min = 0, k_max = 0;
+            size_t i_vis = tiles->bin_points[i];
+            const oskar_GridTilePoint* pt = &points[i_vis];
+            const double conv_conj = (double) pt->conj;
+            double v_re = 0.0, v_im = 0.0;
+
+            /* Get visibility data, summing any that follow with the same
+             * kernel at the same grid cell, so the kernel is used once. */
+            do
+            {
+                const double weight_i = weight[i_vis];
+                v_re += weight_i * vis[2 * i_vis];
+                v_im += weight_i * vis[2 * i_vis + 1] *
+                        points[i_vis].vis_conj;
+                if (++i == end) break;
+                i_vis = tiles->bin_points[i];
+            }
+            while (SAME_KERNEL(pt, (&points[i_vis])));
+
+            /* Convolve the part of this point in the tile onto the grid. */
+            const int w_support = pt->support;
+            const int conv_len = 2 * w_support + 1;
+            const int width = (oversample_h * conv_len + 1) * conv_len;
+            const int mid = pt->kernel_start +
+                    (abs(pt->off_u) + 1) * width - 1 - w_support;
+            const int stride = (pt->off_u >= 0) ? 1 : -1;
+            TILE_CLIP(pt, u0, v0, j_min, j_max, k_min, k_max)
+            for (j = j_min; j <= j_max; ++j)
+            {
+                const int t = mid - abs(pt->off_v + j * oversample) * conv_len;
+                size_t p1 = pt->grid_v + j;
+                p1 *= grid_width; /* Tested to avoid int overflow. */
+                p1 += pt->grid_u;
+                for (k = k_min; k <= k_max; ++k)
+                {
+                    const int p = (t + stride * k) << 1;
+                    const double c_re = wkernel[p];
+                    const double c_im = wkernel[p + 1] * conv_conj;
+                    const size_t p2 = (p1 + k) << 1;
+                    grid[p2]     += (v_re * c_re - v_im * c_im);
+                    grid[p2 + 1] += (v_im * c_re + v_re * c_im);
+                }
+            }
+        }
+    }
+}
+
+
+static void oskar_grid_locate_wproj2_f(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const float* RESTRICT wkernel,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT ww,
+        const float* RESTRICT weight,
+        const float cell_size_rad,
+        const float w_scale,
+        const int grid_size,
+        const int half_plane,
+        const int u_start,
+        oskar_GridTilePoint* RESTRICT points)
+{
+    size_t i = 0;
+    const int grid_centre = grid_size / 2;
+    const int oversample_h = oversample / 2;
+    const float grid_scale = grid_size * cell_size_rad;
+#pragma omp parallel for schedule(static)
+    for (i = 0; i < num_points; ++i)
+    {
+        double sum = 0.0;
+        int j = 0, k = 0;
+        oskar_GridTilePoint* pt = &points[i];
+
+        /* Convert UV coordinates to grid coordinates, using the conjugate
+         * of visibilities that would lie outside the half-plane. */
+        const int vis_conj = (half_plane && uu[i] > 0.0f) ? -1 : 1;
+        const float pos_u = -vis_conj * uu[i] * grid_scale;
+        const float pos_v = vis_conj * vv[i] * grid_scale;
+        const float ww_i = vis_conj * ww[i];
+        const size_t grid_w = (size_t)roundf(sqrtf(fabsf(ww_i * w_scale)));
+        const int grid_u = (int)roundf(pos_u) + grid_centre;
+        const int grid_v = (int)roundf(pos_v) + grid_centre;
+
+        /* Scaled distance from nearest grid point. */
+        const int off_u = (int)roundf((roundf(pos_u) - pos_u) * oversample);
+        const int off_v = (int)roundf((roundf(pos_v) - pos_v) * oversample);
+
+        /* Get kernel support size and start offset. */
+        const int w_support = grid_w < num_w_planes ?
+                support[grid_w] : support[num_w_planes - 1];
+        const int kernel_start = grid_w < num_w_planes ?
+                wkernel_start[grid_w] : wkernel_start[num_w_planes - 1];
+
+        /* Catch points that would lie outside the grid. */
+        if (grid_u + w_support >= grid_size || grid_u - w_support < 0 ||
+                grid_v + w_support >= grid_size || grid_v - w_support < 0)
+        {
+            pt->grid_u = -1;
+            continue;
+        }
+        pt->grid_u = grid_u - u_start;
+        pt->grid_v = grid_v;
+        pt->off_u = off_u;
+        pt->off_v = off_v;
+        pt->support = w_support;
+        pt->kernel_start = kernel_start;
+        pt->conj = (ww_i > 0.0f) ? -1 : 1;
+        pt->vis_conj = vis_conj;
+
+        /* Sum the convolution kernel (real part only). */
+        const int conv_len = 2 * w_support + 1;
+        const int width = (oversample_h * conv_len + 1) * conv_len;
+        const int mid = kernel_start + (abs(off_u) + 1) * width - 1 - w_support;
+        const int stride = (off_u >= 0) ? 1 : -1;
+        for (j = -w_support; j <= w_support; ++j)
+        {
+            const int t = mid - abs(off_v + j * oversample) * conv_len;
+            for (k = -w_support; k <= w_support; ++k)
+            {
+                const int p = (t + stride * k) << 1;
+                sum += wkernel[p];
+            }
+        }
+        pt->norm = sum * weight[i];
+    }
+}
+
+
+static void oskar_grid_tiles_wproj2_f(
+        const oskar_GridBins* tiles,
+        const oskar_GridTilePoint* RESTRICT points,
+        const int oversample,
+        const float* RESTRICT wkernel,
+        const float* RESTRICT vis,
+        const float* RESTRICT weight,
+        const int grid_width,
+        float* RESTRICT grid)
+{
+    int i_tile = 0;
+    const int oversample_h = oversample / 2;
+#pragma omp parallel for schedule(dynamic, 1)
+    for (i_tile = 0; i_tile < tiles->num_bins; ++i_tile)
+    {
+        const int u0 = (i_tile % tiles->num_bins_u) * TILE_SIZE;
+        const int v0 = (i_tile / tiles->num_bins_u) * TILE_SIZE;
+        const size_t end = tiles->bin_start[i_tile + 1];
+        size_t i = tiles->bin_start[i_tile];
+        while (i < end)
+        {
+            int j = 0, k = 0, j_min = 0, j_max = 0, k_min = 0, k_max = 0;
+            size_t i_vis = tiles->bin_points[i];
+            const oskar_GridTilePoint* pt = &points[i_vis];
+            const float conv_conj = (float) pt->conj;
+            float v_re = 0.0f, v_im = 0.0f;
+
+            /* Get visibility data, summing any that follow with the same
+             * kernel at the same grid cell, so the kernel is used once. */
+            do
+            {
+                const float weight_i = weight[i_vis];
+                v_re += weight_i * vis[2 * i_vis];
+                v_im += weight_i * vis[2 * i_vis + 1] *
+                        points[i_vis].vis_conj;
+                if (++i == end) break;
+                i_vis = tiles->bin_points[i];
+            }
+            while (SAME_KERNEL(pt, (&points[i_vis])));
+
+            /* Convolve the part of this point in the tile onto the grid. */
+            const int w_support = pt->support;
+            const int conv_len = 2 * w_support + 1;
+            const int width = (oversample_h * conv_len + 1) * conv_len;
+            const int mid = pt->kernel_start +
+                    (abs(pt->off_u) + 1) * width - 1 - w_support;
+            const int stride = (pt->off_u >= 0) ? 1 : -1;
+            TILE_CLIP(pt, u0, v0, j_min, j_max, k_min, k_max)
+            for (j = j_min; j <= j_max; ++j)
+            {
+                const int t = mid - abs(pt->off_v + j * oversample) * conv_len;
+                size_t p1 = pt->grid_v + j;
+                p1 *= grid_width; /* Tested to avoid int overflow. */
+                p1 += pt->grid_u;
+                for (k = k_min; k <= k_max; ++k)
+                {
+                    const int p = (t + stride * k) << 1;
+                    const float c_re = wkernel[p];
+                    const float c_im = wkernel[p + 1] * conv_conj;
+                    const size_t p2 = (p1 + k) << 1;
+                    grid[p2]     += (v_re * c_re - v_im * c_im);
+                    grid[p2 + 1] += (v_im * c_re + v_re * c_im);
+                }
+            }
+        }
+    }
+}
+
+
+void oskar_grid_simple_tiled_d(
+        const int support,
+        const int oversample,
+        const double* RESTRICT conv_func,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT vis,
+        const double* RESTRICT weight,
+        const double cell_size_rad,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        double* RESTRICT grid,
+        int* status)
+{
+    oskar_GridBins tiles;
+    if (*status) return;
+    const int u_start = half_plane ? grid_size / 2 - support : 0;
+    const int grid_width = half_plane ?
+            grid_size / 2 + 1 + support : grid_size;
+    const size_t num_rows =
+            2 * oskar_grid_kernel_table_max_offset(oversample) + 1;
+    oskar_GridTilePoint* points = (oskar_GridTilePoint*) malloc(
+            num_points * sizeof(oskar_GridTilePoint));
+    double* table = (double*) malloc(
+            num_rows * (2 * support + 1) * sizeof(double));
+    double* table_sum = (double*) malloc(num_rows * sizeof(double));
+    if ((num_points > 0 && !points) || !table || !table_sum)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+    }
+    else
+    {
+        oskar_grid_kernel_table_d(support, oversample, conv_func,
+                table, table_sum);
+        oskar_grid_locate_simple_d(support, oversample, table_sum,
+                num_points, uu, vv, weight, cell_size_rad, grid_size,
+                half_plane, u_start, points);
+        oskar_grid_bins_create(num_points, points, oskar_grid_tile_range,
+                NUM_TILES(grid_width), NUM_TILES(grid_size), &tiles, status);
+        if (!*status)
+        {
+            oskar_grid_tiles_simple_d(&tiles, points, oversample, table,
+                    vis, weight, grid_width, grid);
+            oskar_grid_tiles_sum_norm(num_points, points, num_skipped, norm);
+        }
+        oskar_grid_bins_free(&tiles);
+    }
+    free(table_sum);
+    free(table);
+    free(points);
+}
+
+
+void oskar_grid_simple_tiled_f(
+        const int support,
+        const int oversample,
+        const float* RESTRICT conv_func,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT vis,
+        const float* RESTRICT weight,
+        const float cell_size_rad,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        float* RESTRICT grid,
+        int* status)
+{
+    oskar_GridBins tiles;
+    if (*status) return;
+    const int u_start = half_plane ? grid_size / 2 - support : 0;
+    const int grid_width = half_plane ?
+            grid_size / 2 + 1 + support : grid_size;
+    const size_t num_rows =
+            2 * oskar_grid_kernel_table_max_offset(oversample) + 1;
+    oskar_GridTilePoint* points = (oskar_GridTilePoint*) malloc(
+            num_points * sizeof(oskar_GridTilePoint));
+    float* table = (float*) malloc(
+            num_rows * (2 * support + 1) * sizeof(float));
+    double* table_sum = (double*) malloc(num_rows * sizeof(double));
+    if ((num_points > 0 && !points) || !table || !table_sum)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+    }
+    else
+    {
+        oskar_grid_kernel_table_f(support, oversample, conv_func,
+                table, table_sum);
+        oskar_grid_locate_simple_f(support, oversample, table_sum,
+                num_points, uu, vv, weight, cell_size_rad, grid_size,
+                half_plane, u_start, points);
+        oskar_grid_bins_create(num_points, points, oskar_grid_tile_range,
+                NUM_TILES(grid_width), NUM_TILES(grid_size), &tiles, status);
+        if (!*status)
+        {
+            oskar_grid_tiles_simple_f(&tiles, points, oversample, table,
+                    vis, weight, grid_width, grid);
+            oskar_grid_tiles_sum_norm(num_points, points, num_skipped, norm);
+        }
+        oskar_grid_bins_free(&tiles);
+    }
+    free(table_sum);
+    free(table);
+    free(points);
+}
+
+
+void oskar_grid_wproj2_tiled_d(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const double* RESTRICT wkernel,
+        const size_t num_points,
+        const double* RESTRICT uu,
+        const double* RESTRICT vv,
+        const double* RESTRICT ww,
+        const double* RESTRICT vis,
+        const double* RESTRICT weight,
+        const double cell_size_rad,
+        const double w_scale,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        double* RESTRICT grid,
+        int* status)
+{
+    oskar_GridBins tiles;
+    size_t i = 0;
+    int max_support = 0;
+    if (*status) return;
+    for (i = 0; i < num_w_planes; ++i)
+    {
+        if (support[i] > max_support) max_support = support[i];
+    }
+    const int u_start = half_plane ? grid_size / 2 - max_support : 0;
+    const int grid_width = half_plane ?
+            grid_size / 2 + 1 + max_support : grid_size;
+    oskar_GridTilePoint* points = (oskar_GridTilePoint*) malloc(
+            num_points * sizeof(oskar_GridTilePoint));
+    if (num_points > 0 && !points)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    oskar_grid_locate_wproj2_d(num_w_planes, support, oversample,
+            wkernel_start, wkernel, num_points, uu, vv, ww, weight,
+            cell_size_rad, w_scale, grid_size, half_plane, u_start, points);
+    oskar_grid_bins_create(num_points, points, oskar_grid_tile_range,
+            NUM_TILES(grid_width), NUM_TILES(grid_size), &tiles, status);
+    if (!*status)
+    {
+        oskar_grid_tiles_wproj2_d(&tiles, points, oversample, wkernel,
+                vis, weight, grid_width, grid);
+        oskar_grid_tiles_sum_norm(num_points, points, num_skipped, norm);
+    }
+    oskar_grid_bins_free(&tiles);
+    free(points);
+}
+
+
+void oskar_grid_wproj2_tiled_f(
+        const size_t num_w_planes,
+        const int* RESTRICT support,
+        const int oversample,
+        const int* wkernel_start,
+        const float* RESTRICT wkernel,
+        const size_t num_points,
+        const float* RESTRICT uu,
+        const float* RESTRICT vv,
+        const float* RESTRICT ww,
+        const float* RESTRICT vis,
+        const float* RESTRICT weight,
+        const float cell_size_rad,
+        const float w_scale,
+        const int grid_size,
+        const int half_plane,
+        size_t* RESTRICT num_skipped,
+        double* RESTRICT norm,
+        float* RESTRICT grid,
+        int* status)
+{
+    oskar_GridBins tiles;
+    size_t i = 0;
+    int max_support = 0;
+    if (*status) return;
+    for (i = 0; i < num_w_planes; ++i)
+    {
+        if (support[i] > max_support) max_support = support[i];
+    }
+    const int u_start = half_plane ? grid_size / 2 - max_support : 0;
+    const int grid_width = half_plane ?
+            grid_size / 2 + 1 + max_support : grid_size;
+    oskar_GridTilePoint* points = (oskar_GridTilePoint*) malloc(
+            num_points * sizeof(oskar_GridTilePoint));
+    if (num_points > 0 && !points)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    oskar_grid_locate_wproj2_f(num_w_planes, support, oversample,
+            wkernel_start, wkernel, num_points, uu, vv, ww, weight,
+            cell_size_rad, w_scale, grid_size, half_plane, u_start, points);
+    oskar_grid_bins_create(num_points, points, oskar_grid_tile_range,
+            NUM_TILES(grid_width), NUM_TILES(grid_size), &tiles, status);
+    if (!*status)
+    {
+        oskar_grid_tiles_wproj2_f(&tiles, points, oversample, wkernel,
+                vis, weight, grid_width, grid);
+        oskar_grid_tiles_sum_norm(num_points, points, num_skipped, norm);
+    }
+    oskar_grid_bins_free(&tiles);
+    free(points);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,18 +1,45 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "imager/oskar_grid_weights.h"
+#include "imager/private_grid_bins.h"
 #include "math/oskar_kahan_sum.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Number of grid rows in each band updated by one thread. */
+#define BAND_ROWS 16
+
+/* Location of a point on the grid. */
+struct oskar_GridWeightPoint
+{
+    size_t cell; /* Grid cell index. */
+    int band; /* Band of grid rows (-1 if skipped). */
+};
+typedef struct oskar_GridWeightPoint oskar_GridWeightPoint;
+
+/* Returns the band containing point i. */
+static int oskar_grid_weights_band(const void* points, size_t i,
+        int* u0, int* u1, int* v0, int* v1)
+{
+    const int band = ((const oskar_GridWeightPoint*) points)[i].band;
+    if (band < 0) return 0;
+    *u0 = *u1 = 0;
+    *v0 = *v1 = band;
+    return 1;
+}
+
 void oskar_grid_weights_write_d(const size_t num_points,
         const double* RESTRICT uu, const double* RESTRICT vv,
         const double* RESTRICT weight, const double cell_size_rad,
@@ -53,12 +80,12 @@ void oskar_grid_weights_read_d(const size_t num_points,
         const double cell_size_rad, const int grid_size,
         size_t* RESTRICT num_skipped, const double* RESTRICT grid)
 {
-    size_t i = 0;
+    size_t i = 0, skipped = 0;
     const int grid_centre = grid_size / 2;
     const double grid_scale = grid_size * cell_size_rad;
 
     /* Look up gridded weight density at each point location. */
-    *num_skipped = 0;
+#pragma omp parallel for reduction(+:skipped)
     for (i = 0; i < num_points; ++i)
     {
         /* Convert UV coordinates to grid coordinates. */
@@ -72,13 +99,15 @@ void oskar_grid_weights_read_d(const size_t num_points,
         if (grid_u >= grid_size || grid_u < 0 ||
                 grid_v >= grid_size || grid_v < 0)
         {
-            *num_skipped += 1;
+            weight_out[i] = 0;
+            skipped++;
             continue;
         }
 
         /* Calculate new weight based on gridded point density. */
         weight_out[i] = (grid[t] != 0.0) ? weight_in[i] / grid[t] : 0.0;
     }
+    *num_skipped = skipped;
 }
 
 void oskar_grid_weights_write_f(const size_t num_points,
@@ -121,12 +150,12 @@ void oskar_grid_weights_read_f(const size_t num_points,
         const float cell_size_rad, const int grid_size,
         size_t* RESTRICT num_skipped, const float* RESTRICT grid)
 {
-    size_t i = 0;
+    size_t i = 0, skipped = 0;
     const int grid_centre = grid_size / 2;
     const float grid_scale = grid_size * cell_size_rad;
 
     /* Look up gridded weight density at each point location. */
-    *num_skipped = 0;
+#pragma omp parallel for reduction(+:skipped)
     for (i = 0; i < num_points; ++i)
     {
         /* Convert UV coordinates to grid coordinates. */
@@ -140,13 +169,134 @@ void oskar_grid_weights_read_f(const size_t num_points,
         if (grid_u >= grid_size || grid_u < 0 ||
                 grid_v >= grid_size || grid_v < 0)
         {
-            *num_skipped += 1;
+            weight_out[i] = 0;
+            skipped++;
             continue;
         }
 
         /* Calculate new weight based on gridded point density. */
         weight_out[i] = (grid[t] != 0.0) ? weight_in[i] / grid[t] : 0.0;
     }
+    *num_skipped = skipped;
+}
+
+void oskar_grid_weights_write_tiled_d(const size_t num_points,
+        const double* RESTRICT uu, const double* RESTRICT vv,
+        const double* RESTRICT weight, const double cell_size_rad,
+        const int grid_size, size_t* RESTRICT num_skipped,
+        double* RESTRICT grid, int* status)
+{
+    oskar_GridBins bands;
+    size_t i = 0, skipped = 0;
+    int band = 0;
+    if (*status) return;
+    const int grid_centre = grid_size / 2;
+    const int num_bands = (grid_size + BAND_ROWS - 1) / BAND_ROWS;
+    const double grid_scale = grid_size * cell_size_rad;
+    oskar_GridWeightPoint* points = (oskar_GridWeightPoint*) malloc(
+            num_points * sizeof(oskar_GridWeightPoint));
+    if (num_points > 0 && !points)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+
+    /* Find the grid cell and band of each point. */
+#pragma omp parallel for schedule(static) reduction(+:skipped)
+    for (i = 0; i < num_points; ++i)
+    {
+        const int grid_u = (int)round(-uu[i] * grid_scale) + grid_centre;
+        const int grid_v = (int)round(vv[i] * grid_scale) + grid_centre;
+        if (grid_u >= grid_size || grid_u < 0 ||
+                grid_v >= grid_size || grid_v < 0)
+        {
+            points[i].band = -1;
+            skipped++;
+            continue;
+        }
+        points[i].cell = (size_t) grid_v * grid_size + grid_u;
+        points[i].band = grid_v / BAND_ROWS;
+    }
+    *num_skipped = skipped;
+
+    /* Add the weights in each band, in their original order. */
+    oskar_grid_bins_create(num_points, points, oskar_grid_weights_band,
+            1, num_bands, &bands, status);
+    if (!*status)
+    {
+#pragma omp parallel for schedule(dynamic, 1)
+        for (band = 0; band < num_bands; ++band)
+        {
+            size_t j = 0;
+            for (j = bands.bin_start[band]; j < bands.bin_start[band + 1]; ++j)
+            {
+                const size_t k = bands.bin_points[j], t = points[k].cell;
+                grid[t] += weight[k];
+            }
+        }
+    }
+    oskar_grid_bins_free(&bands);
+    free(points);
+}
+
+void oskar_grid_weights_write_tiled_f(const size_t num_points,
+        const float* RESTRICT uu, const float* RESTRICT vv,
+        const float* RESTRICT weight, const float cell_size_rad,
+        const int grid_size, size_t* RESTRICT num_skipped,
+        float* RESTRICT grid, float* RESTRICT grid_guard, int* status)
+{
+    oskar_GridBins bands;
+    size_t i = 0, skipped = 0;
+    int band = 0;
+    if (*status) return;
+    const int grid_centre = grid_size / 2;
+    const int num_bands = (grid_size + BAND_ROWS - 1) / BAND_ROWS;
+    const float grid_scale = grid_size * cell_size_rad;
+    oskar_GridWeightPoint* points = (oskar_GridWeightPoint*) malloc(
+            num_points * sizeof(oskar_GridWeightPoint));
+    if (num_points > 0 && !points)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+
+    /* Find the grid cell and band of each point. */
+#pragma omp parallel for schedule(static) reduction(+:skipped)
+    for (i = 0; i < num_points; ++i)
+    {
+        const int grid_u = (int)roundf(-uu[i] * grid_scale) + grid_centre;
+        const int grid_v = (int)roundf(vv[i] * grid_scale) + grid_centre;
+        if (grid_u >= grid_size || grid_u < 0 ||
+                grid_v >= grid_size || grid_v < 0)
+        {
+            points[i].band = -1;
+            skipped++;
+            continue;
+        }
+        points[i].cell = (size_t) grid_v * grid_size + grid_u;
+        points[i].band = grid_v / BAND_ROWS;
+    }
+    *num_skipped = skipped;
+
+    /* Add the weights in each band, in their original order,
+     * using Kahan summation. */
+    oskar_grid_bins_create(num_points, points, oskar_grid_weights_band,
+            1, num_bands, &bands, status);
+    if (!*status)
+    {
+#pragma omp parallel for schedule(dynamic, 1)
+        for (band = 0; band < num_bands; ++band)
+        {
+            size_t j = 0;
+            for (j = bands.bin_start[band]; j < bands.bin_start[band + 1]; ++j)
+            {
+                const size_t k = bands.bin_points[j], t = points[k].cell;
+                OSKAR_KAHAN_SUM(float, grid[t], weight[k], grid_guard[t]);
+            }
+        }
+    }
+    oskar_grid_bins_free(&bands);
+    free(points);
 }
 
 #ifdef __cplusplus
@@ -32,6 +32,7 @@ const char* oskar_imager_algorithm(const oskar_Imager* h)
     {
     case OSKAR_ALGORITHM_FFT:    return "FFT";
     case OSKAR_ALGORITHM_WPROJ:  return "W-projection";
+    case OSKAR_ALGORITHM_WSTACK: return "W-stacking";
     case OSKAR_ALGORITHM_DFT_2D: return "DFT 2D";
     case OSKAR_ALGORITHM_DFT_3D: return "DFT 3D";
     default:                     return "";
@@ -51,6 +52,12 @@ int oskar_imager_channel_snapshots(const oskar_Imager* h)
 }
 
 
+double oskar_imager_coord_cache_mb(const oskar_Imager* h)
+{
+    return h->coord_cache_mb;
+}
+
+
 int oskar_imager_coords_only(const oskar_Imager* h)
 {
     return h->coords_only;
@@ -63,6 +70,23 @@ int oskar_imager_fft_on_gpu(const oskar_Imager* h)
 }
 
 
+const char* oskar_imager_fits_compression(const oskar_Imager* h)
+{
+    switch (h->fits_compression)
+    {
+    case RICE_1: return "Rice";
+    case GZIP_2: return "GZIP";
+    default:     return "None";
+    }
+}
+
+
+double oskar_imager_fits_quantize_level(const oskar_Imager* h)
+{
+    return h->fits_quantize_level;
+}
+
+
 double oskar_imager_fov(const oskar_Imager* h)
 {
     return h->fov_deg;
@@ -87,12 +111,30 @@ int oskar_imager_generate_w_kernels_on_gpu(const oskar_Imager* h)
 }
 
 
+double oskar_imager_grid_memory_mb(const oskar_Imager* h)
+{
+    return h->grid_memory_mb;
+}
+
+
 int oskar_imager_grid_on_gpu(const oskar_Imager* h)
 {
     return h->grid_on_gpu;
 }
 
 
+const char* oskar_imager_grid_scratch_dir(const oskar_Imager* h)
+{
+    return h->grid_scratch_dir;
+}
+
+
+int oskar_imager_half_plane(const oskar_Imager* h)
+{
+    return h->half_plane;
+}
+
+
 int oskar_imager_image_size(const oskar_Imager* h)
 {
     return h->image_size;
@@ -165,7 +207,8 @@ int oskar_imager_plane_size(oskar_Imager* h)
 {
     if (h->grid_size == 0)
     {
-        if (h->algorithm == OSKAR_ALGORITHM_WPROJ)
+        if (h->algorithm == OSKAR_ALGORITHM_WPROJ ||
+                h->algorithm == OSKAR_ALGORITHM_WSTACK)
         {
             (void) oskar_imager_composite_nearest_even(h->image_padding *
                     ((double)(h->image_size)) - 0.5, 0, &h->grid_size);
@@ -216,6 +259,15 @@ void oskar_imager_set_algorithm(oskar_Imager* h, const char* type,
         h->support = 3;
         h->oversample = 100;
     }
+    else if (!strncmp(type, "W-s", 3) || !strncmp(type, "W-S", 3) ||
+            !strncmp(type, "w-s", 3))
+    {
+        h->algorithm = OSKAR_ALGORITHM_WSTACK;
+        h->kernel_type = 'S';
+        h->support = 3;
+        h->oversample = 100;
+        h->image_padding = 1.2;
+    }
     else if (!strncmp(type, "W", 1) || !strncmp(type, "w", 1))
     {
         h->algorithm = OSKAR_ALGORITHM_WPROJ;
@@ -258,6 +310,12 @@ void oskar_imager_set_channel_snapshots(oskar_Imager* h, int value)
 }
 
 
+void oskar_imager_set_coord_cache_mb(oskar_Imager* h, double value)
+{
+    h->coord_cache_mb = value;
+}
+
+
 void oskar_imager_set_coords_only(oskar_Imager* h, int flag)
 {
     h->coords_only = flag;
@@ -280,7 +338,8 @@ void oskar_imager_set_coords_only(oskar_Imager* h, int flag)
         }
 
         /* Calculate required number of w-planes if not set. */
-        if ((h->ww_max > 0.0) && (h->num_w_planes < 1))
+        if ((h->ww_max > 0.0) && (h->num_w_planes < 1) &&
+                h->algorithm == OSKAR_ALGORITHM_WPROJ)
         {
             double max_uvw = 0.0, ww_mid = 0.0;
             max_uvw = 1.05 * h->ww_max;
@@ -310,6 +369,35 @@ void oskar_imager_set_direction(oskar_Imager* h, double ra_deg, double dec_deg)
 }
 
 
+void oskar_imager_set_fits_compression(oskar_Imager* h, const char* type,
+        int* status)
+{
+    if (*status || !type) return;
+    if (!strncmp(type, "N", 1) || !strncmp(type, "n", 1))
+    {
+        h->fits_compression = 0;
+    }
+    else if (!strncmp(type, "R", 1) || !strncmp(type, "r", 1))
+    {
+        h->fits_compression = RICE_1;
+    }
+    else if (!strncmp(type, "G", 1) || !strncmp(type, "g", 1))
+    {
+        h->fits_compression = GZIP_2;
+    }
+    else
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+    }
+}
+
+
+void oskar_imager_set_fits_quantize_level(oskar_Imager* h, double value)
+{
+    h->fits_quantize_level = value;
+}
+
+
 void oskar_imager_set_fov(oskar_Imager* h, double fov_deg)
 {
     h->set_cellsize = 0;
@@ -426,12 +514,41 @@ void oskar_imager_set_grid_kernel(oskar_Imager* h, const char* type,
 }
 
 
+void oskar_imager_set_grid_memory_mb(oskar_Imager* h, double value)
+{
+    h->grid_memory_mb = value;
+}
+
+
 void oskar_imager_set_grid_on_gpu(oskar_Imager* h, int value)
 {
     h->grid_on_gpu = value;
 }
 
 
+void oskar_imager_set_grid_scratch_dir(oskar_Imager* h, const char* dir_path)
+{
+    size_t len = 0;
+    free(h->grid_scratch_dir);
+    h->grid_scratch_dir = 0;
+    if (dir_path) len = strlen(dir_path);
+    if (len > 0)
+    {
+        h->grid_scratch_dir = (char*) calloc(1 + len, 1);
+        if (h->grid_scratch_dir)
+        {
+            memcpy(h->grid_scratch_dir, dir_path, len);
+        }
+    }
+}
+
+
+void oskar_imager_set_half_plane(oskar_Imager* h, int value)
+{
+    h->half_plane = value;
+}
+
+
 void oskar_imager_set_image_size(oskar_Imager* h, int size, int* status)
 {
     oskar_imager_set_size(h, size, status);
@@ -785,6 +902,24 @@ void oskar_imager_set_num_w_planes(oskar_Imager* h, int value)
 }
 
 
+void oskar_imager_set_w_kernel_cache_dir(oskar_Imager* h,
+        const char* dir_path)
+{
+    size_t len = 0;
+    free(h->w_kernel_cache_dir);
+    h->w_kernel_cache_dir = 0;
+    if (dir_path) len = strlen(dir_path);
+    if (len > 0)
+    {
+        h->w_kernel_cache_dir = (char*) calloc(1 + len, 1);
+        if (h->w_kernel_cache_dir)
+        {
+            memcpy(h->w_kernel_cache_dir, dir_path, len);
+        }
+    }
+}
+
+
 void oskar_imager_set_weighting(oskar_Imager* h, const char* type, int* status)
 {
     if (*status || !type) return;
@@ -839,6 +974,12 @@ double oskar_imager_uv_filter_min(const oskar_Imager* h)
 }
 
 
+const char* oskar_imager_w_kernel_cache_dir(const oskar_Imager* h)
+{
+    return h->w_kernel_cache_dir;
+}
+
+
 const char* oskar_imager_weighting(const oskar_Imager* h)
 {
     switch (h->weighting)
@@ -9,6 +9,7 @@
 #include "imager/private_imager_init_dft.h"
 #include "imager/private_imager_init_fft.h"
 #include "imager/private_imager_init_wproj.h"
+#include "imager/private_imager_init_wstack.h"
 #include "utility/oskar_timer.h"
 
 #include <stdlib.h>
@@ -55,6 +56,9 @@ void oskar_imager_check_init(oskar_Imager* h, int* status)
     case OSKAR_ALGORITHM_WPROJ:
         oskar_imager_init_wproj(h, status);
         break;
+    case OSKAR_ALGORITHM_WSTACK:
+        oskar_imager_init_wstack(h, status);
+        break;
     default:
         *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
     }
@@ -53,12 +53,14 @@ oskar_Imager* oskar_imager_create(int imager_precision, int* status)
     h->tmr_rotate = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_filter = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_read = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    h->tmr_read_io = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_write = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_overall = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_copy_convert = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_coord_scan = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_weights_grid = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_weights_lookup = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    h->tmr_sort = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->mutex = oskar_mutex_create();
     h->log = oskar_log_create(OSKAR_LOG_MESSAGE, OSKAR_LOG_WARNING);
 
@@ -74,6 +76,12 @@ oskar_Imager* oskar_imager_create(int imager_precision, int* status)
             OSKAR_CPU, 0, status);
     h->weight_im   = oskar_mem_create(imager_precision, OSKAR_CPU, 0, status);
     h->weight_tmp  = oskar_mem_create(imager_precision, OSKAR_CPU, 0, status);
+    h->vis_tmp     = oskar_mem_create(imager_precision | OSKAR_COMPLEX,
+            OSKAR_CPU, 0, status);
+    h->w_key       = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, status);
+    h->w_index     = oskar_mem_create(OSKAR_CHAR, OSKAR_CPU, 0, status);
+    h->w_key_tmp   = oskar_mem_create(OSKAR_INT, OSKAR_CPU, 0, status);
+    h->w_index_tmp = oskar_mem_create(OSKAR_CHAR, OSKAR_CPU, 0, status);
     h->time_im     = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 0, status);
 
     /* Check data type. */
@@ -99,6 +107,8 @@ oskar_Imager* oskar_imager_create(int imager_precision, int* status)
     oskar_imager_set_fov(h, 1.0);
     oskar_imager_set_size(h, 256, status);
     oskar_imager_set_uv_filter_max(h, DBL_MAX);
+    oskar_imager_set_coord_cache_mb(h, 1024.0);
+    oskar_imager_set_fits_quantize_level(h, 16.0);
     return h;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -7,15 +7,18 @@
 #include "imager/oskar_imager.h"
 
 #include "imager/oskar_grid_correction.h"
-#include "imager/oskar_grid_functions_pillbox.h"
-#include "imager/oskar_grid_functions_spheroidal.h"
 #include "imager/private_imager_free_device_data.h"
+#include "imager/private_imager_generate_corr_func.h"
+#include "imager/private_imager_grid_scratch.h"
+#include "imager/private_imager_half_plane.h"
+#include "imager/private_imager_update_plane_wstack.h"
 #include "math/oskar_fft.h"
 #include "math/oskar_fftphase.h"
 #include "mem/oskar_mem.h"
 #include "utility/oskar_device.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_get_memory_usage.h"
+#include "utility/oskar_thread.h"
 #include "utility/oskar_timer.h"
 
 #include <fitsio.h>
@@ -27,15 +30,108 @@
 extern "C" {
 #endif
 
+/*
+ * Image planes are written to the FITS files by a separate thread, so that
+ * each plane can be compressed and written while the next one is being
+ * finalised. Planes are written in order, as soon as they are ready.
+ * Written planes are released from memory by the main thread, which owns
+ * the scratch state.
+ */
+typedef struct WriteQueue
+{
+    oskar_ConditionVar* cond;
+    oskar_Thread* thread;
+    oskar_Imager* h;
+    int num_ready, num_written, num_released, stop, status;
+} WriteQueue;
+
 static void write_plane(oskar_Imager* h, oskar_Mem* plane,
         int c, int p, int* status);
 
+static void* write_thread(void* arg)
+{
+    WriteQueue* q = (WriteQueue*) arg;
+    oskar_Imager* h = q->h;
+    int i = 0;
+    for (i = 0; i < h->num_planes; ++i)
+    {
+        int ready = 0, status = 0;
+
+        /* Wait for the plane to be finalised. */
+        oskar_condition_lock(q->cond);
+        while (!q->stop && q->num_ready <= i)
+        {
+            oskar_condition_wait(q->cond);
+        }
+        ready = (q->num_ready > i);
+        oskar_condition_unlock(q->cond);
+        if (!ready) break;
+
+        /* Write the plane, and pass any error back to the imager. */
+        oskar_timer_resume(h->tmr_write);
+        write_plane(h, h->planes[i], i / h->num_im_pols, i % h->num_im_pols,
+                &status);
+        oskar_timer_pause(h->tmr_write);
+        oskar_condition_lock(q->cond);
+        if (status)
+        {
+            q->status = status;
+        }
+        else
+        {
+            q->num_written = i + 1;
+        }
+        oskar_condition_unlock(q->cond);
+        if (status) break;
+    }
+    return 0;
+}
+
+static void write_queue_push(WriteQueue* q, int num_ready)
+{
+    if (!q->thread) return;
+    oskar_condition_lock(q->cond);
+    q->num_ready = num_ready;
+    oskar_condition_notify_all(q->cond);
+    oskar_condition_unlock(q->cond);
+}
+
+/* Releases from memory the planes that have been written. */
+static void write_queue_release(WriteQueue* q)
+{
+    int num_written = 0;
+    if (!q->thread) return;
+    oskar_condition_lock(q->cond);
+    num_written = q->num_written;
+    oskar_condition_unlock(q->cond);
+    for (; q->num_released < num_written; ++q->num_released)
+    {
+        oskar_imager_grid_scratch_release(q->h, q->num_released);
+    }
+}
+
+/* Waits for all the planes that are ready to be written. */
+static void write_queue_finish(WriteQueue* q, int* status)
+{
+    if (!q->thread) return;
+    oskar_condition_lock(q->cond);
+    q->stop = 1;
+    oskar_condition_notify_all(q->cond);
+    oskar_condition_unlock(q->cond);
+    oskar_thread_join(q->thread);
+    write_queue_release(q);
+    oskar_thread_free(q->thread);
+    oskar_condition_free(q->cond);
+    q->thread = 0;
+    if (!*status) *status = q->status;
+}
+
 
 void oskar_imager_finalise(oskar_Imager* h,
         int num_output_images, oskar_Mem** output_images,
         int num_output_grids, oskar_Mem** output_grids, int* status)
 {
-    int c = 0, p = 0, i = 0;
+    int i = 0;
     size_t j = 0, log_size = 0, length = 0;
     char* log_data = 0;
 
@@ -103,6 +199,14 @@ void oskar_imager_finalise(oskar_Imager* h,
         oskar_mem_free(temp, status);
     }
 
+    /* Add any resident W-stacking layers to their planes. */
+    if (h->algorithm == OSKAR_ALGORITHM_WSTACK)
+    {
+        oskar_timer_resume(h->tmr_grid_finalise);
+        oskar_imager_flush_wstack_layers(h, 0, status);
+        oskar_timer_pause(h->tmr_grid_finalise);
+    }
+
     /* Copy grids to output grid planes if given. */
     for (i = 0; (i < h->num_planes) && (i < num_output_grids); ++i)
     {
@@ -127,8 +231,18 @@ void oskar_imager_finalise(oskar_Imager* h,
     const size_t num_pix = (size_t)h->image_size * (size_t)h->image_size;
     if (h->fits_file[0] || output_images)
     {
-        /* Finalise all the planes. */
-        for (i = 0; i < h->num_planes; ++i)
+        /* Start the writer thread if required. */
+        WriteQueue queue;
+        memset(&queue, 0, sizeof(WriteQueue));
+        if (h->fits_file[0])
+        {
+            queue.h = h;
+            queue.cond = oskar_condition_create();
+            queue.thread = oskar_thread_create(write_thread, &queue, 0);
+        }
+
+        /* Finalise all the planes, and write each one when it is ready. */
+        for (i = 0; i < h->num_planes && !*status; ++i)
         {
             oskar_Mem *plane = h->planes[i];
             if (h->grid_on_gpu && h->num_gpus > 0 && !(
@@ -144,6 +258,16 @@ void oskar_imager_finalise(oskar_Imager* h,
             }
             oskar_imager_trim_image(h, h->planes[i],
                     oskar_imager_plane_size(h), h->image_size, status);
+            if (*status) break;
+            if (queue.thread)
+            {
+                write_queue_push(&queue, i + 1);
+                write_queue_release(&queue);
+            }
+            else
+            {
+                oskar_imager_grid_scratch_release(h, i);
+            }
         }
 
         /* Copy images to output image planes if given. */
@@ -160,16 +284,8 @@ void oskar_imager_finalise(oskar_Imager* h,
                     num_pix * oskar_mem_element_size(h->imager_prec));
         }
 
-        /* Write to files if required. */
-        oskar_timer_resume(h->tmr_write);
-        for (c = 0, i = 0; c < h->num_im_channels; ++c)
-        {
-            for (p = 0; p < h->num_im_pols; ++p, ++i)
-            {
-                write_plane(h, h->planes[i], c, p, status);
-            }
-        }
-        oskar_timer_pause(h->tmr_write);
+        /* Wait for the planes to be written. */
+        write_queue_finish(&queue, status);
     }
 
     /* Record memory usage. */
@@ -189,11 +305,13 @@ void oskar_imager_finalise(oskar_Imager* h,
     const double t_select_scale = oskar_timer_elapsed(h->tmr_select_scale);
     const double t_rotate = oskar_timer_elapsed(h->tmr_rotate);
     const double t_filter = oskar_timer_elapsed(h->tmr_filter);
+    const double t_sort = oskar_timer_elapsed(h->tmr_sort);
     const double t_grid_update = oskar_timer_elapsed(h->tmr_grid_update);
     const double t_wt_grid = oskar_timer_elapsed(h->tmr_weights_grid);
     const double t_wt_lookup = oskar_timer_elapsed(h->tmr_weights_lookup);
     const double t_grid_finalise = oskar_timer_elapsed(h->tmr_grid_finalise);
     const double t_read = oskar_timer_elapsed(h->tmr_read);
+    const double t_read_io = oskar_timer_elapsed(h->tmr_read_io);
     const double t_write = oskar_timer_elapsed(h->tmr_write);
     if (t_scan > 0.0)
     {
@@ -225,6 +343,11 @@ void oskar_imager_finalise(oskar_Imager* h,
         oskar_log_value(h->log, 'M', 0,
             "Filter visibility data", "%.3f s", t_filter);
     }
+    if (t_sort > 0.0)
+    {
+        oskar_log_value(h->log, 'M', 0,
+            "Sort visibility data by W", "%.3f s", t_sort);
+    }
     if (t_grid_update > 0.0)
     {
         oskar_log_value(h->log, 'M', 0,
@@ -248,7 +371,12 @@ void oskar_imager_finalise(oskar_Imager* h,
     if (t_read > 0.0)
     {
         oskar_log_value(h->log, 'M', 0,
-            "Read visibility data", "%.3f s", t_read);
+            "Wait for visibility data", "%.3f s", t_read);
+    }
+    if (t_read_io > 0.0)
+    {
+        oskar_log_value(h->log, 'M', 0,
+            "Read visibility data", "%.3f s", t_read_io);
     }
     if (t_write > 0.0)
     {
@@ -275,7 +403,9 @@ void oskar_imager_finalise(oskar_Imager* h,
         if (h->num_w_planes > 0)
         {
             oskar_log_value(h->log, 'M', 0,
-                    "W-projection planes", "%d", h->num_w_planes);
+                    h->algorithm == OSKAR_ALGORITHM_WSTACK ?
+                    "W-stacking layers" : "W-projection planes",
+                    "%d", h->num_w_planes);
         }
         if (h->fov_deg > 0.1)
         {
@@ -357,6 +487,14 @@ void oskar_imager_finalise_plane(oskar_Imager* h,
 {
     if (*status) return;
 
+    /* Add any resident W-stacking layers to the plane. */
+    if (h->algorithm == OSKAR_ALGORITHM_WSTACK)
+    {
+        oskar_timer_resume(h->tmr_grid_finalise);
+        oskar_imager_flush_wstack_layers(h, plane, status);
+        oskar_timer_pause(h->tmr_grid_finalise);
+    }
+
     /* Apply normalisation. */
     if (plane_norm > 0.0 || plane_norm < 0.0)
     {
@@ -382,58 +520,51 @@ void oskar_imager_finalise_plane(oskar_Imager* h,
 
     /* Check plane size is as expected. */
     const int size = oskar_imager_plane_size(h);
-    if (oskar_mem_length(plane) != ((size_t)size * (size_t)size))
+    const int half_width = oskar_imager_half_plane_width(h);
+    if (oskar_mem_length(plane) != ((size_t)size *
+            (size_t)(half_width ? half_width : size)))
     {
         *status = OSKAR_ERR_DIMENSION_MISMATCH;
         return;
     }
 
-    /* Perform FFT shift of the input grid. */
+    /* Generate grid correction function if required. */
     oskar_timer_resume(h->tmr_grid_finalise);
-    const int fft_loc = (h->fft_on_gpu && h->num_gpus > 0) ?
-            h->dev_loc : OSKAR_CPU;
-    if (fft_loc != OSKAR_CPU)
-    {
-        oskar_device_set(h->dev_loc, h->gpu_ids[0], status);
-    }
-    oskar_fftphase(size, size, plane, status);
+    oskar_imager_generate_corr_func(h, status);
 
-    /* Call FFT. */
-    if (!h->fft)
+    /* Half-plane grids are transformed straight to a real image. */
+    if (half_width)
     {
-        h->fft = oskar_fft_create(h->imager_prec, fft_loc, 2, size, 0, status);
+        oskar_imager_finalise_half_plane(h, h->corr_func, plane, status);
+        oskar_timer_pause(h->tmr_grid_finalise);
+        return;
     }
-    oskar_fft_exec(h->fft, plane, status);
 
-    /* Generate grid correction function if required. */
-    if (!h->corr_func)
+    /* Perform FFT shift of the input grid.
+     * W-stacking planes are already in the image domain. */
+    if (h->algorithm != OSKAR_ALGORITHM_WSTACK)
     {
-        oskar_Mem* corr_func = 0;
-        corr_func = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, size, status);
-        if (h->algorithm != OSKAR_ALGORITHM_FFT)
+        const int fft_loc = (h->fft_on_gpu && h->num_gpus > 0) ?
+            h->dev_loc : OSKAR_CPU;
+        if (fft_loc != OSKAR_CPU)
         {
-            oskar_grid_correction_function_spheroidal(size, h->oversample,
-                    oskar_mem_double(corr_func, status));
+            oskar_device_set(h->dev_loc, h->gpu_ids[0], status);
         }
-        else
+        oskar_fftphase(size, size, plane, status);
+
+        /* Call FFT. */
+        if (!h->fft)
         {
-            if (h->kernel_type == 'S')
-            {
-                oskar_grid_correction_function_spheroidal(size, 0,
-                        oskar_mem_double(corr_func, status));
-            }
-            else if (h->kernel_type == 'P')
-            {
-                oskar_grid_correction_function_pillbox(size,
-                        oskar_mem_double(corr_func, status));
-            }
+            h->fft = oskar_fft_create(h->imager_prec, fft_loc, 2, size, 0,
+                    status);
         }
-        h->corr_func = oskar_mem_convert_precision(corr_func,
-                h->imager_prec, status);
+        oskar_fft_exec(h->fft, plane, status);
+
+        /* FFT shift again. */
+        oskar_fftphase(size, size, plane, status);
     }
 
-    /* FFT shift again, and apply grid correction. */
-    oskar_fftphase(size, size, plane, status);
+    /* Apply grid correction. */
     oskar_grid_correction(size, h->corr_func, plane, status);
     oskar_timer_pause(h->tmr_grid_finalise);
 }
@@ -444,9 +575,10 @@ void oskar_imager_trim_image(oskar_Imager* h, oskar_Mem* plane,
 {
     if (*status) return;
 
-    /* Get the real part only, if the plane is complex. */
+    /* Get the real part only, if the plane is complex.
+     * Images from half-plane grids are already packed as real values. */
     oskar_timer_resume(h->tmr_grid_finalise);
-    if (oskar_mem_is_complex(plane))
+    if (oskar_mem_is_complex(plane) && !oskar_imager_half_plane_width(h))
     {
         size_t i = 0;
         const size_t num_cells = (size_t)plane_size * (size_t)plane_size;
@@ -30,6 +30,11 @@ void oskar_imager_free(oskar_Imager* h, int* status)
     oskar_mem_free(h->vis_im, status);
     oskar_mem_free(h->weight_im, status);
     oskar_mem_free(h->weight_tmp, status);
+    oskar_mem_free(h->vis_tmp, status);
+    oskar_mem_free(h->w_key, status);
+    oskar_mem_free(h->w_index, status);
+    oskar_mem_free(h->w_key_tmp, status);
+    oskar_mem_free(h->w_index_tmp, status);
     oskar_mem_free(h->time_im, status);
     oskar_timer_free(h->tmr_grid_finalise);
     oskar_timer_free(h->tmr_grid_update);
@@ -38,11 +43,13 @@ void oskar_imager_free(oskar_Imager* h, int* status)
     oskar_timer_free(h->tmr_rotate);
     oskar_timer_free(h->tmr_filter);
     oskar_timer_free(h->tmr_read);
+    oskar_timer_free(h->tmr_read_io);
     oskar_timer_free(h->tmr_write);
     oskar_timer_free(h->tmr_overall);
     oskar_timer_free(h->tmr_copy_convert);
     oskar_timer_free(h->tmr_coord_scan);
     oskar_timer_free(h->tmr_weights_grid);
+    oskar_timer_free(h->tmr_sort);
     oskar_timer_free(h->tmr_weights_lookup);
     oskar_mutex_free(h->mutex);
     oskar_log_free(h->log);
@@ -55,6 +62,8 @@ void oskar_imager_free(oskar_Imager* h, int* status)
     free(h->input_root);
     free(h->output_root);
     free(h->ms_column);
+    free(h->w_kernel_cache_dir);
+    free(h->grid_scratch_dir);
     free(h->gpu_ids);
     free(h->d);
     free(h);
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+
+#include "imager/oskar_degrid.h"
+#include "imager/oskar_grid_correction.h"
+#include "imager/private_imager_generate_corr_func.h"
+#include "log/oskar_log.h"
+#include "math/oskar_fft.h"
+#include "math/oskar_fftphase.h"
+#include "utility/oskar_device.h"
+#include "utility/oskar_timer.h"
+
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define C0 299792458.0
+
+void oskar_imager_set_model_image(oskar_Imager* h, const oskar_Mem* image,
+        int* status)
+{
+    const oskar_Mem* image_ptr = 0;
+    oskar_Mem *temp = 0, *grid = 0;
+    int i = 0;
+    if (*status) return;
+
+    /* Check the algorithm and image. */
+    if (h->algorithm != OSKAR_ALGORITHM_FFT &&
+            h->algorithm != OSKAR_ALGORITHM_WPROJ)
+    {
+        *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+        return;
+    }
+    if (oskar_mem_is_complex(image))
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+    const size_t num_pix = (size_t) h->image_size * h->image_size;
+    if (oskar_mem_length(image) < num_pix)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+    if (oskar_mem_location(image) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+
+    /* Initialise the convolution kernels if required. */
+    oskar_imager_check_init(h, status);
+    if (*status) return;
+    if (!h->init || (h->algorithm == OSKAR_ALGORITHM_WPROJ &&
+            !h->w_kernels_compact))
+    {
+        /* Not initialised in "coords only" mode,
+         * or kernels are only in GPU memory. */
+        *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
+        return;
+    }
+
+    /* Copy the image into the centre of the grid. */
+    oskar_timer_resume(h->tmr_grid_finalise);
+    image_ptr = image;
+    if (oskar_mem_precision(image) != h->imager_prec)
+    {
+        temp = oskar_mem_convert_precision(image, h->imager_prec, status);
+        image_ptr = temp;
+    }
+    const int size = oskar_imager_plane_size(h);
+    const int offset = (size - h->image_size) / 2;
+    const size_t element_size = oskar_mem_element_size(h->imager_prec);
+    if (!h->model_grid)
+    {
+        h->model_grid = oskar_mem_create(h->imager_prec | OSKAR_COMPLEX,
+                OSKAR_CPU, 0, status);
+    }
+    grid = h->model_grid;
+    oskar_mem_ensure(grid, (size_t) size * size, status);
+    oskar_mem_clear_contents(grid, status);
+    if (!*status)
+    {
+        const char* in = oskar_mem_char_const(image_ptr);
+        char* out = oskar_mem_char(grid);
+        for (i = 0; i < h->image_size; ++i)
+        {
+            int j = 0;
+            const char* row_in = in + element_size * h->image_size * i;
+            char* row_out = out + 2 * element_size *
+                    ((size_t) size * (i + offset) + offset);
+            for (j = 0; j < h->image_size; ++j)
+            {
+                memcpy(row_out + 2 * element_size * j,
+                        row_in + element_size * j, element_size);
+            }
+        }
+    }
+    oskar_mem_free(temp, status);
+
+    /* Apply the grid correction, and transform to the uv-plane.
+     * For a real image, the adjoint of the imager's transform is the
+     * conjugate of the forward transform. */
+    oskar_imager_generate_corr_func(h, status);
+    oskar_grid_correction(size, h->corr_func, grid, status);
+    const int fft_loc = (h->fft_on_gpu && h->num_gpus > 0) ?
+            h->dev_loc : OSKAR_CPU;
+    if (fft_loc != OSKAR_CPU)
+    {
+        oskar_device_set(h->dev_loc, h->gpu_ids[0], status);
+        grid = oskar_mem_create_copy(h->model_grid, fft_loc, status);
+    }
+    if (!h->fft)
+    {
+        h->fft = oskar_fft_create(h->imager_prec, fft_loc, 2, size, 0,
+                status);
+    }
+    oskar_fftphase(size, size, grid, status);
+    oskar_fft_exec(h->fft, grid, status);
+    oskar_fftphase(size, size, grid, status);
+    if (grid != h->model_grid)
+    {
+        oskar_mem_copy(h->model_grid, grid, status);
+        oskar_mem_free(grid, status);
+    }
+    oskar_mem_conjugate(h->model_grid, status);
+    oskar_timer_pause(h->tmr_grid_finalise);
+}
+
+
+void oskar_imager_predict(oskar_Imager* h, size_t num_vis,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        oskar_Mem* amps, int* status)
+{
+    oskar_Mem *tu = 0, *tv = 0, *tw = 0, *ta = 0;
+    const oskar_Mem *u_in = 0, *v_in = 0, *w_in = 0;
+    oskar_Mem* out = 0;
+    size_t num_skipped = 0;
+    if (*status) return;
+    const int size = oskar_imager_plane_size(h);
+    if (!h->model_grid)
+    {
+        *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
+        return;
+    }
+    if (oskar_mem_location(amps) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (!oskar_mem_is_complex(amps) || oskar_mem_is_matrix(amps))
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+
+    /* Convert precision of input data if required. */
+    oskar_timer_resume(h->tmr_copy_convert);
+    u_in = uu; v_in = vv; w_in = ww; out = amps;
+    if (oskar_mem_precision(uu) != h->imager_prec)
+    {
+        tu = oskar_mem_convert_precision(uu, h->imager_prec, status);
+        u_in = tu;
+    }
+    if (oskar_mem_precision(vv) != h->imager_prec)
+    {
+        tv = oskar_mem_convert_precision(vv, h->imager_prec, status);
+        v_in = tv;
+    }
+    if (oskar_mem_precision(ww) != h->imager_prec)
+    {
+        tw = oskar_mem_convert_precision(ww, h->imager_prec, status);
+        w_in = tw;
+    }
+    if (oskar_mem_precision(amps) != h->imager_prec)
+    {
+        ta = oskar_mem_create(h->imager_prec | OSKAR_COMPLEX, OSKAR_CPU,
+                num_vis, status);
+        out = ta;
+    }
+    oskar_mem_ensure(out, num_vis, status);
+    oskar_timer_pause(h->tmr_copy_convert);
+
+    /* Degrid the visibilities. */
+    oskar_timer_resume(h->tmr_grid_update);
+    if (*status)
+    {
+        /* Nothing to do. */
+    }
+    else if (h->algorithm == OSKAR_ALGORITHM_FFT)
+    {
+        if (h->imager_prec == OSKAR_DOUBLE)
+        {
+            oskar_degrid_simple_d(h->support, h->oversample,
+                    oskar_mem_double_const(h->conv_func, status), num_vis,
+                    oskar_mem_double_const(u_in, status),
+                    oskar_mem_double_const(v_in, status),
+                    h->cellsize_rad, size,
+                    oskar_mem_double_const(h->model_grid, status),
+                    &num_skipped, oskar_mem_double(out, status));
+        }
+        else
+        {
+            oskar_degrid_simple_f(h->support, h->oversample,
+                    oskar_mem_float_const(h->conv_func, status), num_vis,
+                    oskar_mem_float_const(u_in, status),
+                    oskar_mem_float_const(v_in, status),
+                    (float) (h->cellsize_rad), size,
+                    oskar_mem_float_const(h->model_grid, status),
+                    &num_skipped, oskar_mem_float(out, status));
+        }
+    }
+    else
+    {
+        if (h->imager_prec == OSKAR_DOUBLE)
+        {
+            oskar_degrid_wproj2_d(h->num_w_planes,
+                    oskar_mem_int_const(h->w_support, status),
+                    h->oversample,
+                    oskar_mem_int_const(h->w_kernel_start, status),
+                    oskar_mem_double_const(h->w_kernels_compact, status),
+                    num_vis,
+                    oskar_mem_double_const(u_in, status),
+                    oskar_mem_double_const(v_in, status),
+                    oskar_mem_double_const(w_in, status),
+                    h->cellsize_rad, h->w_scale, size,
+                    oskar_mem_double_const(h->model_grid, status),
+                    &num_skipped, oskar_mem_double(out, status));
+        }
+        else
+        {
+            oskar_degrid_wproj2_f(h->num_w_planes,
+                    oskar_mem_int_const(h->w_support, status),
+                    h->oversample,
+                    oskar_mem_int_const(h->w_kernel_start, status),
+                    oskar_mem_float_const(h->w_kernels_compact, status),
+                    num_vis,
+                    oskar_mem_float_const(u_in, status),
+                    oskar_mem_float_const(v_in, status),
+                    oskar_mem_float_const(w_in, status),
+                    (float) (h->cellsize_rad), (float) (h->w_scale), size,
+                    oskar_mem_float_const(h->model_grid, status),
+                    &num_skipped, oskar_mem_float(out, status));
+        }
+    }
+    oskar_timer_pause(h->tmr_grid_update);
+    if (num_skipped > 0)
+    {
+        oskar_log_warning(h->log, "Skipped %lu visibility points.",
+                (unsigned long) num_skipped);
+    }
+
+    /* Copy to the output array if required. */
+    if (out != amps && !*status)
+    {
+        oskar_timer_resume(h->tmr_copy_convert);
+        oskar_Mem* t = oskar_mem_convert_precision(out,
+                oskar_mem_precision(amps), status);
+        oskar_mem_copy_contents(amps, t, 0, 0, num_vis, status);
+        oskar_mem_free(t, status);
+        oskar_timer_pause(h->tmr_copy_convert);
+    }
+
+    oskar_mem_free(tu, status);
+    oskar_mem_free(tv, status);
+    oskar_mem_free(tw, status);
+    oskar_mem_free(ta, status);
+}
+
+
+void oskar_imager_predict_block(oskar_Imager* h,
+        const oskar_VisHeader* header, oskar_VisBlock* block, int* status)
+{
+    int c = 0, t = 0;
+    oskar_Mem *uvw[3], *pred = 0;
+    if (*status) return;
+    if (!oskar_vis_block_has_cross_correlations(block)) return;
+    oskar_Mem* xcorr = oskar_vis_block_cross_correlations(block);
+    if (oskar_mem_location(xcorr) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+
+    /* Get baseline coordinates if required. */
+    if (oskar_vis_block_has_station_coords(block))
+    {
+        oskar_vis_block_station_to_baseline_coords(block, status);
+    }
+
+    /* Get dimensions from the block. */
+    const int start_chan    = oskar_vis_block_start_channel_index(block);
+    const int num_baselines = oskar_vis_block_num_baselines(block);
+    const int num_channels  = oskar_vis_block_num_channels(block);
+    const int num_times     = oskar_vis_block_num_times(block);
+    const int is_matrix     = oskar_mem_is_matrix(xcorr);
+    const size_t num_rows   = (size_t) num_baselines * num_times;
+    const double freq_start_hz = oskar_vis_header_freq_start_hz(header);
+    const double freq_inc_hz = oskar_vis_header_freq_inc_hz(header);
+
+    /* Predict visibilities for each channel in turn.
+     * The imager's coordinate arrays are used as work space, so the
+     * imager is locked to allow blocks to be predicted from several
+     * threads. */
+    oskar_mutex_lock(h->mutex);
+    pred = oskar_mem_create(oskar_mem_precision(xcorr) | OSKAR_COMPLEX,
+            OSKAR_CPU, num_rows, status);
+    uvw[0] = h->uu_im; uvw[1] = h->vv_im; uvw[2] = h->ww_im;
+    oskar_mem_ensure(uvw[0], num_rows, status);
+    oskar_mem_ensure(uvw[1], num_rows, status);
+    oskar_mem_ensure(uvw[2], num_rows, status);
+    for (c = 0; c < num_channels; ++c)
+    {
+        int i = 0;
+        if (*status) break;
+        const double freq_hz = freq_start_hz + (start_chan + c) * freq_inc_hz;
+
+        /* Convert baseline coordinates to wavelengths. */
+        oskar_timer_resume(h->tmr_copy_convert);
+        for (i = 0; i < 3; ++i)
+        {
+            const oskar_Mem* in =
+                    oskar_vis_block_baseline_uvw_metres_const(block, i);
+            if (oskar_mem_precision(in) == h->imager_prec)
+            {
+                oskar_mem_copy_contents(uvw[i], in, 0, 0, num_rows, status);
+            }
+            else
+            {
+                oskar_Mem* tmp = oskar_mem_convert_precision(in,
+                        h->imager_prec, status);
+                oskar_mem_copy_contents(uvw[i], tmp, 0, 0, num_rows, status);
+                oskar_mem_free(tmp, status);
+            }
+            oskar_mem_scale_real(uvw[i], freq_hz / C0, 0, num_rows, status);
+        }
+        oskar_timer_pause(h->tmr_copy_convert);
+
+        /* Predict, and add to the block. */
+        oskar_imager_predict(h, num_rows, uvw[0], uvw[1], uvw[2],
+                pred, status);
+        if (*status) break;
+        for (t = 0; t < num_times; ++t)
+        {
+            int b = 0;
+            const size_t i_out = (size_t) num_baselines *
+                    ((size_t) num_channels * t + c);
+            const size_t i_in = (size_t) num_baselines * t;
+            if (oskar_mem_precision(xcorr) == OSKAR_DOUBLE)
+            {
+                const double* in = oskar_mem_double_const(pred, status);
+                double* out = oskar_mem_double(xcorr, status);
+                for (b = 0; b < num_baselines; ++b)
+                {
+                    const double re = in[2 * (i_in + b)];
+                    const double im = in[2 * (i_in + b) + 1];
+                    if (is_matrix)
+                    {
+                        double* xx = out + 8 * (i_out + b);
+                        xx[0] += re; xx[1] += im; xx[6] += re; xx[7] += im;
+                    }
+                    else
+                    {
+                        double* xx = out + 2 * (i_out + b);
+                        xx[0] += re; xx[1] += im;
+                    }
+                }
+            }
+            else
+            {
+                const float* in = oskar_mem_float_const(pred, status);
+                float* out = oskar_mem_float(xcorr, status);
+                for (b = 0; b < num_baselines; ++b)
+                {
+                    const float re = in[2 * (i_in + b)];
+                    const float im = in[2 * (i_in + b) + 1];
+                    if (is_matrix)
+                    {
+                        float* xx = out + 8 * (i_out + b);
+                        xx[0] += re; xx[1] += im; xx[6] += re; xx[7] += im;
+                    }
+                    else
+                    {
+                        float* xx = out + 2 * (i_out + b);
+                        xx[0] += re; xx[1] += im;
+                    }
+                }
+            }
+        }
+    }
+    oskar_mutex_unlock(h->mutex);
+    oskar_mem_free(pred, status);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,11 +1,15 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "imager/private_imager.h"
 #include "imager/oskar_imager_reset_cache.h"
+#include "imager/private_imager_coord_cache.h"
 #include "imager/private_imager_free_device_data.h"
+#include "imager/private_imager_grid_scratch.h"
+#include "imager/private_imager_update_plane_wstack.h"
+#include "imager/private_imager_w_kernel_cache.h"
 #include "log/oskar_log.h"
 #include "math/oskar_fft.h"
 #include <fitsio.h>
@@ -29,9 +33,15 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     h->num_sel_freqs = 0;
     h->num_im_channels = 0;
 
+    /* Clear the coordinate cache. */
+    oskar_imager_coord_cache_free(h, status);
+    h->coord_cache_write = 0;
+    h->coord_cache_read = 0;
+
     /* Clear FFT caches. */
     oskar_fft_free(h->fft); h->fft = 0;
     oskar_mem_free(h->corr_func, status); h->corr_func = 0;
+    oskar_mem_free(h->model_grid, status); h->model_grid = 0;
 
     /* Clear algorithm-specific caches. */
     oskar_mem_free(h->l, status); h->l = 0;
@@ -41,6 +51,11 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     oskar_mem_free(h->w_support, status); h->w_support = 0;
     oskar_mem_free(h->w_kernels_compact, status); h->w_kernels_compact = 0;
     oskar_mem_free(h->w_kernel_start, status); h->w_kernel_start = 0;
+    oskar_imager_w_kernel_cache_release(h);
+    oskar_imager_free_wstack_layers(h, status);
+    oskar_mem_free(h->layer_uu, status); h->layer_uu = 0;
+    oskar_mem_free(h->layer_vv, status); h->layer_vv = 0;
+    oskar_mem_free(h->layer_vis, status); h->layer_vis = 0;
 
     /* Free the image planes. */
     if (h->planes)
@@ -51,6 +66,7 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
         }
     }
     free(h->planes); h->planes = 0;
+    oskar_imager_grid_scratch_free(h);
     free(h->plane_norm); h->plane_norm = 0;
 
     /* Free the weights grids if they exist. */
@@ -75,6 +91,11 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     oskar_mem_realloc(h->vis_im, 0, status);
     oskar_mem_realloc(h->weight_im, 0, status);
     oskar_mem_realloc(h->weight_tmp, 0, status);
+    oskar_mem_realloc(h->vis_tmp, 0, status);
+    oskar_mem_realloc(h->w_key, 0, status);
+    oskar_mem_realloc(h->w_index, 0, status);
+    oskar_mem_realloc(h->w_key_tmp, 0, status);
+    oskar_mem_realloc(h->w_index_tmp, 0, status);
     oskar_mem_realloc(h->time_im, 0, status);
     oskar_mem_free(h->stokes, status); h->stokes = 0;
 
@@ -99,6 +120,7 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     oskar_timer_reset(h->tmr_select_scale);
     oskar_timer_reset(h->tmr_filter);
     oskar_timer_reset(h->tmr_read);
+    oskar_timer_reset(h->tmr_read_io);
     oskar_timer_reset(h->tmr_write);
     oskar_timer_start(h->tmr_overall);
     oskar_timer_reset(h->tmr_copy_convert);
@@ -106,6 +128,7 @@ void oskar_imager_reset_cache(oskar_Imager* h, int* status)
     oskar_timer_reset(h->tmr_rotate);
     oskar_timer_reset(h->tmr_weights_grid);
     oskar_timer_reset(h->tmr_weights_lookup);
+    oskar_timer_reset(h->tmr_sort);
 
     /* Clear state. */
     h->init = 0;
@@ -4,6 +4,7 @@
  */
 
 #include "imager/private_imager.h"
+#include "imager/private_imager_coord_cache.h"
 #include "imager/private_imager_read_coords.h"
 #include "imager/private_imager_read_data.h"
 #include "imager/private_imager_read_dims.h"
@@ -76,10 +77,12 @@ void oskar_imager_run(oskar_Imager* h,
 
     /* Read baseline coordinates and weights if required. */
     if (h->weighting == OSKAR_WEIGHTING_UNIFORM ||
-            h->algorithm == OSKAR_ALGORITHM_WPROJ)
+            h->algorithm == OSKAR_ALGORITHM_WPROJ ||
+            h->algorithm == OSKAR_ALGORITHM_WSTACK)
     {
         oskar_imager_set_coords_only(h, 1);
         oskar_log_section(h->log, 'M', "Reading coordinates...");
+        h->coord_cache_write = (h->coord_cache_mb > 0.0);
 
         /* Loop over input files. */
         for (i = 0; i < num_files; ++i)
@@ -99,6 +102,11 @@ void oskar_imager_run(oskar_Imager* h,
             }
         }
         oskar_imager_set_coords_only(h, 0);
+
+        /* Use the cached coordinates when reading the visibility data. */
+        h->coord_cache_read = h->coord_cache_write;
+        h->coord_cache_write = 0;
+        oskar_imager_coord_cache_rewind(h);
     }
 
     /* Check for errors. */
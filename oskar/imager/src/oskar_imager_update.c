@@ -5,17 +5,23 @@
 
 #include "imager/private_imager.h"
 
+#include "imager/oskar_grid_tiled.h"
 #include "imager/oskar_grid_weights.h"
 #include "imager/oskar_imager.h"
 #include "imager/private_imager_create_fits_files.h"
 #include "imager/private_imager_filter_time.h"
 #include "imager/private_imager_filter_uv.h"
+#include "imager/private_imager_grid_scratch.h"
+#include "imager/private_imager_half_plane.h"
 #include "imager/private_imager_select_data.h"
 #include "imager/private_imager_set_num_planes.h"
+#include "imager/private_imager_sort_by_w.h"
 #include "imager/private_imager_taper_weights.h"
+#include "imager/private_imager_update_channels.h"
 #include "imager/private_imager_update_plane_dft.h"
 #include "imager/private_imager_update_plane_fft.h"
 #include "imager/private_imager_update_plane_wproj.h"
+#include "imager/private_imager_update_plane_wstack.h"
 #include "imager/private_imager_weight_radial.h"
 #include "imager/private_imager_weight_uniform.h"
 #include "log/oskar_log.h"
@@ -30,6 +36,11 @@ extern "C" {
 #endif
 
 static void oskar_imager_allocate_planes(oskar_Imager* h, int *status);
+static void oskar_imager_update_plane_internal(oskar_Imager* h,
+        size_t num_vis, const oskar_Mem* uu, const oskar_Mem* vv,
+        const oskar_Mem* ww, const oskar_Mem* amps, const oskar_Mem* weight,
+        int i_plane, oskar_Mem* plane, double* plane_norm,
+        oskar_Mem* weights_grid, int weights_applied, int* status);
 static void oskar_imager_update_weights_grid(oskar_Imager* h,
         size_t num_points, const oskar_Mem* uu, const oskar_Mem* vv,
         const oskar_Mem* ww, const oskar_Mem* weight, oskar_Mem* weights_grid,
@@ -39,9 +50,9 @@ void oskar_imager_update_from_block(oskar_Imager* h,
         const oskar_VisHeader* hdr, oskar_VisBlock* block,
         int* status)
 {
-    int c = 0, t = 0;
+    int t = 0;
     double time_start_mjd = 0.0, time_inc_sec = 0.0;
-    oskar_Mem *weight = 0, *weight_ptr = 0, *time_centroid = 0;
+    oskar_Mem *weight = 0, *weight_ptr = 0, *time_centroid = 0, *scratch = 0;
     if (*status) return;
 
     /* Check that cross-correlations exist. */
@@ -98,176 +109,22 @@ void oskar_imager_update_from_block(oskar_Imager* h,
     }
 
     /* Update the imager with the data. */
-    if (!h->coords_only)
-    {
-        oskar_Mem* scratch = oskar_mem_create(oskar_mem_type(
-                oskar_vis_block_cross_correlations_const(block)),
-                OSKAR_CPU, num_rows, status);
-        for (c = 0; c < num_channels; ++c)
-        {
-            /* Update per channel. */
-            const double freq_hz =
-                    freq_start_hz + (start_chan + c) * freq_inc_hz;
-            if (freq_hz >= h->freq_min_hz &&
-                    (freq_hz <= h->freq_max_hz || h->freq_max_hz == 0.0))
-            {
-                oskar_timer_resume(h->tmr_copy_convert);
-                for (t = 0; t < num_times; ++t)
-                {
-                    oskar_mem_copy_contents(scratch,
-                            oskar_vis_block_cross_correlations_const(block),
-                            num_baselines * t,
-                            num_baselines * (num_channels * t + c),
-                            num_baselines, status);
-                }
-                oskar_timer_pause(h->tmr_copy_convert);
-                oskar_imager_update(h, num_rows,
-                        start_chan + c, start_chan + c, num_pols,
-                        oskar_vis_block_baseline_uu_metres_const(block),
-                        oskar_vis_block_baseline_vv_metres_const(block),
-                        oskar_vis_block_baseline_ww_metres_const(block),
-                        scratch, weight_ptr, time_centroid, status);
-            }
-        }
-        oskar_mem_free(scratch, status);
-    }
-    else
-    {
-        for (c = 0; c < num_channels; ++c)
-        {
-            /* Update per channel. */
-            const double freq_hz =
-                    freq_start_hz + (start_chan + c) * freq_inc_hz;
-            if (freq_hz >= h->freq_min_hz &&
-                    (freq_hz <= h->freq_max_hz || h->freq_max_hz == 0.0))
-            {
-                oskar_imager_update(h, num_rows,
-                        start_chan + c, start_chan + c, num_pols,
-                        oskar_vis_block_baseline_uu_metres_const(block),
-                        oskar_vis_block_baseline_vv_metres_const(block),
-                        oskar_vis_block_baseline_ww_metres_const(block),
-                        0, weight_ptr, time_centroid, status);
-            }
-        }
-    }
-
+    scratch = oskar_mem_create(oskar_mem_type(
+            oskar_vis_block_cross_correlations_const(block)),
+            OSKAR_CPU, 0, status);
+    oskar_imager_update_channels(h, num_baselines, num_times,
+            start_chan, num_channels, num_pols,
+            oskar_vis_block_baseline_uu_metres_const(block),
+            oskar_vis_block_baseline_vv_metres_const(block),
+            oskar_vis_block_baseline_ww_metres_const(block),
+            (h->coords_only ? 0 :
+                    oskar_vis_block_cross_correlations_const(block)),
+            weight_ptr, time_centroid, scratch, status);
+    oskar_mem_free(scratch, status);
     oskar_mem_free(weight, status);
     oskar_mem_free(time_centroid, status);
 }
 
-#if 0
-static int compare_f(const void *p0, const void *p1)
-{
-    float w0 = fabs(**(const float* const*)p0);
-    float w1 = fabs(**(const float* const*)p1);
-    if (w0 > w1) return 1;
-    if (w0 < w1) return -1;
-    return 0;
-}
-
-static int compare_d(const void *p0, const void *p1)
-{
-    double w0 = fabs(**(const double* const*)p0);
-    double w1 = fabs(**(const double* const*)p1);
-    if (w0 > w1) return 1;
-    if (w0 < w1) return -1;
-    return 0;
-}
-
-static void oskar_imager_sort_by_abs_w(size_t num_vis,
-        oskar_Mem* uu, oskar_Mem* vv, oskar_Mem* ww, oskar_Mem* amps,
-        oskar_Mem* weight, int* status)
-{
-    if (*status || num_vis == 0) return;
-    /* Based on:
-     * https://stackoverflow.com/questions/32948281/c-sort-two-arrays-the-same-way */
-    if (oskar_mem_precision(weight) == OSKAR_SINGLE)
-    {
-        size_t i = 0;
-        float** ptr_w = (float**) calloc(num_vis, sizeof(float*));
-        float* uu_ = oskar_mem_float(uu, status);
-        float* vv_ = oskar_mem_float(vv, status);
-        float* ww_ = oskar_mem_float(ww, status);
-        float2* vis_ = oskar_mem_float2(amps, status);
-        float* weight_ = oskar_mem_float(weight, status);
-        for (i = 0; i < num_vis; ++i) ptr_w[i] = &ww_[i];
-        qsort(ptr_w, num_vis, sizeof(void*), compare_f);
-        for (i = 0; i < num_vis; ++i)
-        {
-            if (i != (size_t) (ptr_w[i] - ww_))
-            {
-                size_t j, k;
-                const float temp_u = uu_[i];
-                const float temp_v = vv_[i];
-                const float temp_w = ww_[i];
-                const float2 temp_vis = vis_[i];
-                const float temp_weight = weight_[i];
-                k = i;
-                while (i != (j = (size_t) (ptr_w[k] - ww_)))
-                {
-                    uu_[k] = uu_[j];
-                    vv_[k] = vv_[j];
-                    ww_[k] = ww_[j];
-                    vis_[k] = vis_[j];
-                    weight_[k] = weight_[j];
-                    ptr_w[k] = &ww_[k];
-                    k = j;
-                }
-                uu_[k] = temp_u;
-                vv_[k] = temp_v;
-                ww_[k] = temp_w;
-                vis_[k] = temp_vis;
-                weight_[k] = temp_weight;
-                ptr_w[k] = &ww_[k];
-            }
-        }
-        free(ptr_w);
-    }
-    else
-    {
-        size_t i = 0;
-        double** ptr_w = (double**) calloc(num_vis, sizeof(double*));
-        double* uu_ = oskar_mem_double(uu, status);
-        double* vv_ = oskar_mem_double(vv, status);
-        double* ww_ = oskar_mem_double(ww, status);
-        double2* vis_ = oskar_mem_double2(amps, status);
-        double* weight_ = oskar_mem_double(weight, status);
-        for (i = 0; i < num_vis; ++i) ptr_w[i] = &ww_[i];
-        qsort(ptr_w, num_vis, sizeof(void*), compare_d);
-        for (i = 0; i < num_vis; ++i)
-        {
-            if (i != (size_t) (ptr_w[i] - ww_))
-            {
-                size_t j, k;
-                const double temp_u = uu_[i];
-                const double temp_v = vv_[i];
-                const double temp_w = ww_[i];
-                const double2 temp_vis = vis_[i];
-                const double temp_weight = weight_[i];
-                k = i;
-                while (i != (j = (size_t) (ptr_w[k] - ww_)))
-                {
-                    uu_[k] = uu_[j];
-                    vv_[k] = vv_[j];
-                    ww_[k] = ww_[j];
-                    vis_[k] = vis_[j];
-                    weight_[k] = weight_[j];
-                    ptr_w[k] = &ww_[k];
-                    k = j;
-                }
-                uu_[k] = temp_u;
-                vv_[k] = temp_v;
-                ww_[k] = temp_w;
-                vis_[k] = temp_vis;
-                weight_[k] = temp_weight;
-                ptr_w[k] = &ww_[k];
-            }
-        }
-        free(ptr_w);
-    }
-}
-#endif
-
 void oskar_imager_update(oskar_Imager* h, size_t num_rows, int start_chan,
         int end_chan, int num_pols, const oskar_Mem* uu, const oskar_Mem* vv,
         const oskar_Mem* ww, const oskar_Mem* amps, const oskar_Mem* weight,
@@ -374,6 +231,8 @@ void oskar_imager_update(oskar_Imager* h, size_t num_rows, int start_chan,
     }
 
     /* Loop over each image plane being made. */
+    const int fused = !h->coords_only &&
+            h->weighting == OSKAR_WEIGHTING_UNIFORM;
     for (c = 0; c < h->num_im_channels; ++c)
     {
         for (p = 0; p < h->num_im_pols; ++p)
@@ -423,24 +282,27 @@ void oskar_imager_update(oskar_Imager* h, size_t num_rows, int start_chan,
                 }
             }
 
-            /* Apply time and baseline length filters if required. */
+            /* Apply time and baseline length filters if required.
+             * Uniform weights are looked up in the same pass. */
+            i_plane = h->num_im_pols * c + p;
             oskar_imager_filter_time(h, &num_vis, h->uu_im, h->vv_im,
                     h->ww_im, h->vis_im, h->weight_im, pt, status);
             oskar_imager_filter_uv(h, &num_vis, h->uu_im, h->vv_im,
-                    h->ww_im, h->vis_im, h->weight_im, status);
+                    h->ww_im, h->vis_im, h->weight_im,
+                    (fused ? h->weights_grids[i_plane] : 0), status);
 
-#if 0
-            /* Sort visibility data by w coordinate. */
-            if (h->algorithm == OSKAR_ALGORITHM_WPROJ && !h->coords_only)
-                oskar_imager_sort_by_abs_w(num_vis, h->uu_im, h->vv_im,
-                        h->ww_im, h->vis_im, h->weight_im, status);
-#endif
+            /* Sort visibility data by W-projection plane or W-layer. */
+            if ((h->algorithm == OSKAR_ALGORITHM_WPROJ ||
+                    h->algorithm == OSKAR_ALGORITHM_WSTACK) && !h->coords_only)
+            {
+                oskar_imager_sort_by_w(h, num_vis, status);
+            }
 
             /* Update this image plane with the visibilities. */
-            i_plane = h->num_im_pols * c + p;
-            oskar_imager_update_plane(h, num_vis, h->uu_im, h->vv_im,
-                    h->ww_im, (h->coords_only ? 0 : h->vis_im), h->weight_im,
-                    i_plane, 0, 0, h->weights_grids[i_plane], status);
+            oskar_imager_update_plane_internal(h, num_vis, h->uu_im,
+                    h->vv_im, h->ww_im, (h->coords_only ? 0 : h->vis_im),
+                    h->weight_im, i_plane, 0, 0, h->weights_grids[i_plane],
+                    fused, status);
         }
     }
 
@@ -457,6 +319,17 @@ void oskar_imager_update_plane(oskar_Imager* h, size_t num_vis,
         const oskar_Mem* amps, const oskar_Mem* weight, int i_plane,
         oskar_Mem* plane, double* plane_norm, oskar_Mem* weights_grid,
         int* status)
+{
+    oskar_imager_update_plane_internal(h, num_vis, uu, vv, ww, amps, weight,
+            i_plane, plane, plane_norm, weights_grid, 0, status);
+}
+
+
+void oskar_imager_update_plane_internal(oskar_Imager* h, size_t num_vis,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight, int i_plane,
+        oskar_Mem* plane, double* plane_norm, oskar_Mem* weights_grid,
+        int weights_applied, int* status)
 {
     oskar_Mem *tu = 0, *tv = 0, *tw = 0, *ta = 0, *th = 0;
     const oskar_Mem *pu = 0, *pv = 0, *pw = 0, *pa = 0, *ph = 0;
@@ -531,6 +404,7 @@ void oskar_imager_update_plane(oskar_Imager* h, size_t num_vis,
             ph = h->weight_tmp;
             break;
         case OSKAR_WEIGHTING_UNIFORM:
+            if (weights_applied) break;
             oskar_timer_resume(h->tmr_weights_lookup);
             oskar_imager_weight_uniform(num_vis, pu, pv, ph, h->weight_tmp,
                     h->cellsize_rad, oskar_imager_plane_size(h), weights_grid,
@@ -563,6 +437,12 @@ void oskar_imager_update_plane(oskar_Imager* h, size_t num_vis,
             plane_norm_ptr = &(h->plane_norm[i_plane]);
         }
         oskar_timer_resume(h->tmr_grid_update);
+        if (h->algorithm != OSKAR_ALGORITHM_WSTACK)
+        {
+            /* (W-stacking updates the plane when its layers are added.) */
+            oskar_imager_grid_scratch_use(h, plane ? plane :
+                    (h->planes ? h->planes[i_plane] : 0));
+        }
         switch (h->algorithm)
         {
         case OSKAR_ALGORITHM_DFT_2D:
@@ -578,6 +458,10 @@ void oskar_imager_update_plane(oskar_Imager* h, size_t num_vis,
             oskar_imager_update_plane_wproj(h, num_vis, pu, pv, pw, pa, ph,
                     i_plane, plane, plane_norm_ptr, &num_skipped, status);
             break;
+        case OSKAR_ALGORITHM_WSTACK:
+            oskar_imager_update_plane_wstack(h, num_vis, pu, pv, pw, pa, ph,
+                    i_plane, plane, plane_norm_ptr, &num_skipped, status);
+            break;
         default:
             *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
             break;
@@ -619,26 +503,52 @@ void oskar_imager_update_weights_grid(oskar_Imager* h, size_t num_points,
         if (*status) return;
 
         oskar_timer_resume(h->tmr_weights_grid);
+        const int tiled = oskar_grid_tiled_num_threads() > 1;
         if (oskar_mem_precision(weights_grid) == OSKAR_DOUBLE)
         {
-            oskar_grid_weights_write_d(num_points,
-                    oskar_mem_double_const(uu, status),
-                    oskar_mem_double_const(vv, status),
-                    oskar_mem_double_const(weight, status),
-                    h->cellsize_rad, grid_size, &num_skipped,
-                    oskar_mem_double(weights_grid, status));
+            if (tiled)
+            {
+                oskar_grid_weights_write_tiled_d(num_points,
+                        oskar_mem_double_const(uu, status),
+                        oskar_mem_double_const(vv, status),
+                        oskar_mem_double_const(weight, status),
+                        h->cellsize_rad, grid_size, &num_skipped,
+                        oskar_mem_double(weights_grid, status), status);
+            }
+            else
+            {
+                oskar_grid_weights_write_d(num_points,
+                        oskar_mem_double_const(uu, status),
+                        oskar_mem_double_const(vv, status),
+                        oskar_mem_double_const(weight, status),
+                        h->cellsize_rad, grid_size, &num_skipped,
+                        oskar_mem_double(weights_grid, status));
+            }
         }
         else
         {
             oskar_mem_ensure(weights_guard, num_cells, status);
             if (*status) return;
-            oskar_grid_weights_write_f(num_points,
-                    oskar_mem_float_const(uu, status),
-                    oskar_mem_float_const(vv, status),
-                    oskar_mem_float_const(weight, status),
-                    (float) (h->cellsize_rad), grid_size, &num_skipped,
-                    oskar_mem_float(weights_grid, status),
-                    oskar_mem_float(weights_guard, status));
+            if (tiled)
+            {
+                oskar_grid_weights_write_tiled_f(num_points,
+                        oskar_mem_float_const(uu, status),
+                        oskar_mem_float_const(vv, status),
+                        oskar_mem_float_const(weight, status),
+                        (float) (h->cellsize_rad), grid_size, &num_skipped,
+                        oskar_mem_float(weights_grid, status),
+                        oskar_mem_float(weights_guard, status), status);
+            }
+            else
+            {
+                oskar_grid_weights_write_f(num_points,
+                        oskar_mem_float_const(uu, status),
+                        oskar_mem_float_const(vv, status),
+                        oskar_mem_float_const(weight, status),
+                        (float) (h->cellsize_rad), grid_size, &num_skipped,
+                        oskar_mem_float(weights_grid, status),
+                        oskar_mem_float(weights_guard, status));
+            }
         }
         if (num_skipped > 0)
         {
@@ -649,7 +559,8 @@ void oskar_imager_update_weights_grid(oskar_Imager* h, size_t num_points,
     }
 
     /* Update baseline W minimum, maximum and RMS. */
-    if (h->algorithm == OSKAR_ALGORITHM_WPROJ)
+    if (h->algorithm == OSKAR_ALGORITHM_WPROJ ||
+            h->algorithm == OSKAR_ALGORITHM_WSTACK)
     {
         size_t j = 0;
         oskar_timer_resume(h->tmr_coord_scan);
@@ -693,21 +604,32 @@ void oskar_imager_allocate_planes(oskar_Imager* h, int *status)
     const int num_planes = h->num_planes;
     const int plane_size = oskar_imager_plane_size(h);
     const int plane_type = oskar_imager_plane_type(h);
-    const size_t num_cells = ((size_t) plane_size) * ((size_t) plane_size);
+    const int half_width = oskar_imager_half_plane_width(h);
+    const size_t num_cells = ((size_t) plane_size) *
+            ((size_t) (half_width ? half_width : plane_size));
     const size_t plane_mem = num_cells * oskar_mem_element_size(plane_type);
     oskar_log_message(h->log, 'M', 0, "Plane size is %d x %d.",
             plane_size, plane_size);
+    if (half_width)
+    {
+        oskar_log_message(h->log, 'M', 0, "Gridding half of the uv-plane "
+                "(grid size %d x %d).", half_width, plane_size);
+    }
     oskar_log_message(h->log, 'M', 0, "Allocating %d plane(s) of size "
             "%.1f MB (%.1f MB total).", num_planes, plane_mem * 1e-6,
             num_planes * plane_mem * 1e-6);
 
-    /* Allocate the image or visibility planes on the host. */
+    /* Allocate the image or visibility planes on the host.
+     * Use a memory-mapped scratch file if they are too large. */
     h->planes = (oskar_Mem**) calloc(num_planes, sizeof(oskar_Mem*));
     h->plane_norm = (double*) calloc(num_planes, sizeof(double));
-    for (i = 0; i < num_planes; ++i)
+    if (!oskar_imager_grid_scratch_create(h, plane_type, num_cells, status))
     {
-        h->planes[i] = oskar_mem_create(plane_type, OSKAR_CPU,
-                num_cells, status);
+        for (i = 0; i < num_planes; ++i)
+        {
+            h->planes[i] = oskar_mem_create(plane_type, OSKAR_CPU,
+                    num_cells, status);
+        }
     }
 
     /* Allocate visibility planes on the devices if required. */
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_grid_bins.h"
+#include "imager/oskar_grid_tiled.h"
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void oskar_grid_bins_create(size_t num_points, const void* points,
+        oskar_GridBinRange range, int num_bins_u, int num_bins_v,
+        oskar_GridBins* bins, int* status)
+{
+    size_t* counts = 0;
+    const int num_bins = num_bins_u * num_bins_v;
+    bins->num_bins_u = num_bins_u;
+    bins->num_bins = num_bins;
+    bins->bin_start = 0;
+    bins->bin_points = 0;
+    if (*status) return;
+    bins->bin_start = (size_t*) calloc(num_bins + 1, sizeof(size_t));
+    counts = (size_t*) calloc(
+            (size_t) num_bins * oskar_grid_tiled_num_threads(),
+            sizeof(size_t));
+    if (!bins->bin_start || !counts)
+    {
+        free(counts);
+        oskar_grid_bins_free(bins);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+#pragma omp parallel
+    {
+        size_t i = 0, start = 0, end = 0;
+        int thread_id = 0, num_threads = 1, bu = 0, bv = 0;
+        int u0 = 0, u1 = 0, v0 = 0, v1 = 0;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+        num_threads = omp_get_num_threads();
+#endif
+        size_t* thread_counts = &counts[(size_t) thread_id * num_bins];
+        start = num_points * thread_id / num_threads;
+        end = num_points * (thread_id + 1) / num_threads;
+
+        /* Count the points in each bin. */
+        for (i = start; i < end; ++i)
+        {
+            if (!range(points, i, &u0, &u1, &v0, &v1)) continue;
+            for (bv = v0; bv <= v1; ++bv)
+            {
+                for (bu = u0; bu <= u1; ++bu)
+                {
+                    thread_counts[bv * num_bins_u + bu]++;
+                }
+            }
+        }
+#pragma omp barrier
+
+        /* Convert the counts to offsets. */
+#pragma omp single
+        {
+            int i_bin = 0, t = 0;
+            size_t total = 0;
+            for (i_bin = 0; i_bin < num_bins; ++i_bin)
+            {
+                bins->bin_start[i_bin] = total;
+                for (t = 0; t < num_threads; ++t)
+                {
+                    const size_t n = counts[(size_t) t * num_bins + i_bin];
+                    counts[(size_t) t * num_bins + i_bin] = total;
+                    total += n;
+                }
+            }
+            bins->bin_start[num_bins] = total;
+            bins->bin_points = (size_t*) malloc((total + 1) * sizeof(size_t));
+        }
+
+        /* Write the point indices for each bin. */
+        if (bins->bin_points)
+        {
+            for (i = start; i < end; ++i)
+            {
+                if (!range(points, i, &u0, &u1, &v0, &v1)) continue;
+                for (bv = v0; bv <= v1; ++bv)
+                {
+                    for (bu = u0; bu <= u1; ++bu)
+                    {
+                        bins->bin_points[
+                                thread_counts[bv * num_bins_u + bu]++] = i;
+                    }
+                }
+            }
+        }
+    }
+    free(counts);
+    if (!bins->bin_points)
+    {
+        oskar_grid_bins_free(bins);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+    }
+}
+
+
+void oskar_grid_bins_free(oskar_GridBins* bins)
+{
+    free(bins->bin_start);
+    free(bins->bin_points);
+    bins->bin_start = 0;
+    bins->bin_points = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_coord_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Each array is stored as its type and number of elements, followed by
+ * the data. The first part of the cache is held in memory, and once that
+ * is full the rest goes to the temporary file, so that reading it back in
+ * order needs only a single position.
+ */
+static int cache_write(oskar_Imager* h, const void* data, size_t bytes)
+{
+    int status = 0;
+    const size_t budget = (size_t) (h->coord_cache_mb * 1024.0 * 1024.0);
+    const size_t required = h->coord_cache_size + bytes;
+    if (!h->coord_cache_file && required <= budget)
+    {
+        const size_t capacity = oskar_mem_length(h->coord_cache);
+        if (required > capacity)
+        {
+            size_t new_capacity = 2 * capacity;
+            if (new_capacity > budget) new_capacity = budget;
+            if (new_capacity < required) new_capacity = required;
+            oskar_mem_ensure(h->coord_cache, new_capacity, &status);
+            if (status) return status;
+        }
+        memcpy(oskar_mem_char(h->coord_cache) + h->coord_cache_size,
+                data, bytes);
+        h->coord_cache_size = required;
+        return 0;
+    }
+    if (!h->coord_cache_file)
+    {
+        h->coord_cache_file = tmpfile();
+        if (!h->coord_cache_file) return OSKAR_ERR_FILE_IO;
+        oskar_log_message(h->log, 'M', 0, "Coordinate cache is larger "
+                "than %.0f MB: using a temporary file", h->coord_cache_mb);
+    }
+    if (fwrite(data, 1, bytes, h->coord_cache_file) != bytes)
+    {
+        return OSKAR_ERR_FILE_IO;
+    }
+    return 0;
+}
+
+static void cache_read(oskar_Imager* h, void* data, size_t bytes,
+        int* status)
+{
+    if (*status) return;
+    if (h->coord_cache_pos + bytes <= h->coord_cache_size)
+    {
+        memcpy(data, oskar_mem_char(h->coord_cache) + h->coord_cache_pos,
+                bytes);
+        h->coord_cache_pos += bytes;
+    }
+    else if (!h->coord_cache_file ||
+            fread(data, 1, bytes, h->coord_cache_file) != bytes)
+    {
+        *status = OSKAR_ERR_FILE_IO;
+    }
+}
+
+void oskar_imager_coord_cache_put(oskar_Imager* h, const oskar_Mem* data,
+        size_t num_elements)
+{
+    int error = 0;
+    const int type = oskar_mem_type(data);
+    if (!h->coord_cache_write) return;
+    if (!h->coord_cache)
+    {
+        h->coord_cache = oskar_mem_create(OSKAR_CHAR, OSKAR_CPU, 0, &error);
+    }
+    if (!error) error = cache_write(h, &type, sizeof(int));
+    if (!error) error = cache_write(h, &num_elements, sizeof(size_t));
+    if (!error && num_elements > 0)
+    {
+        error = cache_write(h, oskar_mem_void_const(data),
+                num_elements * oskar_mem_element_size(type));
+    }
+    if (error)
+    {
+        oskar_log_warning(h->log, "Could not write coordinate cache: "
+                "coordinates will be read again with the visibility data.");
+        h->coord_cache_write = 0;
+        oskar_imager_coord_cache_free(h, &error);
+    }
+}
+
+void oskar_imager_coord_cache_get(oskar_Imager* h, oskar_Mem* data,
+        int* status)
+{
+    int type = 0;
+    size_t num_elements = 0;
+    cache_read(h, &type, sizeof(int), status);
+    cache_read(h, &num_elements, sizeof(size_t), status);
+    if (*status) return;
+    if (type != oskar_mem_type(data))
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return;
+    }
+    if (oskar_mem_length(data) < num_elements)
+    {
+        oskar_mem_realloc(data, num_elements, status);
+    }
+    if (num_elements > 0)
+    {
+        cache_read(h, oskar_mem_void(data),
+                num_elements * oskar_mem_element_size(type), status);
+    }
+}
+
+void oskar_imager_coord_cache_rewind(oskar_Imager* h)
+{
+    h->coord_cache_pos = 0;
+    if (h->coord_cache_file) rewind(h->coord_cache_file);
+}
+
+void oskar_imager_coord_cache_free(oskar_Imager* h, int* status)
+{
+    oskar_mem_free(h->coord_cache, status);
+    h->coord_cache = 0;
+    h->coord_cache_size = 0;
+    h->coord_cache_pos = 0;
+    if (h->coord_cache_file) fclose(h->coord_cache_file);
+    h->coord_cache_file = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2022, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -28,7 +28,7 @@ extern "C" {
 static fitsfile* create_fits_file(const char* filename, int precision,
         int width, int height, int num_channels, const double centre_deg[2],
         const double fov_deg[2], double start_freq_hz, double delta_freq_hz,
-        int* status);
+        int compression, double quantize_level, int* status);
 static void write_axis_header(fitsfile* fptr, int axis_id,
         const char* ctype, const char* ctype_comment, double crval,
         double cdelt, double crpix, double crota, int* status);
@@ -39,6 +39,15 @@ void oskar_imager_create_fits_files(oskar_Imager* h, int* status)
     if (*status) return;
     if (!h->output_root) return;
     oskar_timer_resume(h->tmr_write);
+
+    /* Rice compression of floating-point data needs quantisation. */
+    int compression = h->fits_compression;
+    if (compression == RICE_1 && h->fits_quantize_level <= 0.0)
+    {
+        oskar_log_warning(h->log, "Using GZIP instead of Rice compression "
+                "for FITS files, as quantisation is disabled");
+        compression = GZIP_2;
+    }
     for (i = 0; i < h->num_im_pols; ++i)
     {
         double fov_deg[2];
@@ -78,7 +87,8 @@ void oskar_imager_create_fits_files(oskar_Imager* h, int* status)
         fov_deg[0] = fov_deg[1] = h->fov_deg;
         h->fits_file[i] = create_fits_file(f, h->imager_prec, h->image_size,
                 h->image_size, h->num_im_channels, h->im_centre_deg, fov_deg,
-                h->im_freqs[0], h->freq_inc_hz, status);
+                h->im_freqs[0], h->freq_inc_hz, compression,
+                h->fits_quantize_level, status);
         const size_t buffer_size = 1 + strlen(f);
         free(h->output_name[i]);
         h->output_name[i] = (char*) calloc(buffer_size, sizeof(char));
@@ -91,7 +101,7 @@ void oskar_imager_create_fits_files(oskar_Imager* h, int* status)
 fitsfile* create_fits_file(const char* filename, int precision,
         int width, int height, int num_channels, const double centre_deg[2],
         const double fov_deg[2], double start_freq_hz, double delta_freq_hz,
-        int* status)
+        int compression, double quantize_level, int* status)
 {
     long naxes[3];
     double delta = 0.0;
@@ -110,6 +120,17 @@ fitsfile* create_fits_file(const char* filename, int precision,
     naxes[1]  = height;
     naxes[2]  = num_channels;
     fits_create_file(&f, filename, status);
+    if (compression)
+    {
+        /* Compress tiles of one image row, so each plane is whole tiles. */
+        long tile[3];
+        tile[0] = width;
+        tile[1] = 1;
+        tile[2] = 1;
+        fits_set_compression_type(f, compression, status);
+        fits_set_tile_dim(f, 3, tile, status);
+        fits_set_quantize_level(f, (float) quantize_level, status);
+    }
     fits_create_img(f, (precision == OSKAR_DOUBLE ? DOUBLE_IMG : FLOAT_IMG),
             3, naxes, status);
     fits_set_hdrsize(f, 160, status); /* Reserve some header space for log. */
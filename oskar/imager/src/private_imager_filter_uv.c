@@ -1,31 +1,164 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "imager/private_imager.h"
 
+#include "imager/oskar_imager_accessors.h"
 #include "imager/private_imager_filter_uv.h"
+#include "log/oskar_log.h"
+#include "utility/oskar_kernel_macros.h"
 #include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* Minimum number of points for each thread. */
+#define MIN_POINTS_PER_THREAD 16384
+
+static int thread_num(void)
+{
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+static int num_threads(void)
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+static int max_threads(void)
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/*
+ * Each thread filters and re-weights one contiguous range of the points,
+ * moving the points it keeps to the start of its range. The ranges are then
+ * joined in thread order, so the result is the same as a serial pass.
+ */
+#define OSKAR_FILTER_UV(NAME, FP, FP2, ROUND)\
+static size_t NAME(const size_t n, const int filter, const double* range,\
+        FP* RESTRICT uu, FP* RESTRICT vv, FP* RESTRICT ww,\
+        FP2* RESTRICT amp, FP* RESTRICT weight, const FP* RESTRICT grid,\
+        const FP cell_size_rad, const int grid_size,\
+        size_t* RESTRICT num_skipped, int* status)\
+{\
+    int t = 0, num_ranges = 1;\
+    size_t skipped = 0, num_out = 0, *counts = 0;\
+    const int grid_centre = grid_size / 2;\
+    const FP grid_scale = grid_size * cell_size_rad;\
+    counts = (size_t*) calloc(max_threads(), sizeof(size_t));\
+    if (!counts)\
+    {\
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;\
+        return n;\
+    }\
+    DO_PRAGMA(omp parallel if(n >= 2 * MIN_POINTS_PER_THREAD) \
+            reduction(+:skipped))\
+    {\
+        size_t i = 0, k = 0;\
+        DO_PRAGMA(omp single)\
+        num_ranges = num_threads();\
+        const int range_id = thread_num();\
+        const size_t start = n * range_id / num_ranges;\
+        const size_t end = n * (range_id + 1) / num_ranges;\
+        for (i = start, k = start; i < end; ++i)\
+        {\
+            FP w = weight[i];\
+            if (filter)\
+            {\
+                const double r = (double)uu[i] * uu[i] +\
+                        (double)vv[i] * vv[i];\
+                if (r < range[0] || r > range[1]) continue;\
+            }\
+            if (grid)\
+            {\
+                const int grid_u = (int)ROUND(-uu[i] * grid_scale) +\
+                        grid_centre;\
+                const int grid_v = (int)ROUND(vv[i] * grid_scale) +\
+                        grid_centre;\
+                if (grid_u >= grid_size || grid_u < 0 ||\
+                        grid_v >= grid_size || grid_v < 0)\
+                {\
+                    w = (FP) 0;\
+                    skipped++;\
+                }\
+                else\
+                {\
+                    size_t p = grid_v;\
+                    p *= grid_size; /* Tested to avoid int overflow. */\
+                    p += grid_u;\
+                    w = (grid[p] != (FP) 0) ? w / grid[p] : (FP) 0;\
+                }\
+            }\
+            uu[k] = uu[i];\
+            vv[k] = vv[i];\
+            ww[k] = ww[i];\
+            weight[k] = w;\
+            if (amp) amp[k] = amp[i];\
+            ++k;\
+        }\
+        counts[range_id] = k - start;\
+    }\
+    for (t = 0; t < num_ranges; ++t)\
+    {\
+        const size_t start = n * t / num_ranges, num = counts[t];\
+        if (start != num_out && num > 0)\
+        {\
+            memmove(uu + num_out, uu + start, num * sizeof(FP));\
+            memmove(vv + num_out, vv + start, num * sizeof(FP));\
+            memmove(ww + num_out, ww + start, num * sizeof(FP));\
+            memmove(weight + num_out, weight + start, num * sizeof(FP));\
+            if (amp) memmove(amp + num_out, amp + start, num * sizeof(FP2));\
+        }\
+        num_out += num;\
+    }\
+    free(counts);\
+    *num_skipped = skipped;\
+    return num_out;\
+}\
+
+OSKAR_FILTER_UV(filter_uv_d, double, double2, round)
+OSKAR_FILTER_UV(filter_uv_f, float, float2, roundf)
+
 void oskar_imager_filter_uv(oskar_Imager* h, size_t* num_vis,
         oskar_Mem* uu, oskar_Mem* vv, oskar_Mem* ww, oskar_Mem* amp,
-        oskar_Mem* weight, int* status)
+        oskar_Mem* weight, const oskar_Mem* weights_grid, int* status)
 {
-    size_t i = 0;
-    double r = 0.0, range[2];
+    size_t num_skipped = 0;
+    double range[2];
 
-    /* Return immediately if filtering is not enabled. */
-    if (h->uv_filter_min <= 0.0 &&
-            (h->uv_filter_max < 0.0 || h->uv_filter_max > FLT_MAX))
+    /* Return immediately if there is nothing to do. */
+    const int filter = !(h->uv_filter_min <= 0.0 &&
+            (h->uv_filter_max < 0.0 || h->uv_filter_max > FLT_MAX));
+    if (!filter && !weights_grid) return;
+    if (*status) return;
+    if (weights_grid && !oskar_mem_allocated(weights_grid))
     {
+        *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
         return;
     }
-    if (*status) return;
 
     /* Get the range (squared, to avoid lots of square roots later). */
     range[0] = h->uv_filter_min;
@@ -33,67 +166,37 @@ void oskar_imager_filter_uv(oskar_Imager* h, size_t* num_vis,
     range[0] *= range[0];
     range[1] *= range[1];
 
-    /* Get the number of input points, and set the number selected to zero. */
-    const size_t n = *num_vis;
-    *num_vis = 0;
-
-    /* Apply the UV baseline length filter. */
-    oskar_timer_resume(h->tmr_filter);
+    /* Apply the UV baseline length filter and the uniform weights. */
+    oskar_timer_resume(weights_grid ? h->tmr_weights_lookup : h->tmr_filter);
+    const int grid_size = oskar_imager_plane_size(h);
     if (h->imager_prec == OSKAR_DOUBLE)
     {
-        double2* amp_ = 0;
-        double *uu_ = 0, *vv_ = 0, *ww_ = 0, *weight_ = 0;
-        uu_ = oskar_mem_double(uu, status);
-        vv_ = oskar_mem_double(vv, status);
-        ww_ = oskar_mem_double(ww, status);
-        weight_ = oskar_mem_double(weight, status);
-        if (!h->coords_only)
-        {
-            amp_ = oskar_mem_double2(amp, status);
-        }
-
-        for (i = 0; i < n; ++i)
-        {
-            r = uu_[i] * uu_[i] + vv_[i] * vv_[i];
-            if (r >= range[0] && r <= range[1])
-            {
-                uu_[*num_vis] = uu_[i];
-                vv_[*num_vis] = vv_[i];
-                ww_[*num_vis] = ww_[i];
-                weight_[*num_vis] = weight_[i];
-                if (amp_) amp_[*num_vis] = amp_[i];
-                (*num_vis)++;
-            }
-        }
+        *num_vis = filter_uv_d(*num_vis, filter, range,
+                oskar_mem_double(uu, status), oskar_mem_double(vv, status),
+                oskar_mem_double(ww, status),
+                h->coords_only ? 0 : oskar_mem_double2(amp, status),
+                oskar_mem_double(weight, status),
+                weights_grid ?
+                        oskar_mem_double_const(weights_grid, status) : 0,
+                h->cellsize_rad, grid_size, &num_skipped, status);
     }
     else
     {
-        float2* amp_ = 0;
-        float *uu_ = 0, *vv_ = 0, *ww_ = 0, *weight_ = 0;
-        uu_ = oskar_mem_float(uu, status);
-        vv_ = oskar_mem_float(vv, status);
-        ww_ = oskar_mem_float(ww, status);
-        weight_ = oskar_mem_float(weight, status);
-        if (!h->coords_only)
-        {
-            amp_ = oskar_mem_float2(amp, status);
-        }
-
-        for (i = 0; i < n; ++i)
-        {
-            r = uu_[i] * uu_[i] + vv_[i] * vv_[i];
-            if (r >= range[0] && r <= range[1])
-            {
-                uu_[*num_vis] = uu_[i];
-                vv_[*num_vis] = vv_[i];
-                ww_[*num_vis] = ww_[i];
-                weight_[*num_vis] = weight_[i];
-                if (amp_) amp_[*num_vis] = amp_[i];
-                (*num_vis)++;
-            }
-        }
+        *num_vis = filter_uv_f(*num_vis, filter, range,
+                oskar_mem_float(uu, status), oskar_mem_float(vv, status),
+                oskar_mem_float(ww, status),
+                h->coords_only ? 0 : oskar_mem_float2(amp, status),
+                oskar_mem_float(weight, status),
+                weights_grid ?
+                        oskar_mem_float_const(weights_grid, status) : 0,
+                (float) (h->cellsize_rad), grid_size, &num_skipped, status);
+    }
+    oskar_timer_pause(weights_grid ? h->tmr_weights_lookup : h->tmr_filter);
+    if (num_skipped > 0)
+    {
+        oskar_log_warning(h->log, "Skipped %lu visibility weights.",
+                (unsigned long) num_skipped);
     }
-    oskar_timer_pause(h->tmr_filter);
 }
 
 #ifdef __cplusplus
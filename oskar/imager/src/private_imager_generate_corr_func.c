@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+
+#include "imager/oskar_grid_functions_pillbox.h"
+#include "imager/oskar_grid_functions_spheroidal.h"
+#include "imager/private_imager_generate_corr_func.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void oskar_imager_generate_corr_func(oskar_Imager* h, int* status)
+{
+    oskar_Mem* corr_func = 0;
+    if (*status || h->corr_func) return;
+    const int size = oskar_imager_plane_size(h);
+    corr_func = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, size, status);
+    if (h->algorithm != OSKAR_ALGORITHM_FFT &&
+            h->algorithm != OSKAR_ALGORITHM_WSTACK)
+    {
+        oskar_grid_correction_function_spheroidal(size, h->oversample,
+                oskar_mem_double(corr_func, status));
+    }
+    else
+    {
+        if (h->kernel_type == 'S')
+        {
+            oskar_grid_correction_function_spheroidal(size, 0,
+                    oskar_mem_double(corr_func, status));
+        }
+        else if (h->kernel_type == 'P')
+        {
+            oskar_grid_correction_function_pillbox(size,
+                    oskar_mem_double(corr_func, status));
+        }
+    }
+    h->corr_func = oskar_mem_convert_precision(corr_func,
+            h->imager_prec, status);
+    oskar_mem_free(corr_func, status);
+}
+
+#ifdef __cplusplus
+}
+#endif
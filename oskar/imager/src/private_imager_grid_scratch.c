@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef _WIN32
+#define _DEFAULT_SOURCE /* For mmap(), madvise(), mkstemp() and fileno(). */
+#endif
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_grid_scratch.h"
+#include "log/oskar_log.h"
+#include "utility/oskar_dir.h"
+
+#ifndef OSKAR_OS_WIN
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef OSKAR_OS_WIN
+/* Creates an unnamed scratch file, which is deleted when it is closed. */
+static FILE* scratch_file(const oskar_Imager* h)
+{
+    int fd = -1;
+    FILE* file = 0;
+    char* path = 0;
+    if (!h->grid_scratch_dir) return tmpfile();
+    if (!oskar_dir_mkpath(h->grid_scratch_dir)) return 0;
+    path = oskar_dir_get_path(h->grid_scratch_dir, "oskar_grid_XXXXXX");
+    fd = mkstemp(path);
+    if (fd >= 0)
+    {
+        (void) unlink(path);
+        file = fdopen(fd, "w+b");
+        if (!file) (void) close(fd);
+    }
+    free(path);
+    return file;
+}
+#endif
+
+
+int oskar_imager_grid_scratch_create(oskar_Imager* h, int plane_type,
+        size_t num_cells, int* status)
+{
+    int i = 0;
+    if (*status || h->grid_memory_mb <= 0.0) return 0;
+    const size_t budget = (size_t) (h->grid_memory_mb * 1024.0 * 1024.0);
+    const size_t plane_bytes = num_cells * oskar_mem_element_size(plane_type);
+    if (plane_bytes * h->num_planes <= budget) return 0;
+#ifdef OSKAR_OS_WIN
+    oskar_log_warning(h->log, "Memory-mapped image planes are not "
+            "supported on this platform: ignoring grid memory limit");
+    return 0;
+#else
+    /* Start each plane on a page boundary. */
+    const size_t page = (size_t) sysconf(_SC_PAGESIZE);
+    const size_t stride = page * ((plane_bytes + page - 1) / page);
+    const size_t map_size = stride * h->num_planes;
+    void* map = MAP_FAILED;
+
+    /* Create and map a sparse file large enough for all the planes. */
+    FILE* file = scratch_file(h);
+    if (file && !ftruncate(fileno(file), (off_t) map_size))
+    {
+        map = mmap(0, map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                fileno(file), 0);
+    }
+    if (map == MAP_FAILED)
+    {
+        if (file) (void) fclose(file);
+        oskar_log_error(h->log, "Could not create memory-mapped scratch "
+                "file for image planes in '%s'", h->grid_scratch_dir ?
+                        h->grid_scratch_dir : "temporary directory");
+        *status = OSKAR_ERR_FILE_IO;
+        return 0;
+    }
+    h->grid_map = map;
+    h->grid_map_size = map_size;
+    h->grid_map_stride = stride;
+    h->grid_map_file = file;
+    h->grid_map_last_used = (size_t*) calloc(h->num_planes, sizeof(size_t));
+    h->grid_map_use_count = 0;
+    h->grid_map_num_used = 0;
+    h->grid_map_max_used = (int) (budget / stride);
+    if (h->grid_map_max_used < 1) h->grid_map_max_used = 1;
+    if (!h->grid_map_last_used)
+    {
+        oskar_imager_grid_scratch_free(h);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+    for (i = 0; i < h->num_planes; ++i)
+    {
+        h->planes[i] = oskar_mem_create_alias_from_raw(
+                (char*) map + i * stride, plane_type, OSKAR_CPU,
+                num_cells, status);
+    }
+    oskar_log_message(h->log, 'M', 0, "Image planes are larger than "
+            "%.0f MB: using a memory-mapped scratch file", h->grid_memory_mb);
+    return 1;
+#endif
+}
+
+
+void oskar_imager_grid_scratch_use(oskar_Imager* h, const oskar_Mem* plane)
+{
+    int i = 0, i_plane = 0;
+    if (!h->grid_map || !plane) return;
+    const char* start = (const char*) h->grid_map;
+    const char* ptr = (const char*) oskar_mem_void_const(plane);
+    if (ptr < start || ptr >= start + h->grid_map_size) return;
+    i_plane = (int) ((size_t) (ptr - start) / h->grid_map_stride);
+
+    /* Release the most recently used planes to make room, if required. */
+    while (!h->grid_map_last_used[i_plane] &&
+            h->grid_map_num_used >= h->grid_map_max_used)
+    {
+        int i_release = -1;
+        size_t last_used = 0;
+        for (i = 0; i < h->num_planes; ++i)
+        {
+            if (h->grid_map_last_used[i] > last_used)
+            {
+                last_used = h->grid_map_last_used[i];
+                i_release = i;
+            }
+        }
+        if (i_release < 0) break;
+        oskar_imager_grid_scratch_release(h, i_release);
+    }
+    if (!h->grid_map_last_used[i_plane]) h->grid_map_num_used++;
+    h->grid_map_last_used[i_plane] = ++h->grid_map_use_count;
+}
+
+
+void oskar_imager_grid_scratch_release(oskar_Imager* h, int i_plane)
+{
+    int i = 0;
+    if (!h->grid_map) return;
+#ifndef OSKAR_OS_WIN
+    /* Pages of a shared file mapping are written back to the file, so
+     * dropping them does not lose their contents. */
+    if (i_plane < 0)
+    {
+        (void) madvise(h->grid_map, h->grid_map_size, MADV_DONTNEED);
+    }
+    else if (i_plane < h->num_planes)
+    {
+        (void) madvise((char*) h->grid_map + i_plane * h->grid_map_stride,
+                h->grid_map_stride, MADV_DONTNEED);
+    }
+#endif
+    for (i = 0; i < h->num_planes; ++i)
+    {
+        if ((i_plane < 0 || i == i_plane) && h->grid_map_last_used[i])
+        {
+            h->grid_map_last_used[i] = 0;
+            h->grid_map_num_used--;
+        }
+    }
+}
+
+
+void oskar_imager_grid_scratch_free(oskar_Imager* h)
+{
+#ifndef OSKAR_OS_WIN
+    if (h->grid_map) (void) munmap(h->grid_map, h->grid_map_size);
+#endif
+    if (h->grid_map_file) (void) fclose(h->grid_map_file);
+    free(h->grid_map_last_used);
+    h->grid_map = 0;
+    h->grid_map_last_used = 0;
+    h->grid_map_use_count = 0;
+    h->grid_map_num_used = 0;
+    h->grid_map_max_used = 0;
+    h->grid_map_size = 0;
+    h->grid_map_stride = 0;
+    h->grid_map_file = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+#include "imager/private_imager_half_plane.h"
+#include "math/oskar_fft.h"
+#include "utility/oskar_kernel_macros.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Column (margin + j) of each row of the half-plane holds column
+ * (size / 2 + j) of the full grid. The Hermitian partner of a cell at
+ * (j, iv) is at (-j, size - iv), with row indices modulo the grid size.
+ */
+#define HALF_PLANE_FUNCTIONS(S, FP)\
+static void fold_ ## S(const int size, const int width, FP* RESTRICT grid)\
+{\
+    int iv = 0;\
+    const int margin = width - size / 2 - 1;\
+    /* Add the conjugate of the margin to the columns it mirrors. */\
+    DO_PRAGMA(omp parallel for)\
+    for (iv = 0; iv < size; ++iv)\
+    {\
+        int c = 0;\
+        const size_t row_in = (size_t) width * iv;\
+        const size_t row_out = (size_t) width * ((size - iv) % size);\
+        for (c = 0; c < margin; ++c)\
+        {\
+            const size_t i = (row_in + c) << 1;\
+            const size_t j = (row_out + 2 * margin - c) << 1;\
+            grid[j]     += grid[i];\
+            grid[j + 1] -= grid[i + 1];\
+        }\
+    }\
+    /* Make the centre column symmetric. */\
+    for (iv = 0; iv <= size / 2; ++iv)\
+    {\
+        const size_t i = ((size_t) width * iv + margin) << 1;\
+        const size_t j = ((size_t) width * ((size - iv) % size) + margin) << 1;\
+        const FP re = grid[i] + grid[j], im = grid[i + 1] - grid[j + 1];\
+        grid[i] = re;\
+        grid[i + 1] = im;\
+        grid[j] = re;\
+        grid[j + 1] = -im;\
+    }\
+    /* Apply the phase factor to centre the image. */\
+    DO_PRAGMA(omp parallel for)\
+    for (iv = 0; iv < size; ++iv)\
+    {\
+        int c = 0;\
+        FP* row = grid + (((size_t) width * iv + margin) << 1);\
+        for (c = (iv & 1) ? 0 : 1; c <= size / 2; c += 2)\
+        {\
+            row[2 * c]     = -row[2 * c];\
+            row[2 * c + 1] = -row[2 * c + 1];\
+        }\
+    }\
+}\
+/* Scales and packs the rows of the real image, and applies the
+ * grid correction. Rows are processed in order, as they can overlap. */\
+static void unpack_ ## S(const int size, const int width,\
+        const FP* RESTRICT corr_func, FP* grid)\
+{\
+    int x = 0, y = 0;\
+    const int margin = width - size / 2 - 1;\
+    for (y = 0; y < size; ++y)\
+    {\
+        const FP* in = grid + (((size_t) width * y + margin) << 1);\
+        FP* out = grid + (size_t) size * y;\
+        const FP sign = ((y + size / 2) & 1) ? (FP) -0.5 : (FP) 0.5;\
+        const FP t = sign * corr_func[y];\
+        for (x = 0; x < size; ++x) out[x] = t * corr_func[x] * in[x];\
+    }\
+}\
+
+HALF_PLANE_FUNCTIONS(d, double)
+HALF_PLANE_FUNCTIONS(f, float)
+
+int oskar_imager_half_plane_width(oskar_Imager* h)
+{
+    int margin = 0, status = 0;
+    const int size = oskar_imager_plane_size(h);
+    if (!h->half_plane || size % 2 != 0 ||
+            ((h->grid_on_gpu || h->fft_on_gpu) && h->num_gpus > 0))
+    {
+        return 0;
+    }
+    if (h->algorithm == OSKAR_ALGORITHM_FFT)
+    {
+        margin = h->support;
+    }
+    else if (h->algorithm == OSKAR_ALGORITHM_WPROJ && h->w_support)
+    {
+        int i = 0;
+        const int* support = oskar_mem_int_const(h->w_support, &status);
+        for (i = 0; i < h->num_w_planes; ++i)
+        {
+            if (support[i] > margin) margin = support[i];
+        }
+    }
+    else
+    {
+        return 0;
+    }
+    return size / 2 + 1 + margin;
+}
+
+
+void oskar_imager_finalise_half_plane(oskar_Imager* h,
+        const oskar_Mem* corr_func, oskar_Mem* plane, int* status)
+{
+    if (*status) return;
+    const int size = oskar_imager_plane_size(h);
+    const int width = oskar_imager_half_plane_width(h);
+    if (oskar_mem_location(plane) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_LOCATION_MISMATCH;
+        return;
+    }
+    if (width == 0 || oskar_mem_length(plane) < (size_t) size * width)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+
+    /* Make the grid Hermitian and transform it. */
+    if (oskar_mem_precision(plane) == OSKAR_DOUBLE)
+    {
+        fold_d(size, width, oskar_mem_double(plane, status));
+    }
+    else
+    {
+        fold_f(size, width, oskar_mem_float(plane, status));
+    }
+    if (!h->fft)
+    {
+        h->fft = oskar_fft_create(h->imager_prec, OSKAR_CPU, 2, size, 0,
+                status);
+    }
+    oskar_fft_exec_c2r(h->fft, plane, width - size / 2 - 1, width, status);
+    if (*status) return;
+
+    /* Get the real image. */
+    if (oskar_mem_precision(plane) == OSKAR_DOUBLE)
+    {
+        unpack_d(size, width, oskar_mem_double_const(corr_func, status),
+                oskar_mem_double(plane, status));
+    }
+    else
+    {
+        unpack_f(size, width, oskar_mem_float_const(corr_func, status),
+                oskar_mem_float(plane, status));
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
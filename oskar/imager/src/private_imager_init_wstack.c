@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+
+#include "imager/private_imager_init_fft.h"
+#include "imager/private_imager_init_wstack.h"
+#include "imager/private_imager_update_plane_wstack.h"
+#include "math/oskar_cmath.h"
+#include "math/oskar_fft.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum phase error (radians) allowed from the nearest W-layer. */
+#define MAX_PHASE_ERROR 0.1
+
+/* Memory limit for the resident layer grids, in MB. */
+#define MAX_LAYER_MEMORY_MB 2048
+
+void oskar_imager_init_wstack(oskar_Imager* h, int* status)
+{
+    if (*status) return;
+
+    /* W-stacking is done on the CPU. */
+    if (h->grid_on_gpu || h->fft_on_gpu)
+    {
+        oskar_log_warning(h->log,
+                "W-stacking uses the CPU for gridding and FFTs.");
+        h->grid_on_gpu = 0;
+        h->fft_on_gpu = 0;
+    }
+
+    /* Generate the convolution function for each layer. */
+    oskar_imager_init_fft(h, status);
+    if (*status) return;
+
+    /* Evaluate the layer spacing. If the number of layers is given and the
+     * range of W is known, the layers span the range; otherwise the spacing
+     * limits the phase error at the corner of the image. */
+    if (h->num_w_planes > 0 && h->ww_max > 0.0)
+    {
+        h->w_scale = (h->num_w_planes - 1) / h->ww_max;
+    }
+    else
+    {
+        const double l_max = h->cellsize_rad * h->image_size / 2.0;
+        const double r_sq = 2.0 * l_max * l_max;
+        const double n_min = r_sq < 1.0 ? sqrt(1.0 - r_sq) : 0.0;
+        h->w_scale = (M_PI * (1.0 - n_min)) / MAX_PHASE_ERROR;
+        if (h->ww_max > 0.0)
+        {
+            h->num_w_planes = 1 + (int) ceil(h->ww_max * h->w_scale);
+        }
+    }
+
+    /* Create the FFT plan and scratch arrays.
+     * Layer grids are allocated when first needed, up to the limit. */
+    const int plane_size = oskar_imager_plane_size(h);
+    const int type = h->imager_prec | OSKAR_COMPLEX;
+    const double layer_mb = (double) plane_size * (double) plane_size *
+            oskar_mem_element_size(type) / (1024.0 * 1024.0);
+    oskar_fft_free(h->fft);
+    h->fft = oskar_fft_create(h->imager_prec, OSKAR_CPU, 2, plane_size, 0,
+            status);
+    oskar_imager_free_wstack_layers(h, status);
+    oskar_mem_free(h->layer_uu, status);
+    oskar_mem_free(h->layer_vv, status);
+    oskar_mem_free(h->layer_vis, status);
+    h->layer_uu = oskar_mem_create(h->imager_prec, OSKAR_CPU, 0, status);
+    h->layer_vv = oskar_mem_create(h->imager_prec, OSKAR_CPU, 0, status);
+    h->layer_vis = oskar_mem_create(type, OSKAR_CPU, 0, status);
+    h->max_layers = (int) (MAX_LAYER_MEMORY_MB / layer_mb);
+    if (h->max_layers < 1) h->max_layers = 1;
+
+    /* Record data about the layers. */
+    if (h->ww_max > 0.0)
+    {
+        oskar_log_message(h->log, 'M', 0, "Baseline W values (wavelengths)");
+        oskar_log_message(h->log, 'M', 1, "Min: %.12e", h->ww_min);
+        oskar_log_message(h->log, 'M', 1, "Max: %.12e", h->ww_max);
+        oskar_log_message(h->log, 'M', 1, "RMS: %.12e", h->ww_rms);
+        oskar_log_message(h->log, 'M', 0,
+                "Using %d W-layers.", h->num_w_planes);
+    }
+    if (h->w_scale > 0.0)
+    {
+        oskar_log_message(h->log, 'M', 0,
+                "W-layer spacing is %.3f wavelengths.", 1.0 / h->w_scale);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,7 +4,9 @@
  */
 
 #include "imager/private_imager.h"
+#include "imager/private_imager_coord_cache.h"
 #include "imager/private_imager_read_coords.h"
+#include "imager/private_imager_update_channels.h"
 #include "imager/oskar_imager.h"
 #include "binary/oskar_binary.h"
 #include "convert/oskar_convert_station_uvw_to_baseline_uvw.h"
@@ -99,9 +101,16 @@ void oskar_imager_read_coords_ms(oskar_Imager* h, const char* filename,
             v_[i] = uvw_[3*i + 1];
             w_[i] = uvw_[3*i + 2];
         }
+        oskar_timer_pause(h->tmr_read);
+
+        /* Cache the coordinates and weights for the visibility data pass. */
+        oskar_imager_coord_cache_put(h, u, block_size);
+        oskar_imager_coord_cache_put(h, v, block_size);
+        oskar_imager_coord_cache_put(h, w, block_size);
+        oskar_imager_coord_cache_put(h, weight, block_size * num_pols);
+        oskar_imager_coord_cache_put(h, time_centroid, block_size);
 
         /* Update the imager with the data. */
-        oskar_timer_pause(h->tmr_read);
         oskar_imager_update(h, block_size, 0, num_channels - 1,
                 num_pols, u, v, w, 0, weight, time_centroid, status);
         *percent_done = (int) round(100.0 * (
@@ -191,7 +200,7 @@ void oskar_imager_read_coords_vis(oskar_Imager* h, const char* filename,
     /* Loop over visibility blocks. */
     for (i_block = 0; i_block < num_blocks; ++i_block)
     {
-        int c = 0, t = 0, dim_start_and_size[6], tag_error = 0;
+        int t = 0, dim_start_and_size[6], tag_error = 0;
         if (*status) break;
 
         /* Read block metadata. */
@@ -249,21 +258,17 @@ void oskar_imager_read_coords_vis(oskar_Imager* h, const char* filename,
                     OSKAR_VIS_BLOCK_TAG_BASELINE_WW, i_block, status);
         }
 
-        /* Update the imager with the data. */
         oskar_timer_pause(h->tmr_read);
-        for (c = 0; c < num_channels; ++c)
-        {
-            /* Update per channel. */
-            const double freq_hz =
-                    freq_start_hz + (start_chan + c) * freq_inc_hz;
-            if (freq_hz >= h->freq_min_hz &&
-                    (freq_hz <= h->freq_max_hz || h->freq_max_hz == 0.0))
-            {
-                oskar_imager_update(h, num_rows,
-                        start_chan + c, start_chan + c, num_pols,
-                        uu, vv, ww, 0, weight, time_centroid, status);
-            }
-        }
+
+        /* Cache the coordinates for the visibility data pass. */
+        oskar_imager_coord_cache_put(h, uu, num_rows);
+        oskar_imager_coord_cache_put(h, vv, num_rows);
+        oskar_imager_coord_cache_put(h, ww, num_rows);
+
+        /* Update the imager with the data. */
+        oskar_imager_update_channels(h, num_baselines, num_times,
+                start_chan, num_channels, num_pols,
+                uu, vv, ww, 0, weight, time_centroid, 0, status);
         *percent_done = (int) round(100.0 * (
                 (i_block + 1) / (double)(num_blocks * num_files) +
                 i_file / (double)num_files));
@@ -1,15 +1,18 @@
 /*
- * Copyright (c) 2017-2021, The OSKAR Developers.
+ * Copyright (c) 2017-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "imager/private_imager.h"
+#include "imager/private_imager_coord_cache.h"
 #include "imager/private_imager_read_data.h"
+#include "imager/private_imager_update_channels.h"
 #include "imager/oskar_imager.h"
 #include "binary/oskar_binary.h"
 #include "math/oskar_cmath.h"
 #include "mem/oskar_binary_read_mem.h"
 #include "ms/oskar_measurement_set.h"
+#include "utility/oskar_thread.h"
 #include "utility/oskar_timer.h"
 #include "vis/oskar_vis_block.h"
 #include "vis/oskar_vis_header.h"
@@ -23,116 +26,349 @@
 extern "C" {
 #endif
 
+/* Number of blocks that can be held in the read queue. */
+#define NUM_READ_BUFFERS 2
+
+/*
+ * The input file is read by a separate thread, so that the next block can
+ * be read while the current one is being imaged.
+ * The reader fills the buffers in turn, and waits for the imager to release
+ * a buffer before reading into it again.
+ * If the coordinates were cached during the first pass, only the
+ * visibility amplitudes are read from the file.
+ */
+typedef struct ReadBuffer
+{
+    oskar_Mem *uvw, *uu, *vv, *ww, *weight, *time_centroid, *data;
+    oskar_VisBlock* block;
+    size_t start_row, num_rows;
+} ReadBuffer;
+
+typedef struct ReadQueue ReadQueue;
+struct ReadQueue
+{
+    ReadBuffer buffer[NUM_READ_BUFFERS];
+    void (*read_block)(ReadQueue* q, int i_block, ReadBuffer* buf,
+            int* status);
+    oskar_ConditionVar* cond;
+    oskar_Thread* thread;
+    oskar_Timer* tmr_io;
+    oskar_Imager* h;
+    int num_blocks, num_read, num_released, stop, status, use_cache;
+
+    /* Measurement Set input. */
+    oskar_MeasurementSet* ms;
+    const char* ms_column;
+    size_t ms_num_rows, ms_rows_per_block;
+
+    /* OSKAR visibility file input. */
+    oskar_Binary* vis_file;
+    oskar_VisHeader* hdr;
+    int tags_per_block, num_baselines;
+    double time_start_sec, time_inc_sec;
+};
+
+static void* read_thread(void* arg)
+{
+    ReadQueue* q = (ReadQueue*) arg;
+    int i_block = 0;
+    for (i_block = 0; i_block < q->num_blocks; ++i_block)
+    {
+        int stop = 0, status = 0;
+
+        /* Wait for a free buffer. */
+        oskar_condition_lock(q->cond);
+        while (!q->stop && i_block - q->num_released >= NUM_READ_BUFFERS)
+        {
+            oskar_condition_wait(q->cond);
+        }
+        stop = q->stop;
+        oskar_condition_unlock(q->cond);
+        if (stop) break;
+
+        /* Read the block, and pass it (or the error) to the imager. */
+        oskar_timer_resume(q->tmr_io);
+        q->read_block(q, i_block, &q->buffer[i_block % NUM_READ_BUFFERS],
+                &status);
+        oskar_timer_pause(q->tmr_io);
+        oskar_condition_lock(q->cond);
+        if (status)
+        {
+            q->status = status;
+        }
+        else
+        {
+            q->num_read = i_block + 1;
+        }
+        oskar_condition_notify_all(q->cond);
+        oskar_condition_unlock(q->cond);
+        if (status) break;
+    }
+    return 0;
+}
+
+static void queue_start(ReadQueue* q, oskar_Imager* h, int num_blocks)
+{
+    q->cond = oskar_condition_create();
+    q->tmr_io = h->tmr_read_io;
+    q->h = h;
+    q->use_cache = h->coord_cache_read;
+    q->num_blocks = num_blocks;
+    q->thread = oskar_thread_create(read_thread, (void*) q, 0);
+}
+
+/* Returns the buffer holding the given block, once it has been read. */
+static ReadBuffer* queue_wait(ReadQueue* q, int i_block,
+        oskar_Timer* tmr_wait, int* status)
+{
+    ReadBuffer* buf = 0;
+    oskar_timer_resume(tmr_wait);
+    oskar_condition_lock(q->cond);
+    while (q->num_read <= i_block && !q->status)
+    {
+        oskar_condition_wait(q->cond);
+    }
+    if (q->num_read > i_block)
+    {
+        buf = &q->buffer[i_block % NUM_READ_BUFFERS];
+    }
+    else
+    {
+        *status = q->status;
+    }
+    oskar_condition_unlock(q->cond);
+    oskar_timer_pause(tmr_wait);
+    return buf;
+}
+
+static void queue_release(ReadQueue* q, int i_block)
+{
+    oskar_condition_lock(q->cond);
+    q->num_released = i_block + 1;
+    oskar_condition_notify_all(q->cond);
+    oskar_condition_unlock(q->cond);
+}
+
+static void queue_stop(ReadQueue* q, int* status)
+{
+    int i = 0;
+    if (q->thread)
+    {
+        oskar_condition_lock(q->cond);
+        q->stop = 1;
+        oskar_condition_notify_all(q->cond);
+        oskar_condition_unlock(q->cond);
+        oskar_thread_join(q->thread);
+        oskar_thread_free(q->thread);
+    }
+    oskar_condition_free(q->cond);
+    for (i = 0; i < NUM_READ_BUFFERS; ++i)
+    {
+        ReadBuffer* buf = &q->buffer[i];
+        oskar_mem_free(buf->uvw, status);
+        oskar_mem_free(buf->uu, status);
+        oskar_mem_free(buf->vv, status);
+        oskar_mem_free(buf->ww, status);
+        oskar_mem_free(buf->weight, status);
+        oskar_mem_free(buf->time_centroid, status);
+        oskar_mem_free(buf->data, status);
+        oskar_vis_block_free(buf->block, status);
+    }
+}
+
+#ifndef OSKAR_NO_MS
+static void read_column(ReadQueue* q, const char* column, size_t start_row,
+        size_t num_rows, oskar_Mem* mem, int* status)
+{
+    size_t required = 0;
+    const size_t allocated = oskar_mem_length(mem) *
+            oskar_mem_element_size(oskar_mem_type(mem));
+    oskar_ms_read_column(q->ms, column, start_row, num_rows,
+            allocated, oskar_mem_void(mem), &required, status);
+}
+
+static void read_block_ms(ReadQueue* q, int i_block, ReadBuffer* buf,
+        int* status)
+{
+    size_t i = 0;
+    const size_t start_row = i_block * q->ms_rows_per_block;
+    size_t block_size = q->ms_num_rows - start_row;
+    if (block_size > q->ms_rows_per_block) block_size = q->ms_rows_per_block;
+
+    /* Read rows from Measurement Set. */
+    read_column(q, q->ms_column, start_row, block_size, buf->data, status);
+    buf->start_row = start_row;
+    buf->num_rows = block_size;
+    if (q->use_cache)
+    {
+        /* Get coordinates in the same order as they were cached. */
+        oskar_imager_coord_cache_get(q->h, buf->uu, status);
+        oskar_imager_coord_cache_get(q->h, buf->vv, status);
+        oskar_imager_coord_cache_get(q->h, buf->ww, status);
+        oskar_imager_coord_cache_get(q->h, buf->weight, status);
+        oskar_imager_coord_cache_get(q->h, buf->time_centroid, status);
+        return;
+    }
+    read_column(q, "UVW", start_row, block_size, buf->uvw, status);
+    read_column(q, "WEIGHT", start_row, block_size, buf->weight, status);
+    read_column(q, "TIME_CENTROID", start_row, block_size,
+            buf->time_centroid, status);
+    if (*status) return;
+
+    /* Split up baseline coordinates. */
+    const double* uvw_ = oskar_mem_double_const(buf->uvw, status);
+    double* u_ = oskar_mem_double(buf->uu, status);
+    double* v_ = oskar_mem_double(buf->vv, status);
+    double* w_ = oskar_mem_double(buf->ww, status);
+    for (i = 0; i < block_size; ++i)
+    {
+        u_[i] = uvw_[3*i + 0];
+        v_[i] = uvw_[3*i + 1];
+        w_[i] = uvw_[3*i + 2];
+    }
+}
+#endif
+
+static void read_block_vis(ReadQueue* q, int i_block, ReadBuffer* buf,
+        int* status)
+{
+    int t = 0;
+    oskar_VisBlock* block = buf->block;
+    if (q->use_cache)
+    {
+        int dim_start_and_size[6];
+
+        /* Read only the block dimensions and cross-correlations. */
+        oskar_binary_set_query_search_start(q->vis_file,
+                oskar_vis_header_num_tags_header(q->hdr) +
+                i_block * q->tags_per_block, status);
+        oskar_binary_read(q->vis_file, OSKAR_INT,
+                OSKAR_TAG_GROUP_VIS_BLOCK,
+                OSKAR_VIS_BLOCK_TAG_DIM_START_AND_SIZE, i_block,
+                sizeof(dim_start_and_size), dim_start_and_size, status);
+        if (*status) return;
+        oskar_vis_block_set_start_time_index(block, dim_start_and_size[0]);
+        oskar_vis_block_set_start_channel_index(block, dim_start_and_size[1]);
+        oskar_vis_block_resize(block, dim_start_and_size[2],
+                dim_start_and_size[3], oskar_vis_block_num_stations(block),
+                status);
+        oskar_binary_read_mem(q->vis_file,
+                oskar_vis_block_cross_correlations(block),
+                OSKAR_TAG_GROUP_VIS_BLOCK,
+                OSKAR_VIS_BLOCK_TAG_CROSS_CORRELATIONS, i_block, status);
+
+        /* Get coordinates in the same order as they were cached. */
+        oskar_imager_coord_cache_get(q->h,
+                oskar_vis_block_baseline_uu_metres(block), status);
+        oskar_imager_coord_cache_get(q->h,
+                oskar_vis_block_baseline_vv_metres(block), status);
+        oskar_imager_coord_cache_get(q->h,
+                oskar_vis_block_baseline_ww_metres(block), status);
+    }
+    else
+    {
+        oskar_binary_set_query_search_start(q->vis_file,
+                i_block * q->tags_per_block, status);
+        oskar_vis_block_read(block, q->hdr, q->vis_file, i_block, status);
+    }
+    if (*status) return;
+
+    /* Fill in the time centroid values. */
+    const int start_time = oskar_vis_block_start_time_index(block);
+    const int num_times = oskar_vis_block_num_times(block);
+    for (t = 0; t < num_times; ++t)
+    {
+        oskar_mem_set_value_real(buf->time_centroid,
+                q->time_start_sec + (start_time + t + 0.5) * q->time_inc_sec,
+                t * q->num_baselines, q->num_baselines, status);
+    }
+}
+
 void oskar_imager_read_data_ms(oskar_Imager* h, const char* filename,
         int i_file, int num_files, int* percent_done, int* percent_next,
         int* status)
 {
 #ifndef OSKAR_NO_MS
-    oskar_MeasurementSet* ms = 0;
-    oskar_Mem *uvw = 0, *u = 0, *v = 0, *w = 0, *data = 0;
-    oskar_Mem *weight = 0, *time_centroid = 0;
-    int type = 0;
-    size_t start_row = 0;
-    double *uvw_ = 0, *u_ = 0, *v_ = 0, *w_ = 0;
+    ReadQueue q;
+    int i = 0, i_block = 0, type = 0;
     if (*status) return;
 
     /* Read the header. */
     oskar_log_message(h->log, 'M', 0, "Opening Measurement Set '%s'", filename);
-    ms = oskar_ms_open_readonly(filename);
-    if (!ms)
+    memset(&q, 0, sizeof(ReadQueue));
+    q.ms = oskar_ms_open_readonly(filename);
+    if (!q.ms)
     {
         *status = OSKAR_ERR_FILE_IO;
         return;
     }
-    const size_t num_rows = (size_t) oskar_ms_num_rows(ms);
-    const size_t num_stations = (size_t) oskar_ms_num_stations(ms);
+    const size_t num_rows = (size_t) oskar_ms_num_rows(q.ms);
+    const size_t num_stations = (size_t) oskar_ms_num_stations(q.ms);
     const size_t num_baselines = num_stations * (num_stations - 1) / 2;
-    const int num_pols = (int) oskar_ms_num_pols(ms);
-    const int num_channels = (int) oskar_ms_num_channels(ms);
+    const int num_pols = (int) oskar_ms_num_pols(q.ms);
+    const int num_channels = (int) oskar_ms_num_channels(q.ms);
+    const int num_blocks = num_baselines > 0 ?
+            (int) ((num_rows + num_baselines - 1) / num_baselines) : 0;
+    q.ms_column = h->ms_column;
+    q.ms_num_rows = num_rows;
+    q.ms_rows_per_block = num_baselines;
+    q.read_block = read_block_ms;
 
     /* Set visibility meta-data. */
     oskar_imager_set_vis_frequency(h,
-            oskar_ms_freq_start_hz(ms),
-            oskar_ms_freq_inc_hz(ms), num_channels);
+            oskar_ms_freq_start_hz(q.ms),
+            oskar_ms_freq_inc_hz(q.ms), num_channels);
     oskar_imager_set_vis_phase_centre(h,
-            oskar_ms_phase_centre_ra_rad(ms) * 180/M_PI,
-            oskar_ms_phase_centre_dec_rad(ms) * 180/M_PI);
+            oskar_ms_phase_centre_ra_rad(q.ms) * 180/M_PI,
+            oskar_ms_phase_centre_dec_rad(q.ms) * 180/M_PI);
 
     /* Create arrays. */
-    uvw = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, 3 * num_baselines, status);
-    u = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    v = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    w = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines, status);
-    weight = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU,
-            num_baselines * num_pols, status);
-    time_centroid = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_baselines,
-            status);
-    uvw_ = oskar_mem_double(uvw, status);
-    u_ = oskar_mem_double(u, status);
-    v_ = oskar_mem_double(v, status);
-    w_ = oskar_mem_double(w, status);
     type = OSKAR_SINGLE | OSKAR_COMPLEX;
     if (num_pols == 4) type |= OSKAR_MATRIX;
-    data = oskar_mem_create(type, OSKAR_CPU,
-            num_baselines * num_channels, status);
-
-    /* Loop over visibility blocks. */
-    for (start_row = 0; start_row < num_rows; start_row += num_baselines)
+    for (i = 0; i < NUM_READ_BUFFERS; ++i)
     {
-        size_t allocated = 0, required = 0, block_size = 0, i = 0;
-        if (*status) break;
+        ReadBuffer* buf = &q.buffer[i];
+        buf->uvw = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                3 * num_baselines, status);
+        buf->uu = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                num_baselines, status);
+        buf->vv = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                num_baselines, status);
+        buf->ww = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                num_baselines, status);
+        buf->weight = oskar_mem_create(OSKAR_SINGLE, OSKAR_CPU,
+                num_baselines * num_pols, status);
+        buf->time_centroid = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+                num_baselines, status);
+        buf->data = oskar_mem_create(type, OSKAR_CPU,
+                num_baselines * num_channels, status);
+    }
 
-        /* Read rows from Measurement Set. */
-        oskar_timer_resume(h->tmr_read);
-        block_size = num_rows - start_row;
-        if (block_size > num_baselines) block_size = num_baselines;
-        allocated = oskar_mem_length(uvw) *
-                oskar_mem_element_size(oskar_mem_type(uvw));
-        oskar_ms_read_column(ms, "UVW", start_row, block_size,
-                allocated, oskar_mem_void(uvw), &required, status);
-        allocated = oskar_mem_length(weight) *
-                oskar_mem_element_size(oskar_mem_type(weight));
-        oskar_ms_read_column(ms, "WEIGHT", start_row, block_size,
-                allocated, oskar_mem_void(weight), &required, status);
-        allocated = oskar_mem_length(time_centroid) *
-                oskar_mem_element_size(oskar_mem_type(time_centroid));
-        oskar_ms_read_column(ms, "TIME_CENTROID", start_row, block_size,
-                allocated, oskar_mem_void(time_centroid), &required, status);
-        allocated = oskar_mem_length(data) *
-                oskar_mem_element_size(oskar_mem_type(data));
-        oskar_ms_read_column(ms, h->ms_column, start_row, block_size,
-                allocated, oskar_mem_void(data), &required, status);
+    /* Loop over visibility blocks as they are read. */
+    if (!*status) queue_start(&q, h, num_blocks);
+    for (i_block = 0; i_block < num_blocks; ++i_block)
+    {
         if (*status) break;
-
-        /* Split up baseline coordinates. */
-        for (i = 0; i < block_size; ++i)
-        {
-            u_[i] = uvw_[3*i + 0];
-            v_[i] = uvw_[3*i + 1];
-            w_[i] = uvw_[3*i + 2];
-        }
+        const ReadBuffer* buf = queue_wait(&q, i_block, h->tmr_read, status);
+        if (!buf) break;
 
         /* Update the imager with the data. */
-        oskar_timer_pause(h->tmr_read);
-        oskar_imager_update(h, block_size, 0, num_channels - 1,
-                num_pols, u, v, w, data, weight, time_centroid, status);
+        oskar_imager_update(h, buf->num_rows, 0, num_channels - 1,
+                num_pols, buf->uu, buf->vv, buf->ww, buf->data, buf->weight,
+                buf->time_centroid, status);
         *percent_done = (int) round(100.0 * (
-                (start_row + block_size) / (double)(num_rows * num_files) +
+                (buf->start_row + buf->num_rows) /
+                (double)(num_rows * num_files) +
                 i_file / (double)num_files));
+        queue_release(&q, i_block);
         if (percent_next && *percent_done >= *percent_next)
         {
             oskar_log_message(h->log, 'S', -2, "%3d%% ...", *percent_done);
             *percent_next = 10 + 10 * (*percent_done / 10);
         }
     }
-    oskar_mem_free(uvw, status);
-    oskar_mem_free(u, status);
-    oskar_mem_free(v, status);
-    oskar_mem_free(w, status);
-    oskar_mem_free(data, status);
-    oskar_mem_free(weight, status);
-    oskar_mem_free(time_centroid, status);
-    oskar_ms_close(ms);
+    queue_stop(&q, status);
+    oskar_ms_close(q.ms);
 #else
     (void) filename;
     (void) i_file;
@@ -150,106 +386,80 @@ void oskar_imager_read_data_vis(oskar_Imager* h, const char* filename,
         int i_file, int num_files, int* percent_done, int* percent_next,
         int* status)
 {
-    oskar_Binary* vis_file = 0;
-    oskar_VisBlock* block = 0;
-    oskar_VisHeader* hdr = 0;
-    oskar_Mem *weight = 0, *time_centroid = 0, *scratch = 0;
-    int i_block = 0;
-    double time_start_mjd = 0.0, time_inc_sec = 0.0;
+    ReadQueue q;
+    oskar_Mem *weight = 0, *scratch = 0;
+    int i = 0, i_block = 0;
     if (*status) return;
 
     /* Read the header. */
     oskar_log_message(h->log, 'M', 0, "Opening '%s'", filename);
-    vis_file = oskar_binary_create(filename, 'r', status);
-    hdr = oskar_vis_header_read(vis_file, status);
+    memset(&q, 0, sizeof(ReadQueue));
+    q.vis_file = oskar_binary_create(filename, 'r', status);
+    q.hdr = oskar_vis_header_read(q.vis_file, status);
     if (*status)
     {
-        oskar_vis_header_free(hdr, status);
-        oskar_binary_free(vis_file);
+        oskar_vis_header_free(q.hdr, status);
+        oskar_binary_free(q.vis_file);
         return;
     }
-    const int max_times_per_block = oskar_vis_header_max_times_per_block(hdr);
-    const int tags_per_block = oskar_vis_header_num_tags_per_block(hdr);
-    const int num_stations = oskar_vis_header_num_stations(hdr);
+    const int max_times_per_block =
+            oskar_vis_header_max_times_per_block(q.hdr);
+    const int num_stations = oskar_vis_header_num_stations(q.hdr);
     const int num_baselines = num_stations * (num_stations - 1) / 2;
     const int num_pols =
-            oskar_type_is_matrix(oskar_vis_header_amp_type(hdr)) ? 4 : 1;
+            oskar_type_is_matrix(oskar_vis_header_amp_type(q.hdr)) ? 4 : 1;
     const int num_weights = num_baselines * num_pols * max_times_per_block;
-    const int num_blocks = oskar_vis_header_num_blocks(hdr);
-    const double freq_inc_hz = oskar_vis_header_freq_inc_hz(hdr);
-    const double freq_start_hz = oskar_vis_header_freq_start_hz(hdr);
-    time_start_mjd = oskar_vis_header_time_start_mjd_utc(hdr) * 86400.0;
-    time_inc_sec = oskar_vis_header_time_inc_sec(hdr);
+    const int num_blocks = oskar_vis_header_num_blocks(q.hdr);
+    const double freq_inc_hz = oskar_vis_header_freq_inc_hz(q.hdr);
+    const double freq_start_hz = oskar_vis_header_freq_start_hz(q.hdr);
+    q.tags_per_block = oskar_vis_header_num_tags_per_block(q.hdr);
+    q.num_baselines = num_baselines;
+    q.time_start_sec = oskar_vis_header_time_start_mjd_utc(q.hdr) * 86400.0;
+    q.time_inc_sec = oskar_vis_header_time_inc_sec(q.hdr);
+    q.read_block = read_block_vis;
 
     /* Set visibility meta-data. */
     oskar_imager_set_vis_frequency(h, freq_start_hz, freq_inc_hz,
-            oskar_vis_header_num_channels_total(hdr));
+            oskar_vis_header_num_channels_total(q.hdr));
     oskar_imager_set_vis_phase_centre(h,
-            oskar_vis_header_phase_centre_ra_deg(hdr),
-            oskar_vis_header_phase_centre_dec_deg(hdr));
+            oskar_vis_header_phase_centre_ra_deg(q.hdr),
+            oskar_vis_header_phase_centre_dec_deg(q.hdr));
 
     /* Create scratch arrays. Weights are all 1. */
-    time_centroid = oskar_mem_create(OSKAR_DOUBLE,
-            OSKAR_CPU, num_baselines * max_times_per_block, status);
     weight = oskar_mem_create(h->imager_prec, OSKAR_CPU, num_weights, status);
     oskar_mem_set_value_real(weight, 1.0, 0, num_weights, status);
-    scratch = oskar_mem_create(oskar_vis_header_amp_type(hdr), OSKAR_CPU,
+    scratch = oskar_mem_create(oskar_vis_header_amp_type(q.hdr), OSKAR_CPU,
             num_baselines * max_times_per_block, status);
+    for (i = 0; i < NUM_READ_BUFFERS; ++i)
+    {
+        ReadBuffer* buf = &q.buffer[i];
+        buf->time_centroid = oskar_mem_create(OSKAR_DOUBLE,
+                OSKAR_CPU, num_baselines * max_times_per_block, status);
+        buf->block = oskar_vis_block_create_from_header(OSKAR_CPU,
+                q.hdr, status);
+    }
 
-    /* Loop over visibility blocks. */
-    block = oskar_vis_block_create_from_header(OSKAR_CPU, hdr, status);
+    /* Loop over visibility blocks as they are read. */
+    if (!*status) queue_start(&q, h, num_blocks);
     for (i_block = 0; i_block < num_blocks; ++i_block)
     {
-        int c = 0, t = 0;
         if (*status) break;
-
-        /* Read the visibility data. */
-        oskar_timer_resume(h->tmr_read);
-        oskar_binary_set_query_search_start(vis_file,
-                i_block * tags_per_block, status);
-        oskar_vis_block_read(block, hdr, vis_file, i_block, status);
-        const int start_time   = oskar_vis_block_start_time_index(block);
+        const ReadBuffer* buf = queue_wait(&q, i_block, h->tmr_read, status);
+        if (!buf) break;
+        oskar_VisBlock* block = buf->block;
         const int start_chan   = oskar_vis_block_start_channel_index(block);
         const int num_times    = oskar_vis_block_num_times(block);
         const int num_channels = oskar_vis_block_num_channels(block);
-        const size_t num_rows  = num_times * num_baselines;
-
-        /* Fill in the time centroid values. */
-        for (t = 0; t < num_times; ++t)
-        {
-            oskar_mem_set_value_real(time_centroid,
-                    time_start_mjd + (start_time + t + 0.5) * time_inc_sec,
-                    t * num_baselines, num_baselines, status);
-        }
-        oskar_timer_pause(h->tmr_read);
 
         /* Update the imager with the data. */
-        for (c = 0; c < num_channels; ++c)
-        {
-            /* Update per channel. */
-            const double freq_hz =
-                    freq_start_hz + (start_chan + c) * freq_inc_hz;
-            if (freq_hz >= h->freq_min_hz &&
-                    (freq_hz <= h->freq_max_hz || h->freq_max_hz == 0.0))
-            {
-                oskar_timer_resume(h->tmr_copy_convert);
-                for (t = 0; t < num_times; ++t)
-                {
-                    oskar_mem_copy_contents(scratch,
-                            oskar_vis_block_cross_correlations(block),
-                            num_baselines * t,
-                            num_baselines * (num_channels * t + c),
-                            num_baselines, status);
-                }
-                oskar_timer_pause(h->tmr_copy_convert);
-                oskar_imager_update(h, num_rows,
-                        start_chan + c, start_chan + c, num_pols,
-                        oskar_vis_block_baseline_uu_metres_const(block),
-                        oskar_vis_block_baseline_vv_metres_const(block),
-                        oskar_vis_block_baseline_ww_metres_const(block),
-                        scratch, weight, time_centroid, status);
-            }
-        }
+        oskar_imager_update_channels(h, num_baselines, num_times,
+                start_chan, num_channels, num_pols,
+                oskar_vis_block_baseline_uu_metres_const(block),
+                oskar_vis_block_baseline_vv_metres_const(block),
+                oskar_vis_block_baseline_ww_metres_const(block),
+                oskar_vis_block_cross_correlations_const(block),
+                weight, buf->time_centroid, scratch, status);
+        queue_release(&q, i_block);
         *percent_done = (int) round(100.0 * (
                 (i_block + 1) / (double)(num_blocks * num_files) +
                 i_file / (double)num_files));
@@ -259,12 +469,11 @@ void oskar_imager_read_data_vis(oskar_Imager* h, const char* filename,
             *percent_next = 10 + 10 * (*percent_done / 10);
         }
     }
+    queue_stop(&q, status);
     oskar_mem_free(scratch, status);
     oskar_mem_free(weight, status);
-    oskar_mem_free(time_centroid, status);
-    oskar_vis_block_free(block, status);
-    oskar_vis_header_free(hdr, status);
-    oskar_binary_free(vis_file);
+    oskar_vis_header_free(q.hdr, status);
+    oskar_binary_free(q.vis_file);
 }
 
 #ifdef __cplusplus
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -8,6 +8,7 @@
 
 #include "imager/private_imager_select_data.h"
 #include <math.h>
+#include <stdlib.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,55 @@ void copy_vis_pol(size_t num_rows, int num_channels, int num_pols,
     }\
     }
 
+/* Outputs are ordered by row and then by selected channel. */
+#define COPY_SYNTH_CPU(FP, FP2) {\
+    size_t r = 0;\
+    FP *uu_o = 0, *vv_o = 0, *ww_o = 0, *wt_o = 0;\
+    FP2 *vis_o = 0;\
+    double *time_o = 0;\
+    const FP *uu_i = 0, *vv_i = 0, *ww_i = 0, *wt_i = 0;\
+    const FP2 *vis_i = 0;\
+    const double *time_i = 0;\
+    uu_o = (FP*) oskar_mem_void(uu_out);\
+    vv_o = (FP*) oskar_mem_void(vv_out);\
+    ww_o = (FP*) oskar_mem_void(ww_out);\
+    wt_o = (FP*) oskar_mem_void(weight_out);\
+    uu_i = (const FP*) oskar_mem_void_const(uu_in);\
+    vv_i = (const FP*) oskar_mem_void_const(vv_in);\
+    ww_i = (const FP*) oskar_mem_void_const(ww_in);\
+    wt_i = (const FP*) oskar_mem_void_const(weight_in);\
+    if (!h->coords_only && vis_in && vis_out) {\
+        vis_o = (FP2*) oskar_mem_void(vis_out);\
+        vis_i = (const FP2*) oskar_mem_void_const(vis_in);\
+    }\
+    if (time_in && time_out) {\
+        time_o = oskar_mem_double(time_out, status);\
+        time_i = oskar_mem_double_const(time_in, status);\
+    }\
+    for (r = 0; r < num_rows; ++r) {\
+        int k = 0;\
+        const FP uu_r = uu_i[r], vv_r = vv_i[r], ww_r = ww_i[r];\
+        const FP wt_r = wt_i[num_pols * r + p];\
+        const size_t out = r * num_sel;\
+        for (k = 0; k < num_sel; ++k) {\
+            const FP scale = (FP) sel_scale[k];\
+            uu_o[out + k] = uu_r * scale;\
+            vv_o[out + k] = vv_r * scale;\
+            ww_o[out + k] = ww_r * scale;\
+            wt_o[out + k] = wt_r;\
+        }\
+        if (vis_o) {\
+            const FP2* vis_r = vis_i + (size_t) num_pols * num_channels * r;\
+            for (k = 0; k < num_sel; ++k) {\
+                vis_o[out + k] = vis_r[num_pols * sel_chan[k] + p];\
+            }\
+        }\
+        if (time_o) {\
+            for (k = 0; k < num_sel; ++k) time_o[out + k] = time_i[r];\
+        }\
+    }\
+    }
+
 
 void oskar_imager_select_data(
         const oskar_Imager* h,
@@ -129,6 +179,50 @@ void oskar_imager_select_data(
         }
         *num_out += num_rows;
     }
+    else if (location == OSKAR_CPU)
+    {
+        /* Frequency synthesis: get the selected channels in this block. */
+        int num_sel = 0;
+        int* sel_chan = (int*) calloc(h->num_sel_freqs, sizeof(int));
+        double* sel_scale = (double*) calloc(h->num_sel_freqs, sizeof(double));
+        if (h->num_sel_freqs > 0 && (!sel_chan || !sel_scale))
+        {
+            free(sel_chan);
+            free(sel_scale);
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return;
+        }
+        for (i = 0; i < h->num_sel_freqs; ++i)
+        {
+            c = (int) round((h->sel_freqs[i] - f0) / df);
+            if (c < start_chan || c > end_chan) continue;
+            if (fabs((h->sel_freqs[i] - f0) - c * df) > s * df) continue;
+            sel_chan[num_sel] = c - start_chan;
+            sel_scale[num_sel] = (f0 + c * df) / C0;
+            num_sel++;
+        }
+
+        /* Load the coordinates of each baseline once, and write out
+         * all its selected channels together. */
+        if (num_sel > 0)
+        {
+            if (time_in && time_out)
+            {
+                oskar_mem_ensure(time_out, num_rows * num_sel, status);
+            }
+            if (prec == OSKAR_SINGLE)
+            {
+                COPY_SYNTH_CPU(float, float2)
+            }
+            else
+            {
+                COPY_SYNTH_CPU(double, double2)
+            }
+            *num_out = num_rows * num_sel;
+        }
+        free(sel_chan);
+        free(sel_scale);
+    }
     else /* Frequency synthesis */
     {
         for (i = 0; i < h->num_sel_freqs; ++i)
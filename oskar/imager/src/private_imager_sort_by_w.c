@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+
+#include "imager/private_imager_sort_by_w.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of bits sorted in each pass of the radix sort. */
+#define RADIX_BITS 8
+#define RADIX_SIZE (1 << RADIX_BITS)
+
+#define SWAP_MEM(A, B) { oskar_Mem* t_ = A; A = B; B = t_; }
+
+/*
+ * Stable least-significant-digit radix sort of keys and indices.
+ * Each thread histograms and then scatters one contiguous range of the
+ * input, using offsets ordered by bucket and then by thread, so the sort
+ * is stable without needing atomic operations.
+ * Indices are size_t so that any number of visibilities can be sorted.
+ * Returns the array holding the sorted indices, or NULL if the counts
+ * could not be allocated.
+ */
+static size_t* radix_sort(const size_t num, const int max_key,
+        int* key, size_t* index, int* key_tmp, size_t* index_tmp,
+        int* status)
+{
+    int num_passes = 0, k = max_key;
+    size_t* counts = 0;
+    for (; k > 0; k >>= RADIX_BITS) num_passes++;
+    if (num_passes == 0) return index;
+#ifdef _OPENMP
+    counts = (size_t*) calloc(
+            (size_t) RADIX_SIZE * omp_get_max_threads(), sizeof(size_t));
+#else
+    counts = (size_t*) calloc(RADIX_SIZE, sizeof(size_t));
+#endif
+    if (!counts)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+#pragma omp parallel
+    {
+        int pass = 0, thread_id = 0, num_threads = 1;
+        size_t i = 0;
+        int *key_in = key, *key_out = key_tmp;
+        size_t *index_in = index, *index_out = index_tmp;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+        num_threads = omp_get_num_threads();
+#endif
+        size_t* thread_counts = &counts[RADIX_SIZE * thread_id];
+        const size_t start = (num * thread_id) / num_threads;
+        const size_t end = (num * (thread_id + 1)) / num_threads;
+        for (pass = 0; pass < num_passes; ++pass)
+        {
+            int* t = 0;
+            size_t* t_index = 0;
+            const int shift = pass * RADIX_BITS;
+            for (i = 0; i < RADIX_SIZE; ++i) thread_counts[i] = 0;
+            for (i = start; i < end; ++i)
+            {
+                thread_counts[(key_in[i] >> shift) & (RADIX_SIZE - 1)]++;
+            }
+#pragma omp barrier
+#pragma omp single
+            {
+                int b = 0, j = 0;
+                size_t total = 0;
+                for (b = 0; b < RADIX_SIZE; ++b)
+                {
+                    for (j = 0; j < num_threads; ++j)
+                    {
+                        const size_t n = counts[RADIX_SIZE * j + b];
+                        counts[RADIX_SIZE * j + b] = total;
+                        total += n;
+                    }
+                }
+            }
+            for (i = start; i < end; ++i)
+            {
+                const int b = (key_in[i] >> shift) & (RADIX_SIZE - 1);
+                const size_t j = thread_counts[b]++;
+                key_out[j] = key_in[i];
+                index_out[j] = index_in[i];
+            }
+#pragma omp barrier
+            t = key_in; key_in = key_out; key_out = t;
+            t_index = index_in; index_in = index_out; index_out = t_index;
+        }
+    }
+    free(counts);
+    return (num_passes % 2) ? index_tmp : index;
+}
+
+void oskar_imager_sort_by_w(oskar_Imager* h, size_t num_vis, int* status)
+{
+    int max_key = 0;
+    ptrdiff_t i = 0;
+    int *key = 0, *key_tmp = 0;
+    size_t *index = 0, *index_tmp = 0;
+    const int num_w_planes = h->num_w_planes;
+    const int sort_vis = !h->coords_only;
+    const int wstack = (h->algorithm == OSKAR_ALGORITHM_WSTACK);
+    if (*status || num_vis <= 1) return;
+    if (wstack ? (h->w_scale <= 0.0) : (num_w_planes <= 1)) return;
+    const ptrdiff_t n = (ptrdiff_t) num_vis;
+    oskar_timer_resume(h->tmr_sort);
+
+    /* Ensure scratch arrays are large enough. */
+    /* (The index arrays are byte buffers holding size_t values.) */
+    oskar_mem_ensure(h->w_key, num_vis, status);
+    oskar_mem_ensure(h->w_index, num_vis * sizeof(size_t), status);
+    oskar_mem_ensure(h->w_key_tmp, num_vis, status);
+    oskar_mem_ensure(h->w_index_tmp, num_vis * sizeof(size_t), status);
+    /* (Temporary arrays must be as large as those they are swapped with.) */
+    oskar_mem_ensure(h->uu_tmp, oskar_mem_length(h->uu_im), status);
+    oskar_mem_ensure(h->vv_tmp, oskar_mem_length(h->vv_im), status);
+    oskar_mem_ensure(h->ww_tmp, oskar_mem_length(h->ww_im), status);
+    oskar_mem_ensure(h->weight_tmp, oskar_mem_length(h->weight_im), status);
+    if (sort_vis)
+    {
+        oskar_mem_ensure(h->vis_tmp, oskar_mem_length(h->vis_im), status);
+    }
+    if (*status)
+    {
+        oskar_timer_pause(h->tmr_sort);
+        return;
+    }
+    key = oskar_mem_int(h->w_key, status);
+    index = (size_t*) oskar_mem_void(h->w_index);
+    key_tmp = oskar_mem_int(h->w_key_tmp, status);
+    index_tmp = (size_t*) oskar_mem_void(h->w_index_tmp);
+
+    /* Get the W-projection plane or W-layer index of each visibility. */
+    if (wstack)
+    {
+        /* This must match the layer index used when gridding. */
+        const double w_scale = h->w_scale;
+        const void* ww = oskar_mem_void_const(h->ww_im);
+        const int dbl = (h->imager_prec == OSKAR_DOUBLE);
+#pragma omp parallel for
+        for (i = 0; i < n; ++i)
+        {
+            const double w = dbl ?
+                    ((const double*) ww)[i] : ((const float*) ww)[i];
+            key[i] = (int) round(fabs(w) * w_scale);
+            index[i] = (size_t) i;
+        }
+        for (i = 0; i < n; ++i)
+        {
+            if (key[i] > max_key) max_key = key[i];
+        }
+    }
+    else if (h->imager_prec == OSKAR_DOUBLE)
+    {
+        const double* ww = oskar_mem_double_const(h->ww_im, status);
+        const double w_scale = h->w_scale;
+#pragma omp parallel for
+        for (i = 0; i < n; ++i)
+        {
+            const size_t grid_w =
+                    (size_t)round(sqrt(fabs(ww[i] * w_scale)));
+            key[i] = grid_w < (size_t) num_w_planes ?
+                    (int) grid_w : num_w_planes - 1;
+            index[i] = (size_t) i;
+        }
+    }
+    else
+    {
+        const float* ww = oskar_mem_float_const(h->ww_im, status);
+        const float w_scale = (float) h->w_scale;
+#pragma omp parallel for
+        for (i = 0; i < n; ++i)
+        {
+            const size_t grid_w =
+                    (size_t)roundf(sqrtf(fabsf(ww[i] * w_scale)));
+            key[i] = grid_w < (size_t) num_w_planes ?
+                    (int) grid_w : num_w_planes - 1;
+            index[i] = (size_t) i;
+        }
+    }
+
+    /* Sort the indices by plane, and gather the data. */
+    if (!wstack) max_key = num_w_planes - 1;
+    index = radix_sort(num_vis, max_key, key, index, key_tmp, index_tmp,
+            status);
+    if (*status)
+    {
+        oskar_timer_pause(h->tmr_sort);
+        return;
+    }
+    if (h->imager_prec == OSKAR_DOUBLE)
+    {
+        const double* uu = oskar_mem_double_const(h->uu_im, status);
+        const double* vv = oskar_mem_double_const(h->vv_im, status);
+        const double* ww = oskar_mem_double_const(h->ww_im, status);
+        const double* wt = oskar_mem_double_const(h->weight_im, status);
+        const double2* vis = sort_vis ?
+                oskar_mem_double2_const(h->vis_im, status) : 0;
+        double* uu_out = oskar_mem_double(h->uu_tmp, status);
+        double* vv_out = oskar_mem_double(h->vv_tmp, status);
+        double* ww_out = oskar_mem_double(h->ww_tmp, status);
+        double* wt_out = oskar_mem_double(h->weight_tmp, status);
+        double2* vis_out = sort_vis ?
+                oskar_mem_double2(h->vis_tmp, status) : 0;
+#pragma omp parallel for
+        for (i = 0; i < n; ++i)
+        {
+            const size_t j = index[i];
+            uu_out[i] = uu[j];
+            vv_out[i] = vv[j];
+            ww_out[i] = ww[j];
+            wt_out[i] = wt[j];
+            if (vis) vis_out[i] = vis[j];
+        }
+    }
+    else
+    {
+        const float* uu = oskar_mem_float_const(h->uu_im, status);
+        const float* vv = oskar_mem_float_const(h->vv_im, status);
+        const float* ww = oskar_mem_float_const(h->ww_im, status);
+        const float* wt = oskar_mem_float_const(h->weight_im, status);
+        const float2* vis = sort_vis ?
+                oskar_mem_float2_const(h->vis_im, status) : 0;
+        float* uu_out = oskar_mem_float(h->uu_tmp, status);
+        float* vv_out = oskar_mem_float(h->vv_tmp, status);
+        float* ww_out = oskar_mem_float(h->ww_tmp, status);
+        float* wt_out = oskar_mem_float(h->weight_tmp, status);
+        float2* vis_out = sort_vis ?
+                oskar_mem_float2(h->vis_tmp, status) : 0;
+#pragma omp parallel for
+        for (i = 0; i < n; ++i)
+        {
+            const size_t j = index[i];
+            uu_out[i] = uu[j];
+            vv_out[i] = vv[j];
+            ww_out[i] = ww[j];
+            wt_out[i] = wt[j];
+            if (vis) vis_out[i] = vis[j];
+        }
+    }
+
+    /* Swap the sorted temporary arrays with the scratch arrays. */
+    SWAP_MEM(h->uu_im, h->uu_tmp)
+    SWAP_MEM(h->vv_im, h->vv_tmp)
+    SWAP_MEM(h->ww_im, h->ww_tmp)
+    SWAP_MEM(h->weight_im, h->weight_tmp)
+    if (sort_vis) SWAP_MEM(h->vis_im, h->vis_tmp)
+    oskar_timer_pause(h->tmr_sort);
+}
+
+#ifdef __cplusplus
+}
+#endif
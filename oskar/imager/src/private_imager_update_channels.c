@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+#include "imager/private_imager_update_channels.h"
+
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int in_range(const oskar_Imager* h, int c)
+{
+    const double freq_hz = h->vis_freq_start_hz + c * h->freq_inc_hz;
+    return (freq_hz >= h->freq_min_hz &&
+            (freq_hz <= h->freq_max_hz || h->freq_max_hz == 0.0));
+}
+
+void oskar_imager_update_channels(oskar_Imager* h, int num_baselines,
+        int num_times, int start_chan, int num_channels, int num_pols,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight,
+        const oskar_Mem* time_centroid, oskar_Mem* scratch, int* status)
+{
+    int c = 0, t = 0, c_lo = -1, c_hi = -1;
+    const size_t num_rows = (size_t) num_baselines * num_times;
+    if (*status) return;
+
+    /* Find the channels in the selected frequency range. */
+    for (c = 0; c < num_channels; ++c)
+    {
+        if (!in_range(h, start_chan + c)) continue;
+        if (c_lo < 0) c_lo = c;
+        c_hi = c;
+    }
+    if (c_lo < 0) return;
+
+    if (h->chan_snaps)
+    {
+        /* Update per channel. */
+        for (c = c_lo; c <= c_hi; ++c)
+        {
+            if (!in_range(h, start_chan + c)) continue;
+            if (amps)
+            {
+                oskar_mem_ensure(scratch, num_rows, status);
+                oskar_timer_resume(h->tmr_copy_convert);
+                for (t = 0; t < num_times; ++t)
+                {
+                    oskar_mem_copy_contents(scratch, amps,
+                            num_baselines * t,
+                            num_baselines * (num_channels * t + c),
+                            num_baselines, status);
+                }
+                oskar_timer_pause(h->tmr_copy_convert);
+            }
+            oskar_imager_update(h, num_rows,
+                    start_chan + c, start_chan + c, num_pols,
+                    uu, vv, ww, (amps ? scratch : 0), weight,
+                    time_centroid, status);
+        }
+    }
+    else
+    {
+        /* Reorder the amplitudes to put channels inside baselines,
+         * so all selected channels are gridded in one update. */
+        const int num_sel = 1 + c_hi - c_lo;
+        if (amps)
+        {
+            int b = 0;
+            oskar_mem_ensure(scratch, num_rows * num_sel, status);
+            if (*status) return;
+            oskar_timer_resume(h->tmr_copy_convert);
+            const size_t element_size =
+                    oskar_mem_element_size(oskar_mem_type(amps));
+            const size_t block_size = element_size * num_sel;
+            const char* in = oskar_mem_char_const(amps);
+            char* out = oskar_mem_char(scratch);
+#pragma omp parallel for private(b, c)
+            for (t = 0; t < num_times; ++t)
+            {
+                for (b = 0; b < num_baselines; ++b)
+                {
+                    const size_t row = (size_t) num_baselines * t + b;
+                    char* out_row = out + row * block_size;
+                    for (c = c_lo; c <= c_hi; ++c)
+                    {
+                        const size_t i_in = (size_t) num_baselines *
+                                ((size_t) num_channels * t + c) + b;
+                        memcpy(out_row + (c - c_lo) * element_size,
+                                in + i_in * element_size, element_size);
+                    }
+                }
+            }
+            oskar_timer_pause(h->tmr_copy_convert);
+        }
+        oskar_imager_update(h, num_rows,
+                start_chan + c_lo, start_chan + c_hi, num_pols,
+                uu, vv, ww, (amps ? scratch : 0), weight,
+                time_centroid, status);
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021, The OSKAR Developers.
+ * Copyright (c) 2016-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -8,8 +8,10 @@
 #include "imager/private_imager.h"
 #include "imager/private_imager_update_plane_dft.h"
 #include "imager/oskar_imager.h"
+#include "convert/oskar_convert_fov_to_cellsize.h"
 #include "math/oskar_cmath.h"
 #include "math/oskar_dft_c2r.h"
+#include "math/oskar_dft_c2r_grid_cpu.h"
 #include "utility/oskar_device.h"
 #include "utility/oskar_thread.h"
 
@@ -22,6 +24,8 @@ extern "C" {
 #endif
 
 static void* run_blocks(void* arg);
+static void copy_blanked_pixels(const oskar_Mem* l, size_t offset,
+        size_t num_pixels, oskar_Mem* block, int* status);
 
 struct ThreadArgs
 {
@@ -169,6 +173,15 @@ static void* run_blocks(void* arg)
     if (max_size < smallest) max_size = smallest;
     const int num_blocks = (int) ((num_pixels + max_size - 1) / max_size);
 
+    /* On the CPU, the 2D transform can use the regular pixel grid
+     * to avoid evaluating phase factors for every pixel.
+     * The grid is the same as that from oskar_evaluate_image_lmn_grid(). */
+    const int use_grid_dft = (dev_loc == OSKAR_CPU &&
+            h->algorithm == OSKAR_ALGORITHM_DFT_2D);
+    const double cellsize_rad = oskar_convert_fov_to_cellsize(
+            h->fov_deg * M_PI / 180.0, h->image_size);
+    const double delta_l = sin(cellsize_rad), delta_m = delta_l;
+
     /* Allocate device memory for pixel block data. */
     block = oskar_mem_create(h->imager_prec, dev_loc, 0, status);
     l = oskar_mem_create(h->imager_prec, dev_loc, max_size, status);
@@ -191,6 +204,26 @@ static void* run_blocks(void* arg)
         block_size = num_pixels - block_start;
         if (block_size > max_size) block_size = max_size;
 
+        /* Run DFT for the block using the pixel grid, if possible. */
+        if (use_grid_dft)
+        {
+            oskar_mem_ensure(block, block_size, status);
+            if (!*status)
+            {
+                oskar_dft_c2r_grid_cpu(h->imager_prec, num_vis, 2.0 * M_PI,
+                        oskar_mem_void_const(uu), oskar_mem_void_const(vv),
+                        oskar_mem_void_const(amp),
+                        oskar_mem_void_const(weight), h->image_size,
+                        (h->image_size / 2) * delta_l, -delta_l,
+                        -(h->image_size / 2) * delta_m, delta_m,
+                        block_start, block_size, oskar_mem_void(block));
+            }
+            copy_blanked_pixels(h->l, block_start, block_size, block, status);
+            oskar_mem_add(plane, plane, block,
+                    block_start, block_start, 0, block_size, status);
+            continue;
+        }
+
         /* Copy the (l,m,n) positions for the block. */
         oskar_mem_copy_contents(l, h->l, 0, block_start, block_size, status);
         oskar_mem_copy_contents(m, h->m, 0, block_start, block_size, status);
@@ -222,6 +255,33 @@ static void* run_blocks(void* arg)
     return 0;
 }
 
+/* Sets pixels outside the unit circle, which have no valid (l,m,n)
+ * coordinates, to the same value as the DFT would give them (NaN). */
+static void copy_blanked_pixels(const oskar_Mem* l, size_t offset,
+        size_t num_pixels, oskar_Mem* block, int* status)
+{
+    size_t i = 0;
+    if (*status) return;
+    if (oskar_mem_precision(block) == OSKAR_DOUBLE)
+    {
+        const double* l_ = oskar_mem_double_const(l, status) + offset;
+        double* out = oskar_mem_double(block, status);
+        for (i = 0; i < num_pixels; ++i)
+        {
+            if (l_[i] != l_[i]) out[i] = l_[i];
+        }
+    }
+    else
+    {
+        const float* l_ = oskar_mem_float_const(l, status) + offset;
+        float* out = oskar_mem_float(block, status);
+        for (i = 0; i < num_pixels; ++i)
+        {
+            if (l_[i] != l_[i]) out[i] = l_[i];
+        }
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
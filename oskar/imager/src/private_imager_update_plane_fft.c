@@ -5,10 +5,12 @@
 
 #include "imager/private_imager.h"
 #include "imager/oskar_imager.h"
+#include "imager/private_imager_half_plane.h"
 
 #include "imager/define_grid_tile_grid.h"
 #include "imager/private_imager_update_plane_fft.h"
 #include "imager/oskar_grid_simple.h"
+#include "imager/oskar_grid_tiled.h"
 #include "math/oskar_prefix_sum.h"
 #include "math/oskar_round_robin.h"
 #include "utility/oskar_device.h"
@@ -65,32 +67,67 @@ void oskar_imager_update_plane_fft(oskar_Imager* h, size_t num_vis,
             return;
         }
         const int grid_size = oskar_imager_plane_size(h);
-        const size_t num_cells = ((size_t) grid_size) * ((size_t) grid_size);
+        const int half_width = oskar_imager_half_plane_width(h);
+        const size_t num_cells = ((size_t) grid_size) *
+                ((size_t) (half_width ? half_width : grid_size));
         oskar_mem_ensure(plane_ptr, num_cells, status);
         if (*status) return;
+
+        /* Only the tiled gridder can fill a half-plane grid. */
+        const int tiled = oskar_grid_tiled_num_threads() > 1 || half_width;
         if (h->imager_prec == OSKAR_DOUBLE)
         {
-            oskar_grid_simple_d(h->support, h->oversample,
-                    oskar_mem_double_const(h->conv_func, status), num_vis,
-                    oskar_mem_double_const(uu, status),
-                    oskar_mem_double_const(vv, status),
-                    oskar_mem_double_const(amps, status),
-                    oskar_mem_double_const(weight, status),
-                    h->cellsize_rad,
-                    grid_size, num_skipped, plane_norm,
-                    oskar_mem_double(plane_ptr, status));
+            if (tiled)
+            {
+                oskar_grid_simple_tiled_d(h->support, h->oversample,
+                        oskar_mem_double_const(h->conv_func, status), num_vis,
+                        oskar_mem_double_const(uu, status),
+                        oskar_mem_double_const(vv, status),
+                        oskar_mem_double_const(amps, status),
+                        oskar_mem_double_const(weight, status),
+                        h->cellsize_rad,
+                        grid_size, half_width > 0, num_skipped, plane_norm,
+                        oskar_mem_double(plane_ptr, status), status);
+            }
+            else
+            {
+                oskar_grid_simple_d(h->support, h->oversample,
+                        oskar_mem_double_const(h->conv_func, status), num_vis,
+                        oskar_mem_double_const(uu, status),
+                        oskar_mem_double_const(vv, status),
+                        oskar_mem_double_const(amps, status),
+                        oskar_mem_double_const(weight, status),
+                        h->cellsize_rad,
+                        grid_size, num_skipped, plane_norm,
+                        oskar_mem_double(plane_ptr, status), status);
+            }
         }
         else
         {
-            oskar_grid_simple_f(h->support, h->oversample,
-                    oskar_mem_float_const(h->conv_func, status), num_vis,
-                    oskar_mem_float_const(uu, status),
-                    oskar_mem_float_const(vv, status),
-                    oskar_mem_float_const(amps, status),
-                    oskar_mem_float_const(weight, status),
-                    (float) (h->cellsize_rad),
-                    grid_size, num_skipped, plane_norm,
-                    oskar_mem_float(plane_ptr, status));
+            if (tiled)
+            {
+                oskar_grid_simple_tiled_f(h->support, h->oversample,
+                        oskar_mem_float_const(h->conv_func, status), num_vis,
+                        oskar_mem_float_const(uu, status),
+                        oskar_mem_float_const(vv, status),
+                        oskar_mem_float_const(amps, status),
+                        oskar_mem_float_const(weight, status),
+                        (float) (h->cellsize_rad),
+                        grid_size, half_width > 0, num_skipped, plane_norm,
+                        oskar_mem_float(plane_ptr, status), status);
+            }
+            else
+            {
+                oskar_grid_simple_f(h->support, h->oversample,
+                        oskar_mem_float_const(h->conv_func, status), num_vis,
+                        oskar_mem_float_const(uu, status),
+                        oskar_mem_float_const(vv, status),
+                        oskar_mem_float_const(amps, status),
+                        oskar_mem_float_const(weight, status),
+                        (float) (h->cellsize_rad),
+                        grid_size, num_skipped, plane_norm,
+                        oskar_mem_float(plane_ptr, status), status);
+            }
         }
     }
     else
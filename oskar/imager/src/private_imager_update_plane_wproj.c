@@ -5,10 +5,12 @@
 
 #include "imager/private_imager.h"
 #include "imager/oskar_imager.h"
+#include "imager/private_imager_half_plane.h"
 
 #include "imager/define_grid_tile_grid.h"
 #include "imager/private_imager_update_plane_wproj.h"
 #include "imager/oskar_grid_wproj2.h"
+#include "imager/oskar_grid_tiled.h"
 #include "math/oskar_prefix_sum.h"
 #include "math/oskar_round_robin.h"
 #include "utility/oskar_device.h"
@@ -65,40 +67,87 @@ void oskar_imager_update_plane_wproj(oskar_Imager* h, size_t num_vis,
             return;
         }
         const int grid_size = oskar_imager_plane_size(h);
-        const size_t num_cells = ((size_t) grid_size) * ((size_t) grid_size);
+        const int half_width = oskar_imager_half_plane_width(h);
+        const size_t num_cells = ((size_t) grid_size) *
+                ((size_t) (half_width ? half_width : grid_size));
         oskar_mem_ensure(plane_ptr, num_cells, status);
         if (*status) return;
+
+        /* Only the tiled gridder can fill a half-plane grid. */
+        const int tiled = oskar_grid_tiled_num_threads() > 1 || half_width;
         if (h->imager_prec == OSKAR_DOUBLE)
         {
-            oskar_grid_wproj2_d(h->num_w_planes,
-                    oskar_mem_int_const(h->w_support, status),
-                    h->oversample,
-                    oskar_mem_int_const(h->w_kernel_start, status),
-                    oskar_mem_double_const(h->w_kernels_compact, status), num_vis,
-                    oskar_mem_double_const(uu, status),
-                    oskar_mem_double_const(vv, status),
-                    oskar_mem_double_const(ww, status),
-                    oskar_mem_double_const(amps, status),
-                    oskar_mem_double_const(weight, status),
-                    h->cellsize_rad, h->w_scale,
-                    grid_size, num_skipped, plane_norm,
-                    oskar_mem_double(plane_ptr, status));
+            if (tiled)
+            {
+                oskar_grid_wproj2_tiled_d(h->num_w_planes,
+                        oskar_mem_int_const(h->w_support, status),
+                        h->oversample,
+                        oskar_mem_int_const(h->w_kernel_start, status),
+                        oskar_mem_double_const(h->w_kernels_compact, status),
+                        num_vis,
+                        oskar_mem_double_const(uu, status),
+                        oskar_mem_double_const(vv, status),
+                        oskar_mem_double_const(ww, status),
+                        oskar_mem_double_const(amps, status),
+                        oskar_mem_double_const(weight, status),
+                        h->cellsize_rad, h->w_scale,
+                        grid_size, half_width > 0, num_skipped, plane_norm,
+                        oskar_mem_double(plane_ptr, status), status);
+            }
+            else
+            {
+                oskar_grid_wproj2_d(h->num_w_planes,
+                        oskar_mem_int_const(h->w_support, status),
+                        h->oversample,
+                        oskar_mem_int_const(h->w_kernel_start, status),
+                        oskar_mem_double_const(h->w_kernels_compact, status),
+                        num_vis,
+                        oskar_mem_double_const(uu, status),
+                        oskar_mem_double_const(vv, status),
+                        oskar_mem_double_const(ww, status),
+                        oskar_mem_double_const(amps, status),
+                        oskar_mem_double_const(weight, status),
+                        h->cellsize_rad, h->w_scale,
+                        grid_size, num_skipped, plane_norm,
+                        oskar_mem_double(plane_ptr, status));
+            }
         }
         else
         {
-            oskar_grid_wproj2_f(h->num_w_planes,
-                    oskar_mem_int_const(h->w_support, status),
-                    h->oversample,
-                    oskar_mem_int_const(h->w_kernel_start, status),
-                    oskar_mem_float_const(h->w_kernels_compact, status), num_vis,
-                    oskar_mem_float_const(uu, status),
-                    oskar_mem_float_const(vv, status),
-                    oskar_mem_float_const(ww, status),
-                    oskar_mem_float_const(amps, status),
-                    oskar_mem_float_const(weight, status),
-                    h->cellsize_rad, h->w_scale,
-                    grid_size, num_skipped, plane_norm,
-                    oskar_mem_float(plane_ptr, status));
+            if (tiled)
+            {
+                oskar_grid_wproj2_tiled_f(h->num_w_planes,
+                        oskar_mem_int_const(h->w_support, status),
+                        h->oversample,
+                        oskar_mem_int_const(h->w_kernel_start, status),
+                        oskar_mem_float_const(h->w_kernels_compact, status),
+                        num_vis,
+                        oskar_mem_float_const(uu, status),
+                        oskar_mem_float_const(vv, status),
+                        oskar_mem_float_const(ww, status),
+                        oskar_mem_float_const(amps, status),
+                        oskar_mem_float_const(weight, status),
+                        h->cellsize_rad, h->w_scale,
+                        grid_size, half_width > 0, num_skipped, plane_norm,
+                        oskar_mem_float(plane_ptr, status), status);
+            }
+            else
+            {
+                oskar_grid_wproj2_f(h->num_w_planes,
+                        oskar_mem_int_const(h->w_support, status),
+                        h->oversample,
+                        oskar_mem_int_const(h->w_kernel_start, status),
+                        oskar_mem_float_const(h->w_kernels_compact, status),
+                        num_vis,
+                        oskar_mem_float_const(uu, status),
+                        oskar_mem_float_const(vv, status),
+                        oskar_mem_float_const(ww, status),
+                        oskar_mem_float_const(amps, status),
+                        oskar_mem_float_const(weight, status),
+                        h->cellsize_rad, h->w_scale,
+                        grid_size, num_skipped, plane_norm,
+                        oskar_mem_float(plane_ptr, status));
+            }
         }
     }
     else
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "imager/private_imager.h"
+#include "imager/oskar_imager.h"
+
+#include "imager/private_imager_update_plane_wstack.h"
+#include "imager/private_imager_grid_scratch.h"
+#include "imager/oskar_grid_simple.h"
+#include "imager/oskar_grid_tiled.h"
+#include "math/oskar_cmath.h"
+#include "math/oskar_fft.h"
+#include "math/oskar_fftphase.h"
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static int layer_index(const oskar_Mem* ww, size_t i, double w_scale);
+static WStackLayer* get_layer(oskar_Imager* h, oskar_Mem* plane,
+        int layer, int* status);
+static void grid_run(oskar_Imager* h, size_t start, size_t num,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight, oskar_Mem* grid,
+        double* plane_norm, size_t* num_skipped, int* status);
+static void add_layer(oskar_Imager* h, WStackLayer* layer, int* status);
+
+void oskar_imager_update_plane_wstack(oskar_Imager* h, size_t num_vis,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight, int i_plane,
+        oskar_Mem* plane, double* plane_norm, size_t* num_skipped, int* status)
+{
+    size_t start = 0;
+    oskar_Mem* plane_ptr = plane;
+    if (*status) return;
+    if (!plane_ptr)
+    {
+        if (h->planes)
+        {
+            plane_ptr = h->planes[i_plane];
+        }
+        else
+        {
+            *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
+            return;
+        }
+    }
+    if (oskar_mem_location(plane_ptr) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_LOCATION_MISMATCH;
+        return;
+    }
+    if (oskar_mem_precision(plane_ptr) != h->imager_prec)
+    {
+        *status = OSKAR_ERR_TYPE_MISMATCH;
+        return;
+    }
+    const int grid_size = oskar_imager_plane_size(h);
+    const size_t num_cells = ((size_t) grid_size) * ((size_t) grid_size);
+    oskar_mem_ensure(plane_ptr, num_cells, status);
+    oskar_mem_ensure(h->layer_uu, num_vis, status);
+    oskar_mem_ensure(h->layer_vv, num_vis, status);
+    oskar_mem_ensure(h->layer_vis, num_vis, status);
+    if (*status) return;
+
+    /* Grid each run of visibilities in the same layer onto its layer grid.
+     * Layer grids are only transformed when they are flushed. */
+    while (start < num_vis && !*status)
+    {
+        size_t end = start + 1;
+        WStackLayer* layer = 0;
+        const int i_layer = layer_index(ww, start, h->w_scale);
+        while (end < num_vis && layer_index(ww, end, h->w_scale) == i_layer)
+        {
+            end++;
+        }
+        layer = get_layer(h, plane_ptr, i_layer, status);
+        if (*status) break;
+        grid_run(h, start, end - start, uu, vv, ww, amps, weight,
+                layer->grid, plane_norm, num_skipped, status);
+        start = end;
+    }
+}
+
+void oskar_imager_flush_wstack_layers(oskar_Imager* h,
+        const oskar_Mem* plane, int* status)
+{
+    int i = 0;
+    for (i = 0; i < h->num_layers; ++i)
+    {
+        WStackLayer* layer = &h->layers[i];
+        if (layer->plane && (!plane || layer->plane == plane))
+        {
+            add_layer(h, layer, status);
+        }
+    }
+}
+
+void oskar_imager_free_wstack_layers(oskar_Imager* h, int* status)
+{
+    int i = 0;
+    for (i = 0; i < h->num_layers; ++i)
+    {
+        oskar_mem_free(h->layers[i].grid, status);
+    }
+    free(h->layers);
+    h->layers = 0;
+    h->num_layers = 0;
+    h->layer_use_count = 0;
+}
+
+/*
+ * Returns the resident grid for the layer of the given plane.
+ * If the layer is not resident, an unused grid is returned, or a new one
+ * is allocated if below the limit. Otherwise, the most recently used grid
+ * is flushed and reused: as each block is sorted by W, the layers are
+ * visited in the same order for every block, so this keeps the other
+ * layers resident rather than cycling them all through one grid.
+ */
+static WStackLayer* get_layer(oskar_Imager* h, oskar_Mem* plane,
+        int layer, int* status)
+{
+    int i = 0, i_free = -1, i_mru = 0;
+    WStackLayer* l = 0;
+    for (i = 0; i < h->num_layers; ++i)
+    {
+        l = &h->layers[i];
+        if (l->plane == plane && l->layer == layer) break;
+        if (!l->plane && i_free < 0) i_free = i;
+        if (l->last_used > h->layers[i_mru].last_used) i_mru = i;
+    }
+    if (i < h->num_layers)
+    {
+        l = &h->layers[i];
+    }
+    else if (i_free >= 0)
+    {
+        l = &h->layers[i_free];
+    }
+    else if (h->num_layers < h->max_layers || h->num_layers == 0)
+    {
+        const int plane_size = oskar_imager_plane_size(h);
+        const size_t num_cells = (size_t) plane_size * (size_t) plane_size;
+        WStackLayer* t = (WStackLayer*) realloc(h->layers,
+                (h->num_layers + 1) * sizeof(WStackLayer));
+        if (!t)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return 0;
+        }
+        h->layers = t;
+        l = &h->layers[h->num_layers++];
+        l->plane = 0;
+        l->grid = oskar_mem_create(h->imager_prec | OSKAR_COMPLEX,
+                OSKAR_CPU, num_cells, status);
+        oskar_mem_clear_contents(l->grid, status);
+    }
+    else
+    {
+        l = &h->layers[i_mru];
+        add_layer(h, l, status);
+    }
+    l->plane = plane;
+    l->layer = layer;
+    l->last_used = ++h->layer_use_count;
+    return l;
+}
+
+static int layer_index(const oskar_Mem* ww, size_t i, double w_scale)
+{
+    const double w = oskar_mem_precision(ww) == OSKAR_DOUBLE ?
+            ((const double*) oskar_mem_void_const(ww))[i] :
+            ((const float*) oskar_mem_void_const(ww))[i];
+    return (int) round(fabs(w) * w_scale);
+}
+
+/*
+ * Grids a run of visibilities onto the layer grid.
+ * Visibilities with negative W are reflected to (-u, -v, -w) and
+ * conjugated first, which does not change the real part of the image.
+ */
+static void grid_run(oskar_Imager* h, size_t start, size_t num,
+        const oskar_Mem* uu, const oskar_Mem* vv, const oskar_Mem* ww,
+        const oskar_Mem* amps, const oskar_Mem* weight, oskar_Mem* grid,
+        double* plane_norm, size_t* num_skipped, int* status)
+{
+    size_t i = 0, skipped = 0;
+    const int grid_size = oskar_imager_plane_size(h);
+    const int tiled = oskar_grid_tiled_num_threads() > 1;
+    if (h->imager_prec == OSKAR_DOUBLE)
+    {
+        const double *u = oskar_mem_double_const(uu, status) + start;
+        const double *v = oskar_mem_double_const(vv, status) + start;
+        const double *w = oskar_mem_double_const(ww, status) + start;
+        const double *vis = oskar_mem_double_const(amps, status) + 2 * start;
+        const double *wt = oskar_mem_double_const(weight, status) + start;
+        double *u_out = oskar_mem_double(h->layer_uu, status);
+        double *v_out = oskar_mem_double(h->layer_vv, status);
+        double *vis_out = oskar_mem_double(h->layer_vis, status);
+        for (i = 0; i < num; ++i)
+        {
+            const double s = w[i] < 0.0 ? -1.0 : 1.0;
+            u_out[i] = s * u[i];
+            v_out[i] = s * v[i];
+            vis_out[2 * i]     = vis[2 * i];
+            vis_out[2 * i + 1] = s * vis[2 * i + 1];
+        }
+        if (tiled)
+        {
+            oskar_grid_simple_tiled_d(h->support, h->oversample,
+                    oskar_mem_double_const(h->conv_func, status), num,
+                    u_out, v_out, vis_out, wt, h->cellsize_rad,
+                    grid_size, 0, &skipped, plane_norm,
+                    oskar_mem_double(grid, status), status);
+        }
+        else
+        {
+            oskar_grid_simple_d(h->support, h->oversample,
+                    oskar_mem_double_const(h->conv_func, status), num,
+                    u_out, v_out, vis_out, wt, h->cellsize_rad,
+                    grid_size, &skipped, plane_norm,
+                    oskar_mem_double(grid, status), status);
+        }
+    }
+    else
+    {
+        const float *u = oskar_mem_float_const(uu, status) + start;
+        const float *v = oskar_mem_float_const(vv, status) + start;
+        const float *w = oskar_mem_float_const(ww, status) + start;
+        const float *vis = oskar_mem_float_const(amps, status) + 2 * start;
+        const float *wt = oskar_mem_float_const(weight, status) + start;
+        float *u_out = oskar_mem_float(h->layer_uu, status);
+        float *v_out = oskar_mem_float(h->layer_vv, status);
+        float *vis_out = oskar_mem_float(h->layer_vis, status);
+        for (i = 0; i < num; ++i)
+        {
+            const float s = w[i] < 0.0f ? -1.0f : 1.0f;
+            u_out[i] = s * u[i];
+            v_out[i] = s * v[i];
+            vis_out[2 * i]     = vis[2 * i];
+            vis_out[2 * i + 1] = s * vis[2 * i + 1];
+        }
+        if (tiled)
+        {
+            oskar_grid_simple_tiled_f(h->support, h->oversample,
+                    oskar_mem_float_const(h->conv_func, status), num,
+                    u_out, v_out, vis_out, wt, (float) (h->cellsize_rad),
+                    grid_size, 0, &skipped, plane_norm,
+                    oskar_mem_float(grid, status), status);
+        }
+        else
+        {
+            oskar_grid_simple_f(h->support, h->oversample,
+                    oskar_mem_float_const(h->conv_func, status), num,
+                    u_out, v_out, vis_out, wt, (float) (h->cellsize_rad),
+                    grid_size, &skipped, plane_norm,
+                    oskar_mem_float(grid, status), status);
+        }
+    }
+    *num_skipped += skipped;
+}
+
+/*
+ * Transforms the layer grid, multiplies it by the W-screen for the layer,
+ * adds it to the plane, and clears the layer grid so it can be reused.
+ */
+static void add_layer(oskar_Imager* h, WStackLayer* layer, int* status)
+{
+    int iy = 0;
+    oskar_Mem* grid = layer->grid;
+    const int size = oskar_imager_plane_size(h);
+    const int centre = size / 2;
+    const double cellsize = h->cellsize_rad;
+    const double f = (h->w_scale > 0.0) ?
+            2.0 * M_PI * layer->layer / h->w_scale : 0.0;
+    oskar_fftphase(size, size, grid, status);
+    oskar_fft_exec(h->fft, grid, status);
+    oskar_fftphase(size, size, grid, status);
+    if (*status) return;
+    oskar_imager_grid_scratch_use(h, layer->plane);
+    if (h->imager_prec == OSKAR_DOUBLE)
+    {
+        const double* in = oskar_mem_double_const(grid, status);
+        double* out = oskar_mem_double(layer->plane, status);
+#pragma omp parallel for private(iy)
+        for (iy = 0; iy < size; ++iy)
+        {
+            int ix = 0;
+            const double m = (iy - centre) * cellsize;
+            for (ix = 0; ix < size; ++ix)
+            {
+                const size_t j = 2 * ((size_t) iy * size + ix);
+                const double l = (ix - centre) * cellsize;
+                const double r_sq = l * l + m * m;
+                const double n = r_sq < 1.0 ? sqrt(1.0 - r_sq) : 0.0;
+                const double phase = f * (1.0 - n);
+                const double c = cos(phase), s = sin(phase);
+                out[j]     += in[j] * c - in[j + 1] * s;
+                out[j + 1] += in[j] * s + in[j + 1] * c;
+            }
+        }
+    }
+    else
+    {
+        const float* in = oskar_mem_float_const(grid, status);
+        float* out = oskar_mem_float(layer->plane, status);
+#pragma omp parallel for private(iy)
+        for (iy = 0; iy < size; ++iy)
+        {
+            int ix = 0;
+            const double m = (iy - centre) * cellsize;
+            for (ix = 0; ix < size; ++ix)
+            {
+                const size_t j = 2 * ((size_t) iy * size + ix);
+                const double l = (ix - centre) * cellsize;
+                const double r_sq = l * l + m * m;
+                const double n = r_sq < 1.0 ? sqrt(1.0 - r_sq) : 0.0;
+                const double phase = f * (1.0 - n);
+                const float c = (float) cos(phase), s = (float) sin(phase);
+                out[j]     += in[j] * c - in[j + 1] * s;
+                out[j + 1] += in[j] * s + in[j + 1] * c;
+            }
+        }
+    }
+    oskar_mem_clear_contents(grid, status);
+    layer->plane = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,293 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef _WIN32
+#define _DEFAULT_SOURCE /* For mmap() and fileno(). */
+#endif
+
+#include "imager/private_imager.h"
+#include "imager/private_imager_w_kernel_cache.h"
+#include "imager/oskar_imager_accessors.h"
+#include "utility/oskar_dir.h"
+
+#ifndef OSKAR_OS_WIN
+#include <sys/mman.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CACHE_VERSION 1
+#define DATA_ALIGNMENT 64
+
+/*
+ * Everything the kernels depend on. The kernel generation grid size is
+ * included as well as the imaging parameters, as it depends on the amount
+ * of physical memory available.
+ *
+ * The structure is cleared before use so that it can be hashed and
+ * compared as raw bytes, and it is stored at the start of the file.
+ */
+typedef struct
+{
+    char magic[8];
+    int version, precision, image_size, grid_size, conv_size;
+    int oversample, num_w_planes, kernel_type;
+    double cellsize_rad, fov_deg, image_padding, w_scale;
+} CacheKey;
+
+/*
+ * File layout:
+ *   CacheKey
+ *   Number of compact kernel elements, as a 64-bit integer
+ *   Support size of each W-plane, as int
+ *   Start index of each W-plane in the compact kernels, as int
+ *   Padding to a multiple of DATA_ALIGNMENT bytes
+ *   Compact kernels
+ */
+
+static void cache_key(const oskar_Imager* h, int conv_size, CacheKey* key)
+{
+    memset(key, 0, sizeof(CacheKey));
+    memcpy(key->magic, "OSKARWK", 7);
+    key->version = CACHE_VERSION;
+    key->precision = h->imager_prec;
+    key->image_size = h->image_size;
+    key->grid_size = h->grid_size;
+    key->conv_size = conv_size;
+    key->oversample = h->oversample;
+    key->num_w_planes = h->num_w_planes;
+    key->kernel_type = (int) h->kernel_type;
+    key->cellsize_rad = h->cellsize_rad;
+    key->fov_deg = h->fov_deg;
+    key->image_padding = h->image_padding;
+    key->w_scale = h->w_scale;
+}
+
+
+/* 64-bit FNV-1a hash of the key, to name the file. */
+static char* cache_file_path(const oskar_Imager* h, const CacheKey* key)
+{
+    char name[64];
+    size_t i = 0;
+    unsigned long long hash = 14695981039346656037ULL;
+    const unsigned char* p = (const unsigned char*) key;
+    for (i = 0; i < sizeof(CacheKey); ++i)
+    {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    (void) sprintf(name, "oskar_w_kernels_%016llx.bin", hash);
+    return oskar_dir_get_path(h->w_kernel_cache_dir, name);
+}
+
+
+static size_t data_offset(int num_w_planes)
+{
+    const size_t header = sizeof(CacheKey) + sizeof(unsigned long long) +
+            2 * sizeof(int) * (size_t) num_w_planes;
+    return DATA_ALIGNMENT * ((header + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT);
+}
+
+
+/* Reads the header and returns the file size, or 0 if it doesn't match. */
+static size_t read_header(FILE* file, const CacheKey* key, int type,
+        oskar_Mem* support, oskar_Mem* start, size_t* num_elements)
+{
+    CacheKey file_key;
+    unsigned long long num = 0;
+    const size_t n = oskar_mem_length(support);
+    if (fread(&file_key, sizeof(CacheKey), 1, file) != 1 ||
+            memcmp(key, &file_key, sizeof(CacheKey)) ||
+            fread(&num, sizeof(num), 1, file) != 1 ||
+            fread(oskar_mem_void(support), sizeof(int), n, file) != n ||
+            fread(oskar_mem_void(start), sizeof(int), n, file) != n)
+    {
+        return 0;
+    }
+    const size_t file_size = data_offset((int) n) +
+            (size_t) num * oskar_mem_element_size(type);
+    if (fseek(file, 0, SEEK_END) || ftell(file) != (long) file_size)
+    {
+        return 0;
+    }
+    *num_elements = (size_t) num;
+    return file_size;
+}
+
+
+int oskar_imager_w_kernel_cache_load(oskar_Imager* h, int conv_size,
+        int* status)
+{
+    CacheKey key;
+    FILE* file = 0;
+    char* path = 0;
+    void* map = 0;
+    size_t num_elements = 0, map_size = 0;
+    oskar_Mem *support = 0, *start = 0, *kernels = 0;
+    if (*status || !h->w_kernel_cache_dir) return 0;
+    cache_key(h, conv_size, &key);
+    path = cache_file_path(h, &key);
+    file = fopen(path, "rb");
+    if (!file)
+    {
+        free(path);
+        return 0;
+    }
+
+    /* Check the header matches, and that the file is the expected size. */
+    const int type = h->imager_prec | OSKAR_COMPLEX;
+    const size_t offset = data_offset(h->num_w_planes);
+    support = oskar_mem_create(OSKAR_INT, OSKAR_CPU, h->num_w_planes, status);
+    start = oskar_mem_create(OSKAR_INT, OSKAR_CPU, h->num_w_planes, status);
+    const size_t file_size = *status ? 0 :
+            read_header(file, &key, type, support, start, &num_elements);
+
+    /* Map the kernels from the file, or read them if mapping isn't possible. */
+    if (file_size > 0)
+    {
+#ifndef OSKAR_OS_WIN
+        map = mmap(0, file_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if (map == MAP_FAILED) map = 0;
+#endif
+        if (map)
+        {
+            map_size = file_size;
+            kernels = oskar_mem_create_alias_from_raw((char*) map + offset,
+                    type, OSKAR_CPU, num_elements, status);
+        }
+        else
+        {
+            kernels = oskar_mem_create(type, OSKAR_CPU, num_elements, status);
+            if (!*status && (fseek(file, (long) offset, SEEK_SET) ||
+                    fread(oskar_mem_void(kernels),
+                            oskar_mem_element_size(type), num_elements,
+                            file) != num_elements))
+            {
+                oskar_mem_free(kernels, status);
+                kernels = 0;
+            }
+        }
+    }
+    (void) fclose(file);
+    if (!kernels || *status)
+    {
+        if (!*status)
+        {
+            oskar_log_warning(h->log,
+                    "Ignoring invalid W-kernel cache file '%s'", path);
+        }
+        oskar_mem_free(support, status);
+        oskar_mem_free(start, status);
+        oskar_mem_free(kernels, status);
+#ifndef OSKAR_OS_WIN
+        if (map) (void) munmap(map, map_size);
+#endif
+        free(path);
+        return 0;
+    }
+
+    /* Replace any existing kernels. */
+    oskar_mem_free(h->w_support, status);
+    oskar_mem_free(h->w_kernel_start, status);
+    oskar_mem_free(h->w_kernels_compact, status);
+    oskar_imager_w_kernel_cache_release(h);
+    h->w_support = support;
+    h->w_kernel_start = start;
+    h->w_kernels_compact = kernels;
+    h->w_kernel_map = map;
+    h->w_kernel_map_size = map_size;
+    oskar_log_message(h->log, 'M', 0,
+            "Loaded W-projection kernels from cache file '%s'", path);
+    free(path);
+    return 1;
+}
+
+
+void oskar_imager_w_kernel_cache_save(oskar_Imager* h, int conv_size,
+        int* status)
+{
+    CacheKey key;
+    FILE* file = 0;
+    char *path = 0, *tmp_path = 0;
+    char padding[DATA_ALIGNMENT];
+    int error = 0;
+    if (*status || !h->w_kernel_cache_dir || !h->w_kernels_compact) return;
+    if (!oskar_dir_mkpath(h->w_kernel_cache_dir))
+    {
+        oskar_log_warning(h->log, "Could not create W-kernel cache "
+                "directory '%s'", h->w_kernel_cache_dir);
+        return;
+    }
+    cache_key(h, conv_size, &key);
+    path = cache_file_path(h, &key);
+
+    /* Write to a temporary file first, so that a partial file is
+     * never seen by another process. */
+    tmp_path = (char*) calloc(strlen(path) + 5, 1);
+    sprintf(tmp_path, "%s.tmp", path);
+    file = fopen(tmp_path, "wb");
+    if (!file)
+    {
+        error = 1;
+    }
+    else
+    {
+        const int num_w_planes = h->num_w_planes;
+        const size_t num_bytes = oskar_mem_length(h->w_kernels_compact) *
+                oskar_mem_element_size(oskar_mem_type(h->w_kernels_compact));
+        const unsigned long long num_elements =
+                (unsigned long long) oskar_mem_length(h->w_kernels_compact);
+        const size_t header = sizeof(CacheKey) + sizeof(num_elements) +
+                2 * sizeof(int) * (size_t) num_w_planes;
+        memset(padding, 0, sizeof(padding));
+        error |= fwrite(&key, sizeof(CacheKey), 1, file) != 1;
+        error |= fwrite(&num_elements, sizeof(num_elements), 1, file) != 1;
+        error |= fwrite(oskar_mem_void_const(h->w_support), sizeof(int),
+                num_w_planes, file) != (size_t) num_w_planes;
+        error |= fwrite(oskar_mem_void_const(h->w_kernel_start), sizeof(int),
+                num_w_planes, file) != (size_t) num_w_planes;
+        error |= fwrite(padding, 1, data_offset(num_w_planes) - header,
+                file) != data_offset(num_w_planes) - header;
+        error |= fwrite(oskar_mem_void_const(h->w_kernels_compact), 1,
+                num_bytes, file) != num_bytes;
+        error |= fclose(file) != 0;
+    }
+#ifdef OSKAR_OS_WIN
+    (void) remove(path); /* rename() won't replace an existing file. */
+#endif
+    if (!error) error = rename(tmp_path, path) != 0;
+    if (error)
+    {
+        (void) remove(tmp_path);
+        oskar_log_warning(h->log,
+                "Could not write W-kernel cache file '%s'", path);
+    }
+    else
+    {
+        oskar_log_message(h->log, 'M', 0,
+                "Saved W-projection kernels to cache file '%s'", path);
+    }
+    free(tmp_path);
+    free(path);
+}
+
+
+void oskar_imager_w_kernel_cache_release(oskar_Imager* h)
+{
+#ifndef OSKAR_OS_WIN
+    if (h->w_kernel_map) (void) munmap(h->w_kernel_map, h->w_kernel_map_size);
+#endif
+    h->w_kernel_map = 0;
+    h->w_kernel_map_size = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
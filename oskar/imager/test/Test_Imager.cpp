@@ -1,13 +1,23 @@
 /*
- * Copyright (c) 2021, The OSKAR Developers.
+ * Copyright (c) 2021-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <gtest/gtest.h>
+#include <fitsio.h>
 #include "imager/oskar_imager.h"
+#include "math/oskar_evaluate_image_lmn_grid.h"
+#include "utility/oskar_dir.h"
 #include "vis/oskar_vis_header.h"
 #include "vis/oskar_vis_block.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 #define WRITE_FITS 1
 
 TEST(imager, update_from_block)
@@ -93,3 +103,1083 @@ TEST(imager, update_from_block)
     oskar_mem_free(image, &status);
     oskar_mem_free(grid, &status);
 }
+
+TEST(imager, update_from_block_all_channels)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const int size = 256, num_pixels = size * size;
+    const int num_times = 4, num_channels = 16, num_stations = 32;
+    const double freq_start_hz = 100e6, freq_inc_hz = 1e6;
+
+    // Create visibility data.
+    oskar_VisHeader* hdr = oskar_vis_header_create(type | OSKAR_COMPLEX, type,
+            num_times, num_times, num_channels, num_channels,
+            num_stations, 0, 1, &status);
+    oskar_vis_header_set_freq_start_hz(hdr, freq_start_hz);
+    oskar_vis_header_set_freq_inc_hz(hdr, freq_inc_hz);
+    oskar_VisBlock* block = oskar_vis_block_create_from_header(
+            OSKAR_CPU, hdr, &status);
+    ASSERT_EQ(0, status);
+    oskar_Mem* vis = oskar_vis_block_cross_correlations(block);
+    oskar_mem_random_gaussian(
+            oskar_vis_block_station_uvw_metres(block, 0), 0, 1, 2, 3,
+            100.0, &status);
+    oskar_mem_random_gaussian(
+            oskar_vis_block_station_uvw_metres(block, 1), 4, 5, 6, 7,
+            100.0, &status);
+    oskar_mem_random_gaussian(
+            oskar_vis_block_station_uvw_metres(block, 2), 8, 9, 10, 11,
+            10.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_vis_block_station_to_baseline_coords(block, &status);
+    ASSERT_EQ(0, status);
+
+    // Make images from the whole block, and from one channel at a time.
+    const int num_baselines = oskar_vis_block_num_baselines(block);
+    const size_t num_rows = (size_t) num_baselines * num_times;
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_rows, &status);
+    oskar_Mem* time_centroid = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_rows, &status);
+    oskar_Mem* scratch = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_rows, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_rows, &status);
+    oskar_mem_clear_contents(time_centroid, &status);
+    const char* algorithms[] = {"FFT", "W-projection"};
+    for (int a = 0; a < 2; ++a)
+    {
+        oskar_Mem* image[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            oskar_Imager* im = oskar_imager_create(type, &status);
+            oskar_imager_set_algorithm(im, algorithms[a], &status);
+            oskar_imager_set_fov(im, 4.0);
+            oskar_imager_set_size(im, size, &status);
+            oskar_imager_set_weighting(im, "Uniform", &status);
+            oskar_imager_set_vis_frequency(im,
+                    freq_start_hz, freq_inc_hz, num_channels);
+            oskar_imager_set_vis_phase_centre(im, 0.0, 60.0);
+            ASSERT_EQ(0, status);
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                const int coords_only = (pass == 0);
+                oskar_imager_set_coords_only(im, coords_only);
+                if (i == 0)
+                {
+                    oskar_imager_update_from_block(im, hdr, block, &status);
+                    continue;
+                }
+                for (int c = 0; c < num_channels; ++c)
+                {
+                    for (int t = 0; t < num_times; ++t)
+                    {
+                        oskar_mem_copy_contents(scratch, vis,
+                                num_baselines * t,
+                                num_baselines * (num_channels * t + c),
+                                num_baselines, &status);
+                    }
+                    oskar_imager_update(im, num_rows, c, c, 1,
+                            oskar_vis_block_baseline_uu_metres_const(block),
+                            oskar_vis_block_baseline_vv_metres_const(block),
+                            oskar_vis_block_baseline_ww_metres_const(block),
+                            coords_only ? 0 : scratch, weight,
+                            time_centroid, &status);
+                }
+            }
+            image[i] = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+            oskar_imager_finalise(im, 1, &image[i], 0, 0, &status);
+            oskar_imager_free(im, &status);
+            ASSERT_EQ(0, status);
+        }
+
+        // Check the images are the same, to within rounding errors.
+        const double* a0 = oskar_mem_double_const(image[0], &status);
+        const double* a1 = oskar_mem_double_const(image[1], &status);
+        double max_abs = 0.0;
+        for (int i = 0; i < num_pixels; ++i)
+        {
+            if (std::fabs(a0[i]) > max_abs) max_abs = std::fabs(a0[i]);
+        }
+        ASSERT_GT(max_abs, 0.0);
+        for (int i = 0; i < num_pixels; ++i)
+        {
+            ASSERT_NEAR(a0[i], a1[i], 1e-10 * max_abs) << algorithms[a];
+        }
+        oskar_mem_free(image[0], &status);
+        oskar_mem_free(image[1], &status);
+    }
+
+    // Clean up.
+    oskar_mem_free(weight, &status);
+    oskar_mem_free(time_centroid, &status);
+    oskar_mem_free(scratch, &status);
+    oskar_vis_block_free(block, &status);
+    oskar_vis_header_free(hdr, &status);
+}
+
+TEST(imager, wproj_sort_by_w)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 20000;
+
+    // Create visibility data.
+    // The frequency is set so that coordinates in metres are in wavelengths.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Make W-projection grids, with and without sorting.
+    oskar_Mem* grid[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, "W-projection", &status);
+        oskar_imager_set_fov(im, 1.0);
+        oskar_imager_set_size(im, 256, &status);
+        oskar_imager_set_num_w_planes(im, 16);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        oskar_imager_set_coords_only(im, 1);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        oskar_imager_set_coords_only(im, 0);
+        ASSERT_EQ(0, status);
+        grid[i] = 0;
+        if (i == 0)
+        {
+            // Visibilities are sorted by W-projection plane.
+            oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                    0, &status);
+            oskar_imager_finalise(im, 0, 0, 1, &grid[i], &status);
+        }
+        else
+        {
+            // Visibilities are gridded in the order supplied.
+            const int plane_size = oskar_imager_plane_size(im);
+            double plane_norm = 0.0;
+            grid[i] = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+                    (size_t) plane_size * plane_size, &status);
+            oskar_mem_clear_contents(grid[i], &status);
+            oskar_imager_update_plane(im, num_vis, uu, vv, ww, vis, weight,
+                    0, grid[i], &plane_norm, 0, &status);
+            oskar_mem_scale_real(grid[i], 1.0 / plane_norm,
+                    0, oskar_mem_length(grid[i]), &status);
+        }
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status);
+    }
+
+    // Check the grids are the same, to within rounding errors.
+    ASSERT_EQ(oskar_mem_length(grid[0]), oskar_mem_length(grid[1]));
+    const size_t num_cells = 2 * oskar_mem_length(grid[0]);
+    const double* a = oskar_mem_double_const(grid[0], &status);
+    const double* b = oskar_mem_double_const(grid[1], &status);
+    double max_abs = 0.0;
+    for (size_t i = 0; i < num_cells; ++i)
+    {
+        if (std::fabs(a[i]) > max_abs) max_abs = std::fabs(a[i]);
+    }
+    ASSERT_GT(max_abs, 0.0);
+    for (size_t i = 0; i < num_cells; ++i)
+    {
+        ASSERT_NEAR(a[i], b[i], 1e-10 * max_abs);
+    }
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    oskar_mem_free(grid[0], &status);
+    oskar_mem_free(grid[1], &status);
+}
+
+TEST(imager, wproj_kernel_cache)
+{
+    int status = 0, type = OSKAR_SINGLE;
+    const size_t num_vis = 5000;
+    const char* cache_dir = "temp_test_imager_w_kernel_cache";
+    (void) oskar_dir_remove(cache_dir);
+
+    // Create visibility data.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Make W-projection grids without the cache, then with the cache
+    // when it is empty, then again when it has been filled.
+    oskar_Mem* grid[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, "W-projection", &status);
+        oskar_imager_set_fov(im, 2.0);
+        oskar_imager_set_size(im, 128, &status);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        if (i > 0) oskar_imager_set_w_kernel_cache_dir(im, cache_dir);
+        ASSERT_STREQ(i > 0 ? cache_dir : 0,
+                oskar_imager_w_kernel_cache_dir(im));
+        oskar_imager_set_coords_only(im, 1);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        oskar_imager_set_coords_only(im, 0);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        grid[i] = 0;
+        oskar_imager_finalise(im, 0, 0, 1, &grid[i], &status);
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status);
+
+        // Check there is exactly one kernel file in the cache.
+        int num_items = 0;
+        char** items = 0;
+        oskar_dir_items(cache_dir, "oskar_w_kernels_*", 1, 0,
+                &num_items, &items);
+        EXPECT_EQ(i > 0 ? 1 : 0, num_items);
+        for (int j = 0; j < num_items; ++j) free(items[j]);
+        free(items);
+    }
+
+    // Check the grids are identical.
+    for (int i = 1; i < 3; ++i)
+    {
+        ASSERT_EQ(oskar_mem_length(grid[0]), oskar_mem_length(grid[i]));
+        EXPECT_EQ(0, memcmp(oskar_mem_void_const(grid[0]),
+                oskar_mem_void_const(grid[i]), oskar_mem_length(grid[0]) *
+                oskar_mem_element_size(oskar_mem_type(grid[0]))));
+    }
+
+    // Clean up.
+    (void) oskar_dir_remove(cache_dir);
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    for (int i = 0; i < 3; ++i) oskar_mem_free(grid[i], &status);
+}
+
+TEST(imager, grid_scratch_file)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 5000;
+    const int size = 128, num_pols = 4;
+    const char* scratch_dir = "temp_test_imager_grid_scratch";
+    (void) oskar_dir_remove(scratch_dir);
+
+    // Create visibility data and weights for all linear polarisations.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_pols * num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU,
+            num_pols * num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_pols * num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Make images with the planes on the heap, then memory-mapped in the
+    // system temporary directory, then in the scratch directory.
+    // The four planes need 1 MB, so a limit of 0.5 MB is exceeded,
+    // and only two planes can be in memory at once (or one, with the
+    // smaller limit used last). Data are gridded in two halves, so that
+    // planes are released from memory and read back in between updates.
+    oskar_Mem* image[4][4];
+    const size_t half = num_vis / 2;
+    for (int i = 0; i < 4; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_image_type(im, "Linear", &status);
+        oskar_imager_set_fov(im, 2.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        if (i > 0) oskar_imager_set_grid_memory_mb(im, i < 3 ? 0.5 : 0.1);
+        if (i > 1) oskar_imager_set_grid_scratch_dir(im, scratch_dir);
+        ASSERT_STREQ(i > 1 ? scratch_dir : 0,
+                oskar_imager_grid_scratch_dir(im));
+        for (int j = 0; j < 2; ++j)
+        {
+            oskar_Mem* u = oskar_mem_create_alias(uu, j * half, half, &status);
+            oskar_Mem* v = oskar_mem_create_alias(vv, j * half, half, &status);
+            oskar_Mem* w = oskar_mem_create_alias(ww, j * half, half, &status);
+            oskar_Mem* a = oskar_mem_create_alias(vis, j * num_pols * half,
+                    num_pols * half, &status);
+            oskar_Mem* h = oskar_mem_create_alias(weight, j * num_pols * half,
+                    num_pols * half, &status);
+            oskar_imager_update(im, half, 0, 0, num_pols, u, v, w, a, h,
+                    0, &status);
+            oskar_mem_free(u, &status);
+            oskar_mem_free(v, &status);
+            oskar_mem_free(w, &status);
+            oskar_mem_free(a, &status);
+            oskar_mem_free(h, &status);
+        }
+        for (int p = 0; p < num_pols; ++p) image[i][p] = 0;
+        oskar_imager_finalise(im, num_pols, image[i], 0, 0, &status);
+        ASSERT_EQ(0, status);
+
+        // Check the scratch file has no name, so it is never left behind.
+        int num_items = 0;
+        char** items = 0;
+        oskar_dir_items(scratch_dir, "oskar_grid_*", 1, 0,
+                &num_items, &items);
+        EXPECT_EQ(0, num_items);
+        for (int j = 0; j < num_items; ++j) free(items[j]);
+        free(items);
+        if (i > 1)
+        {
+            EXPECT_TRUE(oskar_dir_exists(scratch_dir));
+        }
+        oskar_imager_free(im, &status);
+    }
+
+    // Check the images are identical.
+    for (int i = 1; i < 4; ++i)
+    {
+        for (int p = 0; p < num_pols; ++p)
+        {
+            ASSERT_EQ(oskar_mem_length(image[0][p]),
+                    oskar_mem_length(image[i][p]));
+            EXPECT_EQ(0, memcmp(oskar_mem_void_const(image[0][p]),
+                    oskar_mem_void_const(image[i][p]),
+                    oskar_mem_length(image[0][p]) *
+                    oskar_mem_element_size(oskar_mem_type(image[0][p]))));
+        }
+    }
+
+    // Clean up.
+    (void) oskar_dir_remove(scratch_dir);
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int p = 0; p < num_pols; ++p)
+        {
+            oskar_mem_free(image[i][p], &status);
+        }
+    }
+}
+
+TEST(imager, fits_compression)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 2000;
+    const int size = 128, num_channels = 3;
+    const size_t num_pix = (size_t) size * size;
+    const char* root[] = {
+            "temp_test_imager_fits_none",
+            "temp_test_imager_fits_gzip",
+            "temp_test_imager_fits_rice"
+    };
+    const char* compression[] = {"None", "GZIP", "Rice"};
+    const double quantize_level[] = {16.0, 0.0, 16.0};
+
+    // Create visibility data for each channel.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_channels * num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Make an image cube with each type of compression.
+    for (int i = 0; i < 3; ++i)
+    {
+        oskar_Mem* image[num_channels];
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_fov(im, 2.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_channel_snapshots(im, 1);
+        oskar_imager_set_vis_frequency(im, 100e6, 1e6, num_channels);
+        oskar_imager_set_output_root(im, root[i]);
+        oskar_imager_set_fits_compression(im, compression[i], &status);
+        oskar_imager_set_fits_quantize_level(im, quantize_level[i]);
+        ASSERT_EQ(0, status);
+        EXPECT_STREQ(compression[i], oskar_imager_fits_compression(im));
+        oskar_imager_update(im, num_vis, 0, num_channels - 1, 1,
+                uu, vv, ww, vis, weight, 0, &status);
+        for (int c = 0; c < num_channels; ++c) image[c] = 0;
+        oskar_imager_finalise(im, num_channels, image, 0, 0, &status);
+        ASSERT_EQ(0, status);
+        oskar_imager_free(im, &status);
+
+        // Read the cube back, and compare it with the output images.
+        char file_name[64];
+        fitsfile* f = 0;
+        int compressed = 0;
+        long firstpix[3] = {1, 1, 1};
+        snprintf(file_name, sizeof(file_name), "%s_I.fits", root[i]);
+        fits_open_image(&f, file_name, READONLY, &status);
+        ASSERT_EQ(0, status);
+        compressed = fits_is_compressed_image(f, &status);
+        EXPECT_EQ(i > 0 ? 1 : 0, compressed);
+        std::vector<double> pix(num_pix);
+        for (int c = 0; c < num_channels; ++c)
+        {
+            firstpix[2] = 1 + c;
+            fits_read_pix(f, TDOUBLE, firstpix, (LONGLONG) num_pix, 0,
+                    &pix[0], 0, &status);
+            ASSERT_EQ(0, status);
+            const double* ref = oskar_mem_double_const(image[c], &status);
+            double max_err = 0.0, sum_sq = 0.0;
+            for (size_t j = 0; j < num_pix; ++j)
+            {
+                max_err = std::max(max_err, fabs(pix[j] - ref[j]));
+                sum_sq += ref[j] * ref[j];
+            }
+            if (i < 2)
+            {
+                EXPECT_EQ(0.0, max_err);
+            }
+            else
+            {
+                EXPECT_LT(max_err, 0.1 * sqrt(sum_sq / num_pix));
+            }
+            oskar_mem_free(image[c], &status);
+        }
+        fits_close_file(f, &status);
+        remove(file_name);
+    }
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+}
+
+TEST(imager, wstack_vs_dft_3d)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 2000;
+    const int size = 128;
+
+    // Create visibility data for an off-centre point source,
+    // with large W coordinates.
+    // The frequency is set so that coordinates in metres are in wavelengths.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 50.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 50.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 200.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+    const double l0 = 0.1, m0 = -0.07, n0 = sqrt(1.0 - l0 * l0 - m0 * m0);
+    const double* u = oskar_mem_double_const(uu, &status);
+    const double* v = oskar_mem_double_const(vv, &status);
+    const double* w = oskar_mem_double_const(ww, &status);
+    double* amp = oskar_mem_double(vis, &status);
+    for (size_t i = 0; i < num_vis; ++i)
+    {
+        const double phase = 2.0 * M_PI * (
+                u[i] * l0 + v[i] * m0 + w[i] * (n0 - 1.0));
+        amp[2 * i] = cos(phase);
+        amp[2 * i + 1] = sin(phase);
+    }
+
+    // Make images using a DFT, an FFT and W-stacking.
+    const char* algorithms[] = {"DFT 3D", "FFT", "W-stacking"};
+    oskar_Mem* image[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, algorithms[i], &status);
+        oskar_imager_set_fov(im, 20.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        image[i] = 0;
+        oskar_imager_finalise(im, 1, &image[i], 0, 0, &status);
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status) << algorithms[i];
+    }
+
+    // Check the W-stacking image matches the DFT image,
+    // and that the FFT image does not.
+    const double* dft = oskar_mem_double_const(image[0], &status);
+    const double* fft = oskar_mem_double_const(image[1], &status);
+    const double* wstack = oskar_mem_double_const(image[2], &status);
+    double max_dft = 0.0, max_diff_fft = 0.0, max_diff_wstack = 0.0;
+    for (int i = 0; i < size * size; ++i)
+    {
+        max_dft = std::max(max_dft, dft[i]);
+        max_diff_fft = std::max(max_diff_fft, std::fabs(fft[i] - dft[i]));
+        max_diff_wstack = std::max(max_diff_wstack,
+                std::fabs(wstack[i] - dft[i]));
+    }
+    EXPECT_GT(max_dft, 0.9);
+    EXPECT_LT(max_diff_wstack, 0.01 * max_dft);
+    EXPECT_GT(max_diff_fft, 0.5 * max_dft);
+
+    // Check that W-stacking the same data in several blocks gives the same
+    // image, as the layer grids are kept between blocks.
+    const size_t num_blocks = 7, block_size = num_vis / num_blocks + 1;
+    oskar_Mem* image_blocks = 0;
+    oskar_Imager* im = oskar_imager_create(type, &status);
+    oskar_imager_set_algorithm(im, "W-stacking", &status);
+    oskar_imager_set_fov(im, 20.0);
+    oskar_imager_set_size(im, size, &status);
+    oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+    for (size_t start = 0; start < num_vis; start += block_size)
+    {
+        const size_t num = std::min(block_size, num_vis - start);
+        oskar_Mem* b_uu = oskar_mem_create_alias(uu, start, num, &status);
+        oskar_Mem* b_vv = oskar_mem_create_alias(vv, start, num, &status);
+        oskar_Mem* b_ww = oskar_mem_create_alias(ww, start, num, &status);
+        oskar_Mem* b_vis = oskar_mem_create_alias(vis, start, num, &status);
+        oskar_Mem* b_wt = oskar_mem_create_alias(weight, start, num, &status);
+        oskar_imager_update(im, num, 0, 0, 1, b_uu, b_vv, b_ww, b_vis, b_wt,
+                0, &status);
+        oskar_mem_free(b_uu, &status);
+        oskar_mem_free(b_vv, &status);
+        oskar_mem_free(b_ww, &status);
+        oskar_mem_free(b_vis, &status);
+        oskar_mem_free(b_wt, &status);
+    }
+    oskar_imager_finalise(im, 1, &image_blocks, 0, 0, &status);
+    oskar_imager_free(im, &status);
+    ASSERT_EQ(0, status);
+    const double* wstack_blocks = oskar_mem_double_const(image_blocks,
+            &status);
+    double max_diff_blocks = 0.0;
+    for (int i = 0; i < size * size; ++i)
+    {
+        max_diff_blocks = std::max(max_diff_blocks,
+                std::fabs(wstack_blocks[i] - wstack[i]));
+    }
+    EXPECT_LT(max_diff_blocks, 1e-10 * max_dft);
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    for (int i = 0; i < 3; ++i) oskar_mem_free(image[i], &status);
+    oskar_mem_free(image_blocks, &status);
+}
+
+TEST(imager, dft_2d_vs_3d)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 500;
+    const int size = 100;
+
+    // Create visibility data with zero W coordinates, so that the 2D and
+    // 3D transforms are the same.
+    // The frequency is set so that coordinates in metres are in wavelengths.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 100.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 8, 9, 10, 11, 1.0, &status);
+    oskar_mem_clear_contents(ww, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Make images using both transforms.
+    const char* algorithms[] = {"DFT 2D", "DFT 3D"};
+    oskar_Mem* image[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, algorithms[i], &status);
+        oskar_imager_set_fov(im, 10.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        image[i] = 0;
+        oskar_imager_finalise(im, 1, &image[i], 0, 0, &status);
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status) << algorithms[i];
+    }
+
+    // Check the images are the same.
+    const double* a = oskar_mem_double_const(image[0], &status);
+    const double* b = oskar_mem_double_const(image[1], &status);
+    double max_abs = 0.0;
+    for (int i = 0; i < size * size; ++i)
+    {
+        max_abs = std::max(max_abs, std::fabs(b[i]));
+    }
+    ASSERT_GT(max_abs, 0.0);
+    for (int i = 0; i < size * size; ++i)
+    {
+        ASSERT_NEAR(a[i], b[i], 1e-9 * max_abs) << "pixel " << i;
+    }
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    for (int i = 0; i < 2; ++i) oskar_mem_free(image[i], &status);
+}
+
+static void run_half_plane(int type, const char* algorithm, double tol)
+{
+    int status = 0;
+    const size_t num_vis = 5000;
+    const int size = 128;
+
+    // Create visibility data.
+    // The frequency is set so that coordinates in metres are in wavelengths.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Make images using full and half-plane grids.
+    oskar_Mem* image[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, algorithm, &status);
+        oskar_imager_set_fov(im, 1.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_num_w_planes(im, 16);
+        oskar_imager_set_half_plane(im, i);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        oskar_imager_set_coords_only(im, 1);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        oskar_imager_set_coords_only(im, 0);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        image[i] = 0;
+        oskar_imager_finalise(im, 1, &image[i], 0, 0, &status);
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status) << algorithm;
+    }
+
+    // Check the images are the same, to within rounding errors.
+    const size_t num_pix = (size_t) size * size;
+    ASSERT_EQ(num_pix, oskar_mem_length(image[0]));
+    ASSERT_EQ(num_pix, oskar_mem_length(image[1]));
+    oskar_Mem* a = oskar_mem_convert_precision(image[0], OSKAR_DOUBLE,
+            &status);
+    oskar_Mem* b = oskar_mem_convert_precision(image[1], OSKAR_DOUBLE,
+            &status);
+    const double* p_a = oskar_mem_double_const(a, &status);
+    const double* p_b = oskar_mem_double_const(b, &status);
+    double max_abs = 0.0;
+    for (size_t i = 0; i < num_pix; ++i)
+    {
+        max_abs = std::max(max_abs, std::fabs(p_a[i]));
+    }
+    ASSERT_GT(max_abs, 0.0);
+    for (size_t i = 0; i < num_pix; ++i)
+    {
+        ASSERT_NEAR(p_a[i], p_b[i], tol * max_abs) << algorithm;
+    }
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    oskar_mem_free(a, &status);
+    oskar_mem_free(b, &status);
+    for (int i = 0; i < 2; ++i) oskar_mem_free(image[i], &status);
+}
+
+TEST(imager, half_plane)
+{
+    run_half_plane(OSKAR_DOUBLE, "FFT", 1e-8);
+    run_half_plane(OSKAR_DOUBLE, "W-projection", 1e-8);
+    run_half_plane(OSKAR_SINGLE, "FFT", 1e-2);
+    run_half_plane(OSKAR_SINGLE, "W-projection", 1e-2);
+}
+
+static void run_predict(const char* algorithm, double max_rms)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 2000;
+    const int size = 128, x0 = 80, y0 = 50;
+    const double fov_deg = 5.0;
+
+    // Create baseline coordinates.
+    // The frequency is set so that coordinates in metres are in wavelengths.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* pred = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 10.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 10.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_set_value_real(weight, 1.0, 0, num_vis, &status);
+    ASSERT_EQ(0, status);
+
+    // Create a model image containing a single pixel, and find its
+    // direction cosines.
+    oskar_Mem* model = oskar_mem_create(type, OSKAR_CPU,
+            (size_t) size * size, &status);
+    oskar_mem_clear_contents(model, &status);
+    oskar_mem_double(model, &status)[y0 * size + x0] = 1.0;
+    oskar_Mem* l = oskar_mem_create(type, OSKAR_CPU,
+            (size_t) size * size, &status);
+    oskar_Mem* m = oskar_mem_create(type, OSKAR_CPU,
+            (size_t) size * size, &status);
+    oskar_Mem* n = oskar_mem_create(type, OSKAR_CPU,
+            (size_t) size * size, &status);
+    oskar_evaluate_image_lmn_grid(size, size, fov_deg * M_PI / 180.0,
+            fov_deg * M_PI / 180.0, 0, l, m, n, &status);
+    const double l0 = oskar_mem_double(l, &status)[y0 * size + x0];
+    const double m0 = oskar_mem_double(m, &status)[y0 * size + x0];
+    const double n0 = oskar_mem_double(n, &status)[y0 * size + x0];
+    ASSERT_EQ(0, status);
+
+    // Evaluate visibilities for the source using a DFT.
+    const double* u = oskar_mem_double_const(uu, &status);
+    const double* v = oskar_mem_double_const(vv, &status);
+    const double* w = oskar_mem_double_const(ww, &status);
+    double* amp = oskar_mem_double(vis, &status);
+    for (size_t i = 0; i < num_vis; ++i)
+    {
+        const double phase = 2.0 * M_PI * (
+                u[i] * l0 + v[i] * m0 + w[i] * (n0 - 1.0));
+        amp[2 * i] = cos(phase);
+        amp[2 * i + 1] = sin(phase);
+    }
+
+    // Predict visibilities from the model image, and make an image
+    // of the DFT visibilities using the same settings.
+    oskar_Mem* image = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, algorithm, &status);
+        oskar_imager_set_fov(im, fov_deg);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        oskar_imager_set_coords_only(im, 1);
+        oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis, weight,
+                0, &status);
+        oskar_imager_set_coords_only(im, 0);
+        if (i == 0)
+        {
+            oskar_imager_set_model_image(im, model, &status);
+            oskar_imager_predict(im, num_vis, uu, vv, ww, pred, &status);
+        }
+        else
+        {
+            oskar_imager_update(im, num_vis, 0, 0, 1, uu, vv, ww, vis,
+                    weight, 0, &status);
+            oskar_imager_finalise(im, 1, &image, 0, 0, &status);
+        }
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status) << algorithm;
+    }
+
+    // Check the predicted visibilities match the DFT visibilities.
+    const double* p = oskar_mem_double_const(pred, &status);
+    double corr = 0.0, rms = 0.0;
+    for (size_t i = 0; i < num_vis; ++i)
+    {
+        const double d_re = p[2 * i] - amp[2 * i];
+        const double d_im = p[2 * i + 1] - amp[2 * i + 1];
+        corr += p[2 * i] * amp[2 * i] + p[2 * i + 1] * amp[2 * i + 1];
+        rms += d_re * d_re + d_im * d_im;
+    }
+    corr /= num_vis;
+    rms = sqrt(rms / num_vis);
+    EXPECT_LT(rms, max_rms) << algorithm;
+
+    // Check prediction is consistent with imaging: the correlation of the
+    // predicted and DFT visibilities must equal the image pixel value.
+    const double pix = oskar_mem_double_const(image, &status)[y0 * size + x0];
+    EXPECT_GT(pix, 0.95) << algorithm;
+    EXPECT_NEAR(pix, corr, 1e-6) << algorithm;
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(pred, &status);
+    oskar_mem_free(weight, &status);
+    oskar_mem_free(model, &status);
+    oskar_mem_free(image, &status);
+    oskar_mem_free(l, &status);
+    oskar_mem_free(m, &status);
+    oskar_mem_free(n, &status);
+}
+
+TEST(imager, predict)
+{
+    run_predict("FFT", 1.0);
+    run_predict("W-projection", 0.1);
+}
+
+TEST(imager, uniform_uv_filter)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const size_t num_vis = 100000;
+    const int size = 256;
+    const double uv_min = 100.0, uv_max = 1000.0;
+
+    // Create visibility data, with some points outside the grid.
+    // The frequency is set so that coordinates in metres are in wavelengths.
+    oskar_Mem* uu = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vv = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* ww = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_Mem* vis = oskar_mem_create(type | OSKAR_COMPLEX, OSKAR_CPU,
+            num_vis, &status);
+    oskar_Mem* weight = oskar_mem_create(type, OSKAR_CPU, num_vis, &status);
+    oskar_mem_random_gaussian(uu, 0, 1, 2, 3, 500.0, &status);
+    oskar_mem_random_gaussian(vv, 4, 5, 6, 7, 500.0, &status);
+    oskar_mem_random_gaussian(ww, 8, 9, 10, 11, 100.0, &status);
+    oskar_mem_random_gaussian(vis, 12, 13, 14, 15, 1.0, &status);
+    oskar_mem_random_uniform(weight, 16, 17, 18, 19, &status);
+    ASSERT_EQ(0, status);
+
+    // Copy the visibilities inside the baseline range.
+    oskar_Mem* uu_sel = oskar_mem_create_copy(uu, OSKAR_CPU, &status);
+    oskar_Mem* vv_sel = oskar_mem_create_copy(vv, OSKAR_CPU, &status);
+    oskar_Mem* ww_sel = oskar_mem_create_copy(ww, OSKAR_CPU, &status);
+    oskar_Mem* vis_sel = oskar_mem_create_copy(vis, OSKAR_CPU, &status);
+    oskar_Mem* weight_sel = oskar_mem_create_copy(weight, OSKAR_CPU, &status);
+    size_t num_sel = 0;
+    {
+        const double* u = oskar_mem_double_const(uu, &status);
+        const double* v = oskar_mem_double_const(vv, &status);
+        const double* w = oskar_mem_double_const(ww, &status);
+        const double* a = oskar_mem_double_const(vis, &status);
+        const double* h = oskar_mem_double_const(weight, &status);
+        double* u_sel = oskar_mem_double(uu_sel, &status);
+        double* v_sel = oskar_mem_double(vv_sel, &status);
+        double* w_sel = oskar_mem_double(ww_sel, &status);
+        double* a_sel = oskar_mem_double(vis_sel, &status);
+        double* h_sel = oskar_mem_double(weight_sel, &status);
+        for (size_t i = 0; i < num_vis; ++i)
+        {
+            const double r = sqrt(u[i] * u[i] + v[i] * v[i]);
+            if (r < uv_min || r > uv_max) continue;
+            u_sel[num_sel] = u[i];
+            v_sel[num_sel] = v[i];
+            w_sel[num_sel] = w[i];
+            a_sel[2 * num_sel] = a[2 * i];
+            a_sel[2 * num_sel + 1] = a[2 * i + 1];
+            h_sel[num_sel] = h[i];
+            num_sel++;
+        }
+    }
+    ASSERT_GT(num_sel, 0u);
+    ASSERT_LT(num_sel, num_vis);
+
+    // Make uniformly-weighted images, using the baseline filter on all
+    // the visibilities, and using only the visibilities already selected.
+    oskar_Mem* image[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_algorithm(im, "FFT", &status);
+        oskar_imager_set_weighting(im, "Uniform", &status);
+        oskar_imager_set_fov(im, 4.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_vis_frequency(im, 299792458.0, 1.0, 1);
+        if (i == 0)
+        {
+            oskar_imager_set_uv_filter_min(im, uv_min);
+            oskar_imager_set_uv_filter_max(im, uv_max);
+        }
+        const size_t n = (i == 0) ? num_vis : num_sel;
+        oskar_Mem* u = (i == 0) ? uu : uu_sel;
+        oskar_Mem* v = (i == 0) ? vv : vv_sel;
+        oskar_Mem* w = (i == 0) ? ww : ww_sel;
+        oskar_Mem* a = (i == 0) ? vis : vis_sel;
+        oskar_Mem* h = (i == 0) ? weight : weight_sel;
+        oskar_imager_set_coords_only(im, 1);
+        oskar_imager_update(im, n, 0, 0, 1, u, v, w, a, h, 0, &status);
+        oskar_imager_set_coords_only(im, 0);
+        oskar_imager_update(im, n, 0, 0, 1, u, v, w, a, h, 0, &status);
+        image[i] = 0;
+        oskar_imager_finalise(im, 1, &image[i], 0, 0, &status);
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status);
+    }
+
+    // Check the images are identical.
+    const size_t num_pix = (size_t) size * size;
+    ASSERT_EQ(num_pix, oskar_mem_length(image[0]));
+    ASSERT_EQ(num_pix, oskar_mem_length(image[1]));
+    const double* p_a = oskar_mem_double_const(image[0], &status);
+    const double* p_b = oskar_mem_double_const(image[1], &status);
+    size_t num_diff = 0;
+    for (size_t i = 0; i < num_pix; ++i)
+    {
+        if (p_a[i] != p_b[i]) num_diff++;
+    }
+    EXPECT_EQ(0u, num_diff);
+
+    // Clean up.
+    oskar_mem_free(uu, &status);
+    oskar_mem_free(vv, &status);
+    oskar_mem_free(ww, &status);
+    oskar_mem_free(vis, &status);
+    oskar_mem_free(weight, &status);
+    oskar_mem_free(uu_sel, &status);
+    oskar_mem_free(vv_sel, &status);
+    oskar_mem_free(ww_sel, &status);
+    oskar_mem_free(vis_sel, &status);
+    oskar_mem_free(weight_sel, &status);
+    for (int i = 0; i < 2; ++i) oskar_mem_free(image[i], &status);
+}
+
+TEST(imager, run_vis_file)
+{
+    int status = 0, type = OSKAR_DOUBLE;
+    const int size = 256, num_pixels = size * size;
+    const int num_times = 12, max_times_per_block = 3, num_channels = 2;
+    const int num_stations = 20;
+    const int num_blocks = num_times / max_times_per_block;
+    const char* filename = "temp_test_imager_run.vis";
+
+    // Write a visibility file with several blocks.
+    oskar_VisHeader* hdr = oskar_vis_header_create(type | OSKAR_COMPLEX, type,
+            max_times_per_block, num_times, num_channels, num_channels,
+            num_stations, 0, 1, &status);
+    oskar_vis_header_set_freq_start_hz(hdr, 100e6);
+    oskar_vis_header_set_freq_inc_hz(hdr, 1e6);
+    oskar_vis_header_set_time_start_mjd_utc(hdr, 51544.5);
+    oskar_vis_header_set_time_inc_sec(hdr, 10.0);
+    oskar_Binary* file = oskar_vis_header_write(hdr, filename, &status);
+    oskar_VisBlock* block = oskar_vis_block_create_from_header(
+            OSKAR_CPU, hdr, &status);
+    ASSERT_EQ(0, status);
+    for (int i_block = 0; i_block < num_blocks; ++i_block)
+    {
+        const unsigned int seed = (unsigned int) i_block;
+        oskar_vis_block_set_start_time_index(block,
+                i_block * max_times_per_block);
+        oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(
+                block, 0), seed, 1, 2, 3, 500.0, &status);
+        oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(
+                block, 1), seed, 4, 5, 6, 500.0, &status);
+        oskar_mem_random_gaussian(oskar_vis_block_station_uvw_metres(
+                block, 2), seed, 7, 8, 9, 100.0, &status);
+        oskar_mem_random_gaussian(oskar_vis_block_cross_correlations(block),
+                seed, 10, 11, 12, 1.0, &status);
+        oskar_vis_block_write(block, file, i_block, &status);
+    }
+    oskar_binary_free(file);
+    ASSERT_EQ(0, status);
+
+    // Make images by reading the file with oskar_imager_run(), which reads
+    // the next block in a separate thread, with and without the coordinate
+    // cache. Then make an image by updating the imager with each block
+    // in turn, without using a separate thread.
+    oskar_Mem* image[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        oskar_Imager* im = oskar_imager_create(type, &status);
+        oskar_imager_set_fov(im, 2.0);
+        oskar_imager_set_size(im, size, &status);
+        oskar_imager_set_weighting(im, "Uniform", &status);
+        oskar_imager_set_coord_cache_mb(im, i == 1 ? 100.0 : 0.0);
+        image[i] = 0;
+        if (i < 2)
+        {
+            oskar_imager_set_input_files(im, 1, &filename, &status);
+            oskar_imager_run(im, 1, &image[i], 0, 0, &status);
+        }
+        else
+        {
+            file = oskar_binary_create(filename, 'r', &status);
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                oskar_imager_set_coords_only(im, pass == 0);
+                if (pass == 1) oskar_imager_check_init(im, &status);
+                for (int i_block = 0; i_block < num_blocks; ++i_block)
+                {
+                    oskar_vis_block_read(block, hdr, file, i_block, &status);
+                    oskar_imager_update_from_block(im, hdr, block, &status);
+                }
+            }
+            oskar_binary_free(file);
+            oskar_imager_finalise(im, 1, &image[i], 0, 0, &status);
+        }
+        oskar_imager_free(im, &status);
+        ASSERT_EQ(0, status) << "Image " << i;
+    }
+
+    // Check the images match.
+    const double* ref = oskar_mem_double_const(image[2], &status);
+    double max_ref = 0.0;
+    for (int j = 0; j < num_pixels; ++j)
+    {
+        max_ref = std::max(max_ref, std::fabs(ref[j]));
+    }
+    EXPECT_GT(max_ref, 0.0);
+    for (int i = 0; i < 2; ++i)
+    {
+        const double* p = oskar_mem_double_const(image[i], &status);
+        double max_diff = 0.0;
+        for (int j = 0; j < num_pixels; ++j)
+        {
+            max_diff = std::max(max_diff, std::fabs(p[j] - ref[j]));
+        }
+        EXPECT_LE(max_diff, 1e-12 * max_ref) << "Image " << i;
+    }
+
+    // Clean up.
+    (void) remove(filename);
+    oskar_vis_block_free(block, &status);
+    oskar_vis_header_free(hdr, &status);
+    for (int i = 0; i < 3; ++i) oskar_mem_free(image[i], &status);
+}
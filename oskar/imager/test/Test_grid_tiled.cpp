@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "imager/oskar_grid_kernel_table.h"
+#include "imager/oskar_grid_simple.h"
+#include "imager/oskar_grid_tiled.h"
+#include "imager/oskar_grid_weights.h"
+#include "imager/oskar_grid_wproj2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+template<typename T>
+static void fill_random(std::vector<T>& data, double min, double max)
+{
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = (T) (min + (max - min) * rand() / (double) RAND_MAX);
+    }
+}
+
+template<typename T>
+static void check_equal(const std::vector<T>& a, const std::vector<T>& b)
+{
+    ASSERT_EQ(a.size(), b.size());
+    size_t num_diff = 0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if (a[i] != b[i]) num_diff++;
+    }
+    EXPECT_EQ(0u, num_diff);
+}
+
+template<typename T>
+static void check_close(const std::vector<T>& a, const std::vector<T>& b,
+        double tol)
+{
+    ASSERT_EQ(a.size(), b.size());
+    double max_a = 0.0, max_diff = 0.0;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        max_a = std::max(max_a, (double) fabs(a[i]));
+        max_diff = std::max(max_diff, (double) fabs(a[i] - b[i]));
+    }
+    EXPECT_GT(max_a, 0.0);
+    EXPECT_LE(max_diff, tol * max_a);
+}
+
+// Makes runs of visibilities at the same (u,v,w) position,
+// as from a baseline with several channels that fall in the same cell.
+template<typename T>
+static void repeat_coords(std::vector<T>& uu, std::vector<T>& vv,
+        std::vector<T>& ww, size_t run_length)
+{
+    for (size_t i = 0; i < uu.size(); ++i)
+    {
+        const size_t j = i - i % run_length;
+        uu[i] = uu[j];
+        vv[i] = vv[j];
+        ww[i] = ww[j];
+    }
+}
+
+// Coordinates are scaled so that some points fall off the grid.
+static const int grid_size = 256;
+static const size_t num_points = 20000;
+static const double cell_size_rad = 1.0 / grid_size;
+
+TEST(grid_tiled, kernel_table)
+{
+    for (int t = 0; t < 2; ++t)
+    {
+        const int support = t == 0 ? 3 : 5;
+        const int oversample = t == 0 ? 100 : 63;
+        const int width = 2 * support + 1;
+        const int max_offset = oskar_grid_kernel_table_max_offset(oversample);
+        const int num_rows = 2 * max_offset + 1;
+        EXPECT_EQ((oversample + 1) / 2, max_offset);
+        srand(1);
+        std::vector<double> conv_func((support + 1) * oversample);
+        std::vector<double> table(num_rows * width), table_sum(num_rows);
+        fill_random(conv_func, 0.0, 1.0);
+        oskar_grid_kernel_table_d(support, oversample, &conv_func[0],
+                &table[0], &table_sum[0]);
+        for (int off = -max_offset; off <= max_offset; ++off)
+        {
+            double sum = 0.0;
+            const double* row = &table[(off + max_offset) * width];
+            for (int k = -support; k <= support; ++k)
+            {
+                const double c = conv_func[abs(off + k * oversample)];
+                EXPECT_EQ(c, row[k + support]);
+                sum += c;
+            }
+            EXPECT_EQ(sum, table_sum[off + max_offset]);
+        }
+    }
+}
+
+TEST(grid_tiled, simple_double)
+{
+    int status = 0;
+    for (int t = 0; t < 2; ++t)
+    {
+        const int support = t == 0 ? 3 : 5;
+        const int oversample = t == 0 ? 100 : 63;
+        srand(1);
+        std::vector<double> conv_func((support + 1) * oversample + 1);
+        std::vector<double> uu(num_points), vv(num_points);
+        std::vector<double> vis(2 * num_points), weight(num_points);
+        fill_random(conv_func, 0.0, 1.0);
+        fill_random(uu, -140.0, 140.0);
+        fill_random(vv, -140.0, 140.0);
+        fill_random(vis, -1.0, 1.0);
+        fill_random(weight, 0.5, 2.0);
+        std::vector<double> grid1(2 * grid_size * grid_size, 0.0);
+        std::vector<double> grid2(grid1);
+        size_t num_skipped1 = 0, num_skipped2 = 0;
+        double norm1 = 0.0, norm2 = 0.0;
+        oskar_grid_simple_d(support, oversample, &conv_func[0], num_points,
+                &uu[0], &vv[0], &vis[0], &weight[0], cell_size_rad,
+                grid_size, &num_skipped1, &norm1, &grid1[0], &status);
+        oskar_grid_simple_tiled_d(support, oversample, &conv_func[0],
+                num_points, &uu[0], &vv[0], &vis[0], &weight[0],
+                cell_size_rad, grid_size, 0, &num_skipped2, &norm2, &grid2[0],
+                &status);
+        ASSERT_EQ(0, status);
+        EXPECT_GT(num_skipped1, 0u);
+        EXPECT_EQ(num_skipped1, num_skipped2);
+        EXPECT_EQ(norm1, norm2);
+        check_equal(grid1, grid2);
+    }
+}
+
+TEST(grid_tiled, simple_single)
+{
+    int status = 0;
+    for (int t = 0; t < 2; ++t)
+    {
+        const int support = t == 0 ? 3 : 5;
+        const int oversample = t == 0 ? 100 : 63;
+        srand(2);
+        std::vector<float> conv_func((support + 1) * oversample + 1);
+        std::vector<float> uu(num_points), vv(num_points);
+        std::vector<float> vis(2 * num_points), weight(num_points);
+        fill_random(conv_func, 0.0, 1.0);
+        fill_random(uu, -140.0, 140.0);
+        fill_random(vv, -140.0, 140.0);
+        fill_random(vis, -1.0, 1.0);
+        fill_random(weight, 0.5, 2.0);
+        std::vector<float> grid1(2 * grid_size * grid_size, 0.0f);
+        std::vector<float> grid2(grid1);
+        size_t num_skipped1 = 0, num_skipped2 = 0;
+        double norm1 = 0.0, norm2 = 0.0;
+        oskar_grid_simple_f(support, oversample, &conv_func[0], num_points,
+                &uu[0], &vv[0], &vis[0], &weight[0], (float) cell_size_rad,
+                grid_size, &num_skipped1, &norm1, &grid1[0], &status);
+        oskar_grid_simple_tiled_f(support, oversample, &conv_func[0],
+                num_points, &uu[0], &vv[0], &vis[0], &weight[0],
+                (float) cell_size_rad, grid_size, 0,
+                &num_skipped2, &norm2, &grid2[0], &status);
+        ASSERT_EQ(0, status);
+        EXPECT_GT(num_skipped1, 0u);
+        EXPECT_EQ(num_skipped1, num_skipped2);
+        EXPECT_EQ(norm1, norm2);
+        check_equal(grid1, grid2);
+    }
+}
+
+// Sets up W-kernel supports and start offsets for the given oversample.
+static size_t wkernel_layout(int num_w_planes, int oversample,
+        std::vector<int>& support, std::vector<int>& wkernel_start)
+{
+    size_t total = 0;
+    const int oversample_h = oversample / 2;
+    support.resize(num_w_planes);
+    wkernel_start.resize(num_w_planes);
+    for (int i = 0; i < num_w_planes; ++i)
+    {
+        support[i] = 2 + i;
+        const int conv_len = 2 * support[i] + 1;
+        const int width = (oversample_h * conv_len + 1) * conv_len;
+        wkernel_start[i] = (int) total;
+        total += (oversample_h + 1) * width;
+    }
+    return total;
+}
+
+TEST(grid_tiled, wproj2_double)
+{
+    int status = 0;
+    const int num_w_planes = 8, oversample = 4;
+    std::vector<int> support, wkernel_start;
+    const size_t kernel_size = wkernel_layout(num_w_planes, oversample,
+            support, wkernel_start);
+    srand(3);
+    std::vector<double> wkernel(2 * kernel_size);
+    std::vector<double> uu(num_points), vv(num_points), ww(num_points);
+    std::vector<double> vis(2 * num_points), weight(num_points);
+    fill_random(wkernel, -1.0, 1.0);
+    fill_random(uu, -140.0, 140.0);
+    fill_random(vv, -140.0, 140.0);
+    fill_random(ww, -100.0, 100.0);
+    fill_random(vis, -1.0, 1.0);
+    fill_random(weight, 0.5, 2.0);
+    std::vector<double> grid1(2 * grid_size * grid_size, 0.0);
+    std::vector<double> grid2(grid1);
+    size_t num_skipped1 = 0, num_skipped2 = 0;
+    double norm1 = 0.0, norm2 = 0.0;
+    const double w_scale = 0.5;
+    oskar_grid_wproj2_d(num_w_planes, &support[0], oversample,
+            &wkernel_start[0], &wkernel[0], num_points,
+            &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+            cell_size_rad, w_scale, grid_size,
+            &num_skipped1, &norm1, &grid1[0]);
+    oskar_grid_wproj2_tiled_d(num_w_planes, &support[0], oversample,
+            &wkernel_start[0], &wkernel[0], num_points,
+            &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+            cell_size_rad, w_scale, grid_size, 0,
+            &num_skipped2, &norm2, &grid2[0], &status);
+    ASSERT_EQ(0, status);
+    EXPECT_GT(num_skipped1, 0u);
+    EXPECT_EQ(num_skipped1, num_skipped2);
+    EXPECT_EQ(norm1, norm2);
+    check_equal(grid1, grid2);
+}
+
+TEST(grid_tiled, wproj2_single)
+{
+    int status = 0;
+    const int num_w_planes = 8, oversample = 4;
+    std::vector<int> support, wkernel_start;
+    const size_t kernel_size = wkernel_layout(num_w_planes, oversample,
+            support, wkernel_start);
+    srand(4);
+    std::vector<float> wkernel(2 * kernel_size);
+    std::vector<float> uu(num_points), vv(num_points), ww(num_points);
+    std::vector<float> vis(2 * num_points), weight(num_points);
+    fill_random(wkernel, -1.0, 1.0);
+    fill_random(uu, -140.0, 140.0);
+    fill_random(vv, -140.0, 140.0);
+    fill_random(ww, -100.0, 100.0);
+    fill_random(vis, -1.0, 1.0);
+    fill_random(weight, 0.5, 2.0);
+    std::vector<float> grid1(2 * grid_size * grid_size, 0.0f);
+    std::vector<float> grid2(grid1);
+    size_t num_skipped1 = 0, num_skipped2 = 0;
+    double norm1 = 0.0, norm2 = 0.0;
+    const float w_scale = 0.5f;
+    oskar_grid_wproj2_f(num_w_planes, &support[0], oversample,
+            &wkernel_start[0], &wkernel[0], num_points,
+            &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+            (float) cell_size_rad, w_scale, grid_size,
+            &num_skipped1, &norm1, &grid1[0]);
+    oskar_grid_wproj2_tiled_f(num_w_planes, &support[0], oversample,
+            &wkernel_start[0], &wkernel[0], num_points,
+            &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+            (float) cell_size_rad, w_scale, grid_size, 0,
+            &num_skipped2, &norm2, &grid2[0], &status);
+    ASSERT_EQ(0, status);
+    EXPECT_GT(num_skipped1, 0u);
+    EXPECT_EQ(num_skipped1, num_skipped2);
+    EXPECT_EQ(norm1, norm2);
+    check_equal(grid1, grid2);
+}
+
+// Visibilities at the same position are summed before gridding them,
+// so the results agree with the serial version only to rounding error.
+TEST(grid_tiled, repeated_uv)
+{
+    int status = 0;
+    const int num_w_planes = 8, oversample = 4, support_simple = 3;
+    const size_t run_length = 5;
+    std::vector<int> support, wkernel_start;
+    const size_t kernel_size = wkernel_layout(num_w_planes, oversample,
+            support, wkernel_start);
+    srand(7);
+    std::vector<double> conv_func((support_simple + 1) * oversample + 1);
+    std::vector<double> wkernel(2 * kernel_size);
+    std::vector<double> uu(num_points), vv(num_points), ww(num_points);
+    std::vector<double> vis(2 * num_points), weight(num_points);
+    fill_random(conv_func, 0.0, 1.0);
+    fill_random(wkernel, -1.0, 1.0);
+    fill_random(uu, -140.0, 140.0);
+    fill_random(vv, -140.0, 140.0);
+    fill_random(ww, -100.0, 100.0);
+    fill_random(vis, -1.0, 1.0);
+    fill_random(weight, 0.5, 2.0);
+    repeat_coords(uu, vv, ww, run_length);
+    std::vector<float> conv_func_f(conv_func.begin(), conv_func.end());
+    std::vector<float> wkernel_f(wkernel.begin(), wkernel.end());
+    std::vector<float> uu_f(uu.begin(), uu.end());
+    std::vector<float> vv_f(vv.begin(), vv.end());
+    std::vector<float> ww_f(ww.begin(), ww.end());
+    std::vector<float> vis_f(vis.begin(), vis.end());
+    std::vector<float> weight_f(weight.begin(), weight.end());
+    for (int t = 0; t < 4; ++t)
+    {
+        std::vector<double> grid1(2 * grid_size * grid_size, 0.0);
+        std::vector<double> grid2(grid1);
+        std::vector<float> grid1_f(2 * grid_size * grid_size, 0.0f);
+        std::vector<float> grid2_f(grid1_f);
+        size_t num_skipped1 = 0, num_skipped2 = 0;
+        double norm1 = 0.0, norm2 = 0.0;
+        switch (t)
+        {
+        case 0:
+            oskar_grid_simple_d(support_simple, oversample, &conv_func[0],
+                    num_points, &uu[0], &vv[0], &vis[0], &weight[0],
+                    cell_size_rad, grid_size, &num_skipped1, &norm1,
+                    &grid1[0], &status);
+            oskar_grid_simple_tiled_d(support_simple, oversample,
+                    &conv_func[0], num_points, &uu[0], &vv[0], &vis[0],
+                    &weight[0], cell_size_rad, grid_size, 0,
+                    &num_skipped2, &norm2, &grid2[0], &status);
+            break;
+        case 1:
+            oskar_grid_simple_f(support_simple, oversample, &conv_func_f[0],
+                    num_points, &uu_f[0], &vv_f[0], &vis_f[0], &weight_f[0],
+                    (float) cell_size_rad, grid_size, &num_skipped1, &norm1,
+                    &grid1_f[0], &status);
+            oskar_grid_simple_tiled_f(support_simple, oversample,
+                    &conv_func_f[0], num_points, &uu_f[0], &vv_f[0],
+                    &vis_f[0], &weight_f[0], (float) cell_size_rad,
+                    grid_size, 0, &num_skipped2, &norm2, &grid2_f[0], &status);
+            break;
+        case 2:
+            oskar_grid_wproj2_d(num_w_planes, &support[0], oversample,
+                    &wkernel_start[0], &wkernel[0], num_points,
+                    &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+                    cell_size_rad, 0.5, grid_size,
+                    &num_skipped1, &norm1, &grid1[0]);
+            oskar_grid_wproj2_tiled_d(num_w_planes, &support[0], oversample,
+                    &wkernel_start[0], &wkernel[0], num_points,
+                    &uu[0], &vv[0], &ww[0], &vis[0], &weight[0],
+                    cell_size_rad, 0.5, grid_size, 0,
+                    &num_skipped2, &norm2, &grid2[0], &status);
+            break;
+        default:
+            oskar_grid_wproj2_f(num_w_planes, &support[0], oversample,
+                    &wkernel_start[0], &wkernel_f[0], num_points,
+                    &uu_f[0], &vv_f[0], &ww_f[0], &vis_f[0], &weight_f[0],
+                    (float) cell_size_rad, 0.5f, grid_size,
+                    &num_skipped1, &norm1, &grid1_f[0]);
+            oskar_grid_wproj2_tiled_f(num_w_planes, &support[0], oversample,
+                    &wkernel_start[0], &wkernel_f[0], num_points,
+                    &uu_f[0], &vv_f[0], &ww_f[0], &vis_f[0], &weight_f[0],
+                    (float) cell_size_rad, 0.5f, grid_size, 0,
+                    &num_skipped2, &norm2, &grid2_f[0], &status);
+            break;
+        }
+        ASSERT_EQ(0, status);
+        EXPECT_GT(num_skipped1, 0u);
+        EXPECT_EQ(num_skipped1, num_skipped2);
+        EXPECT_DOUBLE_EQ(norm1, norm2);
+        if (t % 2 == 0)
+        {
+            check_close(grid1, grid2, 1e-12);
+        }
+        else
+        {
+            check_close(grid1_f, grid2_f, 1e-5);
+        }
+    }
+}
+
+TEST(grid_tiled, weights_double)
+{
+    int status = 0;
+    srand(5);
+    std::vector<double> uu(num_points), vv(num_points), weight(num_points);
+    fill_random(uu, -140.0, 140.0);
+    fill_random(vv, -140.0, 140.0);
+    fill_random(weight, 0.5, 2.0);
+    std::vector<double> grid1(grid_size * grid_size, 0.0);
+    std::vector<double> grid2(grid1);
+
+    // Update each grid twice, to check accumulation.
+    for (int t = 0; t < 2; ++t)
+    {
+        size_t num_skipped1 = 0, num_skipped2 = 0;
+        oskar_grid_weights_write_d(num_points, &uu[0], &vv[0], &weight[0],
+                cell_size_rad, grid_size, &num_skipped1, &grid1[0]);
+        oskar_grid_weights_write_tiled_d(num_points, &uu[0], &vv[0],
+                &weight[0], cell_size_rad, grid_size, &num_skipped2,
+                &grid2[0], &status);
+        ASSERT_EQ(0, status);
+        EXPECT_GT(num_skipped1, 0u);
+        EXPECT_EQ(num_skipped1, num_skipped2);
+    }
+    check_equal(grid1, grid2);
+}
+
+TEST(grid_tiled, weights_single)
+{
+    int status = 0;
+    srand(6);
+    std::vector<float> uu(num_points), vv(num_points), weight(num_points);
+    fill_random(uu, -140.0, 140.0);
+    fill_random(vv, -140.0, 140.0);
+    fill_random(weight, 0.5, 2.0);
+    std::vector<float> grid1(grid_size * grid_size, 0.0f);
+    std::vector<float> grid2(grid1), guard1(grid1), guard2(grid1);
+
+    // Update each grid twice, to check accumulation.
+    for (int t = 0; t < 2; ++t)
+    {
+        size_t num_skipped1 = 0, num_skipped2 = 0;
+        oskar_grid_weights_write_f(num_points, &uu[0], &vv[0], &weight[0],
+                (float) cell_size_rad, grid_size, &num_skipped1,
+                &grid1[0], &guard1[0]);
+        oskar_grid_weights_write_tiled_f(num_points, &uu[0], &vv[0],
+                &weight[0], (float) cell_size_rad, grid_size, &num_skipped2,
+                &grid2[0], &guard2[0], &status);
+        ASSERT_EQ(0, status);
+        EXPECT_GT(num_skipped1, 0u);
+        EXPECT_EQ(num_skipped1, num_skipped2);
+    }
+    check_equal(grid1, grid2);
+    check_equal(guard1, guard2);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2023, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -58,6 +58,49 @@ void oskar_evaluate_jones_E(
         oskar_StationWork* work,
         int* status);
 
+/**
+ * @brief
+ * Evaluates sets of E-Jones matrices for several frequency channels.
+ *
+ * @details
+ * Evaluates station beams for a telescope model at the specified source
+ * positions for each of the given frequencies, storing the results for
+ * each channel in a separate Jones matrix data structure.
+ *
+ * The loop over channels is inside the loop over stations, so that
+ * the frequency-independent parts of each station beam are evaluated only
+ * once for all the channels (see oskar_station_beam_channels()).
+ *
+ * @param[in]  num_channels  Number of frequency channels.
+ * @param[out] E             Output set of Jones matrices for each channel.
+ * @param[in]  coord_type    Type of coordinates.
+ * @param[in]  num_points    Number of coordinates given.
+ * @param[in]  source_coords Source coordinate values.
+ * @param[in]  ref_lon_rad   Reference longitude in radians, if inputs are direction cosines.
+ * @param[in]  ref_lat_rad   Reference latitude in radians, if inputs are direction cosines.
+ * @param[in]  tel           Input telescope model.
+ * @param[in]  time_index    Simulation time index.
+ * @param[in]  gast_rad      The Greenwich Apparent Sidereal Time, in radians.
+ * @param[in]  frequency_hz  The observing frequency of each channel, in Hz.
+ * @param[in]  work          Pointer to structure holding work arrays.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+void oskar_evaluate_jones_E_channels(
+        int num_channels,
+        oskar_Jones* const* E,
+        int coord_type,
+        int num_points,
+        const oskar_Mem* const source_coords[3],
+        double ref_lon_rad,
+        double ref_lat_rad,
+        oskar_Telescope* tel,
+        int time_index,
+        double gast_rad,
+        const double* frequency_hz,
+        oskar_StationWork* work,
+        int* status);
+
 #ifdef __cplusplus
 }
 #endif
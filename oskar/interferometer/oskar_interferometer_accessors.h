@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2020, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -11,6 +11,7 @@
  */
 
 #include <oskar_global.h>
+#include <imager/oskar_imager.h>
 #include <log/oskar_log.h>
 #include <sky/oskar_sky.h>
 #include <telescope/oskar_telescope.h>
@@ -77,9 +78,43 @@ OSKAR_EXPORT
 void oskar_interferometer_set_max_times_per_block(oskar_Interferometer* h,
         int value);
 
+/**
+ * @brief
+ * Sets an imager used to predict visibilities from a model image.
+ *
+ * @details
+ * If set, visibilities predicted from the imager's model image using
+ * oskar_imager_predict_block() are added to the cross-correlations of
+ * each block, before any system noise.
+ *
+ * Note that station beams and other Jones terms are NOT applied to the
+ * predicted visibilities, so the model image must already include any
+ * beam response (it is the apparent sky, as it would be imaged).
+ * The imager is not owned by the simulator, and must not be freed
+ * while it is in use.
+ *
+ * @param[in,out] h       Handle to simulator.
+ * @param[in]     imager  Handle to imager with a model image, or NULL.
+ */
+OSKAR_EXPORT
+void oskar_interferometer_set_model_imager(oskar_Interferometer* h,
+        oskar_Imager* imager);
+
 OSKAR_EXPORT
 void oskar_interferometer_set_num_devices(oskar_Interferometer* h, int value);
 
+OSKAR_EXPORT
+void oskar_interferometer_set_num_threads_per_device(oskar_Interferometer* h,
+        int value);
+
+OSKAR_EXPORT
+void oskar_interferometer_set_num_output_buffers(oskar_Interferometer* h,
+        int value);
+
+OSKAR_EXPORT
+void oskar_interferometer_set_num_writer_threads(oskar_Interferometer* h,
+        int value);
+
 OSKAR_EXPORT
 void oskar_interferometer_set_observation_frequency(oskar_Interferometer* h,
         double start_hz, double inc_hz, int num_channels);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2020, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -7,6 +7,7 @@
 #define OSKAR_PRIVATE_INTERFEROMETER_H_
 
 #include <binary/oskar_binary.h>
+#include <imager/oskar_imager.h>
 #include <interferometer/oskar_jones.h>
 #include <log/oskar_log.h>
 #include <mem/oskar_mem.h>
@@ -18,20 +19,37 @@
 #include <vis/oskar_vis_block.h>
 #include <vis/oskar_vis_header.h>
 
+/* Limits on the number of channels of Jones E evaluated together. */
+#define MAX_CHANNEL_BATCH 16
+#define MAX_CHANNEL_BATCH_BYTES (256ul << 20)
+
+/* Result of a work unit, held on the host until it can be added to its
+ * visibility block after the results for all preceding sky chunks. */
+struct PendingUnit
+{
+    int buffer_index, time_index, chunk_index, has_sources;
+    oskar_Mem *cross, *autos;
+    struct PendingUnit* next;
+};
+typedef struct PendingUnit PendingUnit;
+
 /* Memory allocated per compute device (may be either CPU or GPU). */
 struct DeviceData
 {
-    /* Host memory. */
-    oskar_VisBlock* vis_block_cpu[2]; /* On host, for copy back & write. */
+    /* Work units queued for this device, which may be stolen by others. */
+    oskar_Mutex* queue_mutex;
+    int *queue, queue_capacity, queue_head, queue_count;
 
     /* Device memory. */
     int previous_chunk_index;
-    oskar_VisBlock* vis_block;  /* Device memory block. */
+    oskar_VisBlock* vis_block;  /* Device memory block, for one time. */
     oskar_Mem *lmn[3], *uvw[3];
     oskar_Sky* chunk;           /* The unmodified sky chunk being processed. */
     oskar_Sky* chunk_clip;      /* Copy of the chunk after horizon clipping. */
     oskar_Telescope* tel;       /* Telescope model, created as a copy. */
-    oskar_Jones *J, *R, *E, *K;
+    oskar_Jones *J, *R, *K;
+    oskar_Jones** E;            /* Jones E for each channel in a batch. */
+    int num_channels_batch;     /* Number of channels in a batch. */
     oskar_Mem *gains;
     oskar_StationWork* station_work;
 
@@ -43,6 +61,7 @@ struct DeviceData
     oskar_Timer* tmr_join;      /* Time spent combining Jones matrices. */
     oskar_Timer* tmr_E;         /* Time spent evaluating E-Jones. */
     oskar_Timer* tmr_K;         /* Time spent evaluating K-Jones. */
+    oskar_Timer* tmr_stall;     /* Time spent waiting for a free buffer. */
 };
 typedef struct DeviceData DeviceData;
 
@@ -53,6 +72,7 @@ struct oskar_Interferometer
     int prec, num_devices, num_gpus_avail, dev_loc, num_gpus, *gpu_ids;
     int num_channels, num_time_steps;
     int max_sources_per_chunk, max_times_per_block, max_channels_per_block;
+    int num_output_buffers, num_writer_threads, num_threads_per_device;
     int apply_horizon_clip, force_polarised_ms, zero_failed_gaussians;
     int coords_only, ignore_w_components;
     double freq_start_hz, freq_inc_hz, time_start_mjd_utc, time_inc_sec;
@@ -61,20 +81,36 @@ struct oskar_Interferometer
 
     /* State. */
     int init_sky, work_unit_index;
+    int num_threads_cpu_device; /* Size of each CPU device thread team. */
     oskar_Mutex* mutex;
-    oskar_Barrier* barrier;
     oskar_Log* log;
 
+    /* Work unit scheduler state, protected by the condition variable. */
+    oskar_ConditionVar* schedule;
+    int next_block_index, next_block_to_finalise;
+    int num_blocks_complete, num_blocks_written;
+    int *num_units_remaining;  /* Work units left for each host buffer. */
+
+    /* Work unit results are added to the host buffers in sky chunk order,
+     * protected by the mutex. */
+    int *num_chunks_added;     /* For each time slice of each buffer. */
+    PendingUnit *pending, *pending_free;
+    int queue_depth_max, queue_depth_sum, queue_depth_samples;
+
     /* Sky model and telescope model. */
     int num_sources_total, num_sky_chunks;
     oskar_Sky** sky_chunks;
     oskar_Telescope* tel;
+    oskar_Imager* model_imager; /* Not owned: predicts diffuse emission. */
 
     /* Output data and file handles. */
     oskar_VisHeader* header;
+    int num_vis_blocks_cpu;         /* Number of host buffers allocated. */
+    oskar_VisBlock** vis_block_cpu; /* On host, for copy back & write. */
+    int *vis_block_cpu_index;       /* Block index held in each buffer. */
+    oskar_Mem** vis_block_temp;     /* Noise work array for each buffer. */
     oskar_MeasurementSet* ms;
     oskar_Binary* vis;
-    oskar_Mem *temp;
     oskar_Timer* tmr_sim;   /* The total time for the simulation. */
     oskar_Timer* tmr_write; /* The time spent writing vis blocks. */
 
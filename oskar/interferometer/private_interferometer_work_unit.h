@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_PRIVATE_INTERFEROMETER_WORK_UNIT_H_
+#define OSKAR_PRIVATE_INTERFEROMETER_WORK_UNIT_H_
+
+#include <oskar_global.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * A work unit is the simulation of one sky chunk for one time step of
+ * one visibility block. The units of a block are ordered chunk-major,
+ * so that a device can keep the same sky chunk for consecutive units.
+ * The results for each time slice are added to the host block in sky chunk
+ * order, whichever device they came from, so the output does not depend on
+ * how units are distributed.
+ */
+
+/* Returns the time and channel ranges covered by the given block. */
+void oskar_interferometer_block_range(const oskar_Interferometer* h,
+        int block_index, int* time_index_start, int* num_times,
+        int* chan_index_start, int* num_chans);
+
+/* Frees the ring of host buffers used for copy back and write. */
+void oskar_interferometer_free_host_blocks(oskar_Interferometer* h,
+        int* status);
+
+/* Prepares the host buffer for the given block, if not already done.
+ * The caller must ensure this is not called concurrently. */
+void oskar_interferometer_set_up_host_block(oskar_Interferometer* h,
+        int block_index, int* status);
+
+/* Simulates one work unit, and adds the result to the host buffer. */
+void oskar_interferometer_sim_work_unit(oskar_Interferometer* h,
+        int block_index, int time_index_block, int chunk_index,
+        int device_id, int* status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2023, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -100,43 +100,95 @@ void oskar_evaluate_jones_E(
         oskar_StationWork* work,
         int* status)
 {
-    int i = 0, j = 0;
-    if (*status) return;
+    oskar_evaluate_jones_E_channels(1, &E, coord_type, num_points,
+            source_coords, ref_lon_rad, ref_lat_rad, tel, time_index,
+            gast_rad, &frequency_hz, work, status);
+}
+
+
+/* NOLINTNEXTLINE(readability-identifier-naming) */
+void oskar_evaluate_jones_E_channels(
+        int num_channels,
+        oskar_Jones* const* E,
+        int coord_type,
+        int num_points,
+        const oskar_Mem* const source_coords[3],
+        double ref_lon_rad,
+        double ref_lat_rad,
+        oskar_Telescope* tel,
+        int time_index,
+        double gast_rad,
+        const double* frequency_hz,
+        oskar_StationWork* work,
+        int* status)
+{
+    int c = 0, i = 0, j = 0, use_harp = 0;
+    oskar_Mem** beam = 0;
+    if (*status || num_channels < 1) return;
     const int num_stations = oskar_telescope_num_stations(tel);
-    const int num_sources = oskar_jones_num_sources(E);
+    const int num_sources = oskar_jones_num_sources(E[0]);
     if (num_stations == 0)
     {
         *status = OSKAR_ERR_MEMORY_NOT_ALLOCATED;
         return;
     }
-    if (num_stations != oskar_jones_num_stations(E))
+    for (c = 0; c < num_channels; ++c)
     {
-        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        if (num_stations != oskar_jones_num_stations(E[c]) ||
+                num_sources != oskar_jones_num_sources(E[c]))
+        {
+            *status = OSKAR_ERR_DIMENSION_MISMATCH;
+            return;
+        }
+        if (oskar_telescope_harp_data(tel, frequency_hz[c])) use_harp = 1;
+    }
+
+    /* Check if HARP data exist. These are evaluated one channel at a time,
+     * as each channel can use different coefficients. */
+    if (use_harp)
+    {
+        for (c = 0; c < num_channels; ++c)
+        {
+            oskar_Harp* harp_data =
+                    oskar_telescope_harp_data(tel, frequency_hz[c]);
+            if (harp_data)
+            {
+                oskar_evaluate_element_beams_harp(harp_data, coord_type,
+                        num_points, source_coords, ref_lon_rad, ref_lat_rad,
+                        tel, gast_rad, frequency_hz[c], work,
+                        oskar_jones_mem(E[c]), status);
+            }
+            else
+            {
+                oskar_evaluate_jones_E_channels(1, &E[c], coord_type,
+                        num_points, source_coords, ref_lon_rad, ref_lat_rad,
+                        tel, time_index, gast_rad, &frequency_hz[c],
+                        work, status);
+            }
+        }
         return;
     }
 
-    /* Check if HARP data exist. */
-    oskar_Harp* harp_data = oskar_telescope_harp_data(tel, frequency_hz);
-    if (harp_data)
+    /* Get the output array for each channel. */
+    beam = (oskar_Mem**) malloc(num_channels * sizeof(oskar_Mem*));
+    for (c = 0; c < num_channels; ++c)
     {
-        oskar_evaluate_element_beams_harp(harp_data, coord_type, num_points,
-                source_coords, ref_lon_rad, ref_lat_rad, tel, gast_rad,
-                frequency_hz, work, oskar_jones_mem(E), status);
+        beam[c] = oskar_jones_mem(E[c]);
     }
-    else if (!oskar_telescope_allow_station_beam_duplication(tel))
+    if (!oskar_telescope_allow_station_beam_duplication(tel))
     {
         /* Evaluate all the station beams. */
         for (i = 0; i < num_stations; ++i)
         {
-            oskar_station_beam(
+            oskar_station_beam_channels(
                     oskar_telescope_station(tel, i),
                     work, coord_type, num_points, source_coords,
                     ref_lon_rad, ref_lat_rad,
                     oskar_telescope_phase_centre_coord_type(tel),
                     oskar_telescope_phase_centre_longitude_rad(tel),
                     oskar_telescope_phase_centre_latitude_rad(tel),
-                    time_index, gast_rad, frequency_hz,
-                    i * num_sources, oskar_jones_mem(E), status);
+                    time_index, gast_rad, num_channels, frequency_hz,
+                    i * num_sources, beam, status);
         }
     }
     else
@@ -160,23 +212,25 @@ void oskar_evaluate_jones_E(
             }
             if (station_to_copy >= 0)
             {
-                oskar_mem_copy_contents(
-                        oskar_jones_mem(E), oskar_jones_mem(E),
-                        (size_t)(i * num_sources),               /* Dest. */
-                        (size_t)(station_to_copy * num_sources), /* Source. */
-                        (size_t)num_sources, status);
+                for (c = 0; c < num_channels; ++c)
+                {
+                    oskar_mem_copy_contents(beam[c], beam[c],
+                            (size_t)(i * num_sources),               /* Dest. */
+                            (size_t)(station_to_copy * num_sources), /* Source. */
+                            (size_t)num_sources, status);
+                }
             }
             else
             {
-                oskar_station_beam(
+                oskar_station_beam_channels(
                         oskar_telescope_station(tel, station_model_type),
                         work, coord_type, num_points, source_coords,
                         ref_lon_rad, ref_lat_rad,
                         oskar_telescope_phase_centre_coord_type(tel),
                         oskar_telescope_phase_centre_longitude_rad(tel),
                         oskar_telescope_phase_centre_latitude_rad(tel),
-                        time_index, gast_rad, frequency_hz,
-                        i * num_sources, oskar_jones_mem(E), status);
+                        time_index, gast_rad, num_channels, frequency_hz,
+                        i * num_sources, beam, status);
                 num_models_evaluated++;
                 models_evaluated = (int*) realloc(models_evaluated,
                         num_models_evaluated * sizeof(int));
@@ -189,6 +243,7 @@ void oskar_evaluate_jones_E(
         free(models_evaluated);
         free(model_offsets);
     }
+    free(beam);
 }
 
 #ifdef __cplusplus
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2022, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -172,6 +172,12 @@ void oskar_interferometer_set_max_times_per_block(oskar_Interferometer* h,
     h->max_times_per_block = value;
 }
 
+void oskar_interferometer_set_model_imager(oskar_Interferometer* h,
+        oskar_Imager* imager)
+{
+    h->model_imager = imager;
+}
+
 void oskar_interferometer_set_num_devices(oskar_Interferometer* h, int value)
 {
     int status = 0;
@@ -186,6 +192,24 @@ void oskar_interferometer_set_num_devices(oskar_Interferometer* h, int value)
     h->d = (DeviceData*) calloc(h->num_devices, sizeof(DeviceData));
 }
 
+void oskar_interferometer_set_num_threads_per_device(oskar_Interferometer* h,
+        int value)
+{
+    h->num_threads_per_device = (value < 1) ? 0 : value;
+}
+
+void oskar_interferometer_set_num_output_buffers(oskar_Interferometer* h,
+        int value)
+{
+    h->num_output_buffers = (value < 2) ? 2 : value;
+}
+
+void oskar_interferometer_set_num_writer_threads(oskar_Interferometer* h,
+        int value)
+{
+    h->num_writer_threads = (value < 1) ? 1 : value;
+}
+
 void oskar_interferometer_set_observation_frequency(oskar_Interferometer* h,
         double start_hz, double inc_hz, int num_channels)
 {
@@ -1,15 +1,17 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <stdlib.h>
 
 #include "interferometer/private_interferometer.h"
+#include "interferometer/private_interferometer_work_unit.h"
 #include "interferometer/oskar_interferometer.h"
 #include "math/oskar_cmath.h"
 #include "utility/oskar_device.h"
 #include "utility/oskar_get_memory_usage.h"
+#include "utility/oskar_get_num_procs.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,6 +36,14 @@ void oskar_interferometer_check_init(oskar_Interferometer* h, int* status)
     if (!h->header)
     {
         set_up_vis_header(h, status);
+
+        /* Predicted model visibilities are not corrupted by the beam. */
+        if (h->model_imager)
+        {
+            oskar_log_warning(h->log, "Station beams and other Jones terms "
+                    "are not applied to visibilities predicted from the "
+                    "model image.");
+        }
     }
 
     /* Calculate source parameters if required. */
@@ -188,7 +198,7 @@ typedef struct ThreadArgs ThreadArgs;
 
 static void* init_device(void* arg)
 {
-    int dev_loc = 0, vistype = 0, *status = 0;
+    int c = 0, dev_loc = 0, vistype = 0, *status = 0;
     ThreadArgs* a = (ThreadArgs*)arg;
     oskar_Interferometer* h = a->h;
     DeviceData* d = a->d;
@@ -226,21 +236,37 @@ static void* init_device(void* arg)
         d->tmr_K         = oskar_timer_create(dev_loc);
         d->tmr_join      = oskar_timer_create(dev_loc);
         d->tmr_correlate = oskar_timer_create(dev_loc);
+        d->tmr_stall     = oskar_timer_create(OSKAR_TIMER_NATIVE);
     }
 
-    /* Visibility blocks. */
+    /* Visibility block, for one time step. */
     if (!d->vis_block)
     {
         d->vis_block = oskar_vis_block_create_from_header(dev_loc,
                 h->header, status);
-        d->vis_block_cpu[0] = oskar_vis_block_create_from_header(OSKAR_CPU,
-                h->header, status);
-        d->vis_block_cpu[1] = oskar_vis_block_create_from_header(OSKAR_CPU,
-                h->header, status);
+        oskar_vis_block_resize(d->vis_block, 1,
+                oskar_vis_header_max_channels_per_block(h->header),
+                num_stations, status);
     }
     oskar_vis_block_clear(d->vis_block, status);
-    oskar_vis_block_clear(d->vis_block_cpu[0], status);
-    oskar_vis_block_clear(d->vis_block_cpu[1], status);
+
+    /* Work unit queue. Enough space for all blocks that can be in flight. */
+    if (!d->queue_mutex) d->queue_mutex = oskar_mutex_create();
+    const int queue_capacity = h->num_output_buffers *
+            h->max_times_per_block * (h->num_sky_chunks > 0 ?
+                    h->num_sky_chunks : 1);
+    if (d->queue_capacity != queue_capacity)
+    {
+        int* queue = (int*) realloc(d->queue, queue_capacity * sizeof(int));
+        if (!queue)
+        {
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return 0;
+        }
+        d->queue = queue;
+        d->queue_capacity = queue_capacity;
+    }
+    d->queue_head = d->queue_count = 0;
 
     /* Device scratch memory. */
     if (!d->tel)
@@ -258,8 +284,29 @@ static void* init_device(void* arg)
                 status);
         d->R = oskar_type_is_matrix(vistype) ? oskar_jones_create(vistype,
                 dev_loc, num_stations, num_src, status) : 0;
-        d->E = oskar_jones_create(vistype, dev_loc, num_stations, num_src,
-                status);
+
+        /* Jones E for a batch of channels, limited in size. */
+        const size_t bytes_E = (size_t) num_stations * num_src *
+                oskar_mem_element_size(vistype);
+        d->num_channels_batch =
+                oskar_vis_header_max_channels_per_block(h->header);
+        if (d->num_channels_batch > MAX_CHANNEL_BATCH)
+        {
+            d->num_channels_batch = MAX_CHANNEL_BATCH;
+        }
+        while (d->num_channels_batch > 1 &&
+                d->num_channels_batch * bytes_E > MAX_CHANNEL_BATCH_BYTES)
+        {
+            d->num_channels_batch--;
+        }
+        if (d->num_channels_batch < 1) d->num_channels_batch = 1;
+        d->E = (oskar_Jones**) calloc(d->num_channels_batch,
+                sizeof(oskar_Jones*));
+        for (c = 0; c < d->num_channels_batch; ++c)
+        {
+            d->E[c] = oskar_jones_create(vistype, dev_loc,
+                    num_stations, num_src, status);
+        }
         d->K = oskar_jones_create(complx, dev_loc, num_stations, num_src,
                 status);
         d->gains = oskar_mem_create(vistype, dev_loc, num_stations, status);
@@ -295,6 +342,57 @@ static void set_up_device_data(oskar_Interferometer* h, int* status)
         oskar_interferometer_set_num_devices(h, h->num_gpus);
     }
 
+    /* Set the size of the thread team used by each CPU device.
+     * By default, the CPU cores are shared out between the CPU devices. */
+    h->num_threads_cpu_device = h->num_threads_per_device;
+    if (h->num_threads_cpu_device < 1)
+    {
+        const int num_cpu_devices = h->num_devices - h->num_gpus;
+        h->num_threads_cpu_device = (num_cpu_devices > 0) ?
+                oskar_get_num_procs() / num_cpu_devices : 1;
+        if (h->num_threads_cpu_device < 1) h->num_threads_cpu_device = 1;
+    }
+
+    /* Create the ring of host visibility blocks used for copy back and
+     * write, and the noise work array that goes with each one. */
+    if (h->num_vis_blocks_cpu != h->num_output_buffers)
+    {
+        const size_t num = (size_t) h->num_output_buffers;
+        oskar_interferometer_free_host_blocks(h, status);
+        h->vis_block_cpu = (oskar_VisBlock**) calloc(num,
+                sizeof(oskar_VisBlock*));
+        h->vis_block_cpu_index = (int*) calloc(num, sizeof(int));
+        h->vis_block_temp = (oskar_Mem**) calloc(num, sizeof(oskar_Mem*));
+        h->num_units_remaining = (int*) calloc(num, sizeof(int));
+        if (!h->vis_block_cpu || !h->vis_block_cpu_index ||
+                !h->vis_block_temp || !h->num_units_remaining)
+        {
+            oskar_interferometer_free_host_blocks(h, status);
+            *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+            return;
+        }
+        h->num_vis_blocks_cpu = h->num_output_buffers;
+        for (i = 0; i < h->num_output_buffers; ++i)
+        {
+            h->vis_block_cpu[i] = oskar_vis_block_create_from_header(
+                    OSKAR_CPU, h->header, status);
+            h->vis_block_temp[i] = oskar_mem_create(h->prec,
+                    OSKAR_CPU, 0, status);
+        }
+    }
+    for (i = 0; i < h->num_vis_blocks_cpu; ++i)
+    {
+        h->vis_block_cpu_index[i] = -1;
+    }
+    int* num_chunks_added = (int*) realloc(h->num_chunks_added,
+            h->num_vis_blocks_cpu * h->max_times_per_block * sizeof(int));
+    if (!num_chunks_added)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return;
+    }
+    h->num_chunks_added = num_chunks_added;
+
     /* Set up devices in parallel. */
     const int num_devices = h->num_devices;
     threads = (oskar_Thread**) calloc(num_devices, sizeof(oskar_Thread*));
@@ -327,6 +425,12 @@ static void set_up_device_data(oskar_Interferometer* h, int* status)
         }
         oskar_log_mem(h->log);
     }
+    if (!*status && h->num_devices > h->num_gpus)
+    {
+        oskar_log_message(h->log, 'M', 0, "Using %d CPU device(s) with "
+                "%d thread(s) each.", h->num_devices - h->num_gpus,
+                h->num_threads_cpu_device);
+    }
 }
 
 #ifdef __cplusplus
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2020, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -21,9 +21,8 @@ oskar_Interferometer* oskar_interferometer_create(int precision, int* status)
     h->prec      = precision;
     h->tmr_sim   = oskar_timer_create(OSKAR_TIMER_NATIVE);
     h->tmr_write = oskar_timer_create(OSKAR_TIMER_NATIVE);
-    h->temp      = oskar_mem_create(precision, OSKAR_CPU, 0, status);
     h->mutex     = oskar_mutex_create();
-    h->barrier   = oskar_barrier_create(0);
+    h->schedule  = oskar_condition_create();
     h->log       = oskar_log_create(OSKAR_LOG_MESSAGE, OSKAR_LOG_WARNING);
 
     /* Get number of devices available, and device location. */
@@ -38,6 +37,8 @@ oskar_Interferometer* oskar_interferometer_create(int precision, int* status)
     oskar_interferometer_set_horizon_clip(h, 1);
     oskar_interferometer_set_source_flux_range(h, -DBL_MAX, DBL_MAX);
     oskar_interferometer_set_max_times_per_block(h, 8);
+    oskar_interferometer_set_num_output_buffers(h, 2);
+    oskar_interferometer_set_num_writer_threads(h, 1);
     return h;
 }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -117,6 +117,7 @@ static void record_timing(oskar_Interferometer* h)
     int i = 0;
     double t_copy = 0., t_clip = 0., t_E = 0., t_K = 0., t_join = 0.;
     double t_correlate = 0., t_compute = 0., t_components = 0.;
+    double t_stall = 0.;
     double *compute_times = 0;
     compute_times = (double*) calloc(h->num_devices, sizeof(double));
     for (i = 0; i < h->num_devices; ++i)
@@ -128,6 +129,7 @@ static void record_timing(oskar_Interferometer* h)
         t_E += oskar_timer_elapsed(h->d[i].tmr_E);
         t_K += oskar_timer_elapsed(h->d[i].tmr_K);
         t_correlate += oskar_timer_elapsed(h->d[i].tmr_correlate);
+        t_stall += oskar_timer_elapsed(h->d[i].tmr_stall);
         t_compute += compute_times[i];
     }
     t_components = t_copy + t_clip + t_E + t_K + t_join + t_correlate;
@@ -143,6 +145,25 @@ static void record_timing(oskar_Interferometer* h)
     }
     oskar_log_value(h->log, 'M', 0, "Write", "%.3f s",
             oskar_timer_elapsed(h->tmr_write));
+    oskar_log_value(h->log, 'M', 0, "Output buffer wait",
+            "%.3f s [All devices]", t_stall);
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        const oskar_StationWork* work = h->d[i].station_work;
+        if (!work || !oskar_station_work_element_cache_lookups(work)) continue;
+        oskar_log_value(h->log, 'M', 0, "Element pattern cache",
+                "%lu hits of %lu [Device %i]",
+                (unsigned long) oskar_station_work_element_cache_hits(work),
+                (unsigned long) oskar_station_work_element_cache_lookups(work),
+                i);
+    }
+    if (h->queue_depth_samples > 0)
+    {
+        oskar_log_value(h->log, 'M', 0, "Output queue depth",
+                "%.1f mean, %d max [%d buffers]",
+                (double) h->queue_depth_sum / h->queue_depth_samples,
+                h->queue_depth_max, h->num_output_buffers);
+    }
     oskar_log_message(h->log, 'M', 0, "Compute components:");
     oskar_log_value(h->log, 'M', 1, "Copy", "%4.1f%%",
             (t_copy / t_compute) * 100.0);
@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <stdlib.h>
 
 #include "interferometer/private_interferometer.h"
+#include "interferometer/private_interferometer_work_unit.h"
 #include "interferometer/oskar_interferometer.h"
 
 #include "utility/oskar_get_error_string.h"
@@ -20,36 +21,17 @@ static unsigned int disp_width(unsigned int v);
 oskar_VisBlock* oskar_interferometer_finalise_block(oskar_Interferometer* h,
         int block_index, int* status)
 {
-    int i = 0, i_active = 0;
-    oskar_VisBlock *b0 = 0, *b = 0;
+    oskar_VisBlock *b0 = 0;
     if (*status) return 0;
 
-    /* The visibilities must be copied back
-     * at the end of the block simulation. */
-
-    /* Combine all vis blocks into the first one. */
-    i_active = (block_index + 1) % 2;
-    b0 = h->d[0].vis_block_cpu[!i_active];
-    if (!h->coords_only)
-    {
-        oskar_Mem *xc0 = 0, *ac0 = 0;
-        xc0 = oskar_vis_block_cross_correlations(b0);
-        ac0 = oskar_vis_block_auto_correlations(b0);
-        for (i = 1; i < h->num_devices; ++i)
-        {
-            b = h->d[i].vis_block_cpu[!i_active];
-            if (oskar_vis_block_has_cross_correlations(b))
-            {
-                oskar_mem_add(xc0, xc0, oskar_vis_block_cross_correlations(b),
-                        0, 0, 0, oskar_mem_length(xc0), status);
-            }
-            if (oskar_vis_block_has_auto_correlations(b))
-            {
-                oskar_mem_add(ac0, ac0, oskar_vis_block_auto_correlations(b),
-                        0, 0, 0, oskar_mem_length(ac0), status);
-            }
-        }
-    }
+    /* Each work unit has already written its own part of the host block,
+     * so there is nothing to combine here. The buffer needs to be set up
+     * only if no work units have been run for it (e.g. coordinates only). */
+    oskar_mutex_lock(h->mutex);
+    oskar_interferometer_set_up_host_block(h, block_index, status);
+    oskar_mutex_unlock(h->mutex);
+    const int i_buffer = block_index % h->num_vis_blocks_cpu;
+    b0 = h->vis_block_cpu[i_buffer];
 
     /* Calculate (u,v,w) coordinates for the block. */
     if (oskar_vis_block_has_cross_correlations(b0))
@@ -67,22 +49,32 @@ oskar_VisBlock* oskar_interferometer_finalise_block(oskar_Interferometer* h,
                 oskar_vis_block_baseline_uvw_metres(b0, 2), status);
     }
 
-    /* Add uncorrelated system noise to the combined visibilities. */
+    /* Add visibilities predicted from the model image, if set. */
+    if (!h->coords_only && h->model_imager)
+    {
+        oskar_imager_predict_block(h->model_imager, h->header, b0, status);
+    }
+
+    /* Add uncorrelated system noise to the combined visibilities.
+     * Each buffer has its own work array, so that blocks can be finalised
+     * concurrently by different writer threads. */
     if (!h->coords_only && oskar_telescope_noise_enabled(h->tel))
     {
         oskar_vis_block_add_system_noise(b0, h->header, h->tel,
-                h->temp, status);
+                h->vis_block_temp[i_buffer], status);
     }
 
     /* Print status message. */
     if (!*status)
     {
         const int num_blocks = oskar_interferometer_num_vis_blocks(h);
+        oskar_mutex_lock(h->mutex);
         oskar_log_message(h->log, 'S', 0, "Block %*i/%i (%3.0f%%) "
                 "complete. Simulation time elapsed: %.3f s",
                 disp_width(num_blocks), block_index + 1, num_blocks,
                 100.0 * (block_index + 1) / (double)num_blocks,
                 oskar_timer_elapsed(h->tmr_sim));
+        oskar_mutex_unlock(h->mutex);
     }
 
     /* Return a pointer to the block. */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "interferometer/private_interferometer.h"
+#include "interferometer/private_interferometer_work_unit.h"
 #include "interferometer/oskar_interferometer.h"
 #include "utility/oskar_device.h"
 
@@ -24,11 +25,10 @@ void oskar_interferometer_free(oskar_Interferometer* h, int* status)
         oskar_sky_free(h->sky_chunks[i], status);
     }
     oskar_telescope_free(h->tel, status);
-    oskar_mem_free(h->temp, status);
     oskar_timer_free(h->tmr_sim);
     oskar_timer_free(h->tmr_write);
     oskar_mutex_free(h->mutex);
-    oskar_barrier_free(h->barrier);
+    oskar_condition_free(h->schedule);
     oskar_log_free(h->log);
     free(h->sky_chunks);
     free(h->gpu_ids);
@@ -41,7 +41,7 @@ void oskar_interferometer_free(oskar_Interferometer* h, int* status)
 
 void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
 {
-    int i = 0;
+    int i = 0, j = 0;
     if (!h->d) return;
     for (i = 0; i < h->num_devices; ++i)
     {
@@ -58,8 +58,9 @@ void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
         oskar_timer_free(d->tmr_K);
         oskar_timer_free(d->tmr_join);
         oskar_timer_free(d->tmr_correlate);
-        oskar_vis_block_free(d->vis_block_cpu[0], status);
-        oskar_vis_block_free(d->vis_block_cpu[1], status);
+        oskar_timer_free(d->tmr_stall);
+        oskar_mutex_free(d->queue_mutex);
+        free(d->queue);
         oskar_vis_block_free(d->vis_block, status);
         oskar_mem_free(d->lmn[0], status);
         oskar_mem_free(d->lmn[1], status);
@@ -72,7 +73,11 @@ void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
         oskar_telescope_free(d->tel, status);
         oskar_station_work_free(d->station_work, status);
         oskar_jones_free(d->J, status);
-        oskar_jones_free(d->E, status);
+        for (j = 0; j < d->num_channels_batch; ++j)
+        {
+            oskar_jones_free(d->E[j], status);
+        }
+        free(d->E);
         oskar_jones_free(d->K, status);
         oskar_jones_free(d->R, status);
         oskar_mem_free(d->gains, status);
@@ -80,9 +85,46 @@ void oskar_interferometer_free_device_data(oskar_Interferometer* h, int* status)
     }
 }
 
+void oskar_interferometer_free_host_blocks(oskar_Interferometer* h,
+        int* status)
+{
+    int i = 0;
+    PendingUnit* lists[] = { h->pending, h->pending_free };
+    for (i = 0; i < h->num_vis_blocks_cpu; ++i)
+    {
+        oskar_vis_block_free(h->vis_block_cpu[i], status);
+        oskar_mem_free(h->vis_block_temp[i], status);
+    }
+    for (i = 0; i < 2; ++i)
+    {
+        while (lists[i])
+        {
+            PendingUnit* unit = lists[i];
+            lists[i] = unit->next;
+            oskar_mem_free(unit->cross, status);
+            oskar_mem_free(unit->autos, status);
+            free(unit);
+        }
+    }
+    free(h->vis_block_cpu);
+    free(h->vis_block_cpu_index);
+    free(h->vis_block_temp);
+    free(h->num_units_remaining);
+    free(h->num_chunks_added);
+    h->vis_block_cpu = 0;
+    h->vis_block_cpu_index = 0;
+    h->vis_block_temp = 0;
+    h->num_units_remaining = 0;
+    h->num_chunks_added = 0;
+    h->pending = 0;
+    h->pending_free = 0;
+    h->num_vis_blocks_cpu = 0;
+}
+
 void oskar_interferometer_reset_cache(oskar_Interferometer* h, int* status)
 {
     oskar_interferometer_free_device_data(h, status);
+    oskar_interferometer_free_host_blocks(h, status);
     oskar_binary_free(h->vis);
     oskar_vis_header_free(h->header, status);
 #ifndef OSKAR_NO_MS
@@ -1,11 +1,12 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <stdlib.h>
 
 #include "interferometer/private_interferometer.h"
+#include "interferometer/private_interferometer_work_unit.h"
 #include "interferometer/oskar_interferometer.h"
 
 #ifdef _OPENMP
@@ -24,60 +25,255 @@ struct ThreadArgs
 };
 typedef struct ThreadArgs ThreadArgs;
 
+/*
+ * Work units are identified by the host buffer holding their block, and
+ * their sky chunk and time index in the block, packed into a single integer.
+ *
+ * Each device has its own double-ended queue of work units. A device takes
+ * units from the front of its own queue, and when that is empty, it steals
+ * from the back of the queues belonging to the other devices in turn.
+ * Only when no units can be found at all is the next block admitted,
+ * which happens as soon as one of the host buffers in the ring has been
+ * written, so devices do not have to wait for the previous block to finish.
+ */
+
+static int queue_pop_front(DeviceData* d)
+{
+    int unit = -1;
+    oskar_mutex_lock(d->queue_mutex);
+    if (d->queue_count > 0)
+    {
+        unit = d->queue[d->queue_head];
+        d->queue_head = (d->queue_head + 1) % d->queue_capacity;
+        d->queue_count--;
+    }
+    oskar_mutex_unlock(d->queue_mutex);
+    return unit;
+}
+
+static int queue_pop_back(DeviceData* d)
+{
+    int unit = -1;
+    oskar_mutex_lock(d->queue_mutex);
+    if (d->queue_count > 0)
+    {
+        d->queue_count--;
+        unit = d->queue[(d->queue_head + d->queue_count) % d->queue_capacity];
+    }
+    oskar_mutex_unlock(d->queue_mutex);
+    return unit;
+}
+
+static void queue_push_back(DeviceData* d, int unit)
+{
+    oskar_mutex_lock(d->queue_mutex);
+    d->queue[(d->queue_head + d->queue_count) % d->queue_capacity] = unit;
+    d->queue_count++;
+    oskar_mutex_unlock(d->queue_mutex);
+}
+
+static int steal_work_unit(oskar_Interferometer* h, int device_id)
+{
+    int i = 0, unit = -1;
+    for (i = 1; i < h->num_devices && unit < 0; ++i)
+    {
+        unit = queue_pop_back(&h->d[(device_id + i) % h->num_devices]);
+    }
+    return unit;
+}
+
+/* Must be called with the schedule lock held, as units are only ever
+ * added to the queues while it is held. */
+static int work_units_queued(oskar_Interferometer* h)
+{
+    int i = 0, count = 0;
+    for (i = 0; i < h->num_devices; ++i)
+    {
+        oskar_mutex_lock(h->d[i].queue_mutex);
+        count += h->d[i].queue_count;
+        oskar_mutex_unlock(h->d[i].queue_mutex);
+    }
+    return count;
+}
+
+/* Must be called with the schedule lock held. */
+static int admit_next_block(oskar_Interferometer* h, int* status)
+{
+    int i = 0, num_times = 0, num_units = 0;
+    const int b = h->next_block_index;
+    const int i_buffer = b % h->num_vis_blocks_cpu;
+    if (b >= oskar_interferometer_num_vis_blocks(h) ||
+            b >= h->num_blocks_written + h->num_vis_blocks_cpu)
+    {
+        return 0;
+    }
+
+    /* Prepare the host buffer, and deal the block's work units out
+     * to the devices in turn, in chunk-major order. Consecutive units
+     * taken by a device then mostly use the same sky chunk, and the
+     * devices work on neighbouring units, so results for each time slice
+     * tend to be ready in chunk order. */
+    oskar_mutex_lock(h->mutex);
+    oskar_interferometer_set_up_host_block(h, b, status);
+    oskar_mutex_unlock(h->mutex);
+    oskar_interferometer_block_range(h, b, 0, &num_times, 0, 0);
+    if (!h->coords_only) num_units = num_times * h->num_sky_chunks;
+    h->num_units_remaining[i_buffer] = num_units;
+    if (num_units == 0) h->num_blocks_complete++;
+    for (i = 0; i < num_units; ++i)
+    {
+        const int i_chunk = i / num_times;
+        const int i_time = i - i_chunk * num_times;
+        queue_push_back(&h->d[i % h->num_devices],
+                (i_buffer * h->num_sky_chunks + i_chunk) *
+                h->max_times_per_block + i_time);
+    }
+    h->next_block_index++;
+    oskar_condition_notify_all(h->schedule);
+    return 1;
+}
+
+static void run_work_units(oskar_Interferometer* h, int device_id,
+        int* status)
+{
+    const int num_blocks = oskar_interferometer_num_vis_blocks(h);
+    DeviceData* d = &(h->d[device_id]);
+    for (;;)
+    {
+        /* Take a work unit from this device's queue, or steal one. */
+        int unit = queue_pop_front(d);
+        if (unit < 0) unit = steal_work_unit(h, device_id);
+        if (unit < 0)
+        {
+            /* Admit the next block if there is a free buffer for it,
+             * or wait for the writers to release one.
+             * Stop once all blocks have been admitted.
+             * Units may have been queued by another thread since the
+             * queues were checked, so check again before waiting. */
+            oskar_condition_lock(h->schedule);
+            if (!admit_next_block(h, status) && !work_units_queued(h))
+            {
+                if (h->next_block_index >= num_blocks)
+                {
+                    oskar_condition_unlock(h->schedule);
+                    break;
+                }
+                oskar_timer_resume(d->tmr_stall);
+                oskar_condition_wait(h->schedule);
+                oskar_timer_pause(d->tmr_stall);
+            }
+            oskar_condition_unlock(h->schedule);
+            continue;
+        }
+
+        /* Simulate the work unit. */
+        const int time_index = unit % h->max_times_per_block;
+        const int chunk_index =
+                (unit / h->max_times_per_block) % h->num_sky_chunks;
+        const int i_buffer =
+                unit / (h->max_times_per_block * h->num_sky_chunks);
+        oskar_interferometer_sim_work_unit(h, h->vis_block_cpu_index[i_buffer],
+                time_index, chunk_index, device_id, status);
+
+        /* Signal the writers if this was the last unit in the block. */
+        oskar_condition_lock(h->schedule);
+        if (--(h->num_units_remaining[i_buffer]) == 0)
+        {
+            h->num_blocks_complete++;
+            oskar_condition_notify_all(h->schedule);
+        }
+        oskar_condition_unlock(h->schedule);
+    }
+}
+
+static void write_blocks(oskar_Interferometer* h, int* status)
+{
+    const int num_blocks = oskar_interferometer_num_vis_blocks(h);
+    for (;;)
+    {
+        oskar_VisBlock* block = 0;
+
+        /* Claim the next block to finalise, then wait until it has been
+         * admitted and all its work units are complete.
+         * Admit it here if no device has done so yet. */
+        oskar_condition_lock(h->schedule);
+        const int b = h->next_block_to_finalise;
+        if (b >= num_blocks)
+        {
+            oskar_condition_unlock(h->schedule);
+            break;
+        }
+        h->next_block_to_finalise++;
+        while (h->next_block_index <= b ||
+                h->num_units_remaining[b % h->num_vis_blocks_cpu] > 0)
+        {
+            if (!admit_next_block(h, status))
+            {
+                oskar_condition_wait(h->schedule);
+            }
+        }
+
+        /* Record the number of completed blocks waiting to be written. */
+        const int depth = h->num_blocks_complete - h->num_blocks_written;
+        if (depth > h->queue_depth_max) h->queue_depth_max = depth;
+        h->queue_depth_sum += depth;
+        h->queue_depth_samples++;
+        oskar_condition_unlock(h->schedule);
+
+        /* Finalise the block. This can happen for several blocks at once. */
+        block = oskar_interferometer_finalise_block(h, b, status);
+
+        /* Wait for all previous blocks to be written, as the output
+         * files must be written in order. */
+        oskar_condition_lock(h->schedule);
+        while (h->num_blocks_written < b)
+        {
+            oskar_condition_wait(h->schedule);
+        }
+        oskar_condition_unlock(h->schedule);
+        oskar_interferometer_write_block(h, block, b, status);
+
+        /* Release the buffer for the next block to use. */
+        oskar_condition_lock(h->schedule);
+        h->num_blocks_written++;
+        oskar_condition_notify_all(h->schedule);
+        oskar_condition_unlock(h->schedule);
+    }
+}
+
 static void* run_blocks(void* arg)
 {
     oskar_Interferometer* h = 0;
-    int b = 0, *status = 0;
+    int *status = 0;
 
     /* Get thread function arguments. */
     h = ((ThreadArgs*)arg)->h;
-    const int num_threads = ((ThreadArgs*)arg)->num_threads;
     const int thread_id = ((ThreadArgs*)arg)->thread_id;
-    const int device_id = thread_id - 1;
+    const int device_id = thread_id - h->num_writer_threads;
     status = ((ThreadArgs*)arg)->status;
 
 #ifdef _OPENMP
-    /* Disable any nested parallelism. */
+    /* Disable any nested parallelism. Threads for CPU devices are given
+     * their own team size when each work unit is simulated. */
     omp_set_nested(0);
     omp_set_num_threads(1);
 #endif
 
-    /* Loop over visibility blocks, running simulation and file
-     * writing one block at a time. Simulation and file output are overlapped
-     * by using double buffering, and a dedicated thread is used for file
-     * output.
-     *
-     * Thread 0 is used for file writes.
-     * Threads 1 to n (mapped to compute devices) do the simulation.
+    /* Threads 0 to (w - 1) are used to finalise and write blocks.
+     * The remaining threads (mapped to compute devices) do the simulation.
      *
-     * Note that no write is launched on the first loop counter (as no
-     * data are ready yet) and no simulation is performed for the last loop
-     * counter (which corresponds to the last block + 1) as this iteration
-     * simply writes the last block.
+     * Simulation and file output are overlapped using a ring of host
+     * buffers: work units from later blocks can be simulated while earlier
+     * blocks are being written, and there are no barriers between blocks.
+     * Devices stall only if all buffers are waiting to be written.
      */
-    const int num_blocks = oskar_interferometer_num_vis_blocks(h);
-    for (b = 0; b < num_blocks + 1; ++b)
+    if (thread_id < h->num_writer_threads)
     {
-        if ((thread_id > 0 || num_threads == 1) && b < num_blocks)
-        {
-            oskar_interferometer_run_block(h, b, device_id, status);
-        }
-        if (thread_id == 0 && b > 0)
-        {
-            oskar_VisBlock* block = 0;
-            block = oskar_interferometer_finalise_block(h, b - 1, status);
-            oskar_interferometer_write_block(h, block, b - 1, status);
-        }
-
-        /* Barrier 1: Reset work unit index and print status. */
-        oskar_barrier_wait(h->barrier);
-        if (thread_id == 0)
-        {
-            oskar_interferometer_reset_work_unit_index(h);
-        }
-
-        /* Barrier 2: Synchronise before moving to the next block. */
-        oskar_barrier_wait(h->barrier);
+        write_blocks(h, status);
+    }
+    else
+    {
+        run_work_units(h, device_id, status);
     }
     return 0;
 }
@@ -113,8 +309,14 @@ void oskar_interferometer_run(oskar_Interferometer* h, int* status)
     oskar_interferometer_check_init(h, status);
 
     /* Set up worker threads. */
-    const int num_threads = h->num_devices + 1;
-    oskar_barrier_set_num_threads(h->barrier, num_threads);
+    const int num_threads = h->num_devices + h->num_writer_threads;
+    h->next_block_index = 0;
+    h->next_block_to_finalise = 0;
+    h->num_blocks_complete = 0;
+    h->num_blocks_written = 0;
+    h->queue_depth_max = 0;
+    h->queue_depth_sum = 0;
+    h->queue_depth_samples = 0;
     threads = (oskar_Thread**) calloc(num_threads, sizeof(oskar_Thread*));
     args = (ThreadArgs*) calloc(num_threads, sizeof(ThreadArgs));
     for (i = 0; i < num_threads; ++i)
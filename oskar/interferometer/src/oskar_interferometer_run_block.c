@@ -1,9 +1,10 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "interferometer/private_interferometer.h"
+#include "interferometer/private_interferometer_work_unit.h"
 #include "interferometer/oskar_interferometer.h"
 
 #include "convert/oskar_convert_apparent_ra_dec_to_enu_directions.h"
@@ -11,27 +12,37 @@
 #include "convert/oskar_convert_mjd_to_gast_fast.h"
 #include "correlate/oskar_auto_correlate.h"
 #include "correlate/oskar_cross_correlate.h"
+#include "correlate/oskar_cross_correlate_fused.h"
 #include "interferometer/oskar_evaluate_jones_E.h"
 #include "interferometer/oskar_evaluate_jones_K.h"
 #include "interferometer/oskar_evaluate_jones_R.h"
 #include "interferometer/oskar_evaluate_jones_Z.h"
 #include "utility/oskar_device.h"
 
+#include <float.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
-        oskar_Sky* sky, int channel_index_block, int time_index_block,
-        int channel_index_sim, int time_index_sim, int* status);
+        oskar_Sky* sky, int time_index_block, int time_index_sim,
+        int channel_index_sim_start, int num_channels, int* status);
+static void add_to_host_block(oskar_Interferometer* h, DeviceData* d,
+        int buffer_index, int time_index_block, int chunk_index,
+        int num_chans_block, int has_sources, int* status);
 static unsigned int disp_width(unsigned int v);
 
 void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
         int device_id, int* status)
 {
-    int chan_index_start = 0, chan_index_end = 0;
-    int time_index_start = 0, time_index_end = 0;
-    DeviceData* d = 0;
+    int num_times_block = 0;
     if (*status) return;
 
     /* Check that initialisation has happened. We can't initialise here,
@@ -44,118 +55,329 @@ void oskar_interferometer_run_block(oskar_Interferometer* h, int block_index,
         return;
     }
 
+    /* Prepare the host buffer for the block, if not already done. */
+    oskar_mutex_lock(h->mutex);
+    oskar_interferometer_set_up_host_block(h, block_index, status);
+    oskar_mutex_unlock(h->mutex);
+
+    /* Go though all possible work units in the block. A work unit is defined
+     * as the simulation for one time and one sky chunk. */
+    oskar_interferometer_block_range(h, block_index,
+            0, &num_times_block, 0, 0);
+    while (!h->coords_only)
+    {
+        oskar_mutex_lock(h->mutex);
+        const int i_work_unit = (h->work_unit_index)++;
+        oskar_mutex_unlock(h->mutex);
+        if ((i_work_unit >= num_times_block * h->num_sky_chunks) || *status)
+        {
+            break;
+        }
+
+        /* Convert slice index to chunk/time index. */
+        const int i_chunk = i_work_unit / num_times_block;
+        const int i_time  = i_work_unit - i_chunk * num_times_block;
+        oskar_interferometer_sim_work_unit(h, block_index, i_time, i_chunk,
+                device_id, status);
+    }
+}
+
+
+void oskar_interferometer_block_range(const oskar_Interferometer* h,
+        int block_index, int* time_index_start, int* num_times,
+        int* chan_index_start, int* num_chans)
+{
+    const int num_blocks_chan = (h->num_channels +
+            h->max_channels_per_block - 1) / h->max_channels_per_block;
+    const int i_block_chan = block_index % num_blocks_chan;
+    const int i_block_time = block_index / num_blocks_chan;
+    const int chan_start = i_block_chan * h->max_channels_per_block;
+    const int time_start = i_block_time * h->max_times_per_block;
+    int chan_end = chan_start + h->max_channels_per_block - 1;
+    int time_end = time_start + h->max_times_per_block - 1;
+    if (time_end >= h->num_time_steps)
+    {
+        time_end = h->num_time_steps - 1;
+    }
+    if (chan_end >= h->num_channels)
+    {
+        chan_end = h->num_channels - 1;
+    }
+    if (time_index_start) *time_index_start = time_start;
+    if (num_times) *num_times = 1 + time_end - time_start;
+    if (chan_index_start) *chan_index_start = chan_start;
+    if (num_chans) *num_chans = 1 + chan_end - chan_start;
+}
+
+
+void oskar_interferometer_set_up_host_block(oskar_Interferometer* h,
+        int block_index, int* status)
+{
+    int time_index_start = 0, num_times = 0;
+    int chan_index_start = 0, num_chans = 0;
+    const int i_active = block_index % h->num_vis_blocks_cpu;
+    oskar_VisBlock* block = h->vis_block_cpu[i_active];
+    if (*status || h->vis_block_cpu_index[i_active] == block_index) return;
+
+    /* Set the size and meta-data of the block, and clear it. */
+    oskar_interferometer_block_range(h, block_index,
+            &time_index_start, &num_times, &chan_index_start, &num_chans);
+    oskar_vis_block_resize(block, num_times, num_chans,
+            oskar_vis_block_num_stations(block), status);
+    oskar_vis_block_set_start_time_index(block, time_index_start);
+    oskar_vis_block_set_start_channel_index(block, chan_index_start);
+    oskar_vis_block_clear(block, status);
+    memset(&h->num_chunks_added[i_active * h->max_times_per_block], 0,
+            h->max_times_per_block * sizeof(int));
+    h->vis_block_cpu_index[i_active] = block_index;
+}
+
+
+void oskar_interferometer_sim_work_unit(oskar_Interferometer* h,
+        int block_index, int time_index_block, int chunk_index,
+        int device_id, int* status)
+{
+    int time_index_start = 0, chan_index_start = 0, num_chans_block = 0;
+    oskar_Sky* sky = 0;
+    if (*status) return;
+
     /* Set the GPU to use. (Supposed to be a very low-overhead call.) */
     if (device_id >= 0 && device_id < h->num_gpus)
     {
         oskar_device_set(h->dev_loc, h->gpu_ids[device_id], status);
     }
 
-    /* Clear the visibility block. */
-    d = &(h->d[device_id]);
-    oskar_timer_resume(d->tmr_compute);
-    oskar_vis_block_clear(d->vis_block, status);
+#ifdef _OPENMP
+    /* Give CPU devices their own team of threads for their kernels. */
+    omp_set_num_threads(device_id < h->num_gpus ?
+            1 : h->num_threads_cpu_device);
+#endif
 
-    /* Set the visibility block meta-data. */
+    /* Get the dimensions of the block. */
+    DeviceData* d = &(h->d[device_id]);
+    oskar_timer_resume(d->tmr_compute);
+    oskar_interferometer_block_range(h, block_index,
+            &time_index_start, 0, &chan_index_start, &num_chans_block);
     const int total_chunks = h->num_sky_chunks;
     const int total_chans = h->num_channels;
     const int total_times = h->num_time_steps;
-    const int num_blocks_chan = (total_chans + h->max_channels_per_block - 1) /
-            h->max_channels_per_block;
-    const int i_block_chan = block_index % num_blocks_chan;
-    const int i_block_time = block_index / num_blocks_chan;
+    const int sim_time_idx = time_index_start + time_index_block;
     const double obs_start_mjd = h->time_start_mjd_utc;
     const double dt_dump_days = h->time_inc_sec / 86400.0;
-    chan_index_start = i_block_chan * h->max_channels_per_block;
-    chan_index_end = chan_index_start + h->max_channels_per_block - 1;
-    time_index_start = i_block_time * h->max_times_per_block;
-    time_index_end = time_index_start + h->max_times_per_block - 1;
-    if (time_index_end >= total_times)
+
+    /* Clear the device block, which holds only this time step. */
+    oskar_vis_block_resize(d->vis_block, 1, num_chans_block,
+            oskar_vis_block_num_stations(d->vis_block), status);
+    oskar_vis_block_clear(d->vis_block, status);
+
+    /* Copy sky chunk to device only if different from the previous one. */
+    if (chunk_index != d->previous_chunk_index)
     {
-        time_index_end = total_times - 1;
+        oskar_timer_resume(d->tmr_copy);
+        oskar_sky_copy(d->chunk, h->sky_chunks[chunk_index], status);
+        oskar_timer_pause(d->tmr_copy);
+        d->previous_chunk_index = chunk_index;
     }
-    if (chan_index_end >= total_chans)
+    sky = h->apply_horizon_clip ? d->chunk_clip : d->chunk;
+
+    /* Apply horizon clip if required. */
+    if (h->apply_horizon_clip)
     {
-        chan_index_end = total_chans - 1;
+        double gast = 0.0, mjd = 0.0;
+        mjd = obs_start_mjd + dt_dump_days * (sim_time_idx + 0.5);
+        gast = oskar_convert_mjd_to_gast_fast(mjd);
+        oskar_timer_resume(d->tmr_clip);
+        oskar_sky_horizon_clip(d->chunk_clip, d->chunk, d->tel, gast,
+                d->station_work, status);
+        oskar_timer_pause(d->tmr_clip);
     }
-    const int num_times_block = 1 + time_index_end - time_index_start;
-    const int num_chans_block = 1 + chan_index_end - chan_index_start;
 
-    /* Set the size of the block. */
-    oskar_vis_block_resize(d->vis_block, num_times_block, num_chans_block,
-            oskar_vis_block_num_stations(d->vis_block), status);
-    oskar_vis_block_set_start_time_index(d->vis_block, time_index_start);
-    oskar_vis_block_set_start_channel_index(d->vis_block, chan_index_start);
+    /* Simulate all baselines for all channels for this time and chunk.
+     * Frequency-independent quantities are evaluated only once
+     * for the whole work unit. */
+    oskar_mutex_lock(h->mutex);
+    oskar_log_message(h->log, 'S', 1, "Time %*i/%i, "
+            "Chunk %*i/%i, Channels %*i-%*i/%i [Device %i, %i sources]",
+            disp_width(total_times), sim_time_idx + 1, total_times,
+            disp_width(total_chunks), chunk_index + 1, total_chunks,
+            disp_width(total_chans), chan_index_start + 1,
+            disp_width(total_chans), chan_index_start + num_chans_block,
+            total_chans, device_id, oskar_sky_num_sources(sky));
+    oskar_mutex_unlock(h->mutex);
+    sim_baselines(h, d, sky, 0, sim_time_idx,
+            chan_index_start, num_chans_block, status);
+
+    /* Add the result to the time slice in the host buffer for the block. */
+    add_to_host_block(h, d, block_index % h->num_vis_blocks_cpu,
+            time_index_block, chunk_index, num_chans_block,
+            oskar_sky_num_sources(sky) > 0, status);
+    oskar_timer_pause(d->tmr_compute);
+}
 
-    /* Go though all possible work units in the block. A work unit is defined
-     * as the simulation for one time and one sky chunk. */
-    while (!h->coords_only)
-    {
-        oskar_Sky* sky = 0;
-        int i_channel = 0;
 
-        oskar_mutex_lock(h->mutex);
-        const int i_work_unit = (h->work_unit_index)++;
-        oskar_mutex_unlock(h->mutex);
-        if ((i_work_unit >= num_times_block * total_chunks) || *status) break;
+static PendingUnit* take_pending_unit(oskar_Interferometer* h,
+        int buffer_index, int time_index_block, int chunk_index)
+{
+    PendingUnit **p = &h->pending, *unit = 0;
+    for (; *p; p = &(*p)->next)
+    {
+        if ((*p)->buffer_index == buffer_index &&
+                (*p)->time_index == time_index_block &&
+                (*p)->chunk_index == chunk_index)
+        {
+            unit = *p;
+            *p = unit->next;
+            break;
+        }
+    }
+    return unit;
+}
 
-        /* Convert slice index to chunk/time index. */
-        const int i_chunk      = i_work_unit / num_times_block;
-        const int i_time       = i_work_unit - i_chunk * num_times_block;
-        const int sim_time_idx = time_index_start + i_time;
+/*
+ * The result for each chunk is added to the time slice only after the
+ * results for all preceding chunks, so that the sums are always formed in
+ * the same order. A result that arrives early is copied to the host and
+ * held in the pending list, to be added by the device that adds the result
+ * for the chunk before it. As units are dealt to the devices in order, only
+ * a few results are normally held at once.
+ */
+static void add_to_host_block(oskar_Interferometer* h, DeviceData* d,
+        int buffer_index, int time_index_block, int chunk_index,
+        int num_chans_block, int has_sources, int* status)
+{
+    PendingUnit* unit = 0;
+    oskar_VisBlock* block = h->vis_block_cpu[buffer_index];
+    const oskar_Mem* cross = oskar_vis_block_cross_correlations_const(
+            d->vis_block);
+    const oskar_Mem* autos = oskar_vis_block_auto_correlations_const(
+            d->vis_block);
+    const size_t num_cross = (size_t) num_chans_block *
+            oskar_vis_block_num_baselines(block);
+    const size_t num_autos = (size_t) num_chans_block *
+            oskar_vis_block_num_stations(block);
+    int* num_chunks_added = &h->num_chunks_added[
+            buffer_index * h->max_times_per_block + time_index_block];
+    if (*status) return;
 
-        /* Copy sky chunk to device only if different from the previous one. */
-        if (i_chunk != d->previous_chunk_index)
+    /* Hold a copy of the result if it cannot be added yet. */
+    oskar_timer_resume(d->tmr_copy);
+    oskar_mutex_lock(h->mutex);
+    if (*num_chunks_added != chunk_index)
+    {
+        unit = h->pending_free;
+        if (unit) h->pending_free = unit->next;
+        oskar_mutex_unlock(h->mutex);
+        if (!unit)
         {
-            oskar_timer_resume(d->tmr_copy);
-            oskar_sky_copy(d->chunk, h->sky_chunks[i_chunk], status);
-            oskar_timer_pause(d->tmr_copy);
+            unit = (PendingUnit*) calloc(1, sizeof(PendingUnit));
+            if (!unit)
+            {
+                *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+                oskar_timer_pause(d->tmr_copy);
+                return;
+            }
+            unit->cross = oskar_mem_create(oskar_mem_type(cross),
+                    OSKAR_CPU, 0, status);
+            unit->autos = oskar_mem_create(oskar_mem_type(autos),
+                    OSKAR_CPU, 0, status);
         }
-        sky = h->apply_horizon_clip ? d->chunk_clip : d->chunk;
-
-        /* Apply horizon clip if required. */
-        if (h->apply_horizon_clip)
+        unit->buffer_index = buffer_index;
+        unit->time_index = time_index_block;
+        unit->chunk_index = chunk_index;
+        unit->has_sources = has_sources;
+        if (has_sources)
         {
-            double gast = 0.0, mjd = 0.0;
-            mjd = obs_start_mjd + dt_dump_days * (sim_time_idx + 0.5);
-            gast = oskar_convert_mjd_to_gast_fast(mjd);
-            oskar_timer_resume(d->tmr_clip);
-            oskar_sky_horizon_clip(d->chunk_clip, d->chunk, d->tel, gast,
-                    d->station_work, status);
-            oskar_timer_pause(d->tmr_clip);
+            if (oskar_vis_block_has_cross_correlations(block))
+            {
+                oskar_mem_copy(unit->cross, cross, status);
+            }
+            if (oskar_vis_block_has_auto_correlations(block))
+            {
+                oskar_mem_copy(unit->autos, autos, status);
+            }
         }
 
-        /* Simulate all baselines for all channels for this time and chunk. */
-        for (i_channel = 0; i_channel < num_chans_block; ++i_channel)
+        /* Check again, as the preceding chunk may have been added
+         * while the copy was made. */
+        oskar_mutex_lock(h->mutex);
+        if (*num_chunks_added != chunk_index)
         {
-            if (*status) break;
-            const int sim_chan_idx = chan_index_start + i_channel;
-            oskar_mutex_lock(h->mutex);
-            oskar_log_message(h->log, 'S', 1, "Time %*i/%i, "
-                    "Chunk %*i/%i, Channel %*i/%i [Device %i, %i sources]",
-                    disp_width(total_times), sim_time_idx + 1, total_times,
-                    disp_width(total_chunks), i_chunk + 1, total_chunks,
-                    disp_width(total_chans), sim_chan_idx + 1, total_chans,
-                    device_id, oskar_sky_num_sources(sky));
+            unit->next = h->pending;
+            h->pending = unit;
             oskar_mutex_unlock(h->mutex);
-            sim_baselines(h, d, sky, i_channel, i_time,
-                    sim_chan_idx, sim_time_idx, status);
+            oskar_timer_pause(d->tmr_copy);
+            return;
         }
-        d->previous_chunk_index = i_chunk;
+        cross = unit->cross;
+        autos = unit->autos;
     }
+    oskar_mutex_unlock(h->mutex);
 
-    /* Copy the visibility block to host memory. */
-    const int i_active = block_index % 2; /* Index of the active buffer. */
-    oskar_timer_resume(d->tmr_copy);
-    oskar_vis_block_copy(d->vis_block_cpu[i_active], d->vis_block, status);
+    /* Add this result, and then any held results for the chunks after it.
+     * No other device can add to this time slice in the meantime. */
+    for (;;)
+    {
+        if (has_sources)
+        {
+            if (oskar_vis_block_has_cross_correlations(block))
+            {
+                const size_t offset = num_cross * time_index_block;
+                oskar_Mem* out = oskar_vis_block_cross_correlations(block);
+                oskar_mem_add(out, out, cross,
+                        offset, offset, 0, num_cross, status);
+            }
+            if (oskar_vis_block_has_auto_correlations(block))
+            {
+                const size_t offset = num_autos * time_index_block;
+                oskar_Mem* out = oskar_vis_block_auto_correlations(block);
+                oskar_mem_add(out, out, autos,
+                        offset, offset, 0, num_autos, status);
+            }
+        }
+        oskar_mutex_lock(h->mutex);
+        if (unit)
+        {
+            unit->next = h->pending_free;
+            h->pending_free = unit;
+        }
+        (*num_chunks_added)++;
+        unit = take_pending_unit(h, buffer_index, time_index_block,
+                *num_chunks_added);
+        oskar_mutex_unlock(h->mutex);
+        if (!unit) break;
+        has_sources = unit->has_sources;
+        cross = unit->cross;
+        autos = unit->autos;
+    }
     oskar_timer_pause(d->tmr_copy);
-    oskar_timer_pause(d->tmr_compute);
 }
 
 
+static int station_beams_are_unity(oskar_Telescope* tel, double freq_hz)
+{
+    int i = 0;
+    if (oskar_telescope_harp_data(tel, freq_hz) ||
+            oskar_telescope_ionosphere_screen_type(tel) != 'N')
+    {
+        return 0;
+    }
+    for (i = 0; i < oskar_telescope_num_station_models(tel); ++i)
+    {
+        if (oskar_station_type(oskar_telescope_station_const(tel, i)) !=
+                OSKAR_STATION_TYPE_ISOTROPIC)
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
-        oskar_Sky* sky, int channel_index_block, int time_index_block,
-        int channel_index_sim, int time_index_sim, int* status)
+        oskar_Sky* sky, int time_index_block, int time_index_sim,
+        int channel_index_sim_start, int num_channels, int* status)
 {
+    int i_channel = 0, i_batch = 0;
+
     /* Get dimensions. */
     const int num_baselines   = oskar_telescope_num_baselines(d->tel);
     const int num_stations    = oskar_telescope_num_stations(d->tel);
@@ -167,26 +389,16 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
      * or if block indices requested are outside the block dimensions. */
     if (num_src == 0 ||
             time_index_block >= num_times_block ||
-            channel_index_block >= num_chans_block)
+            num_channels > num_chans_block)
     {
         return;
     }
 
-    /* Get the time and frequency of the visibility slice being simulated. */
+    /* Get the time of the visibility slice being simulated. */
     const double dt_dump_days = h->time_inc_sec / 86400.0;
     const double t_start = h->time_start_mjd_utc;
     const double t_dump = t_start + dt_dump_days * (time_index_sim + 0.5);
     const double gast_rad = oskar_convert_mjd_to_gast_fast(t_dump);
-    const double freq = h->freq_start_hz + channel_index_sim * h->freq_inc_hz;
-
-    /* Scale source fluxes with spectral index and rotation measure. */
-    oskar_sky_scale_flux_with_frequency(sky, freq, status);
-    const oskar_Mem* const src_flux[] = {
-            oskar_sky_I_const(sky),
-            oskar_sky_Q_const(sky),
-            oskar_sky_U_const(sky),
-            oskar_sky_V_const(sky)
-    };
 
     /* Get true station (u,v,w) coordinates. */
     oskar_telescope_uvw(d->tel,
@@ -227,23 +439,15 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
         oskar_jones_set_size(d->R, num_stations, num_src, status);
     }
     oskar_jones_set_size(d->J, num_stations, num_src, status);
-    oskar_jones_set_size(d->E, num_stations, num_src, status);
     oskar_jones_set_size(d->K, num_stations, num_src, status);
+    for (i_channel = 0; i_channel < d->num_channels_batch; ++i_channel)
+    {
+        oskar_jones_set_size(d->E[i_channel], num_stations, num_src, status);
+    }
 
-    /* Evaluate station beam (Jones E: may be matrix). */
-    const oskar_Mem* const source_coords[] = {
-            oskar_sky_l_const(sky),
-            oskar_sky_m_const(sky),
-            oskar_sky_n_const(sky)
-    };
-    oskar_timer_resume(d->tmr_E);
-    oskar_evaluate_jones_E(d->E, OSKAR_COORDS_REL_DIR, num_src, source_coords,
-            oskar_sky_reference_ra_rad(sky), oskar_sky_reference_dec_rad(sky),
-            d->tel, time_index_sim, gast_rad, freq, d->station_work, status);
-    oskar_timer_pause(d->tmr_E);
-
-    /* Evaluate parallactic angle (Jones R: matrix), and join with Jones E.
-     * TODO Move this into station beam evaluation instead. */
+    /* Evaluate parallactic angle (Jones R: matrix).
+     * This does not depend on frequency, so is evaluated only once
+     * for all channels. */
     if (d->R)
     {
         oskar_timer_resume(d->tmr_E);
@@ -252,61 +456,164 @@ static void sim_baselines(oskar_Interferometer* h, DeviceData* d,
                 oskar_sky_dec_rad_const(sky),
                 d->tel, gast_rad, status);
         oskar_timer_pause(d->tmr_E);
-        oskar_timer_resume(d->tmr_join);
-        oskar_jones_join(d->R, d->E, d->R, status);
-        oskar_timer_pause(d->tmr_join);
     }
 
-    /* Evaluate interferometer phase (Jones K: scalar). */
-    oskar_timer_resume(d->tmr_K);
-    oskar_evaluate_jones_K(d->K, num_src,
-            lmn[0], lmn[1], lmn[2], uvw[0], uvw[1], uvw[2],
-            freq, src_flux[0], h->source_min_jy, h->source_max_jy,
-            h->ignore_w_components, status);
-    oskar_timer_pause(d->tmr_K);
-
-    /* Multiply Jones matrix chain to get a single block. */
-    oskar_timer_resume(d->tmr_join);
-    oskar_jones_join(d->J, d->K, d->R ? d->R : d->E, status);
-    oskar_timer_pause(d->tmr_join);
-
-    /* Check whether gain model exists.
-     * If so, evaluate gains and apply them. */
-    if (oskar_gains_defined(oskar_telescope_gains(d->tel)))
+    /* Get pointers to source parameters. */
+    const oskar_Mem* const source_coords[] = {
+            oskar_sky_l_const(sky),
+            oskar_sky_m_const(sky),
+            oskar_sky_n_const(sky)
+    };
+    const oskar_Mem* const src_flux[] = {
+            oskar_sky_I_const(sky),
+            oskar_sky_Q_const(sky),
+            oskar_sky_U_const(sky),
+            oskar_sky_V_const(sky)
+    };
+    const oskar_Mem* const src_extended[] = {
+            oskar_sky_gaussian_a_const(sky),
+            oskar_sky_gaussian_b_const(sky),
+            oskar_sky_gaussian_c_const(sky)
+    };
+    const int source_type = oskar_sky_use_extended(sky);
+
+    /* Check whether the interferometer phase can be evaluated as part of
+     * the cross-correlation, instead of forming Jones K and joining it with
+     * Jones E for all sources. This is possible for scalar simulations on
+     * the CPU without station gains. The auto-correlations do not depend on
+     * Jones K, unless sources are excluded by the flux filter. */
+    const int has_autos = oskar_vis_block_has_auto_correlations(d->vis_block);
+    const int has_cross = oskar_vis_block_has_cross_correlations(d->vis_block);
+    const int fuse_K = has_cross &&
+            oskar_jones_mem_location(d->J) == OSKAR_CPU &&
+            !oskar_type_is_matrix(oskar_jones_type(d->J)) &&
+            !oskar_gains_defined(oskar_telescope_gains(d->tel)) &&
+            (!has_autos || (h->source_min_jy == -DBL_MAX &&
+                    h->source_max_jy == DBL_MAX));
+
+    /* Loop over batches of channels in the work unit. */
+    for (i_batch = 0; i_batch < num_channels;
+            i_batch += d->num_channels_batch)
     {
-        oskar_gains_evaluate(oskar_telescope_gains(d->tel),
-                time_index_sim, freq, d->gains, 0, status);
-        oskar_jones_apply_station_gains(d->J, d->gains, status);
-    }
+        double freq[MAX_CHANNEL_BATCH];
+        int num_batch = num_channels - i_batch, unity_E = fuse_K;
+        if (*status) break;
+        if (num_batch > d->num_channels_batch)
+        {
+            num_batch = d->num_channels_batch;
+        }
+        for (i_channel = 0; i_channel < num_batch; ++i_channel)
+        {
+            freq[i_channel] = h->freq_start_hz +
+                    (channel_index_sim_start + i_batch + i_channel) *
+                    h->freq_inc_hz;
+            if (!station_beams_are_unity(d->tel, freq[i_channel]))
+            {
+                unity_E = 0;
+            }
+        }
 
-    /* Calculate output offset. */
-    const int offset = num_chans_block * time_index_block + channel_index_block;
-    oskar_timer_resume(d->tmr_correlate);
+        /* Evaluate station beams for all channels in the batch
+         * (Jones E: may be matrix). The frequency-independent parts of
+         * the beams are evaluated only once for the batch.
+         * If the beams are all unity and only used for cross-correlation,
+         * they do not need to be evaluated at all. */
+        if (!unity_E || has_autos)
+        {
+            oskar_timer_resume(d->tmr_E);
+            oskar_evaluate_jones_E_channels(num_batch, d->E,
+                    OSKAR_COORDS_REL_DIR, num_src, source_coords,
+                    oskar_sky_reference_ra_rad(sky),
+                    oskar_sky_reference_dec_rad(sky),
+                    d->tel, time_index_sim, gast_rad, freq,
+                    d->station_work, status);
+            oskar_timer_pause(d->tmr_E);
+        }
 
-    /* Auto-correlate for this time and channel. */
-    if (oskar_vis_block_has_auto_correlations(d->vis_block))
-    {
-        oskar_auto_correlate(num_src, d->J, src_flux, num_stations * offset,
-                oskar_vis_block_auto_correlations(d->vis_block), status);
-    }
+        /* Loop over channels in the batch. */
+        for (i_channel = 0; i_channel < num_batch; ++i_channel)
+        {
+            oskar_Jones* E = d->E[i_channel];
+            if (*status) break;
 
-    /* Cross-correlate for this time and channel. */
-    if (oskar_vis_block_has_cross_correlations(d->vis_block))
-    {
-        const int source_type = oskar_sky_use_extended(sky);
-        const oskar_Mem* const src_extended[] = {
-            oskar_sky_gaussian_a_const(sky),
-            oskar_sky_gaussian_b_const(sky),
-            oskar_sky_gaussian_c_const(sky)
-        };
-        oskar_cross_correlate(
-                source_type, num_src, d->J,
-                src_flux, lmn, src_extended,
-                d->tel, uvw,
-                gast_rad, freq, num_baselines * offset,
-                oskar_vis_block_cross_correlations(d->vis_block), status);
+            /* Scale source fluxes with spectral index and rotation measure. */
+            oskar_sky_scale_flux_with_frequency(sky, freq[i_channel], status);
+
+            /* Join Jones R with Jones E, keeping R for the next channel.
+             * TODO Move this into station beam evaluation instead. */
+            if (d->R)
+            {
+                oskar_timer_resume(d->tmr_join);
+                oskar_jones_join(E, E, d->R, status);
+                oskar_timer_pause(d->tmr_join);
+            }
+
+            if (!fuse_K)
+            {
+                /* Evaluate interferometer phase (Jones K: scalar). */
+                oskar_timer_resume(d->tmr_K);
+                oskar_evaluate_jones_K(d->K, num_src,
+                        lmn[0], lmn[1], lmn[2], uvw[0], uvw[1], uvw[2],
+                        freq[i_channel], src_flux[0],
+                        h->source_min_jy, h->source_max_jy,
+                        h->ignore_w_components, status);
+                oskar_timer_pause(d->tmr_K);
+
+                /* Multiply Jones matrix chain to get a single block. */
+                oskar_timer_resume(d->tmr_join);
+                oskar_jones_join(d->J, d->K, E, status);
+                oskar_timer_pause(d->tmr_join);
+
+                /* Check whether gain model exists.
+                 * If so, evaluate gains and apply them. */
+                if (oskar_gains_defined(oskar_telescope_gains(d->tel)))
+                {
+                    oskar_gains_evaluate(oskar_telescope_gains(d->tel),
+                            time_index_sim, freq[i_channel], d->gains, 0,
+                            status);
+                    oskar_jones_apply_station_gains(d->J, d->gains, status);
+                }
+            }
+
+            /* Calculate output offset. */
+            const int offset = num_chans_block * time_index_block +
+                    i_batch + i_channel;
+            oskar_timer_resume(d->tmr_correlate);
+
+            /* Auto-correlate for this time and channel. */
+            if (has_autos)
+            {
+                oskar_auto_correlate(num_src, fuse_K ? E : d->J, src_flux,
+                        num_stations * offset,
+                        oskar_vis_block_auto_correlations(d->vis_block),
+                        status);
+            }
+
+            /* Cross-correlate for this time and channel. */
+            if (fuse_K)
+            {
+                oskar_cross_correlate_fused(
+                        source_type, num_src, unity_E ? 0 : E,
+                        src_flux, lmn, src_extended,
+                        d->tel, uvw, gast_rad, freq[i_channel],
+                        h->source_min_jy, h->source_max_jy,
+                        h->ignore_w_components, num_baselines * offset,
+                        oskar_vis_block_cross_correlations(d->vis_block),
+                        status);
+            }
+            else if (has_cross)
+            {
+                oskar_cross_correlate(
+                        source_type, num_src, d->J,
+                        src_flux, lmn, src_extended,
+                        d->tel, uvw,
+                        gast_rad, freq[i_channel], num_baselines * offset,
+                        oskar_vis_block_cross_correlations(d->vis_block),
+                        status);
+            }
+            oskar_timer_pause(d->tmr_correlate);
+        }
     }
-    oskar_timer_pause(d->tmr_correlate);
 }
 
 
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_DFT_C2R_GRID_CPU_H_
+#define OSKAR_DFT_C2R_GRID_CPU_H_
+
+/**
+ * @file oskar_dft_c2r_grid_cpu.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief
+ * Computes a complex-to-real DFT onto a regular 2D grid on the CPU.
+ *
+ * @details
+ * Computes the same sum as oskar_dft_c2r() for the 2D case,
+ *
+ *   output = Re( sum_j  weight_j * data_j * exp(-i k (x_j x + y_j y)) ),
+ *
+ * but for output points on a regular grid, with (num_x) points in each
+ * row, so that x changes by a constant amount between adjacent points.
+ * Output point p is at column (p % num_x) and row (p / num_x) of the grid.
+ *
+ * The phase factors along each row are generated by a recurrence,
+ * multiplying by a constant rotation for each input point, so there are
+ * no trigonometric function calls per output point. The recurrence is
+ * restarted from an exact value at regular intervals to bound the
+ * accumulated rounding error.
+ *
+ * Input points are processed in chunks that fit in the L1 cache, and each
+ * recurrence step is vectorised across the chunk, using AVX2 or AVX-512
+ * if available at run time.
+ *
+ * This function is single-threaded; callers should divide the output
+ * points between threads.
+ *
+ * @param[in] precision  Enumerated precision (OSKAR_SINGLE or OSKAR_DOUBLE)
+ *                       of all arrays.
+ * @param[in] num_in     Number of input points.
+ * @param[in] wavenumber Wavenumber (k) to multiply coordinates.
+ * @param[in] x_in       Input x coordinates.
+ * @param[in] y_in       Input y coordinates.
+ * @param[in] data_in    Complex input data.
+ * @param[in] weight_in  Real input weights.
+ * @param[in] num_x      Number of output points in each row of the grid.
+ * @param[in] x_start    Output x coordinate of the first column.
+ * @param[in] x_inc      Output x coordinate increment between columns.
+ * @param[in] y_start    Output y coordinate of the first row.
+ * @param[in] y_inc      Output y coordinate increment between rows.
+ * @param[in] offset_out Index of the first output point on the grid.
+ * @param[in] num_out    Number of output points to compute.
+ * @param[out] output    Real output data, length at least num_out.
+ */
+OSKAR_EXPORT
+void oskar_dft_c2r_grid_cpu(int precision, int num_in, double wavenumber,
+        const void* x_in, const void* y_in, const void* data_in,
+        const void* weight_in, int num_x, double x_start, double x_inc,
+        double y_start, double y_inc, size_t offset_out, size_t num_out,
+        void* output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OSKAR_DFT_C2R_GRID_CPU_H_ */
@@ -83,6 +83,32 @@ oskar_FFT* oskar_fft_create(int precision, int location, int num_dim,
 OSKAR_EXPORT
 void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status);
 
+/**
+ * @brief Executes the FFT plan with Hermitian input data.
+ *
+ * @details
+ * Computes the forward 2D transform of a square array with Hermitian
+ * symmetry, so that the result is real. This takes about half the time
+ * and memory of a complex transform.
+ *
+ * Only the first (dim_size / 2 + 1) values of each row of the input are
+ * used, starting at element \p offset of \p data, with rows
+ * \p stride complex elements apart. The transform is done in-place:
+ * each row of the real output is written over the start of the same row
+ * of the input, so the output has (2 * stride) real values between rows.
+ *
+ * This is only available for 2D plans on the CPU, with an even size.
+ *
+ * @param[in] h             Handle to FFT plan.
+ * @param[in,out] data      Complex data to transform.
+ * @param[in] offset        Index of the first element to use in \p data.
+ * @param[in] stride        Number of elements between rows in \p data.
+ * @param[in,out] status    Status return code.
+ */
+OSKAR_EXPORT
+void oskar_fft_exec_c2r(oskar_FFT* h, oskar_Mem* data, size_t offset,
+        size_t stride, int* status);
+
 /**
  * @brief Frees resources used by the plan.
  *
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#ifndef OSKAR_FFT_CPU_H_
+#define OSKAR_FFT_CPU_H_
+
+/**
+ * @file oskar_fft_cpu.h
+ */
+
+#include <oskar_global.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct oskar_FFTCPU;
+typedef struct oskar_FFTCPU oskar_FFTCPU;
+
+/**
+ * @brief Creates a plan for forward complex transforms on the CPU.
+ *
+ * @details
+ * Creates a plan for forward complex-to-complex transforms of the given
+ * length, using a mixed-radix (4, 2, 3, 5 and any other primes)
+ * self-sorting Stockham algorithm.
+ *
+ * The twiddle factors are computed once here, so the plan should be reused
+ * for all transforms of the same length and precision.
+ *
+ * Transforms are computed on blocks of sequences at once, with the same
+ * element of each sequence stored consecutively, so that each butterfly
+ * is vectorised across the block.
+ * Blocks are gathered from and scattered to the input array using
+ * scratch buffers that fit in cache, and are processed in parallel
+ * using OpenMP.
+ * One scratch buffer for each OpenMP thread is allocated here, so a plan
+ * must not be used for more than one transform at a time.
+ *
+ * @param[in] precision  Enumerated precision (OSKAR_SINGLE or OSKAR_DOUBLE).
+ * @param[in] length     Transform length.
+ * @param[in,out] status Status return code.
+ */
+OSKAR_EXPORT
+oskar_FFTCPU* oskar_fft_cpu_create(int precision, int length, int* status);
+
+/**
+ * @brief Computes a 2D forward transform in-place.
+ *
+ * @details
+ * Computes the (unnormalised) forward transform of a square 2D array of
+ * interleaved complex values, with each side equal to the plan length,
+ * and multiplies the result by the given scale factor.
+ *
+ * @param[in] h          Handle to plan.
+ * @param[in,out] data   Pointer to data to transform.
+ * @param[in] scale      Scale factor to apply to the output.
+ * @param[in,out] status Status return code.
+ */
+OSKAR_EXPORT
+void oskar_fft_cpu_exec_2d(const oskar_FFTCPU* h, void* data, double scale,
+        int* status);
+
+/**
+ * @brief Computes a 2D forward transform of Hermitian data in-place.
+ *
+ * @details
+ * Computes the (unnormalised) forward transform of a square 2D array of
+ * interleaved complex values with Hermitian symmetry, so that the result
+ * is real, and multiplies the result by the given scale factor.
+ * The plan length must be even.
+ *
+ * Only the first (length / 2 + 1) values of each row of the input are
+ * used, and rows start \p stride complex values apart, where \p stride
+ * must be at least (length / 2 + 1). Each row of the real output is
+ * written over the start of the same row of the input, so the output has
+ * (2 * stride) real values between rows.
+ *
+ * The columns are transformed first, and the rows are then transformed
+ * two at a time as the real and imaginary parts of one complex sequence,
+ * so this takes about half the time of a complex transform.
+ *
+ * @param[in] h          Handle to plan.
+ * @param[in,out] data   Pointer to data to transform.
+ * @param[in] stride     Number of complex values between rows of the input.
+ * @param[in] scale      Scale factor to apply to the output.
+ * @param[in,out] status Status return code.
+ */
+OSKAR_EXPORT
+void oskar_fft_cpu_exec_2d_c2r(const oskar_FFTCPU* h, void* data,
+        size_t stride, double scale, int* status);
+
+/**
+ * @brief Computes a batch of 1D forward transforms in-place.
+ *
+ * @details
+ * Computes the (unnormalised) forward transforms of a batch of contiguous
+ * sequences of interleaved complex values, each with the plan length,
+ * and multiplies the result by the given scale factor.
+ *
+ * @param[in] h          Handle to plan.
+ * @param[in] batch_size Number of sequences to transform.
+ * @param[in,out] data   Pointer to data to transform.
+ * @param[in] scale      Scale factor to apply to the output.
+ * @param[in,out] status Status return code.
+ */
+OSKAR_EXPORT
+void oskar_fft_cpu_exec_1d(const oskar_FFTCPU* h, int batch_size,
+        void* data, double scale, int* status);
+
+/**
+ * @brief Frees resources used by the plan.
+ *
+ * @param[in] h          Handle to plan.
+ */
+OSKAR_EXPORT
+void oskar_fft_cpu_free(oskar_FFTCPU* h);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* include guard */
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "math/oskar_dft_c2r_grid_cpu.h"
+#include "binary/oskar_binary_data_types.h"
+#include <math.h>
+
+// The kernel is compiled for each instruction set using target
+// attributes, so only one build of the library is needed.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__x86_64__) || defined(__i386__))
+#define OSKAR_DFT_SIMD 1
+#endif
+
+// Number of input points in each chunk. The six scratch arrays for a chunk
+// use 12 kiB in double precision, which fits in the L1 cache.
+#define DFT_CHUNK 256
+
+// Number of output points computed by the recurrence before it is
+// restarted from an exact value.
+#define DFT_SEGMENT 256
+
+template<typename FP>
+static inline __attribute__((always_inline)) void oskar_dft_c2r_grid(
+        const int num_in, const double wavenumber,
+        const FP* RESTRICT x_in, const FP* RESTRICT y_in,
+        const FP* RESTRICT data_in, const FP* RESTRICT weight_in,
+        const int num_x, const double x_start, const double x_inc,
+        const double y_start, const double y_inc,
+        const size_t offset_out, const size_t num_out, FP* RESTRICT output)
+{
+    FP dr[DFT_CHUNK], di[DFT_CHUNK], rr[DFT_CHUNK], ri[DFT_CHUNK];
+    FP zr[DFT_CHUNK], zi[DFT_CHUNK];
+    for (size_t q = 0; q < num_out; ++q) output[q] = (FP) 0;
+    for (int j0 = 0; j0 < num_in; j0 += DFT_CHUNK)
+    {
+        const int n = (num_in - j0 < DFT_CHUNK) ? num_in - j0 : DFT_CHUNK;
+        const FP* RESTRICT x = x_in + j0;
+        const FP* RESTRICT y = y_in + j0;
+
+        // Get the weighted data, and the rotation between adjacent columns.
+        for (int k = 0; k < n; ++k)
+        {
+            const FP w = weight_in[j0 + k];
+            const double phase = -wavenumber * x[k] * x_inc;
+            dr[k] = w * data_in[2 * (j0 + k)];
+            di[k] = w * data_in[2 * (j0 + k) + 1];
+            rr[k] = (FP) cos(phase);
+            ri[k] = (FP) sin(phase);
+        }
+
+        // Loop over segments of rows.
+        for (size_t p = offset_out, end = offset_out + num_out; p < end;)
+        {
+            const int ix = (int) (p % num_x);
+            const size_t iy = p / num_x;
+            size_t num_seg = (size_t) (num_x - ix);
+            if (num_seg > DFT_SEGMENT) num_seg = DFT_SEGMENT;
+            if (num_seg > end - p) num_seg = end - p;
+            const double xo = x_start + ix * x_inc;
+            const double yo = y_start + iy * y_inc;
+
+            // Start the recurrence from the exact phase factor.
+            for (int k = 0; k < n; ++k)
+            {
+                const double phase = -wavenumber * (x[k] * xo + y[k] * yo);
+                const FP c = (FP) cos(phase), s = (FP) sin(phase);
+                zr[k] = dr[k] * c - di[k] * s;
+                zi[k] = dr[k] * s + di[k] * c;
+            }
+
+            // Sum the real parts, and rotate to the next column.
+            FP* RESTRICT out = output + (p - offset_out);
+            for (size_t i = 0; i < num_seg; ++i)
+            {
+                FP sum = (FP) 0;
+#pragma omp simd reduction(+:sum)
+                for (int k = 0; k < n; ++k)
+                {
+                    const FP t = zr[k] * rr[k] - zi[k] * ri[k];
+                    sum += zr[k];
+                    zi[k] = zr[k] * ri[k] + zi[k] * rr[k];
+                    zr[k] = t;
+                }
+                out[i] += sum;
+            }
+            p += num_seg;
+        }
+    }
+}
+
+#define OSKAR_DFT_C2R_GRID_FN(NAME, FP, ATTRIB)\
+ATTRIB static void NAME(const int num_in, const double wavenumber,\
+        const void* x_in, const void* y_in, const void* data_in,\
+        const void* weight_in, const int num_x, const double x_start,\
+        const double x_inc, const double y_start, const double y_inc,\
+        const size_t offset_out, const size_t num_out, void* output)\
+{\
+    oskar_dft_c2r_grid<FP>(num_in, wavenumber, (const FP*) x_in,\
+            (const FP*) y_in, (const FP*) data_in, (const FP*) weight_in,\
+            num_x, x_start, x_inc, y_start, y_inc, offset_out, num_out,\
+            (FP*) output);\
+}\
+
+OSKAR_DFT_C2R_GRID_FN(oskar_dft_c2r_grid_f, float, )
+OSKAR_DFT_C2R_GRID_FN(oskar_dft_c2r_grid_d, double, )
+#ifdef OSKAR_DFT_SIMD
+OSKAR_DFT_C2R_GRID_FN(oskar_dft_c2r_grid_avx2_f, float,
+        __attribute__((target("avx2,fma"))))
+OSKAR_DFT_C2R_GRID_FN(oskar_dft_c2r_grid_avx2_d, double,
+        __attribute__((target("avx2,fma"))))
+OSKAR_DFT_C2R_GRID_FN(oskar_dft_c2r_grid_avx512_f, float,
+        __attribute__((target("avx512f"))))
+OSKAR_DFT_C2R_GRID_FN(oskar_dft_c2r_grid_avx512_d, double,
+        __attribute__((target("avx512f"))))
+#endif
+
+typedef void (*oskar_DFTGridFn)(const int num_in, const double wavenumber,
+        const void* x_in, const void* y_in, const void* data_in,
+        const void* weight_in, const int num_x, const double x_start,
+        const double x_inc, const double y_start, const double y_inc,
+        const size_t offset_out, const size_t num_out, void* output);
+
+extern "C" {
+
+void oskar_dft_c2r_grid_cpu(int precision, int num_in, double wavenumber,
+        const void* x_in, const void* y_in, const void* data_in,
+        const void* weight_in, int num_x, double x_start, double x_inc,
+        double y_start, double y_inc, size_t offset_out, size_t num_out,
+        void* output)
+{
+    const int dbl = (precision == OSKAR_DOUBLE);
+    oskar_DFTGridFn fn = dbl ? oskar_dft_c2r_grid_d : oskar_dft_c2r_grid_f;
+
+    // Select the instruction set.
+#ifdef OSKAR_DFT_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        fn = dbl ? oskar_dft_c2r_grid_avx512_d : oskar_dft_c2r_grid_avx512_f;
+    }
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        fn = dbl ? oskar_dft_c2r_grid_avx2_d : oskar_dft_c2r_grid_avx2_f;
+    }
+#endif
+    fn(num_in, wavenumber, x_in, y_in, data_in, weight_in, num_x,
+            x_start, x_inc, y_start, y_inc, offset_out, num_out, output);
+}
+
+} // extern "C"
@@ -1,16 +1,27 @@
 /*
- * Copyright (c) 2019-2021, The OSKAR Developers.
+ * Copyright (c) 2019-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #ifdef OSKAR_HAVE_CUDA
 #include <cufft.h>
 #endif
+#ifdef OSKAR_HAVE_FFTW
+#include <fftw3.h>
+#ifdef OSKAR_OS_WIN
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "log/oskar_log.h"
 #include "math/oskar_fft.h"
-#include "math/oskar_fftpack_cfft.h"
-#include "math/oskar_fftpack_cfft_f.h"
+#include "math/oskar_fft_cpu.h"
 
 #include <math.h>
 #include <stdlib.h>
@@ -22,13 +33,38 @@ extern "C" {
 struct oskar_FFT
 {
     size_t num_cells_total;
-    oskar_Mem *fftpack_work, *fftpack_wsave;
-    int precision, location, num_dim, dim_size, ensure_consistent_norm;
+    oskar_FFTCPU* cpu_plan;
+    int precision, location, num_dim, dim_size, batch_size_1d;
+    int ensure_consistent_norm;
+#ifdef OSKAR_HAVE_FFTW
+    fftw_plan fftw_plan_d;
+    fftwf_plan fftw_plan_f;
+#endif
 #ifdef OSKAR_HAVE_CUDA
     cufftHandle cufft_plan;
 #endif
 };
 
+#ifdef OSKAR_HAVE_FFTW
+/*
+ * Only fftw_execute*() is thread-safe: the FFTW planner, plan destruction
+ * and the threads set-up all use global state, so must be serialised.
+ * The lock is statically initialised, as plans can be made from any thread.
+ */
+#ifdef OSKAR_OS_WIN
+static SRWLOCK fftw_lock = SRWLOCK_INIT;
+#define FFTW_LOCK AcquireSRWLockExclusive(&fftw_lock);
+#define FFTW_UNLOCK ReleaseSRWLockExclusive(&fftw_lock);
+#else
+static pthread_mutex_t fftw_lock = PTHREAD_MUTEX_INITIALIZER;
+#define FFTW_LOCK pthread_mutex_lock(&fftw_lock);
+#define FFTW_UNLOCK pthread_mutex_unlock(&fftw_lock);
+#endif
+#ifdef OSKAR_HAVE_FFTW_THREADS
+static int fftw_threads_init = 0, fftwf_threads_init = 0;
+#endif
+#endif
+
 #ifdef OSKAR_HAVE_CUDA
 static void print_cufft_error(cufftResult code)
 {
@@ -83,44 +119,29 @@ oskar_FFT* oskar_fft_create(int precision, int location, int num_dim,
     h->location = location;
     h->num_dim = num_dim;
     h->dim_size = dim_size;
+    h->batch_size_1d = batch_size_1d;
     h->ensure_consistent_norm = 1;
     h->num_cells_total = (size_t) dim_size;
     for (i = 1; i < num_dim; ++i) h->num_cells_total *= (size_t) dim_size;
     if (location == OSKAR_CPU || (location & OSKAR_CL))
     {
-        int len = 4 * dim_size +
-                2 * (int)(log((double)dim_size) / log(2.0)) + 8;
         if (location & OSKAR_CL)
         {
             h->location = OSKAR_CPU;
             oskar_log_warning(0,
                     "OpenCL FFT not implemented; using CPU version instead.");
         }
-        h->fftpack_wsave = oskar_mem_create(precision, OSKAR_CPU, len, status);
-        if (num_dim == 1)
+        if (num_dim == 1 || num_dim == 2)
         {
-            (void) batch_size_1d;
-            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
-        }
-        else if (num_dim == 2)
-        {
-            if (precision == OSKAR_DOUBLE)
-            {
-                oskar_fftpack_cfft2i(dim_size, dim_size,
-                        oskar_mem_double(h->fftpack_wsave, status));
-            }
-            else
-            {
-                oskar_fftpack_cfft2i_f(dim_size, dim_size,
-                        oskar_mem_float(h->fftpack_wsave, status));
-            }
+            /* FFTW plans are created on first use, as they need the data. */
+#ifndef OSKAR_HAVE_FFTW
+            h->cpu_plan = oskar_fft_cpu_create(precision, dim_size, status);
+#endif
         }
         else
         {
             *status = OSKAR_ERR_INVALID_ARGUMENT;
         }
-        h->fftpack_work = oskar_mem_create(precision, OSKAR_CPU,
-                2 * h->num_cells_total, status);
     }
     else if (location == OSKAR_GPU)
     {
@@ -155,6 +176,69 @@ oskar_FFT* oskar_fft_create(int precision, int location, int num_dim,
     return h;
 }
 
+#ifdef OSKAR_HAVE_FFTW
+static void fft_exec_fftw(oskar_FFT* h, oskar_Mem* data, double scale,
+        int* status)
+{
+    const int n[] = {h->dim_size, h->dim_size};
+    const int howmany = h->num_dim == 1 ? h->batch_size_1d : 1;
+    const int dist = h->num_dim == 1 ? h->dim_size : 0;
+    const unsigned flags = FFTW_ESTIMATE | FFTW_UNALIGNED;
+    if (oskar_mem_length(data) < h->num_cells_total * howmany)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+    if (h->precision == OSKAR_DOUBLE)
+    {
+        fftw_complex* ptr = (fftw_complex*) oskar_mem_void(data);
+        if (!h->fftw_plan_d)
+        {
+            FFTW_LOCK
+#ifdef OSKAR_HAVE_FFTW_THREADS
+            if (!fftw_threads_init) fftw_threads_init = fftw_init_threads();
+#ifdef _OPENMP
+            fftw_plan_with_nthreads(omp_get_max_threads());
+#endif
+#endif
+            if (!h->fftw_plan_d)
+            {
+                h->fftw_plan_d = fftw_plan_many_dft(h->num_dim, n, howmany, ptr,
+                        0, 1, dist, ptr, 0, 1, dist, FFTW_FORWARD, flags);
+            }
+            FFTW_UNLOCK
+        }
+        fftw_execute_dft(h->fftw_plan_d, ptr, ptr);
+    }
+    else
+    {
+        fftwf_complex* ptr = (fftwf_complex*) oskar_mem_void(data);
+        if (!h->fftw_plan_f)
+        {
+            FFTW_LOCK
+#ifdef OSKAR_HAVE_FFTW_THREADS
+            if (!fftwf_threads_init) fftwf_threads_init = fftwf_init_threads();
+#ifdef _OPENMP
+            fftwf_plan_with_nthreads(omp_get_max_threads());
+#endif
+#endif
+            if (!h->fftw_plan_f)
+            {
+                h->fftw_plan_f = fftwf_plan_many_dft(h->num_dim, n, howmany, ptr,
+                        0, 1, dist, ptr, 0, 1, dist, FFTW_FORWARD, flags);
+            }
+            FFTW_UNLOCK
+        }
+        fftwf_execute_dft(h->fftw_plan_f, ptr, ptr);
+    }
+    if (scale != 1.0)
+    {
+        oskar_mem_scale_real(data, scale,
+                0, h->num_cells_total * howmany, status);
+    }
+}
+#endif
+
 void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
 {
     oskar_Mem *data_copy = 0, *data_ptr = data;
@@ -166,34 +250,27 @@ void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
     }
     if (h->location == OSKAR_CPU)
     {
+        /* Normalisation is not wanted for W-kernel generation. */
+        double scale = 1.0;
+        if (!h->ensure_consistent_norm)
+        {
+            scale = 1.0 / (h->num_dim == 1 ?
+                    (double) h->dim_size : (double) h->num_cells_total);
+        }
+#ifdef OSKAR_HAVE_FFTW
+        fft_exec_fftw(h, data_ptr, scale, status);
+#else
         if (h->num_dim == 1)
         {
-            *status = OSKAR_ERR_FUNCTION_NOT_AVAILABLE;
+            oskar_fft_cpu_exec_1d(h->cpu_plan, h->batch_size_1d,
+                    oskar_mem_void(data_ptr), scale, status);
         }
-        else if (h->num_dim == 2)
+        else
         {
-            if (h->precision == OSKAR_DOUBLE)
-            {
-                oskar_fftpack_cfft2f(h->dim_size, h->dim_size, h->dim_size,
-                        oskar_mem_double(data_ptr, status),
-                        oskar_mem_double(h->fftpack_wsave, status),
-                        oskar_mem_double(h->fftpack_work, status));
-            }
-            else
-            {
-                oskar_fftpack_cfft2f_f(h->dim_size, h->dim_size, h->dim_size,
-                        oskar_mem_float(data_ptr, status),
-                        oskar_mem_float(h->fftpack_wsave, status),
-                        oskar_mem_float(h->fftpack_work, status));
-            }
-
-            /* This step not needed for W-kernel generation, so turn it off. */
-            if (h->ensure_consistent_norm)
-            {
-                oskar_mem_scale_real(data_ptr, (double)h->num_cells_total,
-                        0, h->num_cells_total, status);
-            }
+            oskar_fft_cpu_exec_2d(h->cpu_plan,
+                    oskar_mem_void(data_ptr), scale, status);
         }
+#endif
     }
     else if (h->location == OSKAR_GPU)
     {
@@ -231,12 +308,59 @@ void oskar_fft_exec(oskar_FFT* h, oskar_Mem* data, int* status)
     oskar_mem_free(data_copy, status);
 }
 
+void oskar_fft_exec_c2r(oskar_FFT* h, oskar_Mem* data, size_t offset,
+        size_t stride, int* status)
+{
+    if (*status) return;
+    const size_t n = (size_t) h->dim_size;
+    if (h->location != OSKAR_CPU || oskar_mem_location(data) != OSKAR_CPU)
+    {
+        *status = OSKAR_ERR_BAD_LOCATION;
+        return;
+    }
+    if (h->num_dim != 2 || n % 2 != 0 || stride < n / 2 + 1)
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        return;
+    }
+    if (oskar_mem_precision(data) != h->precision ||
+            !oskar_mem_is_complex(data))
+    {
+        *status = OSKAR_ERR_BAD_DATA_TYPE;
+        return;
+    }
+    if (oskar_mem_length(data) < offset + (n - 1) * stride + n / 2 + 1)
+    {
+        *status = OSKAR_ERR_DIMENSION_MISMATCH;
+        return;
+    }
+
+    /* FFTW is not used for this, so create the built-in plan if needed. */
+    if (!h->cpu_plan)
+    {
+        h->cpu_plan = oskar_fft_cpu_create(h->precision, h->dim_size, status);
+        if (*status) return;
+    }
+    const double scale = h->ensure_consistent_norm ?
+            1.0 : 1.0 / (double) h->num_cells_total;
+    oskar_fft_cpu_exec_2d_c2r(h->cpu_plan,
+            oskar_mem_char(data) + offset * oskar_mem_element_size(
+                    oskar_mem_type(data)), stride, scale, status);
+}
+
 void oskar_fft_free(oskar_FFT* h)
 {
-    int status = 0;
     if (!h) return;
-    oskar_mem_free(h->fftpack_work, &status);
-    oskar_mem_free(h->fftpack_wsave, &status);
+    oskar_fft_cpu_free(h->cpu_plan);
+#ifdef OSKAR_HAVE_FFTW
+    if (h->fftw_plan_d || h->fftw_plan_f)
+    {
+        FFTW_LOCK
+        if (h->fftw_plan_d) fftw_destroy_plan(h->fftw_plan_d);
+        if (h->fftw_plan_f) fftwf_destroy_plan(h->fftw_plan_f);
+        FFTW_UNLOCK
+    }
+#endif
 #ifdef OSKAR_HAVE_CUDA
     if (h->location == OSKAR_GPU)
     {
@@ -0,0 +1,631 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include "math/oskar_fft_cpu.h"
+#include "binary/oskar_binary_data_types.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// The transforms are compiled for each instruction set using target
+// attributes, so only one build of the library is needed.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__x86_64__) || defined(__i386__))
+#define OSKAR_FFT_SIMD 1
+#endif
+
+// Width of each block of sequences transformed together, in bytes of real
+// data. This is one cache line, and the widest vector.
+#define FFT_BLOCK_BYTES 64
+
+// Alignment of the scratch buffers, in bytes.
+#define FFT_ALIGN 64
+
+// Maximum number of stages (factors of the transform length).
+#define FFT_MAX_STAGES 64
+
+struct oskar_FFTCPU
+{
+    int precision, length, num_stages, simd;
+    int radix[FFT_MAX_STAGES];
+
+    // Offsets into the twiddle and root tables for each stage,
+    // in complex values.
+    size_t twiddle_offset[FFT_MAX_STAGES], root_offset[FFT_MAX_STAGES];
+
+    // Twiddle factors for each stage, as [p][radix - 1] complex values.
+    // Roots of unity for stages with a radix other than 2, 3, 4 or 5,
+    // as [radix] complex values.
+    void *twiddles, *roots;
+
+    // Aligned scratch buffer for each thread, (scratch_stride) bytes apart.
+    int num_threads;
+    size_t scratch_stride;
+    void *scratch_buffer, *scratch;
+};
+
+typedef void (*oskar_FFTBlockFn)(const oskar_FFTCPU* h, void* data,
+        int first, int count, int rows, size_t stride, double scale,
+        void* scratch);
+
+#define CMUL_RE(AR, AI, BR, BI) ((AR) * (BR) - (AI) * (BI))
+#define CMUL_IM(AR, AI, BR, BI) ((AR) * (BI) + (AI) * (BR))
+
+// Computes one stage of a self-sorting Stockham transform.
+// The input holds (radix * m) groups of s values, and group (p + k * m)
+// is combined into output groups (radix * p + j), for 0 <= k, j < radix.
+// The values in each group are independent, so the inner loops vectorise.
+template<typename FP>
+static inline __attribute__((always_inline)) void oskar_fft_stage(
+        const int radix, const int m, const int s,
+        const FP* RESTRICT tw, const FP* RESTRICT root,
+        const FP* RESTRICT xr, const FP* RESTRICT xi,
+        FP* RESTRICT yr, FP* RESTRICT yi)
+{
+    const size_t ms = (size_t) m * s;
+    for (int p = 0; p < m; ++p)
+    {
+        const FP* w = tw + 2 * (radix - 1) * p;
+        const FP *ar = xr + (size_t) p * s, *ai = xi + (size_t) p * s;
+        FP *br = yr + (size_t) radix * p * s, *bi = yi + (size_t) radix * p * s;
+        if (radix == 4)
+        {
+            const FP w1r = w[0], w1i = w[1], w2r = w[2], w2i = w[3];
+            const FP w3r = w[4], w3i = w[5];
+#pragma omp simd
+            for (int t = 0; t < s; ++t)
+            {
+                const FP a0r = ar[t], a0i = ai[t];
+                const FP a1r = ar[t + ms], a1i = ai[t + ms];
+                const FP a2r = ar[t + 2 * ms], a2i = ai[t + 2 * ms];
+                const FP a3r = ar[t + 3 * ms], a3i = ai[t + 3 * ms];
+                const FP t0r = a0r + a2r, t0i = a0i + a2i;
+                const FP t1r = a0r - a2r, t1i = a0i - a2i;
+                const FP t2r = a1r + a3r, t2i = a1i + a3i;
+                const FP t3r = a1i - a3i, t3i = a3r - a1r; // -i * (a1 - a3)
+                const FP c1r = t1r + t3r, c1i = t1i + t3i;
+                const FP c2r = t0r - t2r, c2i = t0i - t2i;
+                const FP c3r = t1r - t3r, c3i = t1i - t3i;
+                br[t] = t0r + t2r;
+                bi[t] = t0i + t2i;
+                br[t + s] = CMUL_RE(c1r, c1i, w1r, w1i);
+                bi[t + s] = CMUL_IM(c1r, c1i, w1r, w1i);
+                br[t + 2 * s] = CMUL_RE(c2r, c2i, w2r, w2i);
+                bi[t + 2 * s] = CMUL_IM(c2r, c2i, w2r, w2i);
+                br[t + 3 * s] = CMUL_RE(c3r, c3i, w3r, w3i);
+                bi[t + 3 * s] = CMUL_IM(c3r, c3i, w3r, w3i);
+            }
+        }
+        else if (radix == 2)
+        {
+            const FP w1r = w[0], w1i = w[1];
+#pragma omp simd
+            for (int t = 0; t < s; ++t)
+            {
+                const FP a0r = ar[t], a0i = ai[t];
+                const FP a1r = ar[t + ms], a1i = ai[t + ms];
+                const FP c1r = a0r - a1r, c1i = a0i - a1i;
+                br[t] = a0r + a1r;
+                bi[t] = a0i + a1i;
+                br[t + s] = CMUL_RE(c1r, c1i, w1r, w1i);
+                bi[t + s] = CMUL_IM(c1r, c1i, w1r, w1i);
+            }
+        }
+        else if (radix == 3)
+        {
+            const FP w1r = w[0], w1i = w[1], w2r = w[2], w2i = w[3];
+            const FP sin60 = (FP) 0.86602540378443864676;
+#pragma omp simd
+            for (int t = 0; t < s; ++t)
+            {
+                const FP a0r = ar[t], a0i = ai[t];
+                const FP a1r = ar[t + ms], a1i = ai[t + ms];
+                const FP a2r = ar[t + 2 * ms], a2i = ai[t + 2 * ms];
+                const FP sr = a1r + a2r, si = a1i + a2i;
+                const FP dr = a1r - a2r, di = a1i - a2i;
+                const FP mr = a0r - (FP)0.5 * sr, mi = a0i - (FP)0.5 * si;
+                const FP nr = sin60 * di, ni = -sin60 * dr; // -i sin60 * d
+                const FP c1r = mr + nr, c1i = mi + ni;
+                const FP c2r = mr - nr, c2i = mi - ni;
+                br[t] = a0r + sr;
+                bi[t] = a0i + si;
+                br[t + s] = CMUL_RE(c1r, c1i, w1r, w1i);
+                bi[t + s] = CMUL_IM(c1r, c1i, w1r, w1i);
+                br[t + 2 * s] = CMUL_RE(c2r, c2i, w2r, w2i);
+                bi[t + 2 * s] = CMUL_IM(c2r, c2i, w2r, w2i);
+            }
+        }
+        else if (radix == 5)
+        {
+            const FP w1r = w[0], w1i = w[1], w2r = w[2], w2i = w[3];
+            const FP w3r = w[4], w3i = w[5], w4r = w[6], w4i = w[7];
+            const FP cos1 = (FP) 0.30901699437494742410;
+            const FP cos2 = (FP) -0.80901699437494742410;
+            const FP sin1 = (FP) 0.95105651629515357212;
+            const FP sin2 = (FP) 0.58778525229247312917;
+#pragma omp simd
+            for (int t = 0; t < s; ++t)
+            {
+                const FP a0r = ar[t], a0i = ai[t];
+                const FP a1r = ar[t + ms], a1i = ai[t + ms];
+                const FP a2r = ar[t + 2 * ms], a2i = ai[t + 2 * ms];
+                const FP a3r = ar[t + 3 * ms], a3i = ai[t + 3 * ms];
+                const FP a4r = ar[t + 4 * ms], a4i = ai[t + 4 * ms];
+                const FP s1r = a1r + a4r, s1i = a1i + a4i;
+                const FP d1r = a1r - a4r, d1i = a1i - a4i;
+                const FP s2r = a2r + a3r, s2i = a2i + a3i;
+                const FP d2r = a2r - a3r, d2i = a2i - a3i;
+                const FP t1r = a0r + cos1 * s1r + cos2 * s2r;
+                const FP t1i = a0i + cos1 * s1i + cos2 * s2i;
+                const FP t2r = a0r + cos2 * s1r + cos1 * s2r;
+                const FP t2i = a0i + cos2 * s1i + cos1 * s2i;
+                const FP u1r = sin1 * d1r + sin2 * d2r;
+                const FP u1i = sin1 * d1i + sin2 * d2i;
+                const FP u2r = sin2 * d1r - sin1 * d2r;
+                const FP u2i = sin2 * d1i - sin1 * d2i;
+                // c1 = t1 - i u1, c4 = t1 + i u1, c2 = t2 - i u2, c3 = t2 + i u2
+                const FP c1r = t1r + u1i, c1i = t1i - u1r;
+                const FP c4r = t1r - u1i, c4i = t1i + u1r;
+                const FP c2r = t2r + u2i, c2i = t2i - u2r;
+                const FP c3r = t2r - u2i, c3i = t2i + u2r;
+                br[t] = a0r + s1r + s2r;
+                bi[t] = a0i + s1i + s2i;
+                br[t + s] = CMUL_RE(c1r, c1i, w1r, w1i);
+                bi[t + s] = CMUL_IM(c1r, c1i, w1r, w1i);
+                br[t + 2 * s] = CMUL_RE(c2r, c2i, w2r, w2i);
+                bi[t + 2 * s] = CMUL_IM(c2r, c2i, w2r, w2i);
+                br[t + 3 * s] = CMUL_RE(c3r, c3i, w3r, w3i);
+                bi[t + 3 * s] = CMUL_IM(c3r, c3i, w3r, w3i);
+                br[t + 4 * s] = CMUL_RE(c4r, c4i, w4r, w4i);
+                bi[t + 4 * s] = CMUL_IM(c4r, c4i, w4r, w4i);
+            }
+        }
+        else
+        {
+            // Direct DFT for any other radix.
+            for (int j = 0; j < radix; ++j)
+            {
+                FP *cr = br + (size_t) j * s, *ci = bi + (size_t) j * s;
+#pragma omp simd
+                for (int t = 0; t < s; ++t)
+                {
+                    cr[t] = ar[t];
+                    ci[t] = ai[t];
+                }
+                for (int k = 1; k < radix; ++k)
+                {
+                    const int e = (j * k) % radix;
+                    const FP rr = root[2 * e], ri = root[2 * e + 1];
+                    const FP *akr = ar + k * ms, *aki = ai + k * ms;
+#pragma omp simd
+                    for (int t = 0; t < s; ++t)
+                    {
+                        cr[t] += CMUL_RE(akr[t], aki[t], rr, ri);
+                        ci[t] += CMUL_IM(akr[t], aki[t], rr, ri);
+                    }
+                }
+                if (j > 0)
+                {
+                    const FP wr = w[2 * (j - 1)], wi = w[2 * (j - 1) + 1];
+#pragma omp simd
+                    for (int t = 0; t < s; ++t)
+                    {
+                        const FP c_r = cr[t], c_i = ci[t];
+                        cr[t] = CMUL_RE(c_r, c_i, wr, wi);
+                        ci[t] = CMUL_IM(c_r, c_i, wr, wi);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Transforms a block of split complex sequences in the scratch arrays,
+// with the same element of each of the (count) sequences stored
+// consecutively. Returns the arrays holding the result in xr and xi.
+template<typename FP>
+static inline __attribute__((always_inline)) void oskar_fft_transform(
+        const oskar_FFTCPU* h, int count, FP** xr, FP** xi, FP** yr, FP** yi)
+{
+    const FP* tw = (const FP*) h->twiddles;
+    const FP* root = (const FP*) h->roots;
+    int s = count, n_cur = h->length;
+    for (int i = 0; i < h->num_stages; ++i)
+    {
+        FP* t = 0;
+        const int radix = h->radix[i], m = n_cur / radix;
+        oskar_fft_stage<FP>(radix, m, s, tw + 2 * h->twiddle_offset[i],
+                root + 2 * h->root_offset[i], *xr, *xi, *yr, *yi);
+        t = *xr; *xr = *yr; *yr = t;
+        t = *xi; *xi = *yi; *yi = t;
+        n_cur = m;
+        s *= radix;
+    }
+}
+
+// Transforms a block of (count) rows or columns of the data.
+// Each row has the transform length, and rows start (stride) complex
+// values apart.
+// The block is gathered into split real and imaginary scratch arrays,
+// with the same element of each sequence stored consecutively.
+template<typename FP>
+static inline __attribute__((always_inline)) void oskar_fft_block(
+        const oskar_FFTCPU* h, FP* data, int first, int count, int rows,
+        size_t stride, FP scale, FP* scratch)
+{
+    const int n = h->length;
+    const size_t row_stride = 2 * stride;
+    const size_t size = (size_t) n * count;
+    FP *xr = scratch, *xi = xr + size, *yr = xi + size, *yi = yr + size;
+
+    // Gather the block.
+    if (rows)
+    {
+        for (int v = 0; v < count; ++v)
+        {
+            const FP* in = data + (size_t) (first + v) * row_stride;
+            for (int j = 0; j < n; ++j)
+            {
+                xr[(size_t) j * count + v] = in[2 * j];
+                xi[(size_t) j * count + v] = in[2 * j + 1];
+            }
+        }
+    }
+    else
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            const FP* in = data + j * row_stride + 2 * first;
+            for (int v = 0; v < count; ++v)
+            {
+                xr[(size_t) j * count + v] = in[2 * v];
+                xi[(size_t) j * count + v] = in[2 * v + 1];
+            }
+        }
+    }
+
+    // Transform the block.
+    oskar_fft_transform<FP>(h, count, &xr, &xi, &yr, &yi);
+
+    // Scatter the block.
+    if (rows)
+    {
+        for (int v = 0; v < count; ++v)
+        {
+            FP* out = data + (size_t) (first + v) * row_stride;
+            for (int j = 0; j < n; ++j)
+            {
+                out[2 * j]     = scale * xr[(size_t) j * count + v];
+                out[2 * j + 1] = scale * xi[(size_t) j * count + v];
+            }
+        }
+    }
+    else
+    {
+        for (int j = 0; j < n; ++j)
+        {
+            FP* out = data + j * row_stride + 2 * first;
+            for (int v = 0; v < count; ++v)
+            {
+                out[2 * v]     = scale * xr[(size_t) j * count + v];
+                out[2 * v + 1] = scale * xi[(size_t) j * count + v];
+            }
+        }
+    }
+}
+
+// Transforms a block of (count) pairs of Hermitian rows to real rows.
+// Each row holds the first (n / 2 + 1) values of its sequence, and rows
+// start (stride) complex values apart. Each pair of rows (a, b) is
+// transformed together as the complex sequence (a + ib), so the real
+// outputs of rows a and b are the real and imaginary parts of the result.
+// Each real output row overwrites the start of its input row.
+template<typename FP>
+static inline __attribute__((always_inline)) void oskar_fft_block_c2r(
+        const oskar_FFTCPU* h, FP* data, int first, int count, int,
+        size_t stride, FP scale, FP* scratch)
+{
+    const int n = h->length, n_h = n / 2;
+    const size_t row_stride = 2 * stride;
+    const size_t size = (size_t) n * count;
+    FP *xr = scratch, *xi = xr + size, *yr = xi + size, *yi = yr + size;
+
+    // Gather the block, using the symmetry to fill in the other half.
+    for (int v = 0; v < count; ++v)
+    {
+        const FP* a = data + (size_t) (2 * (first + v)) * row_stride;
+        const FP* b = a + row_stride;
+        for (int j = 0; j <= n_h; ++j)
+        {
+            // The imaginary parts of the self-symmetric values are ignored.
+            const FP a_im = (j == 0 || j == n_h) ? (FP) 0 : a[2 * j + 1];
+            const FP b_im = (j == 0 || j == n_h) ? (FP) 0 : b[2 * j + 1];
+            xr[(size_t) j * count + v] = a[2 * j] - b_im;
+            xi[(size_t) j * count + v] = a_im + b[2 * j];
+            if (j > 0 && j < n_h)
+            {
+                xr[(size_t) (n - j) * count + v] = a[2 * j] + b_im;
+                xi[(size_t) (n - j) * count + v] = b[2 * j] - a_im;
+            }
+        }
+    }
+
+    // Transform the block.
+    oskar_fft_transform<FP>(h, count, &xr, &xi, &yr, &yi);
+
+    // Scatter the block.
+    for (int v = 0; v < count; ++v)
+    {
+        FP* a = data + (size_t) (2 * (first + v)) * row_stride;
+        FP* b = a + row_stride;
+        for (int j = 0; j < n; ++j)
+        {
+            a[j] = scale * xr[(size_t) j * count + v];
+            b[j] = scale * xi[(size_t) j * count + v];
+        }
+    }
+}
+
+#define OSKAR_FFT_BLOCK_FN(NAME, BLOCK, FP, ATTRIB)\
+        ATTRIB static void NAME(const oskar_FFTCPU* h, void* data,\
+        int first, int count, int rows, size_t stride, double scale,\
+        void* scratch)\
+{\
+    BLOCK<FP>(h, (FP*) data, first, count, rows, stride, (FP) scale,\
+            (FP*) scratch);\
+}\
+
+#define OSKAR_FFT_BLOCK_FNS(NAME, BLOCK)\
+OSKAR_FFT_BLOCK_FN(NAME ## _f, BLOCK, float, )\
+OSKAR_FFT_BLOCK_FN(NAME ## _d, BLOCK, double, )\
+OSKAR_FFT_BLOCK_FNS_SIMD(NAME, BLOCK)\
+
+#ifdef OSKAR_FFT_SIMD
+#define OSKAR_FFT_BLOCK_FNS_SIMD(NAME, BLOCK)\
+OSKAR_FFT_BLOCK_FN(NAME ## _avx2_f, BLOCK, float,\
+        __attribute__((target("avx2,fma"))))\
+OSKAR_FFT_BLOCK_FN(NAME ## _avx2_d, BLOCK, double,\
+        __attribute__((target("avx2,fma"))))\
+OSKAR_FFT_BLOCK_FN(NAME ## _avx512_f, BLOCK, float,\
+        __attribute__((target("avx512f"))))\
+OSKAR_FFT_BLOCK_FN(NAME ## _avx512_d, BLOCK, double,\
+        __attribute__((target("avx512f"))))\
+
+#else
+#define OSKAR_FFT_BLOCK_FNS_SIMD(NAME, BLOCK)
+#endif
+
+OSKAR_FFT_BLOCK_FNS(oskar_fft_block, oskar_fft_block)
+OSKAR_FFT_BLOCK_FNS(oskar_fft_block_c2r, oskar_fft_block_c2r)
+
+// Returns the block function to use for the plan.
+#ifdef OSKAR_FFT_SIMD
+#define OSKAR_FFT_SELECT(H, NAME) (\
+        (H->simd == 2) ? (dbl ? NAME ## _avx512_d : NAME ## _avx512_f) :\
+        (H->simd == 1) ? (dbl ? NAME ## _avx2_d : NAME ## _avx2_f) :\
+        (dbl ? NAME ## _d : NAME ## _f))
+#else
+#define OSKAR_FFT_SELECT(H, NAME) (dbl ? NAME ## _d : NAME ## _f)
+#endif
+
+// Transforms (num) rows, columns or pairs of rows of the data,
+// in parallel blocks.
+// Each thread uses its own scratch buffer in the plan, so the number of
+// threads is limited to the number of buffers.
+static void oskar_fft_cpu_pass(const oskar_FFTCPU* h, oskar_FFTBlockFn fn,
+        void* data, int num, int rows, size_t stride, double scale,
+        int* status)
+{
+    if (*status) return;
+    const int dbl = (h->precision == OSKAR_DOUBLE);
+    const size_t element_size = dbl ? sizeof(double) : sizeof(float);
+    const int width = FFT_BLOCK_BYTES / (int) element_size;
+    const int num_blocks = (num + width - 1) / width;
+#pragma omp parallel if (num_blocks > 1) num_threads(h->num_threads)
+    {
+        int b = 0, thread_id = 0;
+#ifdef _OPENMP
+        thread_id = omp_get_thread_num();
+#endif
+        void* scratch = (char*) h->scratch + thread_id * h->scratch_stride;
+#pragma omp for schedule(dynamic, 1)
+        for (b = 0; b < num_blocks; ++b)
+        {
+            const int first = b * width;
+            const int count = (num - first < width) ? num - first : width;
+            fn(h, data, first, count, rows, stride, scale, scratch);
+        }
+    }
+}
+
+extern "C" {
+
+oskar_FFTCPU* oskar_fft_cpu_create(int precision, int length, int* status)
+{
+    int i = 0, f = 0, n = length;
+    size_t num_twiddles = 0, num_roots = 0;
+    if (*status) return 0;
+    if (length < 1 ||
+            (precision != OSKAR_SINGLE && precision != OSKAR_DOUBLE))
+    {
+        *status = OSKAR_ERR_INVALID_ARGUMENT;
+        return 0;
+    }
+    oskar_FFTCPU* h = (oskar_FFTCPU*) calloc(1, sizeof(oskar_FFTCPU));
+    if (!h)
+    {
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+    h->precision = precision;
+    h->length = length;
+
+    // Factorise the length, using the largest supported radix first.
+    while (n % 4 == 0) { h->radix[h->num_stages++] = 4; n /= 4; }
+    while (n % 2 == 0) { h->radix[h->num_stages++] = 2; n /= 2; }
+    while (n % 3 == 0) { h->radix[h->num_stages++] = 3; n /= 3; }
+    while (n % 5 == 0) { h->radix[h->num_stages++] = 5; n /= 5; }
+    for (f = 7; f <= n / f; f += 2)
+    {
+        while (n % f == 0) { h->radix[h->num_stages++] = f; n /= f; }
+    }
+    if (n > 1) h->radix[h->num_stages++] = n;
+
+    // Get the size of the tables.
+    n = length;
+    for (i = 0; i < h->num_stages; ++i)
+    {
+        const int radix = h->radix[i], m = n / radix;
+        h->twiddle_offset[i] = num_twiddles;
+        h->root_offset[i] = num_roots;
+        num_twiddles += (size_t) m * (radix - 1);
+        if (radix > 5) num_roots += radix;
+        n = m;
+    }
+
+    // Compute the tables in double precision.
+    double* twiddles = (double*) calloc(2 * num_twiddles + 2, sizeof(double));
+    double* roots = (double*) calloc(2 * num_roots + 2, sizeof(double));
+    if (!twiddles || !roots)
+    {
+        free(twiddles);
+        free(roots);
+        free(h);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+    n = length;
+    for (i = 0; i < h->num_stages; ++i)
+    {
+        const int radix = h->radix[i], m = n / radix;
+        double* w = twiddles + 2 * h->twiddle_offset[i];
+        for (int p = 0; p < m; ++p)
+        {
+            for (int j = 1; j < radix; ++j)
+            {
+                const long long e = ((long long) j * p) % n;
+                const double arg = -2.0 * M_PI * (double) e / n;
+                w[2 * ((size_t) p * (radix - 1) + j - 1)]     = cos(arg);
+                w[2 * ((size_t) p * (radix - 1) + j - 1) + 1] = sin(arg);
+            }
+        }
+        if (radix > 5)
+        {
+            double* r = roots + 2 * h->root_offset[i];
+            for (int k = 0; k < radix; ++k)
+            {
+                const double arg = -2.0 * M_PI * (double) k / radix;
+                r[2 * k]     = cos(arg);
+                r[2 * k + 1] = sin(arg);
+            }
+        }
+        n = m;
+    }
+    if (precision == OSKAR_DOUBLE)
+    {
+        h->twiddles = twiddles;
+        h->roots = roots;
+    }
+    else
+    {
+        float* twiddles_f =
+                (float*) calloc(2 * num_twiddles + 2, sizeof(float));
+        float* roots_f = (float*) calloc(2 * num_roots + 2, sizeof(float));
+        if (twiddles_f && roots_f)
+        {
+            for (size_t k = 0; k < 2 * num_twiddles; ++k)
+            {
+                twiddles_f[k] = (float) twiddles[k];
+            }
+            for (size_t k = 0; k < 2 * num_roots; ++k)
+            {
+                roots_f[k] = (float) roots[k];
+            }
+        }
+        h->twiddles = twiddles_f;
+        h->roots = roots_f;
+        free(twiddles);
+        free(roots);
+    }
+
+    // Allocate the scratch buffers, each holding four blocks of the
+    // transform length (one block is FFT_BLOCK_BYTES of real data).
+#ifdef _OPENMP
+    h->num_threads = omp_get_max_threads();
+#else
+    h->num_threads = 1;
+#endif
+    h->scratch_stride = 4 * (size_t) length * FFT_BLOCK_BYTES;
+    h->scratch_buffer = malloc(
+            h->num_threads * h->scratch_stride + FFT_ALIGN);
+    h->scratch = (void*) (((uintptr_t) h->scratch_buffer + FFT_ALIGN - 1) &
+            ~((uintptr_t) FFT_ALIGN - 1));
+    if (!h->twiddles || !h->roots || !h->scratch_buffer)
+    {
+        oskar_fft_cpu_free(h);
+        *status = OSKAR_ERR_MEMORY_ALLOC_FAILURE;
+        return 0;
+    }
+
+    // Select the instruction set.
+#ifdef OSKAR_FFT_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        h->simd = 2;
+    }
+    else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        h->simd = 1;
+    }
+#endif
+    return h;
+}
+
+void oskar_fft_cpu_exec_2d(const oskar_FFTCPU* h, void* data, double scale,
+        int* status)
+{
+    if (*status) return;
+    const int dbl = (h->precision == OSKAR_DOUBLE);
+    const size_t n = (size_t) h->length;
+    oskar_FFTBlockFn fn = OSKAR_FFT_SELECT(h, oskar_fft_block);
+    oskar_fft_cpu_pass(h, fn, data, h->length, 0, n, 1.0, status);
+    oskar_fft_cpu_pass(h, fn, data, h->length, 1, n, scale, status);
+}
+
+void oskar_fft_cpu_exec_2d_c2r(const oskar_FFTCPU* h, void* data,
+        size_t stride, double scale, int* status)
+{
+    if (*status) return;
+    const int dbl = (h->precision == OSKAR_DOUBLE);
+    oskar_fft_cpu_pass(h, OSKAR_FFT_SELECT(h, oskar_fft_block),
+            data, h->length / 2 + 1, 0, stride, 1.0, status);
+    oskar_fft_cpu_pass(h, OSKAR_FFT_SELECT(h, oskar_fft_block_c2r),
+            data, h->length / 2, 1, stride, scale, status);
+}
+
+void oskar_fft_cpu_exec_1d(const oskar_FFTCPU* h, int batch_size,
+        void* data, double scale, int* status)
+{
+    if (*status) return;
+    const int dbl = (h->precision == OSKAR_DOUBLE);
+    oskar_fft_cpu_pass(h, OSKAR_FFT_SELECT(h, oskar_fft_block),
+            data, batch_size, 1, (size_t) h->length, scale, status);
+}
+
+void oskar_fft_cpu_free(oskar_FFTCPU* h)
+{
+    if (!h) return;
+    free(h->twiddles);
+    free(h->roots);
+    free(h->scratch_buffer);
+    free(h);
+}
+
+} // extern "C"
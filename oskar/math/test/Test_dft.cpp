@@ -1,17 +1,21 @@
 /*
- * Copyright (c) 2017-2021, The OSKAR Developers.
+ * Copyright (c) 2017-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <gtest/gtest.h>
 
+#include "convert/oskar_convert_fov_to_cellsize.h"
 #include "math/oskar_cmath.h"
 #include "math/oskar_dft_c2r.h"
+#include "math/oskar_dft_c2r_grid_cpu.h"
 #include "math/oskar_evaluate_image_lmn_grid.h"
 #include "utility/oskar_device.h"
 #include "utility/oskar_get_error_string.h"
 #include "utility/oskar_timer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <cstdio>
 #include <string>
@@ -133,3 +137,99 @@ TEST(dft, c2r)
     oskar_mem_free(v, &status);
     oskar_mem_free(w, &status);
 }
+
+static void run_grid_test(int type, double tol)
+{
+    int status = 0, side = 128;
+    const int num_in = 1000;
+    const size_t num_pixels = (size_t) side * side;
+    const double fov = 4.0 * M_PI / 180.0, wavenumber = 2.0 * M_PI;
+
+    // Generate input data, and the reference output in double precision.
+    oskar_Mem *l = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pixels,
+            &status);
+    oskar_Mem *m = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pixels,
+            &status);
+    oskar_Mem *n = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pixels,
+            &status);
+    oskar_Mem *u = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_in, &status);
+    oskar_Mem *v = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_in, &status);
+    oskar_Mem *amp = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            num_in, &status);
+    oskar_Mem *wt = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_in, &status);
+    oskar_Mem *ref = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU, num_pixels,
+            &status);
+    oskar_evaluate_image_lmn_grid(side, side, fov, fov, 0, l, m, n, &status);
+    oskar_mem_random_range(u, -1000., 1000., &status);
+    oskar_mem_random_range(v, -1000., 1000., &status);
+    oskar_mem_random_gaussian(amp, 0, 1, 2, 3, 1.0, &status);
+    oskar_mem_random_range(wt, 0.5, 1.5, &status);
+    oskar_Timer* tmr = oskar_timer_create(OSKAR_TIMER_NATIVE);
+    oskar_timer_resume(tmr);
+    oskar_dft_c2r(num_in, wavenumber, u, v, 0, amp, wt, (int) num_pixels,
+            l, m, 0, ref, &status);
+    printf("Time taken for oskar_dft_c2r(): %.3f\n", oskar_timer_elapsed(tmr));
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Run the grid DFT in two parts, split part-way along a row.
+    oskar_Mem *u_ = oskar_mem_convert_precision(u, type, &status);
+    oskar_Mem *v_ = oskar_mem_convert_precision(v, type, &status);
+    oskar_Mem *amp_ = oskar_mem_convert_precision(amp, type, &status);
+    oskar_Mem *wt_ = oskar_mem_convert_precision(wt, type, &status);
+    oskar_Mem *out = oskar_mem_create(type, OSKAR_CPU, num_pixels, &status);
+    ASSERT_EQ(0, status);
+    const double delta = sin(oskar_convert_fov_to_cellsize(fov, side));
+    const size_t split = 7 * (size_t) side + 31;
+    const size_t element_size = oskar_mem_element_size(type);
+    oskar_timer_reset(tmr);
+    oskar_timer_resume(tmr);
+    for (int part = 0; part < 2; ++part)
+    {
+        const size_t offset = part ? split : 0;
+        const size_t num_out = part ? num_pixels - split : split;
+        oskar_dft_c2r_grid_cpu(type, num_in, wavenumber,
+                oskar_mem_void_const(u_), oskar_mem_void_const(v_),
+                oskar_mem_void_const(amp_), oskar_mem_void_const(wt_),
+                side, (side / 2) * delta, -delta, -(side / 2) * delta, delta,
+                offset, num_out, oskar_mem_char(out) + offset * element_size);
+    }
+    printf("Time taken for oskar_dft_c2r_grid_cpu(): %.3f\n",
+            oskar_timer_elapsed(tmr));
+    oskar_timer_free(tmr);
+
+    // Check the results.
+    oskar_Mem* out_d = oskar_mem_convert_precision(out, OSKAR_DOUBLE, &status);
+    const double* p_ref = oskar_mem_double_const(ref, &status);
+    const double* p_out = oskar_mem_double_const(out_d, &status);
+    double max_ref = 0.0;
+    for (size_t i = 0; i < num_pixels; ++i)
+    {
+        max_ref = std::max(max_ref, std::fabs(p_ref[i]));
+    }
+    for (size_t i = 0; i < num_pixels; ++i)
+    {
+        ASSERT_NEAR(p_ref[i], p_out[i], tol * max_ref) << "pixel " << i;
+    }
+
+    // Free memory.
+    oskar_mem_free(l, &status);
+    oskar_mem_free(m, &status);
+    oskar_mem_free(n, &status);
+    oskar_mem_free(u, &status);
+    oskar_mem_free(v, &status);
+    oskar_mem_free(amp, &status);
+    oskar_mem_free(wt, &status);
+    oskar_mem_free(ref, &status);
+    oskar_mem_free(u_, &status);
+    oskar_mem_free(v_, &status);
+    oskar_mem_free(amp_, &status);
+    oskar_mem_free(wt_, &status);
+    oskar_mem_free(out, &status);
+    oskar_mem_free(out_d, &status);
+}
+
+TEST(dft, c2r_grid_cpu)
+{
+    run_grid_test(OSKAR_DOUBLE, 1e-10);
+    run_grid_test(OSKAR_SINGLE, 1e-4);
+}
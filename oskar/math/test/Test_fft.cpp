@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026, The OSKAR Developers.
+ * See the LICENSE file at the top-level directory of this distribution.
+ */
+
+#include <gtest/gtest.h>
+
+#include "math/oskar_cmath.h"
+#include "math/oskar_fft.h"
+#include "math/oskar_fft_cpu.h"
+#include "utility/oskar_get_error_string.h"
+
+#include <cstdlib>
+#include <vector>
+
+// Computes forward DFTs of a batch of sequences with the given stride.
+static void dft_1d(int n, int batch, size_t stride, size_t dist,
+        const std::vector<double>& in, std::vector<double>& out)
+{
+    for (int b = 0; b < batch; ++b)
+    {
+        for (int k = 0; k < n; ++k)
+        {
+            double re = 0.0, im = 0.0;
+            for (int j = 0; j < n; ++j)
+            {
+                const double arg = -2.0 * M_PI * ((long long) j * k % n) / n;
+                const size_t i = 2 * (b * dist + j * stride);
+                re += in[i] * cos(arg) - in[i + 1] * sin(arg);
+                im += in[i] * sin(arg) + in[i + 1] * cos(arg);
+            }
+            out[2 * (b * dist + k * stride)] = re;
+            out[2 * (b * dist + k * stride) + 1] = im;
+        }
+    }
+}
+
+// Runs the FFT and checks the result against a DFT.
+// If direct is set, the built-in CPU FFT is called directly, so that it is
+// tested even if oskar_fft() uses FFTW.
+static void run_test(int prec, int num_dim, int n, int batch, int norm,
+        int direct)
+{
+    int status = 0;
+    const size_t num_cells = (num_dim == 1) ? (size_t) n * batch :
+            (size_t) n * n;
+    std::vector<double> in(2 * num_cells), tmp(2 * num_cells);
+    std::vector<double> ref(2 * num_cells);
+    srand(n);
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = 2.0 * rand() / (double) RAND_MAX - 1.0;
+    }
+    if (num_dim == 1)
+    {
+        dft_1d(n, batch, 1, n, in, ref);
+    }
+    else
+    {
+        dft_1d(n, n, 1, n, in, tmp);
+        dft_1d(n, n, n, 1, tmp, ref);
+    }
+    const double scale = norm ? 1.0 : 1.0 / (num_dim == 1 ? n : n * n);
+
+    // Run the FFT.
+    oskar_Mem* data = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+            num_cells, &status);
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        if (prec == OSKAR_DOUBLE)
+        {
+            oskar_mem_double(data, &status)[i] = in[i];
+        }
+        else
+        {
+            oskar_mem_float(data, &status)[i] = (float) in[i];
+        }
+    }
+    oskar_FFT* fft = 0;
+    if (direct)
+    {
+        oskar_FFTCPU* plan = oskar_fft_cpu_create(prec, n, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        if (num_dim == 1)
+        {
+            oskar_fft_cpu_exec_1d(plan, batch, oskar_mem_void(data), scale,
+                    &status);
+        }
+        else
+        {
+            oskar_fft_cpu_exec_2d(plan, oskar_mem_void(data), scale, &status);
+        }
+        oskar_fft_cpu_free(plan);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    }
+    else
+    {
+        fft = oskar_fft_create(prec, OSKAR_CPU, num_dim, n, batch, &status);
+        oskar_fft_set_ensure_consistent_norm(fft, norm);
+        oskar_fft_exec(fft, data, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    }
+
+    // Check the result.
+    double max_ref = 0.0, max_err = 0.0;
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        const double val = (prec == OSKAR_DOUBLE) ?
+                oskar_mem_double(data, &status)[i] :
+                oskar_mem_float(data, &status)[i];
+        const double err = fabs(val - scale * ref[i]);
+        if (fabs(scale * ref[i]) > max_ref) max_ref = fabs(scale * ref[i]);
+        if (err > max_err) max_err = err;
+    }
+    const double tol = (prec == OSKAR_DOUBLE) ? 1e-12 : 1e-5;
+    EXPECT_LT(max_err, tol * max_ref) << "num_dim " << num_dim <<
+            ", length " << n << ", precision " << prec << ", direct " <<
+            direct;
+    oskar_fft_free(fft);
+    oskar_mem_free(data, &status);
+}
+
+static const int sizes[] = {1, 2, 7, 16, 30, 49, 60, 64, 97, 100, 128, 210};
+
+TEST(fft, 1d_batch_double)
+{
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(int); ++i)
+    {
+        run_test(OSKAR_DOUBLE, 1, sizes[i], 37, 1, 0);
+        run_test(OSKAR_DOUBLE, 1, sizes[i], 37, 1, 1);
+    }
+}
+
+TEST(fft, 1d_batch_single)
+{
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(int); ++i)
+    {
+        run_test(OSKAR_SINGLE, 1, sizes[i], 37, 1, 0);
+        run_test(OSKAR_SINGLE, 1, sizes[i], 37, 1, 1);
+    }
+}
+
+TEST(fft, 2d_double)
+{
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(int); ++i)
+    {
+        run_test(OSKAR_DOUBLE, 2, sizes[i], 0, 1, 0);
+        run_test(OSKAR_DOUBLE, 2, sizes[i], 0, 1, 1);
+    }
+}
+
+TEST(fft, 2d_single)
+{
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(int); ++i)
+    {
+        run_test(OSKAR_SINGLE, 2, sizes[i], 0, 1, 0);
+        run_test(OSKAR_SINGLE, 2, sizes[i], 0, 1, 1);
+    }
+}
+
+TEST(fft, normalised)
+{
+    for (int direct = 0; direct < 2; ++direct)
+    {
+        run_test(OSKAR_DOUBLE, 1, 60, 5, 0, direct);
+        run_test(OSKAR_DOUBLE, 2, 64, 0, 0, direct);
+        run_test(OSKAR_SINGLE, 2, 49, 0, 0, direct);
+    }
+}
+
+// Runs the Hermitian FFT and checks the result against a DFT.
+static void run_test_c2r(int prec, int n)
+{
+    int status = 0;
+    const size_t num_cells = (size_t) n * n;
+    const size_t offset = 3, stride = n / 2 + 5;
+    std::vector<double> in(2 * num_cells), herm(2 * num_cells);
+    std::vector<double> tmp(2 * num_cells), ref(2 * num_cells);
+    srand(n);
+    for (size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = 2.0 * rand() / (double) RAND_MAX - 1.0;
+    }
+    for (int y = 0; y < n; ++y)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            const size_t i = 2 * ((size_t) y * n + x);
+            const size_t j = 2 * ((size_t) ((n - y) % n) * n + (n - x) % n);
+            herm[i] = 0.5 * (in[i] + in[j]);
+            herm[i + 1] = 0.5 * (in[i + 1] - in[j + 1]);
+        }
+    }
+    dft_1d(n, n, 1, n, herm, tmp);
+    dft_1d(n, n, n, 1, tmp, ref);
+
+    // Run the FFT on the first half of each row.
+    oskar_Mem* data = oskar_mem_create(prec | OSKAR_COMPLEX, OSKAR_CPU,
+            offset + n * stride, &status);
+    oskar_mem_clear_contents(data, &status);
+    for (int y = 0; y < n; ++y)
+    {
+        for (int x = 0; x <= n / 2; ++x)
+        {
+            const size_t i = 2 * ((size_t) y * n + x);
+            const size_t j = 2 * (offset + y * stride + x);
+            if (prec == OSKAR_DOUBLE)
+            {
+                oskar_mem_double(data, &status)[j] = herm[i];
+                oskar_mem_double(data, &status)[j + 1] = herm[i + 1];
+            }
+            else
+            {
+                oskar_mem_float(data, &status)[j] = (float) herm[i];
+                oskar_mem_float(data, &status)[j + 1] = (float) herm[i + 1];
+            }
+        }
+    }
+    oskar_FFT* fft = oskar_fft_create(prec, OSKAR_CPU, 2, n, 0, &status);
+    oskar_fft_exec_c2r(fft, data, offset, stride, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Check the result.
+    double max_ref = 0.0, max_err = 0.0;
+    for (int y = 0; y < n; ++y)
+    {
+        for (int x = 0; x < n; ++x)
+        {
+            const size_t j = 2 * (offset + y * stride) + x;
+            const double val = (prec == OSKAR_DOUBLE) ?
+                    oskar_mem_double(data, &status)[j] :
+                    oskar_mem_float(data, &status)[j];
+            const double r = ref[2 * ((size_t) y * n + x)];
+            if (fabs(r) > max_ref) max_ref = fabs(r);
+            if (fabs(val - r) > max_err) max_err = fabs(val - r);
+        }
+    }
+    const double tol = (prec == OSKAR_DOUBLE) ? 1e-12 : 1e-5;
+    EXPECT_LT(max_err, tol * max_ref) << "length " << n <<
+            ", precision " << prec;
+    oskar_fft_free(fft);
+    oskar_mem_free(data, &status);
+}
+
+TEST(fft, 2d_c2r)
+{
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(int); ++i)
+    {
+        if (sizes[i] % 2 != 0) continue;
+        run_test_c2r(OSKAR_DOUBLE, sizes[i]);
+        run_test_c2r(OSKAR_SINGLE, sizes[i]);
+    }
+}
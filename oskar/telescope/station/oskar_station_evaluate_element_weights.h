@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2022, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -49,6 +49,37 @@ void oskar_station_evaluate_element_weights(const oskar_Station* station,
         double z_beam, int time_index, oskar_Mem* weights,
         oskar_Mem* weights_scratch, int* status);
 
+/**
+ * @brief
+ * Evaluates element beamforming weights using precomputed element errors.
+ *
+ * @details
+ * This function is the same as oskar_station_evaluate_element_weights(),
+ * except that the time-variable gain and phase errors are supplied by
+ * the caller, if not NULL. The errors do not depend on frequency,
+ * so they can be evaluated once for all channels at each time step
+ * (see oskar_station_work_element_errors()).
+ *
+ * @param[in] station             Station model.
+ * @param[in] feed                Feed index (0 = X, 1 = Y).
+ * @param[in] frequency_hz        Observing frequency, in Hz.
+ * @param[in] x_beam              Beam direction cosine, horizontal x-component.
+ * @param[in] y_beam              Beam direction cosine, horizontal y-component.
+ * @param[in] z_beam              Beam direction cosine, horizontal z-component.
+ * @param[in] time_index          Time index of simulation.
+ * @param[in] errors              Element errors for this feed and time,
+ *                                or NULL to evaluate them here.
+ * @param[in,out] weights         Output array of beamforming weights.
+ * @param[in,out] weights_scratch Work array, for calculating the weights error.
+ * @param[in,out] status          Status return code.
+ */
+OSKAR_EXPORT
+void oskar_station_evaluate_element_weights_with_errors(
+        const oskar_Station* station, int feed, double frequency_hz,
+        double x_beam, double y_beam, double z_beam, int time_index,
+        const oskar_Mem* errors, oskar_Mem* weights,
+        oskar_Mem* weights_scratch, int* status);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2021, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -23,6 +23,18 @@ struct oskar_StationWork;
 typedef struct oskar_StationWork oskar_StationWork;
 #endif /* OSKAR_STATION_WORK_TYPEDEF_ */
 
+struct oskar_Element;
+#ifndef OSKAR_ELEMENT_TYPEDEF_
+#define OSKAR_ELEMENT_TYPEDEF_
+typedef struct oskar_Element oskar_Element;
+#endif /* OSKAR_ELEMENT_TYPEDEF_ */
+
+struct oskar_Station;
+#ifndef OSKAR_STATION_TYPEDEF_
+#define OSKAR_STATION_TYPEDEF_
+typedef struct oskar_Station oskar_Station;
+#endif /* OSKAR_STATION_TYPEDEF_ */
+
 /**
  * @brief Creates a station work buffer structure.
  *
@@ -95,6 +107,99 @@ OSKAR_EXPORT
 oskar_Mem* oskar_station_work_beam(oskar_StationWork* work,
         const oskar_Mem* output_beam, size_t length, int depth, int* status);
 
+/**
+ * @brief Sets the directions used for cached element patterns.
+ *
+ * @details
+ * Sets the direction cosines at which subsequent calls to
+ * oskar_station_work_element_evaluate() will evaluate element patterns,
+ * so that patterns already evaluated for the same directions can be
+ * reused. This is the case, for example, for beam patterns in a frame
+ * fixed to the station, which are evaluated at every time step.
+ *
+ * The directions are compared using a hash of their values.
+ * Patterns are stored only for direction sets that were also used in a
+ * recent call for a different time index, so time-varying directions
+ * (or the channels of a single time step) do not fill the cache.
+ *
+ * Caching is used only for direction cosines in CPU memory.
+ *
+ * @param[in,out] work          Station work buffer structure.
+ * @param[in]     offset_points Start offset into input coordinate arrays.
+ * @param[in]     num_points    Number of direction cosines.
+ * @param[in]     x             Direction cosines in x.
+ * @param[in]     y             Direction cosines in y.
+ * @param[in]     z             Direction cosines in z.
+ * @param[in]     time_index    Simulation time index.
+ */
+OSKAR_EXPORT
+void oskar_station_work_element_cache_set_directions(oskar_StationWork* work,
+        int offset_points, int num_points, const oskar_Mem* x,
+        const oskar_Mem* y, const oskar_Mem* z, int time_index);
+
+/**
+ * @brief Evaluates an element pattern, using cached values if possible.
+ *
+ * @details
+ * Gives the same result as oskar_element_evaluate(), but reuses the element
+ * pattern from the cache if it has already been evaluated with the same
+ * parameters at the directions last given to
+ * oskar_station_work_element_cache_set_directions().
+ *
+ * The last direction is always evaluated, as it may be the normalisation
+ * direction of the station beam, which changes as the beam tracks a source.
+ *
+ * Parameters are as for oskar_element_evaluate().
+ */
+OSKAR_EXPORT
+void oskar_station_work_element_evaluate(oskar_StationWork* work,
+        const oskar_Element* model, int normalise, int swap_xy,
+        double orientation_x, double orientation_y,
+        double virtual_antenna_angle, int offset_points, int num_points,
+        const oskar_Mem* x, const oskar_Mem* y, const oskar_Mem* z,
+        double frequency_hz, oskar_Mem* theta, oskar_Mem* phi_x,
+        oskar_Mem* phi_y, int offset_out, oskar_Mem* output, int* status);
+
+/**
+ * @brief Returns the number of element patterns found in the cache.
+ *
+ * @param[in] work  Station work buffer structure.
+ */
+OSKAR_EXPORT
+size_t oskar_station_work_element_cache_hits(const oskar_StationWork* work);
+
+/**
+ * @brief Returns the number of element patterns looked up in the cache.
+ *
+ * @param[in] work  Station work buffer structure.
+ */
+OSKAR_EXPORT
+size_t oskar_station_work_element_cache_lookups(
+        const oskar_StationWork* work);
+
+/**
+ * @brief Returns the time-variable element errors for a station.
+ *
+ * @details
+ * Returns the time-variable gain and phase errors of the elements in
+ * a station for the given feed and time index, for use with
+ * oskar_station_evaluate_element_weights_with_errors().
+ *
+ * The errors do not depend on frequency, so they are kept for each station
+ * and feed, and are evaluated again only when the time index changes.
+ * The station model must not be modified while its errors are held.
+ * Returns NULL if the station does not apply element errors.
+ *
+ * @param[in,out] work       Station work buffer structure.
+ * @param[in]     station    Station model.
+ * @param[in]     feed       Feed index (0 = X, 1 = Y).
+ * @param[in]     time_index Simulation time index.
+ * @param[in,out] status     Status return code.
+ */
+OSKAR_EXPORT
+const oskar_Mem* oskar_station_work_element_errors(oskar_StationWork* work,
+        const oskar_Station* station, int feed, int time_index, int* status);
+
 #ifdef __cplusplus
 }
 #endif
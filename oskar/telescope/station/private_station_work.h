@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2022, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -8,6 +8,37 @@
 
 #include <mem/oskar_mem.h>
 
+/* Maximum number of element patterns held in the cache. */
+#define OSKAR_ELEMENT_CACHE_SIZE 64
+
+/* Number of recent direction sets remembered by the cache. */
+#define OSKAR_ELEMENT_CACHE_HISTORY 4
+
+/* Element pattern evaluated for a set of directions. */
+struct oskar_ElementCacheEntry
+{
+    const void* element;         /* Element model (NULL if entry unused). */
+    int normalise, swap_xy, num_points;
+    double orientation_x, orientation_y, virtual_angle, frequency_hz;
+    unsigned long long dir_hash; /* Hash of the direction cosines. */
+    unsigned long long last_used;
+    oskar_Mem* pattern;
+};
+typedef struct oskar_ElementCacheEntry oskar_ElementCacheEntry;
+
+/* Maximum number of station feeds for which element errors are held. */
+#define OSKAR_ELEMENT_ERRORS_CACHE_SIZE 16
+
+/* Time-variable element errors for one station feed at one time. */
+struct oskar_ElementErrorsEntry
+{
+    const void* station;         /* Station model (NULL if entry unused). */
+    int feed, time_index;
+    unsigned long long last_used;
+    oskar_Mem* errors;           /* Complex scalar. */
+};
+typedef struct oskar_ElementErrorsEntry oskar_ElementErrorsEntry;
+
 struct oskar_StationWork
 {
     oskar_Mem* weights;          /* Complex scalar. */
@@ -33,12 +64,26 @@ struct oskar_StationWork
     double screen_time_interval_sec;
     oskar_Mem *tec_screen_path, *tec_screen;
     oskar_Mem *screen_output;
+    oskar_Mem* screen_lmn[3];    /* Directions relative to screen centre. */
 
     int num_depths;
     oskar_Mem** beam;            /* For hierarchical stations. */
 
     /* HARP data. */
     oskar_Mem *poly, *ee, *qq, *dd, *phase_fac, *beam_coeffs, *pth, *pph;
+
+    /* Element pattern cache. */
+    int element_cache_store; /* If set, store patterns for these directions. */
+    unsigned long long element_cache_dir_hash; /* 0 if cache not used. */
+    unsigned long long element_cache_history[OSKAR_ELEMENT_CACHE_HISTORY];
+    int element_cache_history_time[OSKAR_ELEMENT_CACHE_HISTORY];
+    unsigned long long element_cache_counter;
+    size_t element_cache_hits, element_cache_lookups;
+    oskar_ElementCacheEntry element_cache[OSKAR_ELEMENT_CACHE_SIZE];
+
+    /* Element errors, for each channel of a time step. */
+    unsigned long long element_errors_counter;
+    oskar_ElementErrorsEntry element_errors[OSKAR_ELEMENT_ERRORS_CACHE_SIZE];
 };
 
 #ifndef OSKAR_STATION_WORK_TYPEDEF_
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2024, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -11,6 +11,7 @@
 #include "telescope/station/element/oskar_element_evaluate.h"
 #include "telescope/station/element/oskar_rotate_virtual_antenna.h"
 #include "telescope/station/oskar_blank_below_horizon.h"
+#include "telescope/station/oskar_station_work.h"
 #include "telescope/station/private_station_work.h"
 
 #include "math/oskar_cmath.h"
@@ -48,6 +49,8 @@ void oskar_evaluate_station_beam_aperture_array(
     /* Evaluate beam directly if there are no child stations. */
     if (!oskar_station_has_child(station))
     {
+        oskar_station_work_element_cache_set_directions(work,
+                0, num_points, x, y, z, time_index);
         oskar_evaluate_station_beam_aperture_array_private(station, work,
                 0, num_points, x, y, z, time_index,
                 gast_rad, frequency_hz, 0, 0, beam, status);
@@ -62,6 +65,8 @@ void oskar_evaluate_station_beam_aperture_array(
             if (chunk_size > MAX_CHUNK_SIZE) chunk_size = MAX_CHUNK_SIZE;
 
             /* Start recursive call at depth 1 (depth 0 is element level). */
+            oskar_station_work_element_cache_set_directions(work,
+                    start, chunk_size, x, y, z, time_index);
             oskar_evaluate_station_beam_aperture_array_private(station, work,
                     start, chunk_size, x, y, z, time_index,
                     gast_rad, frequency_hz, 1, start, beam, status);
@@ -130,8 +135,10 @@ static void oskar_evaluate_station_beam_aperture_array_private(
                 theta, phi_x, phi_y, status);
         for (i = 0; i < 2; ++i)
         {
-            oskar_station_evaluate_element_weights(s, i, frequency_hz,
-                    beam_x, beam_y, beam_z, time_index,
+            oskar_station_evaluate_element_weights_with_errors(s, i,
+                    frequency_hz, beam_x, beam_y, beam_z, time_index,
+                    oskar_station_work_element_errors(work, s, i, time_index,
+                            status),
                     work->weights, work->weights_scratch, status);
             oskar_harp_evaluate_station_beam(
                     harp_data,
@@ -172,13 +179,14 @@ static void oskar_evaluate_station_beam_aperture_array_private(
         const int num_element_types = oskar_station_num_element_types(s);
         if (oskar_station_common_element_orientation(s))
         {
-            /* Evaluate element patterns for each element type. */
+            /* Evaluate element patterns for each element type.
+             * These are reused if the directions have not changed. */
             element_types_ptr = oskar_station_element_types_const(s);
             signal = oskar_station_work_beam(work, beam,
                     num_element_types * (num_points + 1), 0, status);
             for (i = 0; i < num_element_types; ++i)
             {
-                oskar_element_evaluate(
+                oskar_station_work_element_evaluate(work,
                         oskar_station_element_const(s, i),
                         norm_element, swap_xy,
                         oskar_station_element_euler_index_rad(s, 0, 0, 0) + M_PI/2.0, /* FIXME Will change: This matches the old convention. */
@@ -217,8 +225,10 @@ static void oskar_evaluate_station_beam_aperture_array_private(
             {
                 const int eval_x = (i == 0 || num_feeds == 1) ? 1 : 0;
                 const int eval_y = (i == 1 || num_feeds == 1) ? 1 : 0;
-                oskar_station_evaluate_element_weights(s, i, frequency_hz,
-                        beam_x, beam_y, beam_z, time_index,
+                oskar_station_evaluate_element_weights_with_errors(s, i,
+                        frequency_hz, beam_x, beam_y, beam_z, time_index,
+                        oskar_station_work_element_errors(work, s, i, time_index,
+                                status),
                         work->weights, work->weights_scratch, status);
                 oskar_dftw(norm_array, num_elements, wavenumber, work->weights,
                         oskar_station_element_true_enu_metres_const(s, i, 0),
@@ -281,8 +291,10 @@ static void oskar_evaluate_station_beam_aperture_array_private(
         {
             const int eval_x = (i == 0 || num_feeds == 1) ? 1 : 0;
             const int eval_y = (i == 1 || num_feeds == 1) ? 1 : 0;
-            oskar_station_evaluate_element_weights(s, i, frequency_hz,
-                    beam_x, beam_y, beam_z, time_index,
+            oskar_station_evaluate_element_weights_with_errors(s, i,
+                    frequency_hz, beam_x, beam_y, beam_z, time_index,
+                    oskar_station_work_element_errors(work, s, i, time_index,
+                            status),
                     work->weights, work->weights_scratch, status);
             oskar_dftw(norm_array, num_elements, wavenumber, work->weights,
                     oskar_station_element_true_enu_metres_const(s, i, 0),
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2024, The OSKAR Developers.
+ * Copyright (c) 2013-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -50,8 +50,35 @@ void oskar_station_beam(
         oskar_Mem* beam,
         int* status)
 {
-    int i = 0;
+    oskar_station_beam_channels(station, work, source_coord_type,
+            num_points, source_coords, ref_lon_rad, ref_lat_rad,
+            norm_coord_type, norm_lon_rad, norm_lat_rad, time_index,
+            gast_rad, 1, &frequency_hz, offset_out, &beam, status);
+}
+
+void oskar_station_beam_channels(
+        oskar_Station* station,
+        oskar_StationWork* work,
+        int source_coord_type,
+        int num_points,
+        const oskar_Mem* const source_coords[3],
+        double ref_lon_rad,
+        double ref_lat_rad,
+        int norm_coord_type,
+        double norm_lon_rad,
+        double norm_lat_rad,
+        int time_index,
+        double gast_rad,
+        int num_channels,
+        const double* frequency_hz,
+        int offset_out,
+        oskar_Mem* const* beam,
+        int* status)
+{
+    int i = 0, c = 0;
+    double screen_u = 0.0, screen_v = 0.0;
     oskar_Mem *out = 0, *enu[3], *lmn[3];
+    const oskar_Mem *screen_l = 0, *screen_m = 0;
     const size_t num_points_orig = (size_t)num_points;
     if (*status) return;
 
@@ -82,8 +109,11 @@ void oskar_station_beam(
     /* Log warning and return zeros if beam direction is below the horizon. */
     if (beam_el_rad < 0.)
     {
-        oskar_mem_set_value_real(beam, 0.0,
-                (size_t)offset_out, (size_t)num_points, status);
+        for (c = 0; c < num_channels; ++c)
+        {
+            oskar_mem_set_value_real(beam[c], 0.0,
+                    (size_t)offset_out, (size_t)num_points, status);
+        }
         oskar_log_warning(0,
                 "Beam below horizon at time index %d", time_index);
         return;
@@ -130,59 +160,20 @@ void oskar_station_beam(
         num_points++;
     }
 
-    /* Set output beam array to work buffer. */
-    out = oskar_station_work_beam_out(work, beam, num_points_orig, status);
-
-    /* Evaluate station beam based on station type. */
-    if (station_type == OSKAR_STATION_TYPE_ISOTROPIC)
+    /* Convert source ENU coordinates to local tangent plane,
+     * relative to station beam direction, for analytic beams. */
+    if (station_type != OSKAR_STATION_TYPE_ISOTROPIC &&
+            station_type != OSKAR_STATION_TYPE_AA)
     {
-        oskar_mem_set_value_real(out, 1.0, 0, num_points, status);
-    }
-    else if (station_type == OSKAR_STATION_TYPE_AA)
-    {
-        oskar_evaluate_station_beam_aperture_array(station, work,
-                num_points, enu[0], enu[1], enu[2],
-                time_index, gast_rad, frequency_hz, out, status);
-    }
-    else
-    {
-        /* Convert source ENU coordinates to local tangent plane,
-         * relative to station beam direction. */
         oskar_convert_enu_directions_to_local_tangent_plane(num_points,
                 enu[0], enu[1], enu[2], beam_az_rad, beam_el_rad,
                 lmn[0], lmn[1], status);
-
-        /* Evaluate beam on local tangent plane. */
-        switch (station_type)
-        {
-        case OSKAR_STATION_TYPE_GAUSSIAN_BEAM:
-            oskar_station_beam_gaussian(station, num_points,
-                    lmn[0], lmn[1], frequency_hz, out, status);
-            break;
-        case OSKAR_STATION_TYPE_VLA_PBCOR:
-            oskar_evaluate_vla_beam_pbcor(num_points,
-                    lmn[0], lmn[1], frequency_hz, out, status);
-            break;
-        default:
-            *status = OSKAR_ERR_SETTINGS_TELESCOPE;
-            break;
-        }
-        oskar_blank_below_horizon(0, num_points, enu[2], 0, out, status);
     }
 
-    /* Scale beam by amplitude of the last source if required. */
-    if (normalise)
-    {
-        oskar_mem_normalise(out, 0, oskar_mem_length(out),
-                num_points - 1, status);
-    }
-
-    /* Apply ionospheric screen. */
+    /* Get the station (u,v) coordinates and source directions
+     * for the ionospheric screen. */
     if (work->screen_type != 'N')
     {
-        const oskar_Mem* tec_phase = 0;
-
-        /* Evaluate the station (u,v) coordinates. */
         if (norm_coord_type == OSKAR_COORDS_RADEC)
         {
             const double lha0_rad = lst_rad - norm_lon_rad;
@@ -194,19 +185,21 @@ void oskar_station_beam(
             const double x_ = oskar_station_offset_ecef_x(station);
             const double y_ = oskar_station_offset_ecef_y(station);
             const double z_ = oskar_station_offset_ecef_z(station);
-            const double u = x_ * sin_ha0 + y_ * cos_ha0;
-            const double v = z_ * cos_dec0 - x_ * cos_ha0 * sin_dec0 + y_ * sin_ha0 * sin_dec0;
+            screen_u = x_ * sin_ha0 + y_ * cos_ha0;
+            screen_v = z_ * cos_dec0 - x_ * cos_ha0 * sin_dec0 + y_ * sin_ha0 * sin_dec0;
 
             /* Calculate directions relative to normalisation point. */
+            for (i = 0; i < 3; ++i)
+            {
+                oskar_mem_ensure(work->screen_lmn[i],
+                        (size_t) num_points, status);
+            }
             oskar_convert_enu_directions_to_relative_directions(
                     0, num_points, enu[0], enu[1], enu[2],
-                    lha0_rad, norm_lat_rad, lat_rad,
-                    0, lmn[0], lmn[1], lmn[2], status);
-
-            /* Evaluate the phase due to the TEC screen. */
-            tec_phase = oskar_station_work_evaluate_tec_screen(work,
-                    (int) num_points_orig, lmn[0], lmn[1], u, v,
-                    time_index, frequency_hz, status);
+                    lha0_rad, norm_lat_rad, lat_rad, 0, work->screen_lmn[0],
+                    work->screen_lmn[1], work->screen_lmn[2], status);
+            screen_l = work->screen_lmn[0];
+            screen_m = work->screen_lmn[1];
         }
         else if (norm_coord_type == OSKAR_COORDS_AZEL)
         {
@@ -219,24 +212,79 @@ void oskar_station_beam(
             const double x_ = oskar_station_offset_ecef_x(station);
             const double y_ = oskar_station_offset_ecef_y(station);
             const double z_ = oskar_station_offset_ecef_z(station);
-            const double u = x_ * sin_ha0 + y_ * cos_ha0;
-            const double v = z_ * cos_dec0 - x_ * cos_ha0 * sin_dec0 + y_ * sin_ha0 * sin_dec0;
+            screen_u = x_ * sin_ha0 + y_ * cos_ha0;
+            screen_v = z_ * cos_dec0 - x_ * cos_ha0 * sin_dec0 + y_ * sin_ha0 * sin_dec0;
+            screen_l = enu[0];
+            screen_m = enu[1];
+        }
+    }
 
-            /* Evaluate the phase due to the TEC screen. */
-            tec_phase = oskar_station_work_evaluate_tec_screen(work,
-                    (int) num_points_orig, enu[0], enu[1], u, v,
-                    time_index, frequency_hz, status);
+    /* Evaluate the frequency-dependent part of the beam for each channel,
+     * using the directions found above. */
+    for (c = 0; c < num_channels; ++c)
+    {
+        if (*status) break;
+
+        /* Set output beam array to work buffer. */
+        out = oskar_station_work_beam_out(work, beam[c],
+                num_points_orig, status);
+
+        /* Evaluate station beam based on station type. */
+        if (station_type == OSKAR_STATION_TYPE_ISOTROPIC)
+        {
+            oskar_mem_set_value_real(out, 1.0, 0, num_points, status);
+        }
+        else if (station_type == OSKAR_STATION_TYPE_AA)
+        {
+            oskar_evaluate_station_beam_aperture_array(station, work,
+                    num_points, enu[0], enu[1], enu[2],
+                    time_index, gast_rad, frequency_hz[c], out, status);
+        }
+        else
+        {
+            /* Evaluate beam on local tangent plane. */
+            switch (station_type)
+            {
+            case OSKAR_STATION_TYPE_GAUSSIAN_BEAM:
+                oskar_station_beam_gaussian(station, num_points,
+                        lmn[0], lmn[1], frequency_hz[c], out, status);
+                break;
+            case OSKAR_STATION_TYPE_VLA_PBCOR:
+                oskar_evaluate_vla_beam_pbcor(num_points,
+                        lmn[0], lmn[1], frequency_hz[c], out, status);
+                break;
+            default:
+                *status = OSKAR_ERR_SETTINGS_TELESCOPE;
+                break;
+            }
+            oskar_blank_below_horizon(0, num_points, enu[2], 0, out, status);
         }
 
-        if (tec_phase)
+        /* Scale beam by amplitude of the last source if required. */
+        if (normalise)
         {
-            oskar_mem_multiply(out, tec_phase, out,
-                    0, 0, 0, num_points_orig, status);
+            oskar_mem_normalise(out, 0, oskar_mem_length(out),
+                    num_points - 1, status);
+        }
+
+        /* Apply ionospheric screen. */
+        if (screen_l)
+        {
+            /* Evaluate the phase due to the TEC screen. */
+            const oskar_Mem* tec_phase = oskar_station_work_evaluate_tec_screen(
+                    work, (int) num_points_orig, screen_l, screen_m,
+                    screen_u, screen_v, time_index, frequency_hz[c], status);
+            if (tec_phase)
+            {
+                oskar_mem_multiply(out, tec_phase, out,
+                        0, 0, 0, num_points_orig, status);
+            }
         }
-    }
 
-    /* Copy output beam data. */
-    oskar_mem_copy_contents(beam, out, offset_out, 0, num_points_orig, status);
+        /* Copy output beam data. */
+        oskar_mem_copy_contents(beam[c], out,
+                offset_out, 0, num_points_orig, status);
+    }
 }
 
 void oskar_station_beam_gaussian(
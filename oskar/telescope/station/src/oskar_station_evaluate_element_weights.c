@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2012-2022, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -16,6 +16,17 @@ void oskar_station_evaluate_element_weights(const oskar_Station* station,
         int feed, double frequency_hz, double x_beam, double y_beam,
         double z_beam, int time_index, oskar_Mem* weights,
         oskar_Mem* weights_scratch, int* status)
+{
+    oskar_station_evaluate_element_weights_with_errors(station, feed,
+            frequency_hz, x_beam, y_beam, z_beam, time_index, 0,
+            weights, weights_scratch, status);
+}
+
+void oskar_station_evaluate_element_weights_with_errors(
+        const oskar_Station* station, int feed, double frequency_hz,
+        double x_beam, double y_beam, double z_beam, int time_index,
+        const oskar_Mem* errors, oskar_Mem* weights,
+        oskar_Mem* weights_scratch, int* status)
 {
     if (*status) return;
     const int num_elements = oskar_station_num_elements(station);
@@ -33,15 +44,20 @@ void oskar_station_evaluate_element_weights(const oskar_Station* station,
     /* Apply time-variable errors. */
     if (oskar_station_apply_element_errors(station))
     {
-        oskar_mem_ensure(weights_scratch, num_elements, status);
-        oskar_evaluate_element_weights_errors(num_elements,
-                oskar_station_element_gain_const(station, feed),
-                oskar_station_element_gain_error_const(station, feed),
-                oskar_station_element_phase_offset_rad_const(station, feed),
-                oskar_station_element_phase_error_rad_const(station, feed),
-                oskar_station_seed_time_variable_errors(station), time_index,
-                oskar_station_unique_id(station), weights_scratch, status);
-        oskar_mem_multiply(weights, weights, weights_scratch,
+        if (!errors)
+        {
+            oskar_mem_ensure(weights_scratch, num_elements, status);
+            oskar_evaluate_element_weights_errors(num_elements,
+                    oskar_station_element_gain_const(station, feed),
+                    oskar_station_element_gain_error_const(station, feed),
+                    oskar_station_element_phase_offset_rad_const(station, feed),
+                    oskar_station_element_phase_error_rad_const(station, feed),
+                    oskar_station_seed_time_variable_errors(station),
+                    time_index, oskar_station_unique_id(station),
+                    weights_scratch, status);
+            errors = weights_scratch;
+        }
+        oskar_mem_multiply(weights, weights, errors,
                 0, 0, 0, num_elements, status);
     }
 
@@ -1,11 +1,14 @@
 /*
- * Copyright (c) 2012-2022, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include "telescope/station/oskar_station_work.h"
 #include "telescope/station/private_station_work.h"
 #include "telescope/station/oskar_evaluate_tec_screen.h"
+#include "telescope/station/oskar_evaluate_element_weights_errors.h"
+#include "telescope/station/oskar_station.h"
+#include "telescope/station/element/oskar_element_evaluate.h"
 
 #include <string.h>
 
@@ -40,6 +43,7 @@ oskar_StationWork* oskar_station_work_create(int type,
     {
         work->enu[i] = oskar_mem_create(type, location, 0, status);
         work->lmn[i] = oskar_mem_create(type, location, 0, status);
+        work->screen_lmn[i] = oskar_mem_create(type, location, 0, status);
         work->temp_dir_in[i] = oskar_mem_create(type, OSKAR_CPU, 1, status);
         work->temp_dir_out[i] = oskar_mem_create(type, OSKAR_CPU, 1, status);
     }
@@ -80,6 +84,7 @@ void oskar_station_work_free(oskar_StationWork* work, int* status)
     {
         oskar_mem_free(work->enu[i], status);
         oskar_mem_free(work->lmn[i], status);
+        oskar_mem_free(work->screen_lmn[i], status);
         oskar_mem_free(work->temp_dir_in[i], status);
         oskar_mem_free(work->temp_dir_out[i], status);
     }
@@ -95,6 +100,14 @@ void oskar_station_work_free(oskar_StationWork* work, int* status)
     oskar_mem_free(work->beam_coeffs, status);
     oskar_mem_free(work->pth, status);
     oskar_mem_free(work->pph, status);
+    for (i = 0; i < OSKAR_ELEMENT_CACHE_SIZE; ++i)
+    {
+        oskar_mem_free(work->element_cache[i].pattern, status);
+    }
+    for (i = 0; i < OSKAR_ELEMENT_ERRORS_CACHE_SIZE; ++i)
+    {
+        oskar_mem_free(work->element_errors[i].errors, status);
+    }
     free(work);
 }
 
@@ -228,6 +241,205 @@ oskar_Mem* oskar_station_work_beam(oskar_StationWork* work,
     return work->beam[depth];
 }
 
+/* Hashes the 32-bit words of part of an array. */
+static unsigned long long hash_mem(unsigned long long hash,
+        const oskar_Mem* mem, int offset, int num_points)
+{
+    size_t i = 0;
+    const size_t element_size = oskar_mem_element_size(oskar_mem_type(mem));
+    const size_t num_words = num_points * element_size / 4;
+    const unsigned int* words = (const unsigned int*) (
+            (const char*) oskar_mem_void_const(mem) + offset * element_size);
+    for (i = 0; i < num_words; ++i)
+    {
+        hash = (hash ^ words[i]) * 0x100000001b3ull; /* FNV-1a prime. */
+    }
+    return hash;
+}
+
+void oskar_station_work_element_cache_set_directions(oskar_StationWork* work,
+        int offset_points, int num_points, const oskar_Mem* x,
+        const oskar_Mem* y, const oskar_Mem* z, int time_index)
+{
+    int i = 0;
+    unsigned long long hash = 0xcbf29ce484222325ull; /* FNV-1a basis. */
+    work->element_cache_dir_hash = 0;
+    work->element_cache_store = 0;
+    if (num_points < 2 || oskar_mem_location(x) != OSKAR_CPU ||
+            oskar_mem_location(y) != OSKAR_CPU ||
+            oskar_mem_location(z) != OSKAR_CPU)
+    {
+        return;
+    }
+
+    /* Hash all except the last direction, which is always evaluated. */
+    hash = (hash ^ (unsigned long long) num_points) * 0x100000001b3ull;
+    hash = (hash ^ (unsigned long long) oskar_mem_type(x)) * 0x100000001b3ull;
+    hash = hash_mem(hash, x, offset_points, num_points - 1);
+    hash = hash_mem(hash, y, offset_points, num_points - 1);
+    hash = hash_mem(hash, z, offset_points, num_points - 1);
+    if (hash == 0) hash = 1;
+    work->element_cache_dir_hash = hash;
+
+    /* Store patterns only if these directions were used recently
+     * at a different time. */
+    for (i = 0; i < OSKAR_ELEMENT_CACHE_HISTORY; ++i)
+    {
+        if (work->element_cache_history[i] == hash)
+        {
+            if (work->element_cache_history_time[i] != time_index)
+            {
+                work->element_cache_store = 1;
+            }
+            return;
+        }
+    }
+    for (i = OSKAR_ELEMENT_CACHE_HISTORY - 1; i > 0; --i)
+    {
+        work->element_cache_history[i] = work->element_cache_history[i - 1];
+        work->element_cache_history_time[i] =
+                work->element_cache_history_time[i - 1];
+    }
+    work->element_cache_history[0] = hash;
+    work->element_cache_history_time[0] = time_index;
+}
+
+void oskar_station_work_element_evaluate(oskar_StationWork* work,
+        const oskar_Element* model, int normalise, int swap_xy,
+        double orientation_x, double orientation_y,
+        double virtual_antenna_angle, int offset_points, int num_points,
+        const oskar_Mem* x, const oskar_Mem* y, const oskar_Mem* z,
+        double frequency_hz, oskar_Mem* theta, oskar_Mem* phi_x,
+        oskar_Mem* phi_y, int offset_out, oskar_Mem* output, int* status)
+{
+    int i = 0;
+    oskar_ElementCacheEntry* entry = 0;
+    const int num_cached = num_points - 1;
+    const unsigned long long hash = work->element_cache_dir_hash;
+    if (*status) return;
+
+    /* Find the pattern in the cache, and the entry to replace if not. */
+    if (hash)
+    {
+        work->element_cache_lookups++;
+        for (i = 0; i < OSKAR_ELEMENT_CACHE_SIZE; ++i)
+        {
+            oskar_ElementCacheEntry* t = &work->element_cache[i];
+            if (t->element == model && t->dir_hash == hash &&
+                    t->num_points == num_cached &&
+                    t->frequency_hz == frequency_hz &&
+                    t->normalise == normalise && t->swap_xy == swap_xy &&
+                    t->orientation_x == orientation_x &&
+                    t->orientation_y == orientation_y &&
+                    t->virtual_angle == virtual_antenna_angle &&
+                    oskar_mem_type(t->pattern) == oskar_mem_type(output) &&
+                    oskar_mem_location(t->pattern) ==
+                            oskar_mem_location(output))
+            {
+                /* Copy the cached pattern, and evaluate the last point. */
+                t->last_used = ++work->element_cache_counter;
+                work->element_cache_hits++;
+                oskar_mem_ensure(output, offset_out + num_points, status);
+                oskar_mem_copy_contents(output, t->pattern,
+                        offset_out, 0, num_cached, status);
+                oskar_element_evaluate(model, normalise, swap_xy,
+                        orientation_x, orientation_y, virtual_antenna_angle,
+                        offset_points + num_cached, 1, x, y, z, frequency_hz,
+                        theta, phi_x, phi_y, offset_out + num_cached,
+                        output, status);
+                return;
+            }
+            if (!entry || t->last_used < entry->last_used) entry = t;
+        }
+    }
+
+    /* Evaluate the pattern. */
+    oskar_element_evaluate(model, normalise, swap_xy,
+            orientation_x, orientation_y, virtual_antenna_angle,
+            offset_points, num_points, x, y, z, frequency_hz,
+            theta, phi_x, phi_y, offset_out, output, status);
+
+    /* Store it in the least recently used entry, if required. */
+    if (hash && work->element_cache_store && !*status)
+    {
+        if (entry->pattern && (
+                oskar_mem_type(entry->pattern) != oskar_mem_type(output) ||
+                oskar_mem_location(entry->pattern) !=
+                        oskar_mem_location(output)))
+        {
+            oskar_mem_free(entry->pattern, status);
+            entry->pattern = 0;
+        }
+        if (!entry->pattern)
+        {
+            entry->pattern = oskar_mem_create(oskar_mem_type(output),
+                    oskar_mem_location(output), 0, status);
+        }
+        oskar_mem_ensure(entry->pattern, num_cached, status);
+        oskar_mem_copy_contents(entry->pattern, output,
+                0, offset_out, num_cached, status);
+        entry->element = model;
+        entry->normalise = normalise;
+        entry->swap_xy = swap_xy;
+        entry->num_points = num_cached;
+        entry->orientation_x = orientation_x;
+        entry->orientation_y = orientation_y;
+        entry->virtual_angle = virtual_antenna_angle;
+        entry->frequency_hz = frequency_hz;
+        entry->dir_hash = hash;
+        entry->last_used = ++work->element_cache_counter;
+    }
+}
+
+size_t oskar_station_work_element_cache_hits(const oskar_StationWork* work)
+{
+    return work->element_cache_hits;
+}
+
+size_t oskar_station_work_element_cache_lookups(
+        const oskar_StationWork* work)
+{
+    return work->element_cache_lookups;
+}
+
+const oskar_Mem* oskar_station_work_element_errors(oskar_StationWork* work,
+        const oskar_Station* station, int feed, int time_index, int* status)
+{
+    int i = 0;
+    oskar_ElementErrorsEntry* entry = 0;
+    if (*status || !oskar_station_apply_element_errors(station)) return 0;
+
+    /* Find the errors, or the least recently used entry to replace. */
+    for (i = 0; i < OSKAR_ELEMENT_ERRORS_CACHE_SIZE; ++i)
+    {
+        oskar_ElementErrorsEntry* t = &work->element_errors[i];
+        if (t->station == station && t->feed == feed &&
+                t->time_index == time_index)
+        {
+            t->last_used = ++work->element_errors_counter;
+            return t->errors;
+        }
+        if (!entry || t->last_used < entry->last_used) entry = t;
+    }
+
+    /* Evaluate the errors. */
+    const int num_elements = oskar_station_num_elements(station);
+    get_mem_from_template(&entry->errors, work->weights,
+            (size_t) num_elements, status);
+    oskar_evaluate_element_weights_errors(num_elements,
+            oskar_station_element_gain_const(station, feed),
+            oskar_station_element_gain_error_const(station, feed),
+            oskar_station_element_phase_offset_rad_const(station, feed),
+            oskar_station_element_phase_error_rad_const(station, feed),
+            oskar_station_seed_time_variable_errors(station), time_index,
+            oskar_station_unique_id(station), entry->errors, status);
+    entry->station = *status ? 0 : station;
+    entry->feed = feed;
+    entry->time_index = time_index;
+    entry->last_used = ++work->element_errors_counter;
+    return entry->errors;
+}
+
 static void get_mem_from_template(oskar_Mem** b, const oskar_Mem* a,
         size_t length, int* status)
 {
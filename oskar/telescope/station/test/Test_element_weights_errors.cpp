@@ -1,16 +1,20 @@
 /*
- * Copyright (c) 2012-2021, The OSKAR Developers.
+ * Copyright (c) 2012-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
 #include <gtest/gtest.h>
 
 #include "telescope/station/oskar_evaluate_element_weights_errors.h"
+#include "telescope/station/oskar_station.h"
+#include "telescope/station/oskar_station_work.h"
+#include "telescope/station/private_station_work.h"
 #include "utility/oskar_get_error_string.h"
 #include "mem/oskar_mem.h"
 
 #include <cstdio>
 #include <cstdlib>
+#include <vector>
 #include "math/oskar_cmath.h"
 
 #ifdef OSKAR_HAVE_CUDA
@@ -238,3 +242,97 @@ TEST(element_weights_errors, test_reinit)
     oskar_mem_free(d_phase_error, &status);
     oskar_mem_free(d_errors, &status);
 }
+
+
+// Evaluates the element errors for feed 0 of a station without the cache.
+static oskar_Mem* uncached_errors(const oskar_Station* station,
+        int time_index, int* status)
+{
+    const int num_elements = oskar_station_num_elements(station);
+    oskar_Mem* errors = oskar_mem_create(OSKAR_DOUBLE_COMPLEX, OSKAR_CPU,
+            num_elements, status);
+    oskar_evaluate_element_weights_errors(num_elements,
+            oskar_station_element_gain_const(station, 0),
+            oskar_station_element_gain_error_const(station, 0),
+            oskar_station_element_phase_offset_rad_const(station, 0),
+            oskar_station_element_phase_error_rad_const(station, 0),
+            oskar_station_seed_time_variable_errors(station), time_index,
+            oskar_station_unique_id(station), errors, status);
+    return errors;
+}
+
+// Checks that cached element errors match the uncached values, that a
+// repeated request is a hit, and that the least recently used entry is
+// replaced when there are more stations than cache entries.
+TEST(element_weights_errors, test_cache)
+{
+    int status = 0, counter = 0, finished = 0;
+    const int num_elements = 32;
+    const int num_stations = OSKAR_ELEMENT_ERRORS_CACHE_SIZE + 4;
+    std::vector<oskar_Station*> stations(num_stations);
+    std::vector<const oskar_Mem*> ptr(num_stations);
+    oskar_StationWork* work = oskar_station_work_create(OSKAR_DOUBLE,
+            OSKAR_CPU, &status);
+    for (int i = 0; i < num_stations; ++i)
+    {
+        stations[i] = oskar_station_create(OSKAR_DOUBLE, OSKAR_CPU,
+                num_elements, &status);
+        for (int e = 0; e < num_elements; ++e)
+        {
+            oskar_station_set_element_errors(stations[i], 0, e,
+                    1.0, 0.1, 0.0, 5.0, &status);
+        }
+        oskar_station_set_unique_ids(stations[i], &counter);
+        oskar_station_analyse(stations[i], &finished, &status);
+        ASSERT_TRUE(oskar_station_apply_element_errors(stations[i]));
+    }
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Fill the cache, and then replace the oldest entries.
+    for (int i = 0; i < num_stations; ++i)
+    {
+        ptr[i] = oskar_station_work_element_errors(work,
+                stations[i], 0, 0, &status);
+        oskar_Mem* expected = uncached_errors(stations[i], 0, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        EXPECT_FALSE(oskar_mem_different(ptr[i], expected, 0, &status));
+        oskar_mem_free(expected, &status);
+        if (i >= OSKAR_ELEMENT_ERRORS_CACHE_SIZE)
+        {
+            EXPECT_EQ(ptr[i - OSKAR_ELEMENT_ERRORS_CACHE_SIZE], ptr[i]);
+        }
+    }
+
+    // The oldest remaining entry is a hit, and becomes the newest,
+    // so the next evicted station takes the entry after it.
+    const int oldest = num_stations - OSKAR_ELEMENT_ERRORS_CACHE_SIZE;
+    EXPECT_EQ(ptr[oldest], oskar_station_work_element_errors(work,
+            stations[oldest], 0, 0, &status));
+    const oskar_Mem* t = oskar_station_work_element_errors(work,
+            stations[0], 0, 0, &status);
+    EXPECT_EQ(ptr[oldest + 1], t);
+    oskar_Mem* expected = uncached_errors(stations[0], 0, &status);
+    EXPECT_FALSE(oskar_mem_different(t, expected, 0, &status));
+    oskar_mem_free(expected, &status);
+    EXPECT_EQ(ptr[oldest], oskar_station_work_element_errors(work,
+            stations[oldest], 0, 0, &status));
+
+    // A different time index is a miss, with different errors.
+    t = oskar_station_work_element_errors(work,
+            stations[oldest], 0, 1, &status);
+    EXPECT_EQ(ptr[oldest + 2], t);
+    expected = uncached_errors(stations[oldest], 1, &status);
+    EXPECT_FALSE(oskar_mem_different(t, expected, 0, &status));
+    oskar_mem_free(expected, &status);
+    expected = uncached_errors(stations[oldest], 0, &status);
+    EXPECT_TRUE(oskar_mem_different(t, expected, 0, &status));
+    oskar_mem_free(expected, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    for (int i = 0; i < num_stations; ++i)
+    {
+        oskar_station_free(stations[i], &status);
+    }
+    oskar_station_work_free(work, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+}
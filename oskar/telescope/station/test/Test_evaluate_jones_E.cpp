@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -168,3 +168,120 @@ TEST(evaluate_jones_E, evaluate_e)
     oskar_station_work_free(work, &error);
     ASSERT_EQ(0, error) << oskar_get_error_string(error);
 }
+
+// Checks that evaluating Jones E for a batch of channels gives the same
+// result as evaluating it for each channel separately.
+TEST(evaluate_jones_E, evaluate_e_channels)
+{
+    int status = 0, prec = OSKAR_DOUBLE;
+    const int num_stations = 3, num_channels = 3, station_dim = 6;
+    const double frequency_hz[] = {50e6, 65e6, 80e6};
+    const double gast = 0.3;
+
+    // Construct telescope model, with element errors so that the cached
+    // errors are used for the batch.
+    oskar_Telescope* tel = oskar_telescope_create(prec,
+            OSKAR_CPU, num_stations, &status);
+    oskar_telescope_set_allow_station_beam_duplication(tel, OSKAR_FALSE);
+    oskar_telescope_resize_station_array(tel, num_stations, &status);
+    oskar_telescope_set_unique_stations(tel, 1, &status);
+    const int num_antennas = station_dim * station_dim;
+    for (int i = 0; i < num_stations; ++i)
+    {
+        oskar_Station* s = oskar_telescope_station(tel, i);
+        oskar_station_resize(s, num_antennas, &status);
+        oskar_station_resize_element_types(s, 1, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        oskar_station_set_position(s, 0.0, M_PI / 2.0, 0.0, 0.0, 0.0, 0.0);
+        oskar_element_set_element_type(oskar_station_element(s, 0),
+                "Isotropic", &status);
+        std::vector<double> x_pos(station_dim);
+        oskar_linspace_d(&x_pos[0], -10.0 * (i + 1), 10.0 * (i + 1),
+                station_dim);
+        oskar_meshgrid_d(
+                oskar_mem_double(
+                        oskar_station_element_measured_enu_metres(s, 0, 0),
+                        &status),
+                oskar_mem_double(
+                        oskar_station_element_measured_enu_metres(s, 0, 1),
+                        &status),
+                &x_pos[0], station_dim, &x_pos[0], station_dim);
+        oskar_mem_copy(oskar_station_element_true_enu_metres(s, 0, 0),
+                oskar_station_element_measured_enu_metres(s, 0, 0), &status);
+        oskar_mem_copy(oskar_station_element_true_enu_metres(s, 0, 1),
+                oskar_station_element_measured_enu_metres(s, 0, 1), &status);
+        for (int e = 0; e < num_antennas; ++e)
+        {
+            oskar_station_set_element_errors(s, 0, e,
+                    1.0, 0.05, 0.0, 2.0, &status);
+        }
+    }
+    oskar_telescope_set_station_ids_and_coords(tel, &status);
+    oskar_telescope_set_phase_centre(tel,
+            OSKAR_COORDS_RADEC, 0.0, M_PI / 2.0);
+    oskar_telescope_analyse(tel, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+
+    // Create pixel positions.
+    const int num_l = 16, num_m = 16, num_pts = num_l * num_m;
+    oskar_Mem* l = oskar_mem_create(prec, OSKAR_CPU, 1 + num_pts, &status);
+    oskar_Mem* m = oskar_mem_create(prec, OSKAR_CPU, 1 + num_pts, &status);
+    oskar_Mem* n = oskar_mem_create(prec, OSKAR_CPU, 1 + num_pts, &status);
+    oskar_evaluate_image_lmn_grid(num_l, num_m, 40.0 * D2R, 40.0 * D2R,
+            1, l, m, n, &status);
+    const oskar_Mem* const source_coords[] = {l, m, n};
+
+    // Evaluate Jones E for all channels together, and for each separately.
+    oskar_Jones* E_batch[num_channels];
+    oskar_Jones* E = oskar_jones_create(prec | OSKAR_COMPLEX,
+            OSKAR_CPU, num_stations, num_pts, &status);
+    oskar_StationWork* work_batch = oskar_station_work_create(prec,
+            OSKAR_CPU, &status);
+    oskar_StationWork* work = oskar_station_work_create(prec,
+            OSKAR_CPU, &status);
+    for (int c = 0; c < num_channels; ++c)
+    {
+        E_batch[c] = oskar_jones_create(prec | OSKAR_COMPLEX,
+                OSKAR_CPU, num_stations, num_pts, &status);
+    }
+    oskar_evaluate_jones_E_channels(num_channels, E_batch,
+            OSKAR_COORDS_REL_DIR, num_pts, source_coords, 0.0, M_PI / 2.0,
+            tel, 0, gast, frequency_hz, work_batch, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+    for (int c = 0; c < num_channels; ++c)
+    {
+        oskar_evaluate_jones_E(E, OSKAR_COORDS_REL_DIR, num_pts,
+                source_coords, 0.0, M_PI / 2.0, tel, 0, gast,
+                frequency_hz[c], work, &status);
+        ASSERT_EQ(0, status) << oskar_get_error_string(status);
+        const double2* a = oskar_mem_double2_const(
+                oskar_jones_mem_const(E_batch[c]), &status);
+        const double2* b = oskar_mem_double2_const(
+                oskar_jones_mem_const(E), &status);
+        for (int i = 0; i < num_stations * num_pts; ++i)
+        {
+            EXPECT_NEAR(b[i].x, a[i].x, 1e-12) << "channel " << c;
+            EXPECT_NEAR(b[i].y, a[i].y, 1e-12) << "channel " << c;
+        }
+
+        // Channels must differ, or the comparison says nothing.
+        if (c > 0)
+        {
+            EXPECT_TRUE(oskar_mem_different(oskar_jones_mem_const(E),
+                    oskar_jones_mem_const(E_batch[c - 1]), 0, &status));
+        }
+    }
+
+    for (int c = 0; c < num_channels; ++c)
+    {
+        oskar_jones_free(E_batch[c], &status);
+    }
+    oskar_jones_free(E, &status);
+    oskar_mem_free(l, &status);
+    oskar_mem_free(m, &status);
+    oskar_mem_free(n, &status);
+    oskar_telescope_free(tel, &status);
+    oskar_station_work_free(work_batch, &status);
+    oskar_station_work_free(work, &status);
+    ASSERT_EQ(0, status) << oskar_get_error_string(status);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2011-2021, The OSKAR Developers.
+ * Copyright (c) 2011-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -7,6 +7,7 @@
 
 #include "telescope/station/oskar_station.h"
 #include "telescope/station/oskar_evaluate_station_beam_aperture_array.h"
+#include "telescope/station/oskar_station_work.h"
 #include "utility/oskar_get_error_string.h"
 #include "math/oskar_linspace.h"
 #include "math/oskar_meshgrid.h"
@@ -131,3 +132,82 @@ TEST(evaluate_station_beam, test_array_pattern)
 
     ASSERT_EQ(0, error) << oskar_get_error_string(error);
 }
+
+TEST(evaluate_station_beam, element_cache)
+{
+    int error = 0;
+    const int num_antennas = 16, num_pixels = 500, num_times = 4;
+    const double frequency = 100e6;
+
+    // Construct a station model with dipole elements.
+    oskar_Station* station = oskar_station_create(OSKAR_DOUBLE,
+            OSKAR_CPU, num_antennas, &error);
+    oskar_station_resize_element_types(station, 1, &error);
+    oskar_station_set_position(station, 0.0, M_PI / 4.0, 0.0, 0.0, 0.0, 0.0);
+    oskar_station_set_phase_centre(station,
+            OSKAR_COORDS_RADEC, 0.0, M_PI / 4.0);
+    oskar_element_set_element_type(oskar_station_element(station, 0),
+            "Dipole", &error);
+    double* x_pos = oskar_mem_double(
+            oskar_station_element_measured_enu_metres(station, 0, 0), &error);
+    double* y_pos = oskar_mem_double(
+            oskar_station_element_measured_enu_metres(station, 0, 1), &error);
+    for (int i = 0; i < num_antennas; ++i)
+    {
+        x_pos[i] = 2.0 * (i % 4);
+        y_pos[i] = 2.0 * (i / 4);
+    }
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+
+    // Generate fixed horizon directions, as for a beam in the station frame.
+    oskar_Mem* x = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_pixels, &error);
+    oskar_Mem* y = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_pixels, &error);
+    oskar_Mem* z = oskar_mem_create(OSKAR_DOUBLE, OSKAR_CPU,
+            num_pixels, &error);
+    double *x_ = oskar_mem_double(x, &error);
+    double *y_ = oskar_mem_double(y, &error);
+    double *z_ = oskar_mem_double(z, &error);
+    for (int i = 0; i < num_pixels; ++i)
+    {
+        const double phi = 0.1 * i, theta = 0.5 * M_PI * i / num_pixels;
+        x_[i] = sin(theta) * cos(phi);
+        y_[i] = sin(theta) * sin(phi);
+        z_[i] = cos(theta);
+    }
+
+    // Evaluate the beam at each time, with and without cached patterns.
+    oskar_StationWork* work = oskar_station_work_create(OSKAR_DOUBLE,
+            OSKAR_CPU, &error);
+    oskar_Mem* beam = oskar_mem_create(OSKAR_DOUBLE_COMPLEX_MATRIX,
+            OSKAR_CPU, num_pixels, &error);
+    oskar_Mem* beam_ref = oskar_mem_create(OSKAR_DOUBLE_COMPLEX_MATRIX,
+            OSKAR_CPU, num_pixels, &error);
+    for (int t = 0; t < num_times; ++t)
+    {
+        const double gast = 0.1 * t;
+        oskar_StationWork* work_ref = oskar_station_work_create(OSKAR_DOUBLE,
+                OSKAR_CPU, &error);
+        oskar_evaluate_station_beam_aperture_array(station, work,
+                num_pixels, x, y, z, t, gast, frequency, beam, &error);
+        oskar_evaluate_station_beam_aperture_array(station, work_ref,
+                num_pixels, x, y, z, t, gast, frequency, beam_ref, &error);
+        ASSERT_EQ(0, error) << oskar_get_error_string(error);
+        EXPECT_EQ(0, oskar_mem_different(beam, beam_ref, 0, &error));
+        EXPECT_EQ(0u, oskar_station_work_element_cache_hits(work_ref));
+        oskar_station_work_free(work_ref, &error);
+    }
+    EXPECT_GT(oskar_station_work_element_cache_hits(work), 0u);
+    EXPECT_LE(oskar_station_work_element_cache_hits(work),
+            oskar_station_work_element_cache_lookups(work));
+
+    oskar_station_work_free(work, &error);
+    oskar_station_free(station, &error);
+    oskar_mem_free(beam, &error);
+    oskar_mem_free(beam_ref, &error);
+    oskar_mem_free(x, &error);
+    oskar_mem_free(y, &error);
+    oskar_mem_free(z, &error);
+    ASSERT_EQ(0, error) << oskar_get_error_string(error);
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, The OSKAR Developers.
+ * Copyright (c) 2017-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -97,7 +97,6 @@ struct oskar_ConditionVar
     pthread_cond_t var;
 #endif
 };
-typedef struct oskar_ConditionVar oskar_ConditionVar;
 
 static void oskar_condition_init(oskar_ConditionVar* var)
 {
@@ -119,17 +118,32 @@ static void oskar_condition_uninit(oskar_ConditionVar* var)
 #endif
 }
 
-static void oskar_condition_lock(oskar_ConditionVar* var)
+oskar_ConditionVar* oskar_condition_create(void)
+{
+    oskar_ConditionVar* var = 0;
+    var = (oskar_ConditionVar*) calloc(1, sizeof(oskar_ConditionVar));
+    oskar_condition_init(var);
+    return var;
+}
+
+void oskar_condition_free(oskar_ConditionVar* var)
+{
+    if (!var) return;
+    oskar_condition_uninit(var);
+    free(var);
+}
+
+void oskar_condition_lock(oskar_ConditionVar* var)
 {
     oskar_mutex_lock(&var->lock);
 }
 
-static void oskar_condition_unlock(oskar_ConditionVar* var)
+void oskar_condition_unlock(oskar_ConditionVar* var)
 {
     oskar_mutex_unlock(&var->lock);
 }
 
-static void oskar_condition_notify_all(oskar_ConditionVar* var)
+void oskar_condition_notify_all(oskar_ConditionVar* var)
 {
 #if defined(OSKAR_OS_WIN)
     WakeAllConditionVariable(&var->var);
@@ -138,7 +152,7 @@ static void oskar_condition_notify_all(oskar_ConditionVar* var)
 #endif
 }
 
-static void oskar_condition_wait(oskar_ConditionVar* var)
+void oskar_condition_wait(oskar_ConditionVar* var)
 {
 #if defined(OSKAR_OS_WIN)
     SleepConditionVariableCS(&var->var, &(var->lock.lock), INFINITE);
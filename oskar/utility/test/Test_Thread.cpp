@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2017-2021, The OSKAR Developers.
+ * Copyright (c) 2017-2026, The OSKAR Developers.
  * See the LICENSE file at the top-level directory of this distribution.
  */
 
@@ -47,6 +47,31 @@ void* thread_barriers(void* arg)
     return 0;
 }
 
+struct ConditionArgs
+{
+    int thread_id, num_threads, num_loops, *turn;
+    oskar_ConditionVar* var;
+};
+typedef struct ConditionArgs ConditionArgs;
+
+void* thread_condition(void* arg)
+{
+    ConditionArgs* args = (ConditionArgs*) arg;
+    for (int i = 0; i < args->num_loops; ++i)
+    {
+        // Wait for this thread's turn, then pass it on to the next one.
+        oskar_condition_lock(args->var);
+        while (*(args->turn) % args->num_threads != args->thread_id)
+        {
+            oskar_condition_wait(args->var);
+        }
+        (*(args->turn))++;
+        oskar_condition_notify_all(args->var);
+        oskar_condition_unlock(args->var);
+    }
+    return 0;
+}
+
 TEST(thread, create_and_join)
 {
     // Get the number of CPU cores.
@@ -113,3 +138,42 @@ TEST(thread, barriers)
     free(args);
     free(threads);
 }
+
+TEST(thread, condition_variable)
+{
+    // Set the number of threads, and the number of turns each one takes.
+    const int num_threads = 4, num_loops = 100;
+    int turn = 0;
+
+    // Create the shared condition variable.
+    oskar_ConditionVar* var = oskar_condition_create();
+
+    // Start all the threads.
+    oskar_Thread** threads = (oskar_Thread**)
+            calloc((size_t) num_threads, sizeof(oskar_Thread*));
+    ConditionArgs* args = (ConditionArgs*)
+            calloc((size_t) num_threads, sizeof(ConditionArgs));
+    for (int i = 0; i < num_threads; ++i)
+    {
+        args[i].thread_id = i;
+        args[i].num_threads = num_threads;
+        args[i].num_loops = num_loops;
+        args[i].turn = &turn;
+        args[i].var = var;
+        threads[i] = oskar_thread_create(thread_condition,
+                (void*)(&args[i]), 0);
+    }
+
+    // Wait for all threads to finish.
+    for (int i = 0; i < num_threads; ++i)
+    {
+        oskar_thread_join(threads[i]);
+        oskar_thread_free(threads[i]);
+    }
+    EXPECT_EQ(num_threads * num_loops, turn);
+
+    // Clean up.
+    oskar_condition_free(var);
+    free(args);
+    free(threads);
+}
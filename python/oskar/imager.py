@@ -199,7 +199,8 @@ class Imager(object):
     @property
     def algorithm(self):
         """Returns or sets the algorithm used by the imager.
-        Currently one of 'FFT', 'DFT 2D', 'DFT 3D' or 'W-projection'.
+        Currently one of 'FFT', 'DFT 2D', 'DFT 3D', 'W-projection'
+        or 'W-stacking'.
 
         The default is 'FFT', which corresponds to basic but quick 2D gridding,
         ignoring baseline w-components.
@@ -219,6 +220,11 @@ class Imager(object):
         of image you are making, as an extra copy of the grid
         will be made by the FFT library.
 
+        The 'W-stacking' option grids visibilities onto a set of W-layers
+        using a small kernel, and corrects each layer in the image domain
+        after its FFT. It runs only on the CPU, and can be faster than
+        W-projection when the W-kernels would be large.
+
         Type
             str
         """
@@ -451,7 +457,8 @@ class Imager(object):
     @property
     def num_w_planes(self):
         """Returns or sets the number of W-projection planes to use,
-        if using W-projection.
+        if using W-projection, or the number of W-layers to use,
+        if using W-stacking.
 
         A number less than or equal to zero means 'automatic'.
 